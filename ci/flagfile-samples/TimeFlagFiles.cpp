@@ -0,0 +1,203 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+/* Times reading flag files with FlagFileView against the per-field reader that
+ it replaced, and reports every flag that the two disagree on. Built by the
+ time-flag-files target when FLAGFILE_TIMING is on. Usage:
+ time-flag-files [folder], where every flags.lch under folder is read. */
+
+#include "generated/configure_launcher.h"
+#include "datastructures/FlagFileView.h"
+#include "global/Utils.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <wx/dir.h>
+#include <wx/file.h>
+#include <wx/init.h>
+#include <wx/stopwatch.h>
+
+#include "global/MemoryDebugging.h"
+
+/** How many times each file is read by each reader. */
+const int REPEATS = 100;
+/** The size of the fields of a flag record before web_url, the last field. */
+const size_t FLAG_FIELDS_BEFORE_WEB_URL = 88;
+
+/** The fields of a flag as the per-field reader read them. */
+struct TimedFlag {
+	wxString flagString, description, category, webURL;
+	wxInt32 easyOnFlags, easyOffFlags;
+};
+
+static bool ReadFlagFileField(wxFile& file, void* field, size_t size) {
+	const size_t bytesRead = file.Read(field, size);
+	return (size_t)wxInvalidOffset != bytesRead && bytesRead == size;
+}
+
+/** The reader that FlagFileView replaced, which made a read for each field
+ of each record. Unlike the original, which only read 344 byte records, it
+ reads web_url as whatever is left of a record, as FlagFileView does. */
+static bool ReadFlagFileByField(const wxString& filePath, wxArrayString& easyFlags,
+		std::vector<TimedFlag>& flags) {
+	wxFile flagfile(filePath);
+	wxInt32 easy_flag_size, flag_size, num_easy_flags, num_flags;
+	if (!ReadFlagFileField(flagfile, &easy_flag_size, sizeof(easy_flag_size))
+		|| !ReadFlagFileField(flagfile, &flag_size, sizeof(flag_size))
+		|| easy_flag_size != 32 || flag_size <= static_cast<wxInt32>(FLAG_FIELDS_BEFORE_WEB_URL)
+		|| !ReadFlagFileField(flagfile, &num_easy_flags, sizeof(num_easy_flags))) {
+		return false;
+	}
+	for (int i = 0; i < num_easy_flags; i++) {
+		char easy_flag[32];
+		if (!ReadFlagFileField(flagfile, &easy_flag, sizeof(easy_flag))) {
+			return false;
+		}
+		easy_flag[sizeof(easy_flag)-1] = '\0';
+		easyFlags.Add(wxString(easy_flag, wxConvUTF8, strlen(easy_flag)));
+	}
+	if (!ReadFlagFileField(flagfile, &num_flags, sizeof(num_flags))) {
+		return false;
+	}
+	std::vector<char> web_url(static_cast<size_t>(flag_size) - FLAG_FIELDS_BEFORE_WEB_URL);
+	for (int i = 0; i < num_flags; i++) {
+		char flag_string[20], description[40], easy_catagory[16];
+		wxInt32 fso_only;
+		TimedFlag flag;
+		if (!ReadFlagFileField(flagfile, &flag_string, sizeof(flag_string))
+			|| !ReadFlagFileField(flagfile, &description, sizeof(description))
+			|| !ReadFlagFileField(flagfile, &fso_only, sizeof(fso_only))
+			|| !ReadFlagFileField(flagfile, &flag.easyOnFlags, sizeof(flag.easyOnFlags))
+			|| !ReadFlagFileField(flagfile, &flag.easyOffFlags, sizeof(flag.easyOffFlags))
+			|| !ReadFlagFileField(flagfile, &easy_catagory, sizeof(easy_catagory))
+			|| !ReadFlagFileField(flagfile, &web_url[0], web_url.size())) {
+			return false;
+		}
+		flag_string[sizeof(flag_string)-1] = '\0';
+		description[sizeof(description)-1] = '\0';
+		easy_catagory[sizeof(easy_catagory)-1] = '\0';
+		web_url[web_url.size()-1] = '\0';
+		flag.flagString = wxString(flag_string, wxConvUTF8, strlen(flag_string));
+		flag.description = wxString(description, wxConvUTF8, strlen(description));
+		flag.category = wxString(easy_catagory, wxConvUTF8, strlen(easy_catagory));
+		flag.webURL = wxString(&web_url[0], wxConvUTF8, strlen(&web_url[0]));
+		flags.push_back(flag);
+	}
+	return true;
+}
+
+/** Times reading the flag file at filePath with both readers. Returns the
+ number of flags that the two disagree on, counting a file that only one of
+ them can read as one. */
+static size_t TimeFlagFileParsing(const wxString& filePath) {
+	size_t flagCount = 0;
+	wxStopWatch timer;
+	for (int n = 0; n < REPEATS; n++) {
+		FlagFileView view;
+		if (view.Load(filePath) != FlagFileView::VIEW_OK) {
+			break;
+		}
+		for (size_t i = 0; i < view.GetFlagCount(); i++) {
+			delete view.CreateFlag(i);
+		}
+		flagCount = view.GetFlagCount();
+	}
+	const long viewTime = timer.Time();
+
+	timer.Start();
+	for (int n = 0; n < REPEATS; n++) {
+		wxArrayString easyFlags;
+		std::vector<TimedFlag> flags;
+		ReadFlagFileByField(filePath, easyFlags, flags);
+	}
+	const long legacyTime = timer.Time();
+
+	wxLogMessage(_T("%s: FlagFileView read %d times ") SZT
+		_T(" flag(s) in %ld ms, reading field by field took %ld ms"),
+		filePath.c_str(), REPEATS, flagCount, viewTime, legacyTime);
+
+	// not timed: report every flag that the two disagree on
+	FlagFileView view;
+	wxArrayString easyFlags;
+	std::vector<TimedFlag> flags;
+	if (view.Load(filePath) != FlagFileView::VIEW_OK
+		|| !ReadFlagFileByField(filePath, easyFlags, flags)) {
+		wxLogWarning(_T("%s: only one of the readers could read it"), filePath.c_str());
+		return 1;
+	}
+	if (view.GetEasyFlagCount() != easyFlags.GetCount() || view.GetFlagCount() != flags.size()) {
+		wxLogWarning(_T("%s: has a different number of flags in the two readers"),
+			filePath.c_str());
+		return 1;
+	}
+	size_t mismatches = 0;
+	for (size_t i = 0; i < easyFlags.GetCount(); i++) {
+		if (view.GetEasyFlag(i) != easyFlags[i]) {
+			wxLogWarning(_T("%s: easy flag ") SZT _T(" is '%s' but was '%s'"),
+				filePath.c_str(), i, view.GetEasyFlag(i).c_str(), easyFlags[i].c_str());
+			mismatches++;
+		}
+	}
+	for (size_t i = 0; i < flags.size(); i++) {
+		Flag* flag = view.CreateFlag(i);
+		if (flag->flagString != flags[i].flagString
+			|| flag->shortDescription != flags[i].description
+			|| flag->fsoCatagory != flags[i].category
+			|| flag->webURL != flags[i].webURL
+			|| flag->easyEnable != static_cast<wxUint32>(flags[i].easyOnFlags)
+			|| flag->easyDisable != static_cast<wxUint32>(flags[i].easyOffFlags)) {
+			wxLogWarning(_T("%s: flag ") SZT _T(" (%s) differs from '%s'"),
+				filePath.c_str(), i, flag->flagString.c_str(), flags[i].flagString.c_str());
+			mismatches++;
+		}
+		delete flag;
+	}
+	return mismatches;
+}
+
+int main(int argc, char** argv) {
+	wxInitializer initializer;
+	if (!initializer.IsOk()) {
+		fprintf(stderr, "Unable to initialize wxWidgets.\n");
+		return 2;
+	}
+	delete wxLog::SetActiveTarget(new wxLogStderr());
+
+	const wxString folder(argc > 1 ? wxString(argv[1], wxConvLocal) : wxString(_T(".")));
+	wxArrayString files;
+	if (!wxDir::Exists(folder)
+		|| wxDir::GetAllFiles(folder, &files, _T("flags.lch")) == 0) {
+		wxLogError(_T("There are no flags.lch files in %s"), folder.c_str());
+		return 2;
+	}
+	files.Sort();
+
+	size_t mismatches = 0;
+	for (size_t i = 0; i < files.GetCount(); i++) {
+		mismatches += TimeFlagFileParsing(files[i]);
+	}
+	if (mismatches > 0) {
+		wxLogError(_T("The readers disagree on ") SZT _T(" flag(s)."), mismatches);
+		return 1;
+	}
+	wxLogMessage(_T("Both readers agree on all ") SZT _T(" file(s) in %s"),
+		files.GetCount(), folder.c_str());
+	return 0;
+}
@@ -0,0 +1,272 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+/* Compares ModIniScanner and ModIniFile with the code paths that they
+ replaced: times finding the mod.ini files in a folder with each, and reading
+ them with each, and reports every value that the two parsers disagree on.
+ Built by the compare-mod-inis target when MODLIST_TIMING is on. Usage:
+ compare-mod-inis FOLDER, such as the samples in this folder or a TC folder. */
+
+#include "generated/configure_launcher.h"
+#include "datastructures/ModIniFile.h"
+#include "datastructures/ModIniScanner.h"
+#include "global/ModIniKeys.h"
+#include "global/Utils.h"
+
+#include <cstdio>
+
+#include <wx/dir.h>
+#include <wx/fileconf.h>
+#include <wx/filename.h>
+#include <wx/init.h>
+#include <wx/mstream.h>
+#include <wx/sstream.h>
+#include <wx/stopwatch.h>
+#include <wx/wfstream.h>
+
+#include "global/MemoryDebugging.h"
+
+/** The traversal that ModIniScanner replaced. */
+class ModIniFinder: public wxDirTraverser {
+public:
+	const wxArrayString& GetFiles() const {
+		return files;
+	}
+	virtual wxDirTraverseResult OnDir(const wxString& dirname) {
+		if (ShouldIgnore(dirname)) {
+			return wxDIR_IGNORE;
+		} else {
+			return wxDIR_CONTINUE;
+		}
+	}
+	virtual wxDirTraverseResult OnFile(const wxString& filename) {
+		if (filename.EndsWith(_T("mod.ini"))) {
+			files.Add(filename);
+		}
+		return wxDIR_CONTINUE;
+	}
+private:
+	bool ShouldIgnore(const wxString& dirname) {
+		const wxString realDirName(dirname.AfterLast(wxFileName::GetPathSeparator()));
+		return realDirName.EndsWith(_T(".app")) || realDirName.StartsWith(_T("."));
+	}
+	wxArrayString files;
+};
+
+/** The mod.ini parsing that ModIniFile replaced. */
+static wxFileConfig* ReadModIniWithFileConfig(const wxString& modIniPath) {
+	wxFFileInputStream stream(modIniPath);
+
+	if ( !stream.IsOk() ) {
+		return NULL;
+	}
+
+	// check if the stream is a UTF-8 File (has a BOM)
+	char header[3];
+	stream.Read(reinterpret_cast<void*>(&header), sizeof(header));
+	stream.SeekI(0);
+	
+	bool isUTF8 = false;
+	if ( header[0] == '\357' && header[1] == '\273' && header[2] == '\277' ) {
+		// is a UTF-8 file
+		isUTF8 = true;
+	}
+
+	wxMemoryOutputStream tempStream;
+	tempStream.Write(stream);
+
+	wxStreamBuffer* buf = tempStream.GetOutputStreamBuffer();
+	const size_t size = buf->GetBufferSize();
+
+	char* characterBuffer = new char[size+1];
+	characterBuffer[size] = '\0';
+
+	buf->Seek(0, wxFromStart);
+
+	// don't try to read in buffer when there is nothing to read.
+	size_t read = (size == 0) ? 0 : buf->Read(reinterpret_cast<void*>(characterBuffer), size);
+	if ( read != size ) {
+		wxLogError(wxT("read (") SZT wxT(") not equal to size (") SZT wxT(")"), read, size);
+		delete[] characterBuffer;
+		return NULL;
+	}
+
+	const wxMBConv* conv = NULL;
+	if ( isUTF8 ) {
+		conv = &wxConvUTF8;
+	} else {
+		conv = &wxConvISO8859_1;
+	}
+
+	wxString stringBuffer(characterBuffer, *conv);
+
+	// A hack to insert a backslash into the stream so that when
+	// wxFileConfig escapes the backslashes, the one that is in 
+	// the file is returned
+	stringBuffer.Replace(_T("\\"), _T("\\\\"));
+	wxStringInputStream finalBuffer(stringBuffer);
+
+	wxFileConfig* config = new wxFileConfig(finalBuffer);
+	delete[] characterBuffer;
+
+	return config;
+}
+
+/** The keys that are looked up in every mod.ini, for timing comparisons. */
+static const wxString* const TIMED_MOD_INI_KEYS[] = {
+	&MOD_INI_KEY_LAUNCHER_MOD_NAME,
+	&MOD_INI_KEY_LAUNCHER_IMAGE_255X112,
+	&MOD_INI_KEY_LAUNCHER_IMAGE_182X80,
+	&MOD_INI_KEY_LAUNCHER_INFO_TEXT,
+	&MOD_INI_KEY_LAUNCHER_AUTHOR,
+	&MOD_INI_KEY_LAUNCHER_NOTES,
+	&MOD_INI_KEY_LAUNCHER_WARN,
+	&MOD_INI_KEY_LAUNCHER_WEBSITE,
+	&MOD_INI_KEY_LAUNCHER_FORUM,
+	&MOD_INI_KEY_LAUNCHER_BUGS,
+	&MOD_INI_KEY_LAUNCHER_SUPPORT,
+	&MOD_INI_KEY_RESOLUTION_MIN_HORIZONTAL_RES,
+	&MOD_INI_KEY_RESOLUTION_MIN_VERTICAL_RES,
+	&MOD_INI_KEY_RECOMMENDED_LIGHTING_NAME,
+	&MOD_INI_KEY_RECOMMENDED_LIGHTING_FLAGSET,
+	&MOD_INI_KEY_EXTREMEFORCE_FORCED_FLAGS_ON,
+	&MOD_INI_KEY_EXTREMEFORCE_FORCED_FLAGS_OFF,
+	&MOD_INI_KEY_MULTIMOD_PRIMARY_LIST,
+	&MOD_INI_KEY_MULTIMOD_SECONDRY_LIST,
+	&MOD_INI_KEY_MULTIMOD_SECONDARY_LIST,
+};
+static const size_t TIMED_MOD_INI_KEY_COUNT =
+	sizeof(TIMED_MOD_INI_KEYS) / sizeof(TIMED_MOD_INI_KEYS[0]);
+
+/** Times reading modInis and looking up their keys with ModIniFile
+ and with wxFileConfig, and checks that both find the same values.
+ Returns the number of values that they disagree on. */
+static size_t CompareModIniParsers(const wxArrayString& modInis) {
+	wxString value, legacyValue;
+	size_t found = 0, legacyFound = 0, mismatches = 0;
+
+	wxStopWatch timer;
+	for (size_t i = 0; i < modInis.GetCount(); i++) {
+		ModIniFile config;
+		if (config.Load(modInis[i])) {
+			for (size_t k = 0; k < TIMED_MOD_INI_KEY_COUNT; k++) {
+				if (config.Read(*TIMED_MOD_INI_KEYS[k], &value)) {
+					found++;
+				}
+			}
+		}
+	}
+	const long parserTime = timer.Time();
+
+	timer.Start();
+	for (size_t i = 0; i < modInis.GetCount(); i++) {
+		wxFileConfig* config = ReadModIniWithFileConfig(modInis[i]);
+		if (config != NULL) {
+			for (size_t k = 0; k < TIMED_MOD_INI_KEY_COUNT; k++) {
+				if (config->HasEntry(*TIMED_MOD_INI_KEYS[k])) {
+					config->Read(*TIMED_MOD_INI_KEYS[k], &legacyValue);
+					legacyFound++;
+				}
+			}
+			delete config;
+		}
+	}
+	const long legacyTime = timer.Time();
+
+	wxLogMessage(_T("ModIniFile read ") SZT _T(" mod.ini file(s) (") SZT
+		_T(" values) in %ld ms, wxFileConfig read them (") SZT _T(" values) in %ld ms"),
+		modInis.GetCount(), found, parserTime, legacyFound, legacyTime);
+
+	// not timed: report every value that the two disagree on
+	for (size_t i = 0; i < modInis.GetCount(); i++) {
+		ModIniFile config;
+		wxFileConfig* legacyConfig = ReadModIniWithFileConfig(modInis[i]);
+		if (legacyConfig == NULL || !config.Load(modInis[i])) {
+			delete legacyConfig;
+			continue;
+		}
+		for (size_t k = 0; k < TIMED_MOD_INI_KEY_COUNT; k++) {
+			const wxString& key = *TIMED_MOD_INI_KEYS[k];
+			value = config.Read(key, wxEmptyString);
+			legacyValue = legacyConfig->Read(key, wxEmptyString);
+			if (value != legacyValue) {
+				wxLogWarning(_T("%s %s is '%s' but wxFileConfig has '%s'"),
+					modInis[i].c_str(), key.c_str(), value.c_str(), legacyValue.c_str());
+				mismatches++;
+			}
+		}
+		delete legacyConfig;
+	}
+	return mismatches;
+}
+
+/** Times finding the mod.ini files in tcPath with ModIniScanner, against
+ the wxDir traversal that it replaced. */
+static void TimeModIniScanner(const wxString& tcPath) {
+	wxStopWatch timer;
+	ModIniScanner scanner(tcPath);
+	scanner.Start();
+	wxString modIniPath;
+	size_t count = 0;
+	while (scanner.GetNextModIni(modIniPath)) {
+		count++;
+	}
+	const long scannerTime = timer.Time();
+
+	timer.Start();
+	ModIniFinder iniFinder;
+	wxDir dir(tcPath);
+	dir.Traverse(iniFinder, _T("mod.ini"));
+	const long traverseTime = timer.Time();
+
+	wxLogMessage(_T("ModIniScanner found ") SZT _T(" mod.ini file(s) in %ld ms, ")
+		_T("wxDir::Traverse found ") SZT _T(" in %ld ms"),
+		count, scannerTime, iniFinder.GetFiles().Count(), traverseTime);
+}
+
+int main(int argc, char** argv) {
+	wxInitializer initializer;
+	if (!initializer.IsOk()) {
+		fprintf(stderr, "Unable to initialize wxWidgets.\n");
+		return 2;
+	}
+	delete wxLog::SetActiveTarget(new wxLogStderr());
+
+	if (argc < 2) {
+		wxLogError(_T("Usage: compare-mod-inis FOLDER"));
+		return 2;
+	}
+	const wxString folder(argv[1], wxConvLocal);
+	wxArrayString modInis;
+	if (!wxDir::Exists(folder)
+		|| wxDir::GetAllFiles(folder, &modInis, _T("*.ini"), wxDIR_FILES | wxDIR_DIRS) == 0) {
+		wxLogError(_T("There are no .ini files in %s"), folder.c_str());
+		return 2;
+	}
+	modInis.Sort();
+
+	TimeModIniScanner(folder);
+	const size_t mismatches = CompareModIniParsers(modInis);
+	if (mismatches > 0) {
+		wxLogError(_T("The parsers disagree on ") SZT _T(" value(s)."), mismatches);
+		return 1;
+	}
+	wxLogMessage(_T("Both parsers agree on all ") SZT _T(" file(s) in %s"),
+		modInis.GetCount(), folder.c_str());
+	return 0;
+}
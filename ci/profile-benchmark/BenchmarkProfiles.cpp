@@ -0,0 +1,240 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+/* Times the profile index and the profile journal against the code paths that
+ they replaced. Built by the benchmark-profiles target when PROFILE_TIMING is
+ on. The index is timed on the profiles of the current user, which it only
+ reads; the journal on profiles that are made up in memory. */
+
+#include "generated/configure_launcher.h"
+#include "datastructures/ProfileIndex.h"
+#include "global/ProfileKeys.h"
+#include "global/Utils.h"
+
+#include <wx/app.h>
+#include <wx/dir.h>
+#include <wx/fileconf.h>
+#include <wx/sstream.h>
+#include <wx/stopwatch.h>
+#include <wx/wfstream.h>
+
+#include "global/MemoryDebugging.h"
+
+/** Times finding the profiles with the profile index,
+ against parsing every profile file as was done before there was an index. */
+static void TimeProfileIndex() {
+	wxStopWatch timer;
+	ProfileIndex index;
+	index.Load();
+	index.Refresh();
+	const long indexTime = timer.Time();
+
+	timer.Start();
+	wxArrayString foundProfiles;
+	wxDir::GetAllFiles(GetProfileStorageFolder(), &foundProfiles, _T("pro?????.ini"), wxDIR_FILES);
+	wxString name;
+	for (size_t i = 0; i < foundProfiles.GetCount(); i++) {
+		wxFFileInputStream instream(foundProfiles[i]);
+		wxFileConfig config(instream);
+		config.Read(PRO_CFG_MAIN_NAME.GetPath(), &name);
+	}
+	const long parseTime = timer.Time();
+
+	wxLogMessage(_T("the profile index found ") SZT
+		_T(" profile(s) in %ld ms, parsing all ") SZT _T(" profile file(s) took %ld ms"),
+		index.GetEntries().size(), indexTime, foundProfiles.GetCount(), parseTime);
+}
+
+// ProMan's config helpers and journal are private to it, so the two ways of
+// keeping a snapshot are done here the way ProMan does them. wxFileConfig
+// stores every entry as text, so entries are copied and compared as text.
+
+/** The state of an entry, as ProMan::ReadEntry() reads it. */
+struct EntryState {
+	EntryState() : exists(false) { } // required for wxHashMap
+	EntryState(bool exists, const wxString& value) : exists(exists), value(value) { }
+	bool operator==(const EntryState& other) const {
+		return this->exists == other.exists && this->value == other.value;
+	}
+	bool exists;
+	wxString value;
+};
+WX_DECLARE_STRING_HASH_MAP(EntryState, ProfileJournal);
+
+static EntryState ReadEntry(wxFileConfig& config, const wxString& key) {
+	const bool expandingEnvVars = config.IsExpandingEnvVars();
+	config.SetExpandEnvVars(false);
+	wxString value;
+	const bool exists = config.Read(key, &value);
+	config.SetExpandEnvVars(expandingEnvVars);
+	return EntryState(exists, value);
+}
+
+static void WriteEntry(wxFileConfig& config, const wxString& key, const EntryState& state) {
+	if (state.exists) {
+		config.Write(key, state.value);
+	} else {
+		config.DeleteEntry(key, true);
+	}
+}
+
+/** As ProMan::CopyConfig(). */
+static void CopyConfig(wxConfigBase& src, wxConfigBase& dest, const wxString& path = _T("/")) {
+	wxString name;
+	long index;
+	for (bool more = src.GetFirstEntry(name, index); more; more = src.GetNextEntry(name, index)) {
+		dest.Write(path + name, src.Read(name, wxEmptyString));
+	}
+	for (bool more = src.GetFirstGroup(name, index); more; more = src.GetNextGroup(name, index)) {
+		const wxString subPath(path + name + _T("/"));
+		src.SetPath(subPath);
+		CopyConfig(src, dest, subPath);
+		src.SetPath(path);
+	}
+}
+
+/** As ProMan::ClearConfig(). */
+static void ClearConfig(wxConfigBase& config) {
+	wxArrayString entries, groups;
+	wxString name;
+	long index;
+	for (bool more = config.GetFirstEntry(name, index); more; more = config.GetNextEntry(name, index)) {
+		entries.Add(name);
+	}
+	for (bool more = config.GetFirstGroup(name, index); more; more = config.GetNextGroup(name, index)) {
+		groups.Add(name);
+	}
+	for (size_t i = 0; i < entries.GetCount(); i++) {
+		config.DeleteEntry(entries[i]);
+	}
+	for (size_t i = 0; i < groups.GetCount(); i++) {
+		config.DeleteGroup(groups[i]);
+	}
+}
+
+/** As ProMan::IsConfigSubset(). */
+static bool IsConfigSubset(wxConfigBase& config1, wxConfigBase& config2, const wxString& path = _T("/")) {
+	wxString name, value1, value2;
+	long index;
+	for (bool more = config1.GetFirstEntry(name, index); more; more = config1.GetNextEntry(name, index)) {
+		if (!config1.Read(name, &value1) || !config2.Read(path + name, &value2) || value1 != value2) {
+			return false;
+		}
+	}
+	for (bool more = config1.GetFirstGroup(name, index); more; more = config1.GetNextGroup(name, index)) {
+		const wxString subPath(path + name + _T("/"));
+		config1.SetPath(subPath);
+		const bool isSubset = IsConfigSubset(config1, config2, subPath);
+		config1.SetPath(path);
+		if (!isSubset) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/** Returns the key of one of the entries in the profiles that TimeProfileSnapshots() makes. */
+static wxString GetTimingEntryKey(size_t entry) {
+	return wxString::Format(_T("/group%03lu/entry%05lu"),
+		static_cast<unsigned long>(entry / 50), static_cast<unsigned long>(entry));
+}
+
+/** Times saving, checking and reverting a profile of entryCount entries with the journal,
+ against the deep copies and full comparisons of a private copy that it replaced. */
+static void TimeProfileSnapshots(size_t entryCount) {
+	const size_t changeCount = entryCount / 100 + 1;
+	wxStringInputStream profileInput(wxEmptyString);
+	wxFileConfig profile(profileInput);
+	for (size_t i = 0; i < entryCount; i++) {
+		profile.Write(GetTimingEntryKey(i), static_cast<long>(i));
+	}
+
+	// the private copy: reset on every save and switch, compared on every check, copied back on revert
+	wxStringInputStream copyInput(wxEmptyString);
+	wxFileConfig privateCopy(copyInput);
+	wxStopWatch timer;
+	ClearConfig(privateCopy);
+	CopyConfig(profile, privateCopy);
+	const long copyResetTime = timer.Time();
+
+	for (size_t i = 0; i < changeCount; i++) {
+		profile.Write(GetTimingEntryKey((i * 97) % entryCount), -1L);
+	}
+	timer.Start();
+	const bool copyDirty = !IsConfigSubset(profile, privateCopy) || !IsConfigSubset(privateCopy, profile);
+	const long copyCheckTime = timer.Time();
+
+	timer.Start();
+	ClearConfig(profile);
+	CopyConfig(privateCopy, profile);
+	const long copyRevertTime = timer.Time();
+
+	// the journal, kept the way ProMan's JournalChange(), HasUnsavedChanges()
+	// and RevertCurrentProfile() keep it
+	ProfileJournal journal;
+	timer.Start();
+	for (size_t i = 0; i < changeCount; i++) {
+		const wxString key(GetTimingEntryKey((i * 97) % entryCount));
+		const EntryState before(ReadEntry(profile, key));
+		profile.Write(key, -1L);
+		if (!(ReadEntry(profile, key) == before) && journal.find(key) == journal.end()) {
+			journal[key] = before;
+		}
+	}
+	const long journalWriteTime = timer.Time();
+
+	timer.Start();
+	const bool journalDirty = !journal.empty();
+	const long journalCheckTime = timer.Time();
+
+	timer.Start();
+	for (ProfileJournal::const_iterator it = journal.begin(); it != journal.end(); ++it) {
+		WriteEntry(profile, it->first, it->second);
+	}
+	journal.clear();
+	const long journalRevertTime = timer.Time();
+
+	wxLogMessage(SZT _T(" entries, ") SZT _T(" changed. ")
+		_T("private copy: reset %ld ms, check %ld ms (%s), revert %ld ms. ")
+		_T("journal: writes %ld ms, check %ld ms (%s), revert %ld ms"),
+		entryCount, changeCount,
+		copyResetTime, copyCheckTime, copyDirty ? _T("dirty") : _T("clean"), copyRevertTime,
+		journalWriteTime, journalCheckTime, journalDirty ? _T("dirty") : _T("clean"), journalRevertTime);
+}
+
+class BenchmarkProfilesApp: public wxAppConsole {
+public:
+	virtual bool OnInit();
+	virtual int OnRun();
+};
+
+IMPLEMENT_APP_CONSOLE(BenchmarkProfilesApp)
+
+bool BenchmarkProfilesApp::OnInit() {
+	// so that GetProfileStorageFolder() is the launcher's
+	this->SetAppName(_T("wxlauncher"));
+	delete wxLog::SetActiveTarget(new wxLogStderr());
+	return true;
+}
+
+int BenchmarkProfilesApp::OnRun() {
+	TimeProfileIndex();
+	TimeProfileSnapshots(1000);
+	TimeProfileSnapshots(10000);
+	return 0;
+}
@@ -64,9 +64,12 @@ MainWindow::MainWindow() {
 #endif
 
 	// setup keyboard shortcuts
-	wxAcceleratorEntry entries[1];
+	wxAcceleratorEntry entries[4];
 	entries[0].Set(wxACCEL_NORMAL, WXK_F3, ID_F3_PRESSED);
-	wxAcceleratorTable accel(1, entries);
+	entries[1].Set(wxACCEL_CTRL, (int) 'Z', ID_UNDO_PRESSED);
+	entries[2].Set(wxACCEL_CTRL, (int) 'Y', ID_REDO_PRESSED);
+	entries[3].Set(wxACCEL_CTRL | wxACCEL_SHIFT, (int) 'Z', ID_REDO_PRESSED);
+	wxAcceleratorTable accel(4, entries);
 	SetAcceleratorTable(accel);
 	
 	// setup tabs
@@ -112,6 +115,8 @@ BEGIN_EVENT_TABLE(MainWindow, wxFrame)
 	EVT_END_PROCESS(ID_FRED2_PROCESS, MainWindow::OnFRED2Exited)
 	EVT_COMMAND(wxID_NONE, EVT_TC_SKIN_CHANGED, MainWindow::OnTCSkinChanged)
 	EVT_MENU(ID_F3_PRESSED, MainWindow::OnF3Pressed)
+	EVT_MENU(ID_UNDO_PRESSED, MainWindow::OnUndoPressed)
+	EVT_MENU(ID_REDO_PRESSED, MainWindow::OnRedoPressed)
 END_EVENT_TABLE()
 
 void MainWindow::OnQuit(wxCommandEvent& WXUNUSED(event)) {
@@ -158,19 +163,19 @@ void MainWindow::OnStart(wxButton* button, bool startFred) {
 	button->Disable();
 
 	const wxString defaultButtonValue((startFred)?_("FRED"):_("Play"));
-	const wxString cfgBinaryPath((startFred)? PRO_CFG_TC_CURRENT_FRED : PRO_CFG_TC_CURRENT_BINARY);
+	const ProfileKey<wxString>& cfgBinaryPath((startFred)? PRO_CFG_TC_CURRENT_FRED : PRO_CFG_TC_CURRENT_BINARY);
 	
 	ProMan* p = ProMan::GetProfileManager();
 	wxString folder, binary;
 	if ( !p->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &folder) ) {
 		wxLogError(_T("Game root folder for current profile is not set (%s)"),
-			PRO_CFG_TC_ROOT_FOLDER.c_str());
+			PRO_CFG_TC_ROOT_FOLDER.GetPath().c_str());
 		button->SetLabel(defaultButtonValue);
 		button->Enable();
 		return;
 	}
 	if ( !p->ProfileRead(cfgBinaryPath, &binary) ) {
-		wxLogError(_T("No FS2 Open executable has been selected (%s)"), cfgBinaryPath.c_str());
+		wxLogError(_T("No FS2 Open executable has been selected (%s)"), cfgBinaryPath.GetPath().c_str());
 		button->SetLabel(defaultButtonValue);
 		button->Enable();
 		return;
@@ -349,3 +354,37 @@ void MainWindow::OnF3Pressed(wxCommandEvent& WXUNUSED(event)) {
 	proman->GlobalWrite(GBL_CFG_OPT_CONFIG_FRED, !fredEnabled);
 	FREDManager::GenerateFREDEnabledChanged();
 }
+
+/** A text box that has the focus keeps its own undo, so that Ctrl+Z while
+ typing does not undo some other setting. */
+void MainWindow::OnUndoPressed(wxCommandEvent& WXUNUSED(event)) {
+	wxTextCtrl* text = wxDynamicCast(wxWindow::FindFocus(), wxTextCtrl);
+	if (text != NULL) {
+		if (text->CanUndo()) {
+			text->Undo();
+		}
+		return;
+	}
+
+	ProMan* proman = ProMan::GetProfileManager();
+	wxCHECK_RET(proman != NULL, _T("OnUndoPressed(): proman is NULL!"));
+	if (proman->CanUndo()) {
+		proman->Undo();
+	}
+}
+
+void MainWindow::OnRedoPressed(wxCommandEvent& WXUNUSED(event)) {
+	wxTextCtrl* text = wxDynamicCast(wxWindow::FindFocus(), wxTextCtrl);
+	if (text != NULL) {
+		if (text->CanRedo()) {
+			text->Redo();
+		}
+		return;
+	}
+
+	ProMan* proman = ProMan::GetProfileManager();
+	wxCHECK_RET(proman != NULL, _T("OnRedoPressed(): proman is NULL!"));
+	if (proman->CanRedo()) {
+		proman->Redo();
+	}
+}
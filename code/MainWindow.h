@@ -43,6 +43,9 @@ public:
 	
 	/** F3 toggles FRED launching. */
 	void OnF3Pressed(wxCommandEvent& event);
+	/** Ctrl+Z and Ctrl+Y undo and redo changes to the current profile. */
+	void OnUndoPressed(wxCommandEvent& event);
+	void OnRedoPressed(wxCommandEvent& event);
 
 private:
 	wxProcess* process;
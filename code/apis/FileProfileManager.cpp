@@ -21,14 +21,17 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <wx/ffile.h>
 #include <wx/wfstream.h>
 #include <wx/sstream.h>
+#include <wx/mstream.h>
 #include "generated/configure_launcher.h"
 #include "apis/ProfileManager.h"
 #include "apis/PlatformProfileManager.h"
+#include "apis/ProfileWriter.h"
 #include "apis/FlagListManager.h"
 #include "apis/JoystickManager.h"
 #include "global/BasicDefaults.h"
 #include "global/ProfileKeys.h"
 #include "global/RegistryKeys.h"
+#include "global/Utils.h"
 
 #include <SDL_filesystem.h>
 
@@ -85,16 +88,88 @@ wxFileName GetPlatformDefaultConfigFilePath(const wxString& tcPath) {
 
 #define FSO_CONFIG_FILENAME _T("fs2_open.ini")
 
-#define ReturnChecker(retvalue, location) \
-	if ( retvalue != true ) {\
-		wxLogError(_T("Unhandled error in writing to the configuration file above line %d"), location);\
-		return ProMan::UnknownError;\
+/** The entries that a profile sets in, or removes from, fs2_open.ini.
+ Used like a wxFileConfig, but only records the entries, so that nothing has to
+ be read from disk unless they differ from what was pushed last time. */
+class FsoIniSettings {
+public:
+	void SetPath(const wxString& path) { this->path = path; }
+	void Write(const wxString& key, const wxString& value);
+	void Write(const wxString& key, long value);
+	void Remove(const wxString& key);
+
+	/** Hashes the entries, so that they can be compared with the ones pushed last time. */
+	wxString Hash() const;
+	/** Sets the entries in config, leaving the ones that already have their value alone.
+	 Returns the number of entries changed. */
+	size_t Apply(wxFileConfig& config) const;
+
+private:
+	struct Entry {
+		Entry(): remove(false) { }
+		wxString key; //!< absolute
+		wxString value;
+		bool remove;
+	};
+	wxString path;
+	std::vector<Entry> entries;
+};
+
+void FsoIniSettings::Write(const wxString& key, const wxString& value) {
+	Entry entry;
+	entry.key = this->path + _T("/") + key;
+	entry.value = value;
+	this->entries.push_back(entry);
+}
+
+void FsoIniSettings::Write(const wxString& key, long value) {
+	// the same text that wxFileConfig writes for a number
+	this->Write(key, wxString::Format(_T("%ld"), value));
+}
+
+void FsoIniSettings::Remove(const wxString& key) {
+	Entry entry;
+	entry.key = this->path + _T("/") + key;
+	entry.remove = true;
+	this->entries.push_back(entry);
+}
+
+wxString FsoIniSettings::Hash() const {
+	wxString rendered;
+	for (size_t i = 0; i < this->entries.size(); i++) {
+		if (this->entries[i].remove) {
+			rendered += _T("-") + this->entries[i].key + _T("\n");
+		} else {
+			rendered += this->entries[i].key + _T("=") + this->entries[i].value + _T("\n");
+		}
+	}
+	const wxCharBuffer buffer(rendered.utf8_str());
+	return HashUtils::HashBuffer(buffer.data(), strlen(buffer.data()));
+}
+
+size_t FsoIniSettings::Apply(wxFileConfig& config) const {
+	size_t changed = 0;
+	for (size_t i = 0; i < this->entries.size(); i++) {
+		const Entry& entry = this->entries[i];
+		wxString current;
+		if (entry.remove) {
+			if (config.Exists(entry.key)) {
+				config.DeleteEntry(entry.key, false);
+				changed++;
+			}
+		} else if (!config.Read(entry.key, &current) || current != entry.value) {
+			wxLogDebug(_T(" %s changed"), entry.key.c_str());
+			config.Write(entry.key, entry.value);
+			changed++;
+		}
 	}
+	return changed;
+}
 
 ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
 	wxFileName configFileName;
 	wxString tcPath;
-	cfg->Read(PRO_CFG_TC_ROOT_FOLDER, &tcPath);
+	cfg->Read(PRO_CFG_TC_ROOT_FOLDER.GetPath(), &tcPath);
 
 	if ( cfg->Exists(INT_CONFIG_FILE_LOCATION) ) {
 		wxString configFileNameString;
@@ -116,63 +191,48 @@ ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
 		configFileName.SetFullName(FSO_CONFIG_FILENAME);
 	}
 
-	wxFFileInputStream configFileInputStream(configFileName.GetFullPath());
-	wxStringInputStream configBlankInputStream(_T("")); // in case ini file doesn't exist
-	wxInputStream* configInputStreamPtr = &configFileInputStream;
-	
-	if (!configFileInputStream.IsOk()) {
-		wxLogDebug(_T("Could not read from ini file %s, writing new file"),
-			configFileName.GetFullPath().c_str());
-		configInputStreamPtr = &configBlankInputStream;
-	}
-	wxFileConfig outConfig(*configInputStreamPtr, wxMBConvUTF8());
-	bool ret;
-	
+	FsoIniSettings outConfig;
+
 	// most settings are written to "Default" folder
 	outConfig.SetPath(REG_KEY_DEFAULT_FOLDER_CFG);
 
 	// Video
 	int width, height, bitdepth;
-	cfg->Read(PRO_CFG_VIDEO_RESOLUTION_WIDTH, &width, DEFAULT_VIDEO_RESOLUTION_WIDTH);
-	cfg->Read(PRO_CFG_VIDEO_RESOLUTION_HEIGHT, &height, DEFAULT_VIDEO_RESOLUTION_HEIGHT);
-	cfg->Read(PRO_CFG_VIDEO_BIT_DEPTH, &bitdepth, DEFAULT_VIDEO_BIT_DEPTH);
+	cfg->Read(PRO_CFG_VIDEO_RESOLUTION_WIDTH.GetPath(), &width, DEFAULT_VIDEO_RESOLUTION_WIDTH);
+	cfg->Read(PRO_CFG_VIDEO_RESOLUTION_HEIGHT.GetPath(), &height, DEFAULT_VIDEO_RESOLUTION_HEIGHT);
+	cfg->Read(PRO_CFG_VIDEO_BIT_DEPTH.GetPath(), &bitdepth, DEFAULT_VIDEO_BIT_DEPTH);
 
 	wxString videocardValue = wxString::Format(_T("OGL -(%dx%d)x%d bit"), width, height, bitdepth);
 
-	ret = outConfig.Write(REG_KEY_VIDEO_RESOLUTION_DEPTH, videocardValue);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_VIDEO_RESOLUTION_DEPTH, videocardValue);
 
 	
 	wxString filterMethod;
-	cfg->Read(PRO_CFG_VIDEO_TEXTURE_FILTER, &filterMethod, DEFAULT_VIDEO_TEXTURE_FILTER);
+	cfg->Read(PRO_CFG_VIDEO_TEXTURE_FILTER.GetPath(), &filterMethod, DEFAULT_VIDEO_TEXTURE_FILTER);
 	int filterMethodValue = ( filterMethod.StartsWith(_T("Bilinear"))) ? 0 : 1;
 	
-	ret = outConfig.Write(REG_KEY_VIDEO_TEXTURE_FILTER, filterMethodValue);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_VIDEO_TEXTURE_FILTER, filterMethodValue);
 	
 
 	int oglAnisotropicFilter;
-	cfg->Read(PRO_CFG_VIDEO_ANISOTROPIC, &oglAnisotropicFilter, DEFAULT_VIDEO_ANISOTROPIC);
+	cfg->Read(PRO_CFG_VIDEO_ANISOTROPIC.GetPath(), &oglAnisotropicFilter, DEFAULT_VIDEO_ANISOTROPIC);
 
 	// Caution: FSO expects anisotropic values to be a string,
 	// but since we're writing to an .ini file, we can write it out as an int
-	ret = outConfig.Write(REG_KEY_VIDEO_ANISOTROPIC, oglAnisotropicFilter);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_VIDEO_ANISOTROPIC, oglAnisotropicFilter);
 	
 
 	int oglAntiAliasSample;
-	cfg->Read(PRO_CFG_VIDEO_ANTI_ALIAS, &oglAntiAliasSample, DEFAULT_VIDEO_ANTI_ALIAS);
+	cfg->Read(PRO_CFG_VIDEO_ANTI_ALIAS.GetPath(), &oglAntiAliasSample, DEFAULT_VIDEO_ANTI_ALIAS);
 
-	ret = outConfig.Write(REG_KEY_VIDEO_ANTI_ALIAS, oglAntiAliasSample);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_VIDEO_ANTI_ALIAS, oglAntiAliasSample);
 
 
 	// Audio
 	wxString soundDevice;
-	cfg->Read(PRO_CFG_OPENAL_DEVICE, &soundDevice, DEFAULT_AUDIO_OPENAL_DEVICE);
+	cfg->Read(PRO_CFG_OPENAL_DEVICE.GetPath(), &soundDevice, DEFAULT_AUDIO_OPENAL_DEVICE);
 
-	ret = outConfig.Write(REG_KEY_AUDIO_OPENAL_DEVICE, soundDevice);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_AUDIO_OPENAL_DEVICE, soundDevice);
 
 
 	// new sound code settings are written to "Sound" folder
@@ -181,44 +241,40 @@ ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
 
 	wxString playbackDevice;
 	cfg->Read(
-		PRO_CFG_OPENAL_DEVICE,
+		PRO_CFG_OPENAL_DEVICE.GetPath(),
 		&playbackDevice,
 		DEFAULT_AUDIO_OPENAL_PLAYBACK_DEVICE);
 
-	ret = outConfig.Write(REG_KEY_AUDIO_OPENAL_PLAYBACK_DEVICE, playbackDevice);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_AUDIO_OPENAL_PLAYBACK_DEVICE, playbackDevice);
 
 
 	wxString captureDevice;
 	bool hasEntry = cfg->Read(
-		PRO_CFG_OPENAL_CAPTURE_DEVICE,
+		PRO_CFG_OPENAL_CAPTURE_DEVICE.GetPath(),
 		&captureDevice,
 		DEFAULT_AUDIO_OPENAL_CAPTURE_DEVICE);
 
 	if (hasEntry) {
-		ret = outConfig.Write(REG_KEY_AUDIO_OPENAL_CAPTURE_DEVICE, captureDevice);
-		ReturnChecker(ret, __LINE__);
+		outConfig.Write(REG_KEY_AUDIO_OPENAL_CAPTURE_DEVICE, captureDevice);
 	}
 
 
 	int enableEFX;
-	hasEntry = cfg->Read(PRO_CFG_OPENAL_EFX, &enableEFX, DEFAULT_AUDIO_OPENAL_EFX);
+	hasEntry = cfg->Read(PRO_CFG_OPENAL_EFX.GetPath(), &enableEFX, DEFAULT_AUDIO_OPENAL_EFX);
 
 	if (hasEntry) {
-		ret = outConfig.Write(REG_KEY_AUDIO_OPENAL_EFX, enableEFX);
-		ReturnChecker(ret, __LINE__);
+		outConfig.Write(REG_KEY_AUDIO_OPENAL_EFX, enableEFX);
 	}
 
 
 	int sampleRate;
 	cfg->Read(
-		PRO_CFG_OPENAL_SAMPLE_RATE,
+		PRO_CFG_OPENAL_SAMPLE_RATE.GetPath(),
 		&sampleRate,
 		DEFAULT_AUDIO_OPENAL_SAMPLE_RATE);
 
 	if (sampleRate != DEFAULT_AUDIO_OPENAL_SAMPLE_RATE) {
-		ret = outConfig.Write(REG_KEY_AUDIO_OPENAL_SAMPLE_RATE, sampleRate);
-		ReturnChecker(ret, __LINE__);
+		outConfig.Write(REG_KEY_AUDIO_OPENAL_SAMPLE_RATE, sampleRate);
 	}
 
 
@@ -228,94 +284,80 @@ ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
 	// Speech
 #if IS_WIN32 // speech is currently not supported in OS X or Linux (although Windows doesn't use this code)
 	int speechVoice;
-	cfg->Read(PRO_CFG_SPEECH_VOICE, &speechVoice, DEFAULT_SPEECH_VOICE);
+	cfg->Read(PRO_CFG_SPEECH_VOICE.GetPath(), &speechVoice, DEFAULT_SPEECH_VOICE);
 
-	ret = outConfig.Write(REG_KEY_SPEECH_VOICE, speechVoice);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_SPEECH_VOICE, speechVoice);
 
 
 	int speechVolume;
-	cfg->Read(PRO_CFG_SPEECH_VOLUME, &speechVolume, DEFAULT_SPEECH_VOLUME);
+	cfg->Read(PRO_CFG_SPEECH_VOLUME.GetPath(), &speechVolume, DEFAULT_SPEECH_VOLUME);
 
-	ret = outConfig.Write(REG_KEY_SPEECH_VOLUME, speechVolume);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_SPEECH_VOLUME, speechVolume);
 
 
 	int inTechroom, inBriefings, inGame, inMulti;
-	cfg->Read(PRO_CFG_SPEECH_IN_TECHROOM, &inTechroom, DEFAULT_SPEECH_IN_TECHROOM);
-	cfg->Read(PRO_CFG_SPEECH_IN_BRIEFINGS, &inBriefings, DEFAULT_SPEECH_IN_BRIEFINGS);
-	cfg->Read(PRO_CFG_SPEECH_IN_GAME, &inGame, DEFAULT_SPEECH_IN_GAME);
-	cfg->Read(PRO_CFG_SPEECH_IN_MULTI, &inMulti, DEFAULT_SPEECH_IN_MULTI);
+	cfg->Read(PRO_CFG_SPEECH_IN_TECHROOM.GetPath(), &inTechroom, DEFAULT_SPEECH_IN_TECHROOM);
+	cfg->Read(PRO_CFG_SPEECH_IN_BRIEFINGS.GetPath(), &inBriefings, DEFAULT_SPEECH_IN_BRIEFINGS);
+	cfg->Read(PRO_CFG_SPEECH_IN_GAME.GetPath(), &inGame, DEFAULT_SPEECH_IN_GAME);
+	cfg->Read(PRO_CFG_SPEECH_IN_MULTI.GetPath(), &inMulti, DEFAULT_SPEECH_IN_MULTI);
 
-	ret = outConfig.Write(REG_KEY_SPEECH_IN_TECHROOM, inTechroom);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_SPEECH_IN_TECHROOM, inTechroom);
 
-	ret = outConfig.Write(REG_KEY_SPEECH_IN_BRIEFINGS, inBriefings);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_SPEECH_IN_BRIEFINGS, inBriefings);
 
-	ret = outConfig.Write(REG_KEY_SPEECH_IN_GAME, inGame);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_SPEECH_IN_GAME, inGame);
 
-	ret = outConfig.Write(REG_KEY_SPEECH_IN_MULTI, inMulti);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_SPEECH_IN_MULTI, inMulti);
 #endif
 
 
 	// Joystick
 	int currentJoystick;
-	cfg->Read(PRO_CFG_JOYSTICK_ID, &currentJoystick, DEFAULT_JOYSTICK_ID);
+	cfg->Read(PRO_CFG_JOYSTICK_ID.GetPath(), &currentJoystick, DEFAULT_JOYSTICK_ID);
 
-	ret = outConfig.Write(REG_KEY_JOYSTICK_ID, currentJoystick);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_JOYSTICK_ID, currentJoystick);
 
 	// Joystick GUID
 	wxString currentJoystickGUID = JoyMan::JoystickGUID(currentJoystick);
 
-	ret = outConfig.Write(REG_KEY_JOYSTICK_GUID, currentJoystickGUID);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_JOYSTICK_GUID, currentJoystickGUID);
 
 
 	int joystickForceFeedback;
 	cfg->Read(
-		PRO_CFG_JOYSTICK_FORCE_FEEDBACK,
+		PRO_CFG_JOYSTICK_FORCE_FEEDBACK.GetPath(),
 		&joystickForceFeedback,
 		DEFAULT_JOYSTICK_FORCE_FEEDBACK);
 
-	ret = outConfig.Write(REG_KEY_JOYSTICK_FORCE_FEEDBACK, joystickForceFeedback);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_JOYSTICK_FORCE_FEEDBACK, joystickForceFeedback);
 
 
 	int joystickHit;
-	cfg->Read(PRO_CFG_JOYSTICK_DIRECTIONAL, &joystickHit, DEFAULT_JOYSTICK_DIRECTIONAL);
+	cfg->Read(PRO_CFG_JOYSTICK_DIRECTIONAL.GetPath(), &joystickHit, DEFAULT_JOYSTICK_DIRECTIONAL);
 
-	ret = outConfig.Write(REG_KEY_JOYSTICK_DIRECTIONAL, joystickHit);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_JOYSTICK_DIRECTIONAL, joystickHit);
 
 
 	// Network
 	wxString networkConnectionValue;
-	cfg->Read(PRO_CFG_NETWORK_TYPE, &networkConnectionValue, DEFAULT_NETWORK_TYPE);
+	cfg->Read(PRO_CFG_NETWORK_TYPE.GetPath(), &networkConnectionValue, DEFAULT_NETWORK_TYPE);
 
-	ret = outConfig.Write(REG_KEY_NETWORK_TYPE, networkConnectionValue);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_NETWORK_TYPE, networkConnectionValue);
 
 
 	wxString connectionSpeedValue;
-	cfg->Read(PRO_CFG_NETWORK_SPEED, &connectionSpeedValue, DEFAULT_NETWORK_SPEED);
+	cfg->Read(PRO_CFG_NETWORK_SPEED.GetPath(), &connectionSpeedValue, DEFAULT_NETWORK_SPEED);
 
-	ret = outConfig.Write(REG_KEY_NETWORK_SPEED, connectionSpeedValue);
-	ReturnChecker(ret, __LINE__);
+	outConfig.Write(REG_KEY_NETWORK_SPEED, connectionSpeedValue);
 
 
 	int forcedport;
-	cfg->Read(PRO_CFG_NETWORK_PORT, &forcedport, DEFAULT_NETWORK_PORT);
+	cfg->Read(PRO_CFG_NETWORK_PORT.GetPath(), &forcedport, DEFAULT_NETWORK_PORT);
 
 	if (forcedport != DEFAULT_NETWORK_PORT) {
-		ret = outConfig.Write(REG_KEY_NETWORK_PORT, forcedport);
-		ReturnChecker(ret, __LINE__);
-	} else if (outConfig.Exists(REG_KEY_NETWORK_PORT)) {
-		ret = outConfig.DeleteEntry(REG_KEY_NETWORK_PORT, false);
-		ReturnChecker(ret, __LINE__);
+		outConfig.Write(REG_KEY_NETWORK_PORT, forcedport);
+	} else {
+		outConfig.Remove(REG_KEY_NETWORK_PORT);
 	}
 
 
@@ -323,23 +365,58 @@ ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
 	outConfig.SetPath(REG_KEY_NETWORK_FOLDER_CFG);
 
 	wxString networkIP;
-	cfg->Read(PRO_CFG_NETWORK_IP, &networkIP, DEFAULT_NETWORK_IP);
+	cfg->Read(PRO_CFG_NETWORK_IP.GetPath(), &networkIP, DEFAULT_NETWORK_IP);
 
 	if (networkIP != DEFAULT_NETWORK_IP) {
-		ret = outConfig.Write(REG_KEY_NETWORK_IP, networkIP);
-		ReturnChecker(ret, __LINE__);
-	} else if (outConfig.Exists(REG_KEY_NETWORK_IP)) {
-		ret = outConfig.DeleteEntry(REG_KEY_NETWORK_IP, false);
-		ReturnChecker(ret, __LINE__);
+		outConfig.Write(REG_KEY_NETWORK_IP, networkIP);
+	} else {
+		outConfig.Remove(REG_KEY_NETWORK_IP);
 	}
 
 	outConfig.SetPath(REG_KEY_DEFAULT_FOLDER_CFG);
 
 
-	wxLogDebug(_T("Writing fs2_open.ini to %s"), configFileName.GetFullPath().c_str());
-	wxFFileOutputStream outFileStream(configFileName.GetFullPath());
+	const wxString settingsHash(outConfig.Hash());
+	PushedFileRecord record(GBL_CFG_PUSHED_FSO_INI);
+	if (record.Matches(configFileName.GetFullPath(), settingsHash)) {
+		wxLogDebug(_T("fs2_open.ini at %s is unchanged since it was last written"),
+			configFileName.GetFullPath().c_str());
+		return PushCmdlineFSO(cfg);
+	}
 
-	outConfig.Save(outFileStream);
+	wxFFileInputStream configFileInputStream(configFileName.GetFullPath());
+	wxStringInputStream configBlankInputStream(_T("")); // in case ini file doesn't exist
+	wxInputStream* configInputStreamPtr = &configFileInputStream;
+	
+	const bool configFileExists = configFileInputStream.IsOk();
+	if (!configFileExists) {
+		wxLogDebug(_T("Could not read from ini file %s, writing new file"),
+			configFileName.GetFullPath().c_str());
+		configInputStreamPtr = &configBlankInputStream;
+	}
+	wxFileConfig iniConfig(*configInputStreamPtr, wxMBConvUTF8());
+
+	const size_t changed = outConfig.Apply(iniConfig);
+	if (changed == 0 && configFileExists) {
+		wxLogDebug(_T("fs2_open.ini at %s already has the profile's settings, not writing it"),
+			configFileName.GetFullPath().c_str());
+	} else {
+		wxLogDebug(_T("Writing ") SZT _T(" changed setting(s) to fs2_open.ini at %s"),
+			changed, configFileName.GetFullPath().c_str());
+		wxMemoryOutputStream outStream;
+		iniConfig.Save(outStream);
+
+		std::vector<char> contents(outStream.GetSize());
+		if (!contents.empty()) {
+			outStream.CopyTo(&contents[0], contents.size());
+		}
+		wxString error;
+		if (!ProfileWriter::WriteAtomically(configFileName.GetFullPath(), contents, error)) {
+			wxLogError(_T("Unable to write fs2_open.ini: %s"), error.c_str());
+			return ProMan::UnknownError;
+		}
+	}
+	record.Update(configFileName.GetFullPath(), settingsHash);
 
 	return PushCmdlineFSO(cfg);
 }
@@ -415,113 +492,113 @@ ProMan::RegistryCodes FilePullProfile(wxFileConfig *cfg) {
 			}
 		}
 		if ( width > 0 ) {
-			cfg->Write(PRO_CFG_VIDEO_RESOLUTION_WIDTH, width);
+			cfg->Write(PRO_CFG_VIDEO_RESOLUTION_WIDTH.GetPath(), width);
 		} 
 		if ( height > 0 ) {
-			cfg->Write(PRO_CFG_VIDEO_RESOLUTION_HEIGHT, height);
+			cfg->Write(PRO_CFG_VIDEO_RESOLUTION_HEIGHT.GetPath(), height);
 		}
 		if ( bitdepth > 0 ) {
-			cfg->Write(PRO_CFG_VIDEO_BIT_DEPTH, bitdepth);
+			cfg->Write(PRO_CFG_VIDEO_BIT_DEPTH.GetPath(), bitdepth);
 		}
 	}
 
 	if ( inConfig.Read(REG_KEY_VIDEO_TEXTURE_FILTER, &readNumber) ) {
-		cfg->Write(PRO_CFG_VIDEO_TEXTURE_FILTER, readNumber);
+		cfg->Write(PRO_CFG_VIDEO_TEXTURE_FILTER.GetPath(), readNumber);
 	}
 
 	if ( inConfig.Read(REG_KEY_VIDEO_ANISOTROPIC, &readString) ) {
 		long anisotropic;
 		// necessary because FSO expects registry value to be a string
 		if ( readString.ToLong(&anisotropic) ) {
-			cfg->Write(PRO_CFG_VIDEO_ANISOTROPIC, anisotropic);
+			cfg->Write(PRO_CFG_VIDEO_ANISOTROPIC.GetPath(), anisotropic);
 		}
 	}
 
 	if ( inConfig.Read(REG_KEY_VIDEO_ANTI_ALIAS, &readNumber) ) {
-		cfg->Write(PRO_CFG_VIDEO_ANTI_ALIAS, readNumber);
+		cfg->Write(PRO_CFG_VIDEO_ANTI_ALIAS.GetPath(), readNumber);
 	}
 
 
 	// Audio
 	if ( inConfig.Read(REG_KEY_AUDIO_OPENAL_DEVICE, &readString) ) {
-		cfg->Write(PRO_CFG_OPENAL_DEVICE, readString);
+		cfg->Write(PRO_CFG_OPENAL_DEVICE.GetPath(), readString);
 	}
 
 	if ( inConfig.Read(REG_KEY_AUDIO_OPENAL_PLAYBACK_DEVICE, &readString) &&
-			!inConfig.Exists(PRO_CFG_OPENAL_DEVICE)) {
-		cfg->Write(PRO_CFG_OPENAL_DEVICE, readString);
+			!inConfig.Exists(PRO_CFG_OPENAL_DEVICE.GetPath())) {
+		cfg->Write(PRO_CFG_OPENAL_DEVICE.GetPath(), readString);
 	}
 
 	if ( inConfig.Read(REG_KEY_AUDIO_OPENAL_CAPTURE_DEVICE, &readString) ) {
-		cfg->Write(PRO_CFG_OPENAL_CAPTURE_DEVICE, readString);
+		cfg->Write(PRO_CFG_OPENAL_CAPTURE_DEVICE.GetPath(), readString);
 	}
 
 	if ( inConfig.Read(REG_KEY_AUDIO_OPENAL_EFX, &readNumber) ) {
-		cfg->Write(PRO_CFG_OPENAL_EFX, readNumber);
+		cfg->Write(PRO_CFG_OPENAL_EFX.GetPath(), readNumber);
 	}
 
 	if ( inConfig.Read(REG_KEY_AUDIO_OPENAL_SAMPLE_RATE, &readNumber) ) {
-		cfg->Write(PRO_CFG_OPENAL_SAMPLE_RATE, readNumber);
+		cfg->Write(PRO_CFG_OPENAL_SAMPLE_RATE.GetPath(), readNumber);
 	}
 
 
 	// Speech
 #if IS_WIN32 // Linux/OS X don't yet support speech
 	if ( inConfig.Read(REG_KEY_SPEECH_VOICE, &readNumber) ) {
-		cfg->Write(PRO_CFG_SPEECH_VOICE, readNumber);
+		cfg->Write(PRO_CFG_SPEECH_VOICE.GetPath(), readNumber);
 	}
 
 	if ( inConfig.Read(REG_KEY_SPEECH_VOLUME, &readNumber) ) {
-		cfg->Write(PRO_CFG_SPEECH_VOLUME, readNumber);
+		cfg->Write(PRO_CFG_SPEECH_VOLUME.GetPath(), readNumber);
 	}
 	
 	if ( inConfig.Read(REG_KEY_SPEECH_IN_TECHROOM, &readNumber) ) {
-		cfg->Write(PRO_CFG_SPEECH_IN_TECHROOM, readNumber);
+		cfg->Write(PRO_CFG_SPEECH_IN_TECHROOM.GetPath(), readNumber);
 	}
 
 	if ( inConfig.Read(REG_KEY_SPEECH_IN_BRIEFINGS, &readNumber) ) {
-		cfg->Write(PRO_CFG_SPEECH_IN_BRIEFINGS, readNumber);
+		cfg->Write(PRO_CFG_SPEECH_IN_BRIEFINGS.GetPath(), readNumber);
 	}
 
 	if ( inConfig.Read(REG_KEY_SPEECH_IN_GAME, &readNumber) ) {
-		cfg->Write(PRO_CFG_SPEECH_IN_GAME, readNumber);
+		cfg->Write(PRO_CFG_SPEECH_IN_GAME.GetPath(), readNumber);
 	}
 
 	if ( inConfig.Read(REG_KEY_SPEECH_IN_MULTI, &readNumber) ) {
-		cfg->Write(PRO_CFG_SPEECH_IN_MULTI, readNumber);
+		cfg->Write(PRO_CFG_SPEECH_IN_MULTI.GetPath(), readNumber);
 	}
 #endif
 
 
 	// Joystick
 	if ( inConfig.Read(REG_KEY_JOYSTICK_ID, &readNumber) ) {
-		cfg->Write(PRO_CFG_JOYSTICK_ID, readNumber);
+		cfg->Write(PRO_CFG_JOYSTICK_ID.GetPath(), readNumber);
 	}
 	
 	if ( inConfig.Read(REG_KEY_JOYSTICK_FORCE_FEEDBACK, &readNumber) ) {
-		cfg->Write(PRO_CFG_JOYSTICK_FORCE_FEEDBACK, readNumber);
+		cfg->Write(PRO_CFG_JOYSTICK_FORCE_FEEDBACK.GetPath(), readNumber);
 	}
 	
 	if ( inConfig.Read(REG_KEY_JOYSTICK_DIRECTIONAL, &readNumber) ) {
-		cfg->Write(PRO_CFG_JOYSTICK_DIRECTIONAL, readNumber);
+		cfg->Write(PRO_CFG_JOYSTICK_DIRECTIONAL.GetPath(), readNumber);
 	}
 
 
 	//  Network
 	if ( inConfig.Read(REG_KEY_NETWORK_TYPE, &readString) ) {
-		cfg->Write(PRO_CFG_NETWORK_TYPE, readString);
+		cfg->Write(PRO_CFG_NETWORK_TYPE.GetPath(), readString);
 	}
 
 	if ( inConfig.Read(REG_KEY_NETWORK_SPEED, &readString) ) {
-		cfg->Write(PRO_CFG_NETWORK_SPEED, readString);
+		cfg->Write(PRO_CFG_NETWORK_SPEED.GetPath(), readString);
 	}
 
 	if ( inConfig.Read(REG_KEY_NETWORK_PORT, &readNumber) ) {
-		cfg->Write(PRO_CFG_NETWORK_PORT, readNumber);
+		cfg->Write(PRO_CFG_NETWORK_PORT.GetPath(), readNumber);
 	}
 
 	if ( inConfig.Read(REG_KEY_NETWORK_IP, &readString) ) {
-		cfg->Write(PRO_CFG_NETWORK_IP, readString);
+		cfg->Write(PRO_CFG_NETWORK_IP.GetPath(), readString);
 	}
 
 
@@ -0,0 +1,480 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "generated/configure_launcher.h"
+#include "apis/FlagFilePrewarmer.h"
+#include "apis/FlagListManager.h"
+#include "apis/ProfileManager.h"
+#include "apis/TCManager.h"
+#include "datastructures/FlagFileCache.h"
+#include "datastructures/FSOExecutable.h"
+#include "global/ids.h"
+#include "global/ProfileKeys.h"
+#include "global/Utils.h"
+
+#include <wx/thread.h>
+
+#include "global/MemoryDebugging.h"
+
+/** \class FlagFilePrewarmer
+ FlagFilePrewarmer runs every FS2 Open executable in the selected root folder
+ with -get_flags, a few at a time, and stores the resulting flag files in the
+ FlagFileCache. FlagListManager then finds the flag file in the cache when the
+ user switches executables. Each process runs in its own working folder so
+ that the flag files do not overwrite each other. Executables that write
+ their flag file to the TC folder instead, as FlagListManager allows for, are
+ probed again on their own, since it cannot be told whose a flag file in the
+ TC folder is while several are running. Like FlagListManager's probe, an
+ executable that does not write its flag file in time is killed. */
+
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_FLAG_FILE_PREWARM_PROGRESS);
+
+/** How long to wait after the root folder changes before starting to probe,
+ so that the probes do not compete with startup or with the probe of the
+ selected executable. */
+const int PREWARM_START_DELAY_MS = 3000;
+/** Upper bound on the number of executables being probed at once. */
+const int MAX_CONCURRENT_PROBES = 4;
+/** How often running probes are checked against their deadline. */
+const int PREWARM_DEADLINE_CHECK_MS = 1000;
+
+EventHandlers FlagFilePrewarmer::prewarmProgressHandlers;
+
+void FlagFilePrewarmer::RegisterPrewarmProgress(wxEvtHandler *handler) {
+	wxASSERT(FlagFilePrewarmer::IsInitialized());
+	wxASSERT_MSG(prewarmProgressHandlers.IndexOf(handler) == wxNOT_FOUND,
+		wxString::Format(
+			_T("RegisterPrewarmProgress(): Handler at %p already registered."),
+			handler));
+	FlagFilePrewarmer::prewarmProgressHandlers.Append(handler);
+}
+
+void FlagFilePrewarmer::UnRegisterPrewarmProgress(wxEvtHandler *handler) {
+	wxASSERT(FlagFilePrewarmer::IsInitialized());
+	wxASSERT_MSG(prewarmProgressHandlers.IndexOf(handler) != wxNOT_FOUND,
+		wxString::Format(
+			_T("UnRegisterPrewarmProgress(): Handler at %p not registered."),
+			handler));
+	FlagFilePrewarmer::prewarmProgressHandlers.DeleteObject(handler);
+}
+
+void FlagFilePrewarmer::GeneratePrewarmProgress(size_t completed, size_t total) {
+	wxCommandEvent event(EVT_FLAG_FILE_PREWARM_PROGRESS, wxID_NONE);
+	event.SetInt(static_cast<int>(completed));
+	event.SetExtraLong(static_cast<long>(total));
+
+	wxLogDebug(_T("Generating EVT_FLAG_FILE_PREWARM_PROGRESS event (") SZT _T("/") SZT _T(")"),
+		completed, total);
+	for (EventHandlers::iterator
+		 iter = FlagFilePrewarmer::prewarmProgressHandlers.begin(),
+		 end = FlagFilePrewarmer::prewarmProgressHandlers.end();
+		 iter != end; ++iter) {
+		wxEvtHandler* current = *iter;
+		current->AddPendingEvent(event);
+		wxLogDebug(_T(" Sent EVT_FLAG_FILE_PREWARM_PROGRESS event to %p"), current);
+	}
+}
+
+FlagFilePrewarmer* FlagFilePrewarmer::prewarmer = NULL;
+
+bool FlagFilePrewarmer::Initialize() {
+	wxASSERT(!FlagFilePrewarmer::IsInitialized());
+
+	FlagFilePrewarmer::prewarmer = new FlagFilePrewarmer();
+	return true;
+}
+
+void FlagFilePrewarmer::DeInitialize() {
+	wxASSERT(FlagFilePrewarmer::IsInitialized());
+
+	FlagFilePrewarmer* temp = FlagFilePrewarmer::prewarmer;
+	FlagFilePrewarmer::prewarmer = NULL;
+	delete temp;
+	FlagFilePrewarmer::prewarmProgressHandlers.Clear();
+}
+
+bool FlagFilePrewarmer::IsInitialized() {
+	return (FlagFilePrewarmer::prewarmer != NULL);
+}
+
+FlagFilePrewarmer* FlagFilePrewarmer::GetFlagFilePrewarmer() {
+	wxCHECK_MSG(FlagFilePrewarmer::IsInitialized(),
+		NULL,
+		_T("Attempt to get flag file prewarmer when it has not been initialized."));
+
+	return FlagFilePrewarmer::prewarmer;
+}
+
+FlagFilePrewarmer::FlagFilePrewarmer()
+: startTimer(this, ID_FLAG_FILE_PREWARM_TIMER),
+deadlineTimer(this, ID_FLAG_FILE_PREWARM_DEADLINE_TIMER), probeCount(0), completed(0), total(0) {
+	TCManager::RegisterTCChanged(this);
+	FlagListManager::RegisterFlagFileProcessingStatusChanged(this);
+}
+
+FlagFilePrewarmer::~FlagFilePrewarmer() {
+	FlagListManager::UnRegisterFlagFileProcessingStatusChanged(this);
+	TCManager::UnRegisterTCChanged(this);
+	this->Cancel();
+}
+
+BEGIN_EVENT_TABLE(FlagFilePrewarmer, wxEvtHandler)
+EVT_COMMAND(wxID_NONE, EVT_TC_CHANGED, FlagFilePrewarmer::OnTCChanged)
+EVT_COMMAND(wxID_NONE, EVT_FLAG_FILE_PROCESSING_STATUS_CHANGED,
+	FlagFilePrewarmer::OnFlagFileProcessingStatusChanged)
+EVT_TIMER(ID_FLAG_FILE_PREWARM_TIMER, FlagFilePrewarmer::OnStartTimer)
+EVT_TIMER(ID_FLAG_FILE_PREWARM_DEADLINE_TIMER, FlagFilePrewarmer::OnDeadlineTimer)
+END_EVENT_TABLE()
+
+void FlagFilePrewarmer::OnTCChanged(wxCommandEvent &WXUNUSED(event)) {
+	this->Cancel();
+
+	wxString tcPath;
+	if (!ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &tcPath)
+		|| !wxFileName::DirExists(tcPath)) {
+		return;
+	}
+
+	this->tcPath = tcPath;
+	this->startTimer.Start(PREWARM_START_DELAY_MS, wxTIMER_ONE_SHOT);
+}
+
+/** FlagListManager's probe looks for the flag file in the TC folder too, and
+ competes with the prewarm probes for the CPU and disk, so the job is paused
+ while it runs. */
+void FlagFilePrewarmer::OnFlagFileProcessingStatusChanged(wxCommandEvent &WXUNUSED(event)) {
+	if (!this->IsRunning()) {
+		return;
+	}
+	// the event may be stale, so the current status is what counts
+	if (FlagListManager::GetFlagListManager()->IsWaitingForFlagFile()) {
+		this->Pause();
+	} else {
+		this->LaunchPending();
+	}
+}
+
+void FlagFilePrewarmer::OnStartTimer(wxTimerEvent &WXUNUSED(event)) {
+	this->Start(this->tcPath);
+}
+
+void FlagFilePrewarmer::Start(const wxString& tcPath) {
+	this->Cancel();
+
+	wxArrayString binaries(
+		FSOExecutable::GetBinariesFromRootFolder(wxFileName(tcPath, wxEmptyString), true));
+
+	// the selected executable is probed by FlagListManager itself
+	wxString currentBinary;
+	ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_CURRENT_BINARY, &currentBinary);
+
+	for (size_t i = 0; i < binaries.GetCount(); i++) {
+		if (binaries[i] == currentBinary) {
+			continue;
+		}
+		wxFileName exeFilename;
+#if IS_APPLE  // needed because on OSX the binary is a relative path from TC root dir
+		exeFilename.Assign(tcPath + wxFileName::GetPathSeparator() + binaries[i]);
+#else
+		exeFilename.Assign(tcPath, binaries[i]);
+#endif
+		if (!FlagFileCache::HasEntry(exeFilename)) {
+			this->pending.push_back(exeFilename);
+		}
+	}
+
+	this->tcPath = tcPath;
+	this->completed = 0;
+	this->total = this->pending.size();
+
+	if (this->pending.empty()) {
+		wxLogDebug(_T("Flag file prewarm: all executables in %s are already cached."),
+			tcPath.c_str());
+		return;
+	}
+
+	int probes = wxThread::GetCPUCount();
+	if (probes < 1) {
+		probes = 1;
+	} else if (probes > MAX_CONCURRENT_PROBES) {
+		probes = MAX_CONCURRENT_PROBES;
+	}
+	this->slots.assign(static_cast<size_t>(probes), Slot());
+
+	wxLogDebug(_T("Flag file prewarm: probing ") SZT _T(" executable(s) in %s using %d process(es)."),
+		this->total, tcPath.c_str(), probes);
+	this->LaunchPending();
+}
+
+void FlagFilePrewarmer::Cancel() {
+	this->startTimer.Stop();
+	this->deadlineTimer.Stop();
+
+	if (!this->IsRunning()) {
+		return;
+	}
+
+	wxLogDebug(_T("Flag file prewarm: cancelling (") SZT _T("/") SZT _T(" done)."),
+		this->completed, this->total);
+
+	// any process that is still running reports back for a freed slot and is ignored
+	this->pending.clear();
+	this->solo.clear();
+	for (size_t i = 0; i < this->slots.size(); i++) {
+		if (this->slots[i].pid != 0) {
+			this->KillProbe(i);
+		}
+	}
+	this->slots.clear();
+	GeneratePrewarmProgress(this->completed, this->total);
+}
+
+/** Kills the probes that are running and queues their executables again. */
+void FlagFilePrewarmer::Pause() {
+	size_t paused = 0;
+	for (size_t i = 0; i < this->slots.size(); i++) {
+		if (this->slots[i].pid != 0) {
+			if (this->slots[i].solo) {
+				this->solo.push_back(this->slots[i].exeFilename);
+			} else {
+				this->pending.push_back(this->slots[i].exeFilename);
+			}
+			this->KillProbe(i);
+			paused++;
+		}
+	}
+	this->deadlineTimer.Stop();
+	wxLogDebug(_T("Flag file prewarm: paused while the selected executable is probed (")
+		SZT _T(" probe(s) stopped)."), paused);
+}
+
+/** Kills the process in slot and frees the slot. The process's
+ OnTerminate() no longer matches the slot, so it is ignored. */
+void FlagFilePrewarmer::KillProbe(size_t slot) {
+	// a process that shows a dialog may not handle wxSIGTERM
+	const wxKillError error = wxProcess::Kill(static_cast<int>(this->slots[slot].pid), wxSIGKILL);
+	if (error != wxKILL_OK && error != wxKILL_NO_PROCESS) {
+		wxLogDebug(_T("Flag file prewarm: unable to kill pid %ld, error %d"),
+			this->slots[slot].pid, error);
+	}
+	this->slots[slot] = Slot();
+}
+
+size_t FlagFilePrewarmer::GetRunningCount() const {
+	size_t running = 0;
+	for (size_t i = 0; i < this->slots.size(); i++) {
+		if (this->slots[i].pid != 0) {
+			running++;
+		}
+	}
+	return running;
+}
+
+wxFileName FlagFilePrewarmer::GetProbeFolder(unsigned int id) {
+	wxFileName folder;
+	folder.AssignDir(GetProfileStorageFolder());
+	folder.AppendDir(_T("temp_flag_folder"));
+	folder.AppendDir(wxString::Format(_T("prewarm%u"), id));
+	return folder;
+}
+
+/** Fills the free slots with pending executables. Once they have all been
+ probed, the solo executables are probed one at a time. */
+void FlagFilePrewarmer::LaunchPending() {
+	if (FlagListManager::GetFlagListManager()->IsWaitingForFlagFile()) {
+		// resumed by OnFlagFileProcessingStatusChanged()
+		GeneratePrewarmProgress(this->completed, this->total);
+		return;
+	}
+	for (size_t i = 0; i < this->slots.size(); i++) {
+		if (this->slots[i].pid != 0 && this->slots[i].solo) {
+			GeneratePrewarmProgress(this->completed, this->total);
+			return;
+		}
+	}
+
+	for (size_t slot = 0; slot < this->slots.size(); slot++) {
+		while (slot < this->slots.size() && this->slots[slot].pid == 0 && !this->pending.empty()) {
+			wxFileName exeFilename(this->pending.back());
+			this->pending.pop_back();
+			// FlagListManager may have probed it in the meantime
+			if (FlagFileCache::HasEntry(exeFilename) || !this->LaunchProbe(slot, exeFilename, false)) {
+				this->completed++;
+			}
+		}
+	}
+
+	while (this->pending.empty() && !this->solo.empty() && this->GetRunningCount() == 0) {
+		wxFileName exeFilename(this->solo.back());
+		this->solo.pop_back();
+		if (FlagFileCache::HasEntry(exeFilename) || !this->LaunchProbe(0, exeFilename, true)) {
+			this->completed++;
+		}
+	}
+
+	if (!this->IsRunning()) {
+		this->deadlineTimer.Stop();
+		wxLogDebug(_T("Flag file prewarm: finished probing ") SZT _T(" executable(s)."),
+			this->total);
+	}	GeneratePrewarmProgress(this->completed, this->total);
+}
+
+/** Runs exeFilename in slot, which must be free. Returns false if it could not
+ be run; if its working folder could not be created, the job is cancelled. */
+bool FlagFilePrewarmer::LaunchProbe(size_t slot, const wxFileName& exeFilename, bool isSolo) {
+	this->probeCount++;
+	wxFileName folder(GetProbeFolder(this->probeCount));
+	if (!folder.DirExists() && !folder.Mkdir(0777, wxPATH_MKDIR_FULL)) {
+		wxLogDebug(_T("Flag file prewarm: unable to create %s, giving up."),
+			folder.GetFullPath().c_str());
+		this->Cancel();
+		return false;
+	}
+
+	if (isSolo) {
+		// whatever flag file is in the TC folder once it finishes is its
+		wxFileName tcFlagFile(this->tcPath, _T("flags.lch"));
+		if (tcFlagFile.FileExists()) {
+			::wxRemoveFile(tcFlagFile.GetFullPath());
+		}
+	}
+
+	wxString commandline(FlagListManager::GetFlagFileCommandLine(exeFilename));
+	PrewarmProcess* process = new PrewarmProcess(this->probeCount, slot, exeFilename);
+
+#if wxCHECK_VERSION(2, 9, 2)
+	wxExecuteEnv env;
+	env.cwd = folder.GetFullPath();
+
+	long pid = ::wxExecute(commandline, wxEXEC_ASYNC, process, &env);
+#else
+	wxString previousWorkingDir(::wxGetCwd());
+	long pid = 0;
+	if (::wxSetWorkingDirectory(folder.GetFullPath())) {
+		pid = ::wxExecute(commandline, wxEXEC_ASYNC, process);
+		::wxSetWorkingDirectory(previousWorkingDir);
+	}
+#endif
+	if (pid == 0) {
+		wxLogDebug(_T("Flag file prewarm: unable to run '%s'."), commandline.c_str());
+		delete process;
+		::wxRmdir(folder.GetPath());
+		return false;
+	}
+
+	wxLogDebug(_T("Flag file prewarm: started '%s' (pid %ld) in slot ") SZT _T("%s."),
+		commandline.c_str(), pid, slot, isSolo ? _T(" on its own") : _T(""));
+	this->slots[slot].id = this->probeCount;
+	this->slots[slot].pid = pid;
+	this->slots[slot].exeFilename = exeFilename;
+	this->slots[slot].started = ::wxGetLocalTimeMillis();
+	this->slots[slot].solo = isSolo;
+
+	if (FlagListManager::GetFlagProbeTimeout() > 0 && !this->deadlineTimer.IsRunning()) {
+		this->deadlineTimer.Start(PREWARM_DEADLINE_CHECK_MS, wxTIMER_CONTINUOUS);
+	}
+	return true;
+}
+
+void FlagFilePrewarmer::OnDeadlineTimer(wxTimerEvent &WXUNUSED(event)) {
+	const long timeout = FlagListManager::GetFlagProbeTimeout();
+	if (timeout <= 0 || this->GetRunningCount() == 0) {
+		this->deadlineTimer.Stop();
+		return;
+	}
+
+	const wxLongLong now(::wxGetLocalTimeMillis());
+	bool killed = false;
+	for (size_t i = 0; i < this->slots.size(); i++) {
+		if (this->slots[i].pid != 0 && now - this->slots[i].started >= timeout) {
+			wxLogDebug(_T("Flag file prewarm: %s did not write its flag file in %ld ms, killing it."),
+				this->slots[i].exeFilename.GetFullPath().c_str(), timeout);
+			this->KillProbe(i);
+			this->completed++;
+			killed = true;
+		}
+	}
+	if (killed) {
+		this->LaunchPending();
+	}
+}
+
+void FlagFilePrewarmer::OnProbeFinished(unsigned int id, size_t slot,
+	const wxFileName& exeFilename) {
+	const bool current = (slot < this->slots.size()
+		&& this->slots[slot].pid != 0 && this->slots[slot].id == id);
+	const bool isSolo = current && this->slots[slot].solo;
+
+	// probe folders are specific to a probe, so they can be cleaned up either way
+	const wxString folderPath(GetProbeFolder(id).GetPath());
+	wxFileName flagFile(folderPath, _T("flags.lch"));
+	wxFileName tcFlagFile(this->tcPath, _T("flags.lch"));
+	bool requeued = false;
+
+	if (current) {
+		if (flagFile.FileExists()) {
+			FlagFileCache::Store(exeFilename, flagFile);
+		} else if (tcFlagFile.FileExists()) {
+			if (isSolo) {
+				FlagFileCache::Store(exeFilename, tcFlagFile);
+				::wxRemoveFile(tcFlagFile.GetFullPath());
+			} else {
+				wxLogDebug(_T("Flag file prewarm: %s may have written its flag file to %s, ")
+					_T("probing it again on its own."),
+					exeFilename.GetFullPath().c_str(), this->tcPath.c_str());
+				this->solo.push_back(exeFilename);
+				requeued = true;
+			}
+		} else {
+			wxLogDebug(_T("Flag file prewarm: %s did not generate a flag file."),
+				exeFilename.GetFullPath().c_str());
+		}
+	}
+
+	if (flagFile.FileExists()) {
+		::wxRemoveFile(flagFile.GetFullPath());
+	}
+	::wxRmdir(folderPath);
+
+	if (!current) {
+		return;
+	}
+
+	this->slots[slot] = Slot();
+	if (!requeued) {
+		this->completed++;
+	}
+	this->LaunchPending();
+}
+
+FlagFilePrewarmer::PrewarmProcess::PrewarmProcess(unsigned int id, size_t slot,
+	const wxFileName& exeFilename)
+: id(id), slot(slot), exeFilename(exeFilename) {
+}
+
+void FlagFilePrewarmer::PrewarmProcess::OnTerminate(int pid, int status) {
+	wxLogDebug(_T("Flag file prewarm: %s (pid %d) returned %d"),
+		this->exeFilename.GetFullPath().c_str(), pid, status);
+
+	if (FlagFilePrewarmer::IsInitialized()) {
+		FlagFilePrewarmer::GetFlagFilePrewarmer()->OnProbeFinished(
+			this->id, this->slot, this->exeFilename);
+	}
+
+	delete this;
+}
@@ -0,0 +1,115 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef FLAGFILEPREWARMER_H
+#define FLAGFILEPREWARMER_H
+
+#include <vector>
+
+#include <wx/wx.h>
+#include <wx/filename.h>
+#include <wx/longlong.h>
+#include <wx/process.h>
+#include <wx/timer.h>
+
+#include "apis/EventHandlers.h"
+
+/** Progress of the flag file prewarm job has changed. The event's int is the
+ number of executables done, and its extra long the number in the job. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_FLAG_FILE_PREWARM_PROGRESS);
+
+/** Probes every FS2 Open executable in the selected root folder in the
+ background so that their flag files are in the FlagFileCache before the user
+ selects them. Probing stops while FlagListManager probes the selected
+ executable, and resumes once it is done. */
+class FlagFilePrewarmer: public wxEvtHandler {
+public:
+	static bool Initialize();
+	static void DeInitialize();
+	static bool IsInitialized();
+	static FlagFilePrewarmer* GetFlagFilePrewarmer();
+
+	~FlagFilePrewarmer();
+
+	static void RegisterPrewarmProgress(wxEvtHandler *handler);
+	static void UnRegisterPrewarmProgress(wxEvtHandler *handler);
+
+	void OnTCChanged(wxCommandEvent &event);
+	void OnFlagFileProcessingStatusChanged(wxCommandEvent &event);
+	void OnStartTimer(wxTimerEvent &event);
+	void OnDeadlineTimer(wxTimerEvent &event);
+
+	/** Starts probing the executables in tcPath, cancelling any job in progress. */
+	void Start(const wxString& tcPath);
+	/** Stops the current job. Executables that are still running are killed. */
+	void Cancel();
+	inline bool IsRunning() const {
+		return !this->pending.empty() || !this->solo.empty() || this->GetRunningCount() > 0;
+	}
+
+private:
+	FlagFilePrewarmer();
+
+	static FlagFilePrewarmer* prewarmer;
+	static EventHandlers prewarmProgressHandlers;
+	static void GeneratePrewarmProgress(size_t completed, size_t total);
+
+	/** An executable being probed. */
+	struct Slot {
+		Slot(): id(0), pid(0), solo(false) { }
+		unsigned int id; //!< of the probe, which names its working folder
+		long pid; //!< 0 if the slot is free
+		wxFileName exeFilename;
+		wxLongLong started; //!< in ms, for the deadline
+		bool solo; //!< running on its own, so that a flag file in the TC folder is its
+	};
+
+	void LaunchPending();
+	bool LaunchProbe(size_t slot, const wxFileName& exeFilename, bool isSolo);
+	void KillProbe(size_t slot);
+	void Pause();
+	void OnProbeFinished(unsigned int id, size_t slot, const wxFileName& exeFilename);
+	size_t GetRunningCount() const;
+	static wxFileName GetProbeFolder(unsigned int id);
+
+	class PrewarmProcess: public wxProcess {
+	public:
+		PrewarmProcess(unsigned int id, size_t slot, const wxFileName& exeFilename);
+		virtual void OnTerminate(int pid, int status);
+	private:
+		unsigned int id; //!< probe that started this process
+		size_t slot;
+		wxFileName exeFilename;
+	};
+
+	wxTimer startTimer; //!< delays the job so that it does not compete with startup
+	wxTimer deadlineTimer; //!< checks for probes that take too long, while any run
+	wxString tcPath; //!< root folder of the job
+	unsigned int probeCount; //!< number of probes started, for telling them apart
+	std::vector<wxFileName> pending; //!< executables waiting for a free slot
+	/** Executables that are probed one at a time once pending is empty, because
+	 they may write their flag file to the TC folder rather than their own. */
+	std::vector<wxFileName> solo;
+	std::vector<Slot> slots;
+	size_t completed;
+	size_t total;
+
+	DECLARE_EVENT_TABLE()
+};
+
+#endif
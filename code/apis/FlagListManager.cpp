@@ -20,7 +20,10 @@
 #include "apis/FlagListManager.h"
 #include "apis/ProfileManager.h"
 #include "apis/TCManager.h"
+#include "datastructures/FlagFileCache.h"
+#include "datastructures/FlagFileView.h"
 #include "datastructures/FSOExecutable.h"
+#include "global/ids.h"
 #include "global/ProfileKeys.h"
 
 #include "global/MemoryDebugging.h"
@@ -31,6 +34,14 @@
  the data in flag files generated by FS2 Open executables. */
 LAUNCHER_DEFINE_EVENT_TYPE(EVT_FLAG_FILE_PROCESSING_STATUS_CHANGED);
 
+/** How long an executable has to write its flag file on the first attempt,
+ unless the global profile says otherwise. */
+const long DEFAULT_FLAG_PROBE_TIMEOUT_S = 15;
+/** How many times an executable that does not finish in time is run. */
+const int FLAG_PROBE_ATTEMPTS = 3;
+/** How long to wait before running an executable again after the first time out. */
+const int FLAG_PROBE_RETRY_DELAY_MS = 1000;
+
 #include <wx/arrimpl.cpp> // Magic Incantation
 WX_DEFINE_OBJARRAY(FlagFileArray);
 
@@ -112,22 +123,30 @@ FlagListManager* FlagListManager::GetFlagListManager() {
 }
 
 FlagListManager::FlagListManager()
-: data(NULL), proxyData(NULL), buildCaps(0) {
+: data(NULL), proxyData(NULL), buildCaps(0),
+  probeDeadline(this, ID_FLAG_FILE_PROBE_DEADLINE_TIMER),
+  probeRetry(this, ID_FLAG_FILE_PROBE_RETRY_TIMER),
+  probeGeneration(0), probePid(0), probeAttempt(0) {
 	TCManager::RegisterTCBinaryChanged(this);
 }
 
 FlagListManager::~FlagListManager() {
 	TCManager::UnRegisterTCBinaryChanged(this);
+	this->KillProbe();
 	this->DeleteExistingData();
 }
 
 BEGIN_EVENT_TABLE(FlagListManager, wxEvtHandler)
 EVT_COMMAND(wxID_NONE, EVT_TC_BINARY_CHANGED, FlagListManager::OnBinaryChanged)
+EVT_TIMER(ID_FLAG_FILE_PROBE_DEADLINE_TIMER, FlagListManager::OnProbeDeadline)
+EVT_TIMER(ID_FLAG_FILE_PROBE_RETRY_TIMER, FlagListManager::OnProbeRetry)
 END_EVENT_TABLE()
 
 void FlagListManager::OnBinaryChanged(wxCommandEvent& event) {
-	wxCHECK_RET(this->GetProcessingStatus() != WAITING_FOR_FLAG_FILE,
-		_T("Received binary changed event in middle of flag file processing."));
+	if (this->GetProcessingStatus() == WAITING_FOR_FLAG_FILE) {
+		wxLogDebug(_T("Binary changed in the middle of flag file processing, abandoning it."));
+		this->KillProbe();
+	}
 	
 	this->DeleteExistingData();
 	this->SetProcessingStatus(INITIAL_STATUS);
@@ -150,8 +169,10 @@ void FlagListManager::DeleteExistingData() {
 }
 
 void FlagListManager::BeginFlagFileProcessing() {
-	wxCHECK_RET(this->GetProcessingStatus() != WAITING_FOR_FLAG_FILE,
-		_T("Began flag file processing while processing was underway."));
+	if (this->GetProcessingStatus() == WAITING_FOR_FLAG_FILE) {
+		wxLogDebug(_T("Flag file processing began again, abandoning the processing underway."));
+		this->KillProbe();
+	}
 	
 	this->DeleteExistingData(); // don't leak any existing data
 	
@@ -196,6 +217,22 @@ void FlagListManager::BeginFlagFileProcessing() {
 		this->SetProcessingStatus(INVALID_BINARY);
 		return;
 	}
+	
+	// skip running the executable if we already have its flag file
+	wxFileName cachedFlagFile;
+	if (FlagFileCache::Lookup(exeFilename, cachedFlagFile)) {
+		const ProcessingStatus status = this->ParseFlagFile(cachedFlagFile);
+		if (status == PROCESSING_OK) {
+			this->SetProcessingStatus(status);
+			return;
+		}
+		wxLogDebug(_T(" Cached flag file could not be parsed, regenerating it."));
+		FlagFileCache::Invalidate(exeFilename);
+		this->DeleteExistingData();
+		this->data = new FlagFileData();
+		this->proxyData = new ProxyFlagData();
+	}
+	
 	// Make sure that the directory that I am going to change to exists
 	wxFileName tempExecutionLocation;
 	tempExecutionLocation.AssignDir(GetProfileStorageFolder());
@@ -209,59 +246,157 @@ void FlagListManager::BeginFlagFileProcessing() {
 		return;
 	}
 	
-	FlagFileArray flagFileLocations;
-	flagFileLocations.Add(wxFileName(tcPath, _T("flags.lch")));
-	flagFileLocations.Add(wxFileName(tempExecutionLocation.GetFullPath(), _T("flags.lch")));
+	this->probeExe = exeFilename;
+	this->probeFolder = tempExecutionLocation;
+	this->probeFlagFiles.Clear();
+	this->probeFlagFiles.Add(wxFileName(tcPath, _T("flags.lch")));
+	this->probeFlagFiles.Add(wxFileName(tempExecutionLocation.GetFullPath(), _T("flags.lch")));
+	this->probeAttempt = 0;
 	
+	if (this->LaunchProbe()) {
+		this->SetProcessingStatus(WAITING_FOR_FLAG_FILE);
+	}
+}
+
+void FlagListManager::CancelFlagFileProcessing() {
+	if (this->GetProcessingStatus() != WAITING_FOR_FLAG_FILE) {
+		return;
+	}
+	wxLogInfo(_T("Flag file processing of %s cancelled."), this->probeExe.GetFullPath().c_str());
+	this->KillProbe();
+	this->SetProcessingStatus(FLAG_FILE_CANCELLED);
+}
+
+/** Runs the executable to get its flag file. Returns false, having set the
+ processing status, if it could not be run. */
+bool FlagListManager::LaunchProbe() {
 	// remove potential flag files to eliminate any confusion.
-	for( size_t i = 0; i < flagFileLocations.Count(); i++ ) {
-		bool exists = flagFileLocations[i].FileExists();
+	for( size_t i = 0; i < this->probeFlagFiles.Count(); i++ ) {
+		bool exists = this->probeFlagFiles[i].FileExists();
 		if (exists) {
-			::wxRemoveFile(flagFileLocations[i].GetFullPath());
+			::wxRemoveFile(this->probeFlagFiles[i].GetFullPath());
 			wxLogDebug(_T(" Cleaned up %s ... %s"),
-				flagFileLocations[i].GetFullPath().c_str(),
-				(flagFileLocations[i].FileExists())? _T("Failed") : _T("Removed"));
+				this->probeFlagFiles[i].GetFullPath().c_str(),
+				(this->probeFlagFiles[i].FileExists())? _T("Failed") : _T("Removed"));
 		}
 	}
 	
-	wxString commandline;
-	// use "" to correct for spaces in path to exeFilename
-	if (exeFilename.GetFullPath().Find(_T(" ")) != wxNOT_FOUND) {
-		commandline = _T("\"") + exeFilename.GetFullPath() +  _T("\"") + _T(" -get_flags");
-	} else {
-		commandline = exeFilename.GetFullPath() + _T(" -get_flags");
-	}
+	wxString commandline(FlagListManager::GetFlagFileCommandLine(this->probeExe));
 	
 	wxLogDebug(_T(" Called FS2 Open with command line '%s'."), commandline.c_str());
-	FlagProcess *process = new FlagProcess(flagFileLocations);
+	this->probeGeneration++;
+	this->probeAttempt++;
+	FlagProcess *process = new FlagProcess(this->probeGeneration);
 
 #if wxCHECK_VERSION(2, 9, 2)
 	wxExecuteEnv env;
-	env.cwd = tempExecutionLocation.GetFullPath();
+	env.cwd = this->probeFolder.GetFullPath();
 
-	::wxExecute(commandline, wxEXEC_ASYNC, process, &env);
+	const long pid = ::wxExecute(commandline, wxEXEC_ASYNC, process, &env);
 #else
 	wxString previousWorkingDir(::wxGetCwd());
 	// hopefully this doesn't goof anything up
-	if (!::wxSetWorkingDirectory(tempExecutionLocation.GetFullPath())) {
+	if (!::wxSetWorkingDirectory(this->probeFolder.GetFullPath())) {
 		wxLogError(_T("Unable to change working directory to %s"),
-			tempExecutionLocation.GetFullPath().c_str());
+			this->probeFolder.GetFullPath().c_str());
 		this->SetProcessingStatus(CANNOT_CHANGE_WORKING_FOLDER);
 		delete process;
-		return;
+		return false;
 	}
 
-	::wxExecute(commandline, wxEXEC_ASYNC, process);
+	const long pid = ::wxExecute(commandline, wxEXEC_ASYNC, process);
 	
 	if ( !::wxSetWorkingDirectory(previousWorkingDir) ) {
 		wxLogError(_T("Unable to change back to working directory %s"),
 			previousWorkingDir.c_str());
 		this->SetProcessingStatus(CANNOT_CHANGE_WORKING_FOLDER);
-		return;
+		if (pid != 0) {
+			this->probePid = pid;
+			this->KillProbe();
+		} else {
+			delete process;
+		}
+		return false;
 	}
 #endif
 
-	this->SetProcessingStatus(WAITING_FOR_FLAG_FILE);
+	if (pid == 0) {
+		wxLogError(_T("Unable to run '%s'"), commandline.c_str());
+		delete process;
+		this->SetProcessingStatus(FLAG_FILE_NOT_GENERATED);
+		return false;
+	}
+	this->probePid = pid;
+
+	const long timeout = FlagListManager::GetFlagProbeTimeout();
+	if (timeout > 0) {
+		// a slow start, like from a cold disk, gets more time on each attempt
+		const long deadline = timeout * (1L << (this->probeAttempt - 1));
+		wxLogDebug(_T(" Attempt %d, giving pid %ld %ld ms to write its flag file."),
+			this->probeAttempt, pid, deadline);
+		this->probeDeadline.Start(static_cast<int>(deadline), wxTIMER_ONE_SHOT);
+	}
+	return true;
+}
+
+/** Abandons the probe that is running or waiting to be retried.
+ A process that is still running is killed, and its OnTerminate() is ignored. */
+void FlagListManager::KillProbe() {
+	this->probeDeadline.Stop();
+	this->probeRetry.Stop();
+	this->probeGeneration++;
+	if (this->probePid != 0) {
+		wxLogDebug(_T(" Killing flag file probe (pid %ld)."), this->probePid);
+		// a process that shows a dialog may not handle wxSIGTERM
+		const wxKillError error = wxProcess::Kill(static_cast<int>(this->probePid), wxSIGKILL);
+		if (error != wxKILL_OK && error != wxKILL_NO_PROCESS) {
+			wxLogWarning(_T("Unable to kill %s (pid %ld), error %d"),
+				this->probeExe.GetFullPath().c_str(), this->probePid, error);
+		}
+		this->probePid = 0;
+	}
+}
+
+void FlagListManager::OnProbeDeadline(wxTimerEvent& WXUNUSED(event)) {
+	if (this->GetProcessingStatus() != WAITING_FOR_FLAG_FILE || this->probePid == 0) {
+		return;
+	}
+	wxLogWarning(_T("%s did not write its flag file in time (attempt %d of %d)."),
+		this->probeExe.GetFullPath().c_str(), this->probeAttempt, FLAG_PROBE_ATTEMPTS);
+	this->KillProbe();
+	
+	if (this->probeAttempt >= FLAG_PROBE_ATTEMPTS) {
+		this->SetProcessingStatus(FLAG_FILE_TIMED_OUT);
+		return;
+	}
+	const int delay = FLAG_PROBE_RETRY_DELAY_MS << (this->probeAttempt - 1);
+	wxLogDebug(_T(" Trying again in %d ms."), delay);
+	this->probeRetry.Start(delay, wxTIMER_ONE_SHOT);
+}
+
+void FlagListManager::OnProbeRetry(wxTimerEvent& WXUNUSED(event)) {
+	if (this->GetProcessingStatus() != WAITING_FOR_FLAG_FILE) {
+		return;
+	}
+	this->LaunchProbe();
+}
+
+wxString FlagListManager::GetFlagFileCommandLine(const wxFileName& exeFilename) {
+	wxString commandline;
+	// use "" to correct for spaces in path to exeFilename
+	if (exeFilename.GetFullPath().Find(_T(" ")) != wxNOT_FOUND) {
+		commandline = _T("\"") + exeFilename.GetFullPath() +  _T("\"") + _T(" -get_flags");
+	} else {
+		commandline = exeFilename.GetFullPath() + _T(" -get_flags");
+	}
+	return commandline;
+}
+
+long FlagListManager::GetFlagProbeTimeout() {
+	long timeout;
+	ProMan::GetProfileManager()->GlobalRead(GBL_CFG_OPT_FLAG_PROBE_TIMEOUT, &timeout,
+		DEFAULT_FLAG_PROBE_TIMEOUT_S);
+	return (timeout > 0) ? timeout * 1000 : 0;
 }
 
 wxString FlagListManager::GetStatusMessage() const {
@@ -302,6 +437,12 @@ wxString FlagListManager::GetStatusMessage() const {
 		case FLAG_FILE_NOT_SUPPORTED:
 			msg = _("Generated flag file is not supported.\n\nUpdate the launcher or talk to a maintainer of this launcher if you have the most recent version.");
 			break;
+		case FLAG_FILE_TIMED_OUT:
+			msg = _("The executable did not generate a flag file in time, and was stopped.\n\nMake sure that the executable runs, or select another on the Basic Settings page.");
+			break;
+		case FLAG_FILE_CANCELLED:
+			msg = _("Getting the flag file from the executable was cancelled.\n\nSelect the executable again on the Basic Settings page to retry.");
+			break;
 		default:
 			msg = wxString::Format(
 				_("Unknown error (%d) occurred while obtaining the flag file from the FS2 Open executable."),
@@ -349,136 +490,29 @@ FlagListManager::ProcessingStatus FlagListManager::ParseFlagFile(const wxFileNam
 		return FLAG_FILE_NOT_GENERATED;
 	}
 	
-	wxFile flagfile(flagfilename.GetFullPath());
 	wxLogDebug(_T("Reading flag file %s."), flagfilename.GetFullPath().c_str());
-	// Flagfile requires that we use 32 bit little-endian numbers
-	wxInt32 easy_flag_size, flag_size, num_easy_flags, num_flags;
-	size_t bytesRead;
-	
-	bytesRead = flagfile.Read(&easy_flag_size, sizeof(easy_flag_size));
-	if ( (size_t)wxInvalidOffset == bytesRead || bytesRead != sizeof(easy_flag_size) ) {
-		wxLogError(_T(" Flag file is too short (failed to read easy_flag_size)"));
-		return FLAG_FILE_NOT_VALID;
-	}
-	if ( easy_flag_size != 32 ) {
-		wxLogError(_T("  Easy flag size (%d) is not supported"), easy_flag_size);
-		return FLAG_FILE_NOT_SUPPORTED;
-	}
-	
-	bytesRead = flagfile.Read(&flag_size, sizeof(flag_size));
-	if ( (size_t)wxInvalidOffset == bytesRead || bytesRead != sizeof(flag_size) ) {
-		wxLogError(_T(" Flag file is too short (failed to read flag_size)"));
-		return FLAG_FILE_NOT_VALID;
-	}
-	if ( flag_size != 344 ) {
-		wxLogError(_T(" Exe flag structure (%d) size is not supported"), flag_size);
-		return FLAG_FILE_NOT_SUPPORTED;
-	}
-	
-	bytesRead = flagfile.Read(&num_easy_flags, sizeof(num_easy_flags));
-	if ( (size_t)wxInvalidOffset == bytesRead || bytesRead != sizeof(num_easy_flags) ) {
-		wxLogError(_T(" Flag file is too short (failed to read num_easy_flags)"));
-		return FLAG_FILE_NOT_VALID;
-	}
-	
-	for ( int i = 0; i < num_easy_flags; i++ ) {
-		char easy_flag[32];
-		bytesRead = flagfile.Read(&easy_flag, sizeof(easy_flag));
-		if ( (size_t)wxInvalidOffset == bytesRead || bytesRead != sizeof(easy_flag) ) {
-			wxLogError(_T(" Flag file is too short, expected %d, got %ld bytes (easy_flag)"), sizeof(easy_flag), bytesRead);
+	FlagFileView view;
+	switch (view.Load(flagfilename.GetFullPath())) {
+		case FlagFileView::VIEW_OK:
+			break;
+		case FlagFileView::VIEW_NOT_SUPPORTED:
+			return FLAG_FILE_NOT_SUPPORTED;
+		default:
 			return FLAG_FILE_NOT_VALID;
-		}
-		wxString easyFlagStr(easy_flag, wxConvUTF8, strlen(easy_flag));
-		this->data->AddEasyFlag(easyFlagStr);
 	}
 	
-	bytesRead = flagfile.Read(&num_flags, sizeof(num_flags));
-	if ( (size_t)wxInvalidOffset == bytesRead || bytesRead != sizeof(num_flags) ) {
-		wxLogError(_T(" Flag file is too short (failed to read num_flags)"));
-		return FLAG_FILE_NOT_VALID;
+	for (size_t i = 0; i < view.GetEasyFlagCount(); i++) {
+		this->data->AddEasyFlag(view.GetEasyFlag(i));
+	}
+	for (size_t i = 0; i < view.GetFlagCount(); i++) {
+		this->data->AddFlag(view.CreateFlag(i));
 	}
-	
-	for ( int i = 0; i < num_flags; i++ ) {
-		char flag_string[20];
-		char description[40];
-		wxInt32 fso_only, easy_on_flags, easy_off_flags;
-		char easy_catagory[16], web_url[256];
-		
-		bytesRead = flagfile.Read(&flag_string, sizeof(flag_string));
-		if ( (size_t)wxInvalidOffset == bytesRead || bytesRead != sizeof(flag_string) ) {
-			wxLogError(_T(" Flag file is too short, expected %d, got %ld bytes (flag_string)"), sizeof(flag_string), bytesRead);
-			return FLAG_FILE_NOT_VALID;
-		}
-		
-		bytesRead = flagfile.Read(&description, sizeof(description));
-		if ( (size_t)wxInvalidOffset == bytesRead || bytesRead != sizeof(description) ) {
-			wxLogError(_T(" Flag file is too short, expected %d, got %ld bytes (description)"), sizeof(description), bytesRead);
-			return FLAG_FILE_NOT_VALID;
-		}
-		
-		bytesRead = flagfile.Read(&fso_only, sizeof(fso_only));
-		if ( (size_t)wxInvalidOffset == bytesRead || bytesRead != sizeof(fso_only) ) {
-			wxLogError(_T(" Flag file is too short, expected %d, got %ld bytes (fso_only)"), sizeof(fso_only), bytesRead);
-			return FLAG_FILE_NOT_VALID;
-		}
-		
-		bytesRead = flagfile.Read(&easy_on_flags, sizeof(easy_on_flags));
-		if ( (size_t)wxInvalidOffset == bytesRead || bytesRead != sizeof(easy_on_flags) ) {
-			wxLogError(_T(" Flag file is too short, expected %d, got %ld bytes (easy_on_flags)"), sizeof(easy_on_flags), bytesRead);
-			return FLAG_FILE_NOT_VALID;
-		}
-		
-		bytesRead = flagfile.Read(&easy_off_flags, sizeof(easy_off_flags));
-		if ( (size_t)wxInvalidOffset == bytesRead || bytesRead != sizeof(easy_off_flags) ) {
-			wxLogError(_T(" Flag file is too short, expected %d, got %ld bytes (easy_off_flags)"), sizeof(easy_off_flags), bytesRead);
-			return FLAG_FILE_NOT_VALID;
-		}
-		
-		bytesRead = flagfile.Read(&easy_catagory, sizeof(easy_catagory));
-		if ( (size_t)wxInvalidOffset == bytesRead || bytesRead != sizeof(easy_catagory) ) {
-			wxLogError(_T(" Flag file is too short, expected %d, got %ld bytes (easy_category)"), sizeof(easy_catagory), bytesRead);
-			return FLAG_FILE_NOT_VALID;
-		}
-		
-		bytesRead = flagfile.Read(&web_url, sizeof(web_url));
-		if ( (size_t)wxInvalidOffset == bytesRead || bytesRead != sizeof(web_url) ) {
-			wxLogError(_T(" Flag file is too short, expected %d, got %ld bytes (web_url)"), sizeof(web_url), bytesRead);
-			return FLAG_FILE_NOT_VALID;
-		}
-		
-		flag_string[sizeof(flag_string)-1] = _T('\0');
-		description[sizeof(description)-1] = _T('\0');
-		easy_catagory[sizeof(easy_catagory)-1] = _T('\0');
-		web_url[sizeof(web_url)-1] = _T('\0');
-		
-		Flag* flag = new Flag();
-		
-		flag->flagString = wxString(flag_string, wxConvUTF8, strlen(flag_string));
-		flag->shortDescription = wxString(description, wxConvUTF8, strlen(description));
-		flag->webURL = wxString(web_url, wxConvUTF8, strlen(web_url));
-		flag->fsoCatagory = wxString(easy_catagory, wxConvUTF8, strlen(easy_catagory));
-		flag->isRecomendedFlag = false; // much better from a UI point of view than "true"
-		
-		flag->easyEnable = easy_on_flags;
-		flag->easyDisable = easy_off_flags;
-		
-		this->data->AddFlag(flag);
-	}		
-	
-	wxLogDebug(_T(" easy_flag_size: %d, %lu; flag_size: %d, %lu; num_easy_flags: %d, %lu; num_flags: %d, %lu"),
-		easy_flag_size, sizeof(easy_flag_size),
-		flag_size, sizeof(flag_size),
-		num_easy_flags, sizeof(num_easy_flags),
-		num_flags, sizeof(num_flags));
 	
 	// build capabilities, which are needed for supporting the new sound code
-	wxByte buildCaps;
-	bytesRead = flagfile.Read(&buildCaps, sizeof(buildCaps));
-	if ( (size_t)wxInvalidOffset == bytesRead ) {
+	if (!view.HasBuildCaps()) {
 		wxLogInfo(_T(" Old build that does not output its capabilities, must not support OpenAL"));
-		buildCaps = 0;
 	}
-	this->buildCaps = buildCaps;
+	this->buildCaps = view.GetBuildCaps();
 	
 	this->data->GenerateFlagSets();
 	
@@ -507,37 +541,48 @@ FlagListManager::FlagFileProcessingStatus FlagListManager::GetFlagFileProcessing
 	}
 }
 
-FlagListManager::FlagProcess::FlagProcess(FlagFileArray flagFileLocations)
-: flagFileLocations(flagFileLocations) {
+FlagListManager::FlagProcess::FlagProcess(unsigned int generation)
+: generation(generation) {
 }
 
-void FlagListManager::FlagProcess::OnTerminate(int pid, int status) {
+void FlagListManager::FlagProcess::OnTerminate(int WXUNUSED(pid), int status) {
+	if (FlagListManager::IsInitialized()) {
+		FlagListManager::GetFlagListManager()->OnProbeFinished(this->generation, status);
+	}
+	delete this;
+}
+
+void FlagListManager::OnProbeFinished(unsigned int generation, int status) {
+	if (generation != this->probeGeneration) {
+		wxLogDebug(_T(" Abandoned flag file probe returned %d, ignoring it."), status);
+		return;
+	}
 	wxLogDebug(_T(" FS2 Open returned %d when polled for the flags"), status);
+	this->probeDeadline.Stop();
+	this->probePid = 0;
 	
 	// Find the flag file
 	wxFileName flagfile;
-	for( size_t i = 0; i < flagFileLocations.Count(); i++ ) {
-		bool exists = flagFileLocations[i].FileExists();
+	for( size_t i = 0; i < this->probeFlagFiles.Count(); i++ ) {
+		bool exists = this->probeFlagFiles[i].FileExists();
 		if (exists) {
-			flagfile = flagFileLocations[i];
+			flagfile = this->probeFlagFiles[i];
 			wxLogDebug(_T(" Searching for flag file at %s ... %s"),
-				flagFileLocations[i].GetFullPath().c_str(),
-				(flagFileLocations[i].FileExists())? _T("Located") : _T("Not Here"));
+				this->probeFlagFiles[i].GetFullPath().c_str(),
+				(this->probeFlagFiles[i].FileExists())? _T("Located") : _T("Not Here"));
 		}
 	}
 	
 	if ( !flagfile.FileExists() ) {
-		FlagListManager::GetFlagListManager()->SetProcessingStatus(FLAG_FILE_NOT_GENERATED);
+		this->SetProcessingStatus(FLAG_FILE_NOT_GENERATED);
 		wxLogError(_T(" FS2 Open did not generate a flag file."));
 		return;
 	}
 	
-	FlagListManager::GetFlagListManager()->SetProcessingStatus(
-		FlagListManager::GetFlagListManager()->ParseFlagFile(flagfile));
+	this->SetProcessingStatus(this->ParseFlagFile(flagfile));
 	
-	if ( FlagListManager::GetFlagListManager()->IsProcessingOK() ) {
+	if ( this->IsProcessingOK() ) {
+		FlagFileCache::Store(this->probeExe, flagfile);
 		::wxRemoveFile(flagfile.GetFullPath());
 	}
-	
-	delete this;
 }
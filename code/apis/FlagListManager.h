@@ -22,6 +22,7 @@
 #include <wx/wx.h>
 #include <wx/filename.h>
 #include <wx/process.h>
+#include <wx/timer.h>
 
 #include "datastructures/FlagFileData.h"
 #include "apis/EventHandlers.h"
@@ -57,14 +58,28 @@ public:
 	};
 
 	void OnBinaryChanged(wxCommandEvent &event);
+	void OnProbeDeadline(wxTimerEvent &event);
+	void OnProbeRetry(wxTimerEvent &event);
 	
 	static void RegisterFlagFileProcessingStatusChanged(wxEvtHandler *handler);
 	static void UnRegisterFlagFileProcessingStatusChanged(wxEvtHandler *handler);
 	
+	/** Starts getting the flag file of the selected executable.
+	 Supersedes any processing that is still underway. */
 	void BeginFlagFileProcessing();
+	/** Stops waiting for the executable to write its flag file, and kills it. */
+	void CancelFlagFileProcessing();
+	
+	/** Returns the command line that makes exeFilename write out its flag file. */
+	static wxString GetFlagFileCommandLine(const wxFileName& exeFilename);
+	/** Returns how many ms an executable has to write its flag file on the
+	 first attempt, or 0 if it can take as long as it likes. */
+	static long GetFlagProbeTimeout();
 	
 	/** Returns true when the flag file processing has succeeded, false otherwise. */
 	inline bool IsProcessingOK() const { return (this->processingStatus == PROCESSING_OK); }
+	/** Returns true while the selected executable is writing its flag file. */
+	inline bool IsWaitingForFlagFile() const { return (this->processingStatus == WAITING_FOR_FLAG_FILE); }
 	
 	/** Returns the message to display when processing has not (yet) succeded.
 	 This function should not called when processing has succeeded. */
@@ -107,6 +122,8 @@ private:
 		FLAG_FILE_NOT_SUPPORTED,
 		CANNOT_CREATE_FLAGFILE_FOLDER,
 		CANNOT_CHANGE_WORKING_FOLDER,
+		FLAG_FILE_TIMED_OUT,
+		FLAG_FILE_CANCELLED,
 		MAX_PROCESSINGSTATUS
 	};
 	ProcessingStatus processingStatus; //!< has processing succeeded
@@ -121,12 +138,30 @@ private:
 	
 	wxByte buildCaps;
 	
+	/** \name The executable that is writing its flag file
+	 An executable that hangs or shows a dialog when run with -get_flags is
+	 killed when its deadline passes and run again after a delay, with the
+	 deadline and the delay doubled each time, up to FLAG_PROBE_ATTEMPTS times. */
+	/** @{*/
+	bool LaunchProbe();
+	void KillProbe();
+	void OnProbeFinished(unsigned int generation, int status);
+	wxTimer probeDeadline;
+	wxTimer probeRetry;
+	unsigned int probeGeneration; //!< incremented whenever a probe is started or abandoned
+	long probePid; //!< 0 if no probe is running
+	int probeAttempt; //!< attempts made at the current executable
+	wxFileName probeExe;
+	wxFileName probeFolder; //!< working folder of the probe
+	FlagFileArray probeFlagFiles; //!< where the probe can write its flag file
+	/** @}*/
+	
 	class FlagProcess: public wxProcess {
 	public:
-		FlagProcess(FlagFileArray flagFileLocations);
+		FlagProcess(unsigned int generation);
 		virtual void OnTerminate(int pid, int status);
 	private:
-		FlagFileArray flagFileLocations;
+		unsigned int generation; //!< probe that started this process
 	};
 	
 	DECLARE_EVENT_TABLE()
@@ -20,6 +20,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #define PLATFORMPROFILEMANAGER_H
 #include <wx/fileconf.h>
 #include "apis/ProfileManager.h"
+#include "global/ProfileKeys.h"
 
 ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg);
 ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg);
@@ -29,4 +30,28 @@ ProMan::RegistryCodes FilePullProfile(wxFileConfig *cfg);
 
 ProMan::RegistryCodes PushCmdlineFSO(wxFileConfig *cfg);
 
+/** What was last pushed to one of FS2 Open's config files, and what the file
+ looked like on disk afterwards. Kept in the global profile so that pushing a
+ profile whose settings have not changed since does not touch the file at all. */
+class PushedFileRecord {
+public:
+	/** Reads the record from the global profile. */
+	PushedFileRecord(const GlobalKey<wxString>& key);
+
+	/** Returns true if filePath is the recorded file, it has not changed on disk
+	 since, and what was pushed to it hashes to contentHash. Only stats the file. */
+	bool Matches(const wxString& filePath, const wxString& contentHash) const;
+	/** Records that filePath, as it is on disk now, holds what hashes to
+	 contentHash, and stores the record in the global profile if it changed. */
+	void Update(const wxString& filePath, const wxString& contentHash);
+
+private:
+	const GlobalKey<wxString>& key;
+	wxString stored; //!< the record as it is in the global profile
+	wxString filePath;
+	wxString contentHash;
+	wxString fileSize; //!< as a string
+	wxString fileMtime; //!< milliseconds since the epoch, as a string
+};
+
 #endif
\ No newline at end of file
@@ -18,22 +18,106 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include <wx/wx.h>
 #include <wx/dir.h>
+#include <wx/ffile.h>
 #include <wx/filename.h>
-#include <wx/wfstream.h>
+#include <wx/tokenzr.h>
 #include "generated/configure_launcher.h"
 #include "apis/PlatformProfileManager.h"
+#include "apis/ProfileWriter.h"
 #include "controls/LightingPresets.h"
 #include "global/ProfileKeys.h"
+#include "global/Utils.h"
+
+/** Separates the fields of a PushedFileRecord in the global profile.
+ The file path comes last, so it may contain the separator. */
+#define PUSHED_RECORD_SEPARATOR _T("|")
+
+PushedFileRecord::PushedFileRecord(const GlobalKey<wxString>& key): key(key) {
+	ProMan* proman = ProMan::GetProfileManager();
+	if (proman == NULL || !proman->GlobalRead(key, &this->stored)) {
+		return;
+	}
+
+	wxStringTokenizer tokens(this->stored, PUSHED_RECORD_SEPARATOR, wxTOKEN_RET_EMPTY_ALL);
+	this->contentHash = tokens.GetNextToken();
+	this->fileSize = tokens.GetNextToken();
+	this->fileMtime = tokens.GetNextToken();
+	this->filePath = tokens.GetString();
+}
+
+bool PushedFileRecord::Matches(const wxString& filePath, const wxString& contentHash) const {
+	if (this->filePath.IsEmpty() || this->filePath != filePath
+		|| this->contentHash != contentHash) {
+		return false;
+	}
+
+	wxFileName file(filePath);
+	if (!file.FileExists()) {
+		return false;
+	}
+	wxDateTime modTime(file.GetModificationTime());
+	return modTime.IsValid()
+		&& file.GetSize().ToString() == this->fileSize
+		&& modTime.GetValue().ToString() == this->fileMtime;
+}
+
+void PushedFileRecord::Update(const wxString& filePath, const wxString& contentHash) {
+	this->filePath = filePath;
+	this->contentHash = contentHash;
+
+	wxFileName file(filePath);
+	wxDateTime modTime;
+	if (file.FileExists()) {
+		modTime = file.GetModificationTime();
+	}
+	if (modTime.IsValid()) {
+		this->fileSize = file.GetSize().ToString();
+		this->fileMtime = modTime.GetValue().ToString();
+	} else {
+		// never matches, so the file is checked again next time
+		this->fileSize.Clear();
+		this->fileMtime.Clear();
+	}
+
+	const wxString record(this->contentHash + PUSHED_RECORD_SEPARATOR
+		+ this->fileSize + PUSHED_RECORD_SEPARATOR
+		+ this->fileMtime + PUSHED_RECORD_SEPARATOR + this->filePath);
+	// writing the same record again would still queue a save of the global profile
+	if (record == this->stored) {
+		return;
+	}
+	ProMan* proman = ProMan::GetProfileManager();
+	if (proman != NULL && proman->GlobalWrite(this->key, record)) {
+		this->stored = record;
+	}
+}
+
+/** Appends str to contents as the bytes that FS2 Open reads. */
+static void AppendToCmdline(std::vector<char>& contents, const wxString& str) {
+	const wxCharBuffer buffer(str.char_str());
+	contents.insert(contents.end(), buffer.data(), buffer.data() + strlen(buffer.data()));
+}
+
+/** Returns true if the file at filePath holds exactly contents. */
+static bool FileHasContents(const wxString& filePath, const std::vector<char>& contents) {
+	wxFFile file(filePath, _T("rb"));
+	if (!file.IsOpened() || file.Length() != static_cast<wxFileOffset>(contents.size())) {
+		return false;
+	}
+	std::vector<char> current(contents.size());
+	return current.empty()
+		|| (file.Read(&current[0], current.size()) == current.size() && current == contents);
+}
 
 ProMan::RegistryCodes PushCmdlineFSO(wxFileConfig *cfg) {
 	wxString modLine, flagLine, tcPath;
-	cfg->Read(PRO_CFG_TC_CURRENT_MODLINE, &modLine);
-	cfg->Read(PRO_CFG_TC_CURRENT_FLAG_LINE, &flagLine);
-	cfg->Read(PRO_CFG_TC_ROOT_FOLDER, &tcPath);
+	cfg->Read(PRO_CFG_TC_CURRENT_MODLINE.GetPath(), &modLine);
+	cfg->Read(PRO_CFG_TC_CURRENT_FLAG_LINE.GetPath(), &flagLine);
+	cfg->Read(PRO_CFG_TC_ROOT_FOLDER.GetPath(), &tcPath);
 	
 	wxString presetName;
 	wxString lightingPresetFlagSet;
-	if (cfg->Read(PRO_CFG_LIGHTING_PRESET, &presetName)) {
+	if (cfg->Read(PRO_CFG_LIGHTING_PRESET.GetPath(), &presetName)) {
 		lightingPresetFlagSet = LightingPresets::PresetNameToPresetFlagSet(presetName);
 	}
 
@@ -91,29 +175,40 @@ ProMan::RegistryCodes PushCmdlineFSO(wxFileConfig *cfg) {
 	cmdLineString += wxFileName::GetPathSeparator();
 	cmdLineString += _T("cmdline_fso.cfg");
 	wxFileName cmdLineFileName(cmdLineString);
-	wxFFileOutputStream outStream(cmdLineFileName.GetFullPath(), _T("w+b"));
-	if ( !outStream.IsOk() ) {
-		return ProMan::UnknownError;
-	}
-	if ( !modLine.IsEmpty()) {
-		outStream.Write("-mod ", 5);
 
+	std::vector<char> contents;
+	if ( !modLine.IsEmpty()) {
 		// Enclose the mod parameter in quotes to escape spaces
-		outStream.Write("\"", 1);
-		outStream.Write(modLine.char_str(), modLine.size());
-		outStream.Write("\"", 1);
+		AppendToCmdline(contents, _T("-mod \"") + modLine + _T("\""));
 	}
 	if ( !flagLine.IsEmpty() ) {
-		outStream.Write(" ", 1);
-		outStream.Write(flagLine.char_str(), flagLine.size());
+		AppendToCmdline(contents, _T(" ") + flagLine);
 	}
 	if ( !lightingPresetFlagSet.IsEmpty()) {
-		outStream.Write(" ", 1);
-		outStream.Write(lightingPresetFlagSet.char_str(), lightingPresetFlagSet.size());
+		AppendToCmdline(contents, _T(" ") + lightingPresetFlagSet);
+	}
+
+	const wxString contentsHash(HashUtils::HashBuffer(
+		contents.empty() ? NULL : &contents[0], contents.size()));
+	PushedFileRecord record(GBL_CFG_PUSHED_CMDLINE);
+	if (record.Matches(cmdLineFileName.GetFullPath(), contentsHash)) {
+		wxLogDebug(_T("%s is unchanged since it was last written"),
+			cmdLineFileName.GetFullPath().c_str());
+		return ProMan::NoError;
 	}
-	if ( !outStream.Close() ) {
-		return ProMan::UnknownError;
+
+	if (FileHasContents(cmdLineFileName.GetFullPath(), contents)) {
+		wxLogDebug(_T("%s already has the command line, not writing it"),
+			cmdLineFileName.GetFullPath().c_str());
+	} else {
+		wxString error;
+		if (!ProfileWriter::WriteAtomically(cmdLineFileName.GetFullPath(), contents, error)) {
+			wxLogError(_T("Unable to write the command line: %s"), error.c_str());
+			return ProMan::UnknownError;
+		}
+		wxLogDebug(_T("Wrote the command line to %s"), cmdLineFileName.GetFullPath().c_str());
 	}
+	record.Update(cmdLineFileName.GetFullPath(), contentsHash);
 
 	return ProMan::NoError;
-}
\ No newline at end of file
+}
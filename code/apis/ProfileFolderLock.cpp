@@ -0,0 +1,106 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "generated/configure_launcher.h"
+#include "apis/ProfileFolderLock.h"
+#include "global/ProfileKeys.h"
+
+#include <wx/filename.h>
+
+#if IS_WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include "global/MemoryDebugging.h"
+
+#define PROFILE_FOLDER_LOCK_FILE_NAME _T("profiles.lock")
+/** How long to wait for another launcher to finish writing to the profile folder. */
+const long PROFILE_FOLDER_LOCK_TIMEOUT_MS = 5000;
+const long PROFILE_FOLDER_LOCK_RETRY_MS = 20;
+
+wxString ProfileFolderLock::GetLockFile() {
+	return wxFileName(GetProfileStorageFolder(), PROFILE_FOLDER_LOCK_FILE_NAME).GetFullPath();
+}
+
+// Does not log, because it is used on ProfileWriter's worker thread.
+ProfileFolderLock::ProfileFolderLock(const wxString& lockFile): locked(false) {
+#if IS_WIN32
+	this->handle = ::CreateFileW(lockFile.wc_str(), GENERIC_READ | GENERIC_WRITE,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_ALWAYS,
+		FILE_ATTRIBUTE_NORMAL, NULL);
+	if (this->handle == INVALID_HANDLE_VALUE) {
+		this->handle = NULL;
+		this->error = wxString::Format(_T("unable to open the lock file %s (error %lu)"),
+			lockFile.c_str(), static_cast<unsigned long>(::GetLastError()));
+		return;
+	}
+#else
+	// other users that share the profile folder need to open it as well;
+	// the umask takes away what they should not have
+	this->fd = ::open(lockFile.fn_str(), O_RDWR | O_CREAT, 0666);
+	if (this->fd < 0) {
+		this->error = wxString::Format(_T("unable to open the lock file %s (error %d)"),
+			lockFile.c_str(), errno);
+		return;
+	}
+#endif
+
+	for (long waited = 0; ; waited += PROFILE_FOLDER_LOCK_RETRY_MS) {
+#if IS_WIN32
+		OVERLAPPED overlapped;
+		::ZeroMemory(&overlapped, sizeof(overlapped));
+		this->locked = ::LockFileEx(this->handle,
+			LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0, 1, 0, &overlapped) != 0;
+#else
+		this->locked = ::flock(this->fd, LOCK_EX | LOCK_NB) == 0;
+#endif
+		if (this->locked) {
+			return;
+		} else if (waited >= PROFILE_FOLDER_LOCK_TIMEOUT_MS) {
+			this->error = wxString::Format(
+				_T("another launcher has kept the profile folder locked for more than %ld seconds"),
+				PROFILE_FOLDER_LOCK_TIMEOUT_MS / 1000);
+			return;
+		}
+		wxMilliSleep(PROFILE_FOLDER_LOCK_RETRY_MS);
+	}
+}
+
+ProfileFolderLock::~ProfileFolderLock() {
+#if IS_WIN32
+	if (this->handle != NULL) {
+		if (this->locked) {
+			OVERLAPPED overlapped;
+			::ZeroMemory(&overlapped, sizeof(overlapped));
+			::UnlockFileEx(this->handle, 0, 1, 0, &overlapped);
+		}
+		::CloseHandle(this->handle);
+	}
+#else
+	if (this->fd >= 0) {
+		// closing the file releases the lock
+		::close(this->fd);
+	}
+#endif
+}
@@ -0,0 +1,63 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef PROFILEFOLDERLOCK_H
+#define PROFILEFOLDERLOCK_H
+
+#include <wx/wx.h>
+
+/** An advisory, exclusive lock on the profile folder, held for as long as the
+ object exists. Launchers that run at the same time, such as one started with
+ --session-only next to a scripted --add-profile, take it while they write to
+ the folder, so that they never write to it at once. The lock is on a lock file
+ in the folder, and the operating system releases it if the launcher dies.
+ Taking the lock can wait for another launcher, so it is only taken on
+ ProfileWriter's worker thread, never on the main thread. */
+class ProfileFolderLock {
+public:
+	/** Takes the lock on the folder that lockFile is in, waiting for another
+	 launcher to release it for up to PROFILE_FOLDER_LOCK_TIMEOUT_MS.
+	 lockFile should come from GetLockFile(). */
+	ProfileFolderLock(const wxString& lockFile);
+	~ProfileFolderLock();
+
+	/** Returns false if the lock file could not be opened, or the lock could
+	 not be taken in time. What needed the lock should not go ahead then, as it
+	 could overwrite what another launcher is writing. */
+	bool IsLocked() const { return this->locked; }
+	/** Why the lock could not be taken. */
+	const wxString& GetError() const { return this->error; }
+
+	/** The lock file in the profile folder. Must be called on the main thread. */
+	static wxString GetLockFile();
+
+private:
+	bool locked;
+	wxString error;
+#if IS_WIN32
+	void* handle; //!< a HANDLE
+#else
+	int fd;
+#endif
+
+	// not copyable
+	ProfileFolderLock(const ProfileFolderLock&);
+	ProfileFolderLock& operator=(const ProfileFolderLock&);
+};
+
+#endif
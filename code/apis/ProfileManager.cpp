@@ -20,6 +20,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <vector>
 
 #include <wx/wx.h>
+#include <wx/file.h>
 #include <wx/fileconf.h>
 #include <wx/stdpaths.h>
 #include <wx/filename.h>
@@ -30,9 +31,12 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "apis/EventHandlers.h"
 #include "apis/ProfileManager.h"
 #include "apis/PlatformProfileManager.h"
+#include "apis/ProfileFolderLock.h"
 #include "apis/FlagListManager.h"
 #include "wxLauncherApp.h"
+#include "global/ids.h"
 #include "global/ProfileKeys.h"
+#include "global/Utils.h"
 
 #include "global/MemoryDebugging.h"
 
@@ -42,12 +46,22 @@ ProMan::Flags ProMan::flags;
 
 const wxString& ProMan::DEFAULT_PROFILE_NAME = _T("Default");
 #define GLOBAL_INI_FILE_NAME _T("global.ini")
+/** How often the profile folder is checked for changes made by other launchers. */
+const int PROFILE_RELOAD_POLL_MS = 2000;
+/** How many changes to the current profile can be undone, unless the global profile says otherwise. */
+const long DEFAULT_UNDO_DEPTH = 100;
 
 ///////////// Events
 
 /** EVT_PROFILE_EVENT */
 LAUNCHER_DEFINE_EVENT_TYPE(EVT_PROFILE_CHANGE);
 LAUNCHER_DEFINE_EVENT_TYPE(EVT_CURRENT_PROFILE_CHANGED);
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_PROFILE_SAVED);
+
+BEGIN_EVENT_TABLE(ProMan, wxEvtHandler)
+EVT_COMMAND(wxID_NONE, EVT_PROFILE_FILES_WRITTEN, ProMan::OnProfileFilesWritten)
+EVT_TIMER(ID_PROFILE_RELOAD_TIMER, ProMan::OnReloadTimer)
+END_EVENT_TABLE()
 
 void ProMan::GenerateChangeEvent() {
 	wxCommandEvent event(EVT_PROFILE_CHANGE, wxID_NONE);
@@ -73,6 +87,20 @@ void ProMan::GenerateCurrentProfileChangedEvent() {
 	} 
 }
 
+void ProMan::GenerateProfileSavedEvent(const wxString& name, bool success) {
+	wxCommandEvent event(EVT_PROFILE_SAVED, wxID_NONE);
+	event.SetString(name);
+	event.SetInt(success ? 1 : 0);
+	wxLogDebug(wxT_2("Generating profile saved event"));
+	EventHandlers::iterator iter = this->eventHandlers.begin();
+	while (iter != this->eventHandlers.end()) {
+		wxEvtHandler* current = *iter;
+		current->AddPendingEvent(event);
+		wxLogDebug(wxT_2(" Sent profile saved event to %p"), current);
+		iter++;
+	}
+}
+
 void ProMan::AddEventHandler(wxEvtHandler *handler) {
 	wxASSERT_MSG(eventHandlers.IndexOf(handler) == wxNOT_FOUND,
 		wxString::Format(
@@ -89,12 +117,6 @@ void ProMan::RemoveEventHandler(wxEvtHandler *handler) {
 	this->eventHandlers.DeleteObject(handler);
 }
 
-NewsData::NewsData(const wxString& theNews, const wxDateTime& lastDownloadNews)
-: theNews(theNews), lastDownloadNews(lastDownloadNews) {
-	wxASSERT(!theNews.IsEmpty());
-	wxASSERT(lastDownloadNews.IsValid());
-}
-
 /** Load a profile from a fully quaified path.  Returns NULL on failure
 or a pointer to a wxFileConfig that you must delete when done. */
 wxFileConfig* LoadProfileFromFile(const wxFileName &file)
@@ -104,6 +126,12 @@ wxFileConfig* LoadProfileFromFile(const wxFileName &file)
 	return new wxFileConfig(globalProfileInput);
 }
 
+/** Returns a string that changes whenever files are added to, removed from or
+ replaced in the profile folder. */
+static wxString GetProfileFolderStamp() {
+	return ProfileIndex::GetFolderStamp(GetProfileStorageFolder());
+}
+
 /** Sets up the profile manager. Must be called on program startup so that
 it can intercept global wxWidgets configuation functions. 
 \return true when setup was successful, false if proman is not
@@ -129,29 +157,31 @@ bool ProMan::Initialize(Flags flags) {
 		return false;
 	}
 
+	// the stat is taken first, so that a change made while reading is not missed
+	ProMan::proman->globalFileStat.ReadFileStat(file.GetFullPath());
 	ProMan::proman->globalProfile = LoadProfileFromFile(file);
-	ProMan::proman->LoadNewsMapFromGlobalProfile();
+	ProMan::proman->MoveNewsOutOfGlobalProfile();
 
-	// fetch all profiles.
-	wxArrayString foundProfiles;
-	wxDir::GetAllFiles(GetProfileStorageFolder(), &foundProfiles, wxT_2("pro?????.ini"));
+	// fetch all profiles. only their names are needed until they are used,
+	// so they come from the index, which only parses profiles that have changed.
+	ProMan::proman->profileFolderStamp = GetProfileFolderStamp();
+	ProMan::proman->profileIndex.Load();
+	ProMan::proman->profileIndex.Refresh();
+	const ProfileIndexEntries& indexedProfiles = ProMan::proman->profileIndex.GetEntries();
 
-	wxLogInfo(wxT_2(" Found %d profile(s)."), foundProfiles.Count());
-	for( size_t i = 0; i < foundProfiles.Count(); i++) {
-		wxLogDebug(wxT_2("  Opening %s"), foundProfiles[i].c_str());
-		wxFFileInputStream instream(foundProfiles[i]);
-		wxFileConfig *config = new wxFileConfig(instream);
-		
-		wxString name;
-		config->Read(PRO_CFG_MAIN_NAME, &name, wxString::Format(wxT_2("Profile %05ld"), i));
-
-		ProMan::proman->profiles[name] = config;
-		wxLogDebug(wxT_2("  Opened profile named: %s"), name.c_str());
+	wxLogInfo(wxT_2(" Found ") SZT wxT_2(" profile(s)."), indexedProfiles.size());
+	for (ProfileIndexEntries::const_iterator it = indexedProfiles.begin();
+		 it != indexedProfiles.end(); ++it) {
+		const wxString& name = it->second.name;
+		ProMan::proman->profiles[name] = NULL;
+		ProMan::proman->profileFiles[name] = it->second.filePath;
+		wxLogDebug(wxT_2("  Found profile named %s in %s"), name.c_str(), it->first.c_str());
 	}
+	ProMan::proman->profileIndex.Save(ProMan::proman->writer);
 
 	wxString currentProfile;
 	ProMan::proman->globalProfile->Read(
-		GBL_CFG_MAIN_LASTPROFILE, &currentProfile, ProMan::DEFAULT_PROFILE_NAME);
+		GBL_CFG_MAIN_LASTPROFILE.GetPath(), &currentProfile, ProMan::DEFAULT_PROFILE_NAME);
 	
 	wxLogDebug(wxT_2(" Searching for profile: %s"), currentProfile.c_str());
 	if ( ProMan::proman->profiles.find(currentProfile)
@@ -171,9 +201,8 @@ bool ProMan::Initialize(Flags flags) {
 		}
 		wxLogInfo(wxT_2(" Resetting lastprofile to Default."));
 		// Do not ignore updating last profile here because this is fixing bad data
-		ProMan::proman->globalProfile->Write(GBL_CFG_MAIN_LASTPROFILE, ProMan::DEFAULT_PROFILE_NAME);
-		wxFFileOutputStream globalProfileOutput(file.GetFullPath());
-		ProMan::proman->globalProfile->Save(globalProfileOutput);
+		ProMan::proman->GlobalWrite(GBL_CFG_MAIN_LASTPROFILE, ProMan::DEFAULT_PROFILE_NAME);
+		ProMan::proman->SaveGlobalProfile();
 		currentProfile = ProMan::DEFAULT_PROFILE_NAME;
 	}
 
@@ -183,6 +212,12 @@ bool ProMan::Initialize(Flags flags) {
 		return false;
 	}
 
+	long undoDepth;
+	ProMan::proman->GlobalRead(GBL_CFG_MAIN_UNDODEPTH, &undoDepth, DEFAULT_UNDO_DEPTH);
+	ProMan::proman->SetUndoDepth(static_cast<size_t>(std::max(undoDepth, 0L)));
+
+	ProMan::proman->reloadTimer.Start(PROFILE_RELOAD_POLL_MS);
+
 	ProMan::isInitialized = true;
 	wxLogDebug(wxT_2(" Profile Manager is set up"));
 	return true;
@@ -221,14 +256,13 @@ ProMan* ProMan::GetProfileManager() {
 /** Private constructor.  Just makes instance variables safe.  Call Initialize()
 to setup class, then call GetProfileManager() to get a pointer to the instance.
 */
-ProMan::ProMan() {
+ProMan::ProMan()
+: writer(this, ProfileFolderLock::GetLockFile()), reloadTimer(this, ID_PROFILE_RELOAD_TIMER) {
 	this->globalProfile = NULL;
 	this->isAutoSaving = true;
 	this->currentProfile = NULL;
-	
-	this->privateCopyFilename = wxFileName::CreateTempFileName(wxT_2("wxLtest"));
-	wxFFileInputStream instream(this->privateCopyFilename);
-	this->privateCopy = new wxFileConfig(instream);
+	this->profileGeneration = 0;
+	this->undoDepth = DEFAULT_UNDO_DEPTH;
 }
 
 /** Destructor. */
@@ -239,24 +273,16 @@ ProMan::~ProMan() {
 		delete iter->second;
 		iter++;
 	}
-	
-	delete this->privateCopy;
-	privateCopy = NULL;
-	::wxRemoveFile(this->privateCopyFilename);
 }
 
 /** Saves changes to profiles according to autosave profiles checkbox. */
 void ProMan::SaveProfilesBeforeExiting() {
+	this->reloadTimer.Stop();
+
 	if ( this->globalProfile != NULL ) {
 		wxLogInfo(wxT_2("saving global profile before exiting."));
-		SaveNewsMapToGlobalProfile();
-		
-		wxFileName file;
-		file.Assign(GetProfileStorageFolder(), GLOBAL_INI_FILE_NAME);
-		wxFFileOutputStream globalProfileOutput(file.GetFullPath());
-		this->globalProfile->Save(globalProfileOutput);
-		
-		delete this->globalProfile;
+		this->newsCache.Save(this->writer);
+		this->SaveGlobalProfile();
 	} else {
 		wxLogWarning(_("global profile is null, cannot save it"));
 	}
@@ -284,102 +310,619 @@ void ProMan::SaveProfilesBeforeExiting() {
 		wxLogInfo(wxT_2("Current profile %s has no unsaved changes. Exiting."),
 			this->GetCurrentName().c_str());
 	}
+
+	// the index should only list files as they are on disk
+	this->FlushWriter(false);
+	this->profileIndex.Save(this->writer);
+	this->FlushWriter(false);
+
+	// saving again after another launcher has changed the global profile needs it
+	delete this->globalProfile;
+	this->globalProfile = NULL;
 }
 
-void ProMan::LoadNewsMapFromGlobalProfile() {
-	wxASSERT(newsMap.empty());
-	
+/** Older versions kept the downloaded news in the global profile, under
+ /net/<news source>. Moves any news found there into the news cache, so that
+ the global profile only holds settings. */
+void ProMan::MoveNewsOutOfGlobalProfile() {
 	globalProfile->SetPath(GBL_CFG_NET_FOLDER);
 	
 	// inspired by CopyConfig()
 	wxString groupName;
 	long groupIndex;
-	bool groupKeepGoing;
+	wxArrayString newsSources;
+	bool groupKeepGoing = globalProfile->GetFirstGroup(groupName, groupIndex);
+	while (groupKeepGoing) {
+		newsSources.Add(groupName);
+		groupKeepGoing = globalProfile->GetNextGroup(groupName, groupIndex);
+	}
 	
 	wxString theNews;
 	wxString lastDownloadNewsStr;
 	wxDateTime lastDownloadNews;
-	
-	groupKeepGoing = globalProfile->GetFirstGroup(groupName, groupIndex);
-	
-	while (groupKeepGoing) {
-		globalProfile->SetPath(groupName);
+	for (size_t i = 0; i < newsSources.GetCount(); i++) {
+		const wxString& newsSource = newsSources[i];
+		globalProfile->SetPath(newsSource);
 		
 		if (globalProfile->Read(GBL_CFG_NET_THE_NEWS, &theNews) &&
 			(globalProfile->Read(GBL_CFG_NET_NEWS_LAST_TIME, &lastDownloadNewsStr))) {
 			if ((!theNews.IsEmpty()) &&
 				(NULL != lastDownloadNews.ParseFormat(
 					lastDownloadNewsStr, NEWS_LAST_TIME_FORMAT))) {
-				newsMap[groupName] = NewsData(theNews, lastDownloadNews);
-				
-				wxLogDebug(wxT_2("Created news map entry for source %s"),
-					groupName.c_str());
+				const NewsData* cached = this->newsCache.Read(newsSource);
+				if (cached == NULL || cached->lastDownloadNews < lastDownloadNews) {
+					this->newsCache.Write(newsSource, NewsData(theNews, lastDownloadNews));
+				}
+				wxLogDebug(wxT_2("Moved news for source %s to the news cache"),
+					newsSource.c_str());
 			}
 		}
+		this->GlobalChanged(globalProfile->GetPath() + wxT_2("/") + GBL_CFG_NET_THE_NEWS);
+		this->GlobalChanged(globalProfile->GetPath() + wxT_2("/") + GBL_CFG_NET_NEWS_LAST_TIME);
 		
 		globalProfile->SetPath(wxT_2(".."));
-		
-		groupKeepGoing = globalProfile->GetNextGroup(groupName, groupIndex);
+		globalProfile->DeleteGroup(newsSource);
 	}
 	
 	globalProfile->SetPath(wxT_2("/"));
+	
+	if (!newsSources.IsEmpty()) {
+		// the news is only removed from the global profile once it is safe in the cache.
+		// This only happens once, on the first run after an upgrade, so waiting here is fine
+		this->newsCache.Save(this->writer);
+		this->FlushWriter(false);
+		if (!this->newsCache.IsUnsaved()) {
+			this->SaveGlobalProfile();
+		} else {
+			wxLogWarning(_("Unable to save the news cache, the news stays in the global profile"));
+			delete this->globalProfile;
+			this->globalProfile = LoadProfileFromFile(this->globalFileStat.filePath);
+			this->changedGlobalEntries.Clear();
+		}
+	}
 }
 
-void ProMan::SaveNewsMapToGlobalProfile() {
-	globalProfile->SetPath(GBL_CFG_NET_FOLDER);
-	
-	for (NewsMap::const_iterator it = newsMap.begin(), end = newsMap.end();
-		 it != end; ++it) {
-		const wxString& newsSource = it->first;
-		const NewsData& newsData = it->second;
-		
-		globalProfile->SetPath(newsSource);
-		globalProfile->Write(GBL_CFG_NET_THE_NEWS, newsData.theNews);
-		globalProfile->Write(GBL_CFG_NET_NEWS_LAST_TIME,
-			newsData.lastDownloadNews.Format(NEWS_LAST_TIME_FORMAT));
-		globalProfile->SetPath(wxT_2(".."));
+/** Returns the state of the entry at key in config. */
+ProMan::EntryState ProMan::ReadEntry(wxFileConfig& config, const wxString& key) {
+	// read the text as it is stored, so that WriteEntry() can write it back as is.
+	// wxFileConfig stores every entry as text, so this compares bools and longs as well
+	const bool expandingEnvVars = config.IsExpandingEnvVars();
+	config.SetExpandEnvVars(false);
+	wxString value;
+	const bool exists = config.Read(key, &value);
+	config.SetExpandEnvVars(expandingEnvVars);
+	return EntryState(exists, value);
+}
+
+/** Gives the entry at key in config the state read by ReadEntry(). */
+void ProMan::WriteEntry(wxFileConfig& config, const wxString& key, const EntryState& state) {
+	if (state.exists) {
+		config.Write(key, state.value);
+	} else {
+		config.DeleteEntry(key, true);
 	}
-	
-	globalProfile->SetPath(wxT_2("/"));
 }
 
-/** Resets the private copy so that it contains a copy
- of the current profile's contents. */
-void ProMan::ResetPrivateCopy() {
-	wxCHECK_RET(this->currentProfile != NULL, wxT_2("ResetPrivateCopy called with null current profile!"));
-	ClearConfig(*(this->privateCopy));
-	CopyConfig(*(this->currentProfile), *(this->privateCopy));
+/** Returns the state of the entry at key in the current profile. */
+ProMan::EntryState ProMan::ReadCurrentEntry(const wxString& key) const {
+	return ReadEntry(*this->currentProfile, key);
+}
+
+/** Records a write or deletion of the entry at key in the current profile,
+ given the entry's state before it. Must be called for every change to the current
+ profile, so that HasUnsavedChanges() does not have to compare the whole profile,
+ and so that the change can be undone. */
+void ProMan::JournalChange(const wxString& key, const EntryState& before) {
+	const EntryState after(this->ReadCurrentEntry(key));
+	if (after == before) {
+		return;
+	}
+	this->UpdateJournal(key, before, after);
+
+	// a new change replaces whatever was undone before it
+	this->redoHistory.clear();
+	if (!this->undoHistory.empty() && this->undoHistory.back().key == key) {
+		ProfileEdit& last = this->undoHistory.back();
+		last.after = after;
+		if (last.after == last.before) {
+			this->undoHistory.pop_back();
+		}
+	} else if (this->undoDepth > 0) {
+		if (this->undoHistory.size() >= this->undoDepth) {
+			this->undoHistory.pop_front();
+		}
+		this->undoHistory.push_back(ProfileEdit(key, before, after));
+	}
+}
+
+/** Updates the journal for a change of the entry at key from before to after. */
+void ProMan::UpdateJournal(const wxString& key, const EntryState& before, const EntryState& after) {
+	this->profileGeneration++;
+	InvalidateSlot(this->profileSlots, this->profileSlotIds, key);
+
+	ProfileJournal::iterator it = this->journal.find(key);
+	if (it == this->journal.end()) {
+		// first change since the last save, so before is what was saved
+		this->journal[key] = before;
+	} else if (it->second == after) {
+		wxLogDebug(wxT_2("entry %s is back to its saved value"), key.c_str());
+		this->journal.erase(it);
+	}
 }
 
+/** Gives the entry at key in the current profile the state, as a step of undo or redo. */
+void ProMan::ApplyEdit(const wxString& key, const EntryState& state) {
+	const EntryState before(this->ReadCurrentEntry(key));
+	WriteEntry(*this->currentProfile, key, state);
+	const EntryState after(this->ReadCurrentEntry(key));
+	if (!(after == before)) {
+		this->UpdateJournal(key, before, after);
+	}
+}
+
+/** Undoes the most recent change to the current profile that has not been undone.
+ Returns false if there is none. */
+bool ProMan::Undo() {
+	if (this->currentProfile == NULL || this->undoHistory.empty()) {
+		return false;
+	}
+	const ProfileEdit edit(this->undoHistory.back());
+	this->undoHistory.pop_back();
+	wxLogDebug(wxT_2("undoing change to entry %s"), edit.key.c_str());
+	this->ApplyEdit(edit.key, edit.before);
+	this->redoHistory.push_back(edit);
+	this->GenerateCurrentProfileChangedEvent();
+	return true;
+}
+
+/** Redoes the change to the current profile that was most recently undone.
+ Returns false if there is none. */
+bool ProMan::Redo() {
+	if (this->currentProfile == NULL || this->redoHistory.empty()) {
+		return false;
+	}
+	const ProfileEdit edit(this->redoHistory.back());
+	this->redoHistory.pop_back();
+	wxLogDebug(wxT_2("redoing change to entry %s"), edit.key.c_str());
+	this->ApplyEdit(edit.key, edit.after);
+	this->undoHistory.push_back(edit);
+	this->GenerateCurrentProfileChangedEvent();
+	return true;
+}
+
+void ProMan::SetUndoDepth(size_t depth) {
+	this->undoDepth = depth;
+	while (this->undoHistory.size() > depth) {
+		this->undoHistory.pop_front();
+	}
+	while (this->redoHistory.size() > depth) {
+		this->redoHistory.pop_front();
+	}
+}
+
+void ProMan::ClearUndoHistory() {
+	this->undoHistory.clear();
+	this->redoHistory.clear();
+}
+
+/** Drops the undo and redo steps for the entries that have a different state
+ in reloaded than in the current profile. */
+void ProMan::DropEditsChangedIn(wxFileConfig& reloaded) {
+	std::deque<ProfileEdit>* histories[] = { &this->undoHistory, &this->redoHistory };
+	for (size_t i = 0; i < WXSIZEOF(histories); i++) {
+		std::deque<ProfileEdit> kept;
+		for (std::deque<ProfileEdit>::const_iterator it = histories[i]->begin();
+			 it != histories[i]->end(); ++it) {
+			if (this->ReadCurrentEntry(it->key) == ReadEntry(reloaded, it->key)) {
+				kept.push_back(*it);
+			} else {
+				wxLogDebug(wxT_2("dropping undo step for entry %s, which was changed by another launcher"),
+					it->key.c_str());
+			}
+		}
+		histories[i]->swap(kept);
+	}
+}
+
+/** Debugging function that logs the saved and current values of the entries
+ in the current profile that have unsaved changes. */
+void ProMan::LogUnsavedChanges() const {
+	const wxArrayString changes(this->GetUnsavedChanges());
+	for (size_t i = 0; i < changes.GetCount(); i++) {
+		const EntryState saved(this->SavedEntry(changes[i]));
+		const EntryState current(this->ReadCurrentEntry(changes[i]));
+		const wxString notFound(wxT_2("ENTRY_NOT_FOUND"));
+		wxLogDebug(wxT_2("  %s = %s (saved: %s)"), changes[i].c_str(),
+			(current.exists ? current.value : notFound).c_str(),
+			(saved.exists ? saved.value : notFound).c_str());
+	}
+}
+
+/** How many file names are tried for a new profile, when other launchers
+ take the names first. */
+const int PROFILE_FILE_NAME_ATTEMPTS = 10;
+
 /** Creates a new profile including the directory for it to go in, the entry
 in the profiles map. Returns true if creation was successful. */
 bool ProMan::CreateNewProfile(wxString newName) {
 	wxFileName profile;
-	profile.Assign(
-		GetProfileStorageFolder(),
-		this->GenerateNewProfileFileName());
+	// creating the file claims its name, and another launcher could pick the
+	// same name, so the file is only created if it does not exist yet
+	bool created = false;
+	for (int attempt = 0; attempt < PROFILE_FILE_NAME_ATTEMPTS && !created; attempt++) {
+		profile.Assign(
+			GetProfileStorageFolder(),
+			this->GenerateNewProfileFileName());
+
+		wxLogInfo(wxT_2("New profile will be written to %s"), profile.GetFullPath().c_str());
+		
+		wxASSERT_MSG( profile.IsOk(), wxT_2("Profile filename is invalid"));
 
-	wxLogInfo(wxT_2("New profile will be written to %s"), profile.GetFullPath().c_str());
-	
-	wxASSERT_MSG( profile.IsOk(), wxT_2("Profile filename is invalid"));
+		if ( !wxFileName::DirExists(profile.GetPath())
+			&& !wxFileName::Mkdir( profile.GetPath(), wxPATH_MKDIR_FULL) ) {
+			wxLogWarning(_("  Unable to create profile folder: %s"), profile.GetPath().c_str());
+			return false;
+		}
 
-	if ( !wxFileName::DirExists(profile.GetPath())
-		&& !wxFileName::Mkdir( profile.GetPath(), wxPATH_MKDIR_FULL) ) {
-		wxLogWarning(_("  Unable to create profile folder: %s"), profile.GetPath().c_str());
+		wxFile file;
+		const wxString folderStamp(GetProfileFolderStamp());
+		{
+			wxLogNull noLog; // failing because the file exists is expected
+			created = file.Create(profile.GetFullPath(), false);
+		}
+		if (created) {
+			this->OwnFolderChange(folderStamp, GetProfileFolderStamp());
+		}
+		if (!created && !profile.FileExists()) {
+			wxLogWarning(_("  Unable to create profile file: %s"), profile.GetFullPath().c_str());
+			return false;
+		}
+	}
+	if (!created) {
+		wxLogWarning(_("  Unable to find a free file name for profile '%s'"), newName.c_str());
 		return false;
 	}
 
-	wxFFileInputStream configInput(profile.GetFullPath(), wxT_2("w+b"));
-	wxFileConfig* config = new wxFileConfig(configInput);
-	config->Write(PRO_CFG_MAIN_NAME, newName);
-	config->Write(PRO_CFG_MAIN_FILENAME, profile.GetFullName());
-	wxFFileOutputStream configOutput(profile.GetFullPath());
-	config->Save(configOutput);
+	wxFileConfig* config;
+	{
+		wxFFileInputStream configInput(profile.GetFullPath());
+		config = new wxFileConfig(configInput);
+	}
+	config->Write(PRO_CFG_MAIN_NAME.GetPath(), newName);
+	config->Write(PRO_CFG_MAIN_FILENAME.GetPath(), profile.GetFullName());
 
 	this->profiles[newName] = config;
+	this->profileFiles[newName] = profile.GetFullPath();
+	this->SaveProfileToDisk(config, newName, true);
 	return true;
 }
 
+/** Returns the named profile, parsing its file if the profile has not been used yet.
+ Returns NULL if there is no such profile. */
+wxFileConfig* ProMan::GetProfile(const wxString& name) {
+	ProfileMap::iterator it = this->profiles.find(name);
+	if (it == this->profiles.end()) {
+		return NULL;
+	}
+	if (it->second == NULL) {
+		ProfileFileMap::const_iterator file = this->profileFiles.find(name);
+		wxCHECK_MSG(file != this->profileFiles.end(), NULL,
+			wxString::Format(wxT_2("No file is known for profile '%s'"), name.c_str()));
+		wxLogDebug(wxT_2("Opening profile %s from %s"), name.c_str(), file->second.c_str());
+		wxFFileInputStream instream(file->second);
+		it->second = new wxFileConfig(instream);
+	}
+	return it->second;
+}
+
+/** Queues the global profile to be written to disk. If another launcher has
+ saved it since it was loaded, the writer does not write it, and it is merged
+ with the other launcher's changes and saved again. */
+void ProMan::SaveGlobalProfile() {
+	wxFileName file;
+	file.Assign(GetProfileStorageFolder(), GLOBAL_INI_FILE_NAME);
+	// the global profile has no name, so saving it does not generate EVT_PROFILE_SAVED
+	this->writer.Save(*this->globalProfile, file.GetFullPath(), wxEmptyString, true,
+		this->globalFileStat.filePath.IsEmpty() ? NULL : &this->globalFileStat);
+}
+
+void ProMan::OnProfileFilesWritten(wxCommandEvent& WXUNUSED(event)) {
+	this->HandleWrittenProfiles(true);
+}
+
+/** Reports the outcome of the writes and deletions that the writer has finished, and updates
+ the profile index for the profiles whose files have been written. Files that
+ were not written because another launcher had changed them are merged with
+ its changes and queued again.
+ EVT_PROFILE_SAVED is only generated if notify is true.
+ Returns false if any of the files could not be written. */
+bool ProMan::HandleWrittenProfiles(bool notify) {
+	std::vector<ProfileWriter::Written> written;
+	this->writer.CollectWritten(written);
+
+	bool allWritten = true;
+	for (size_t i = 0; i < written.size(); i++) {
+		const ProfileWriter::Written& file = written[i];
+		if (file.removed) {
+			this->OwnFolderChange(file.folderStampBefore, file.folderStampAfter);
+			this->FinishDeletingProfile(file);
+			continue;
+		}
+		if (file.conflict) {
+			wxLogDebug(wxT_2("'%s' not written, as %s"),
+				file.name.c_str(), file.error.c_str());
+		} else if (!file.success) {
+			allWritten = false;
+			wxLogError(_("Unable to save %s: %s"),
+				file.filePath.c_str(), file.error.c_str());
+		} else {
+			wxLogDebug(wxT_2("'%s' written to '%s'"),
+				file.name.c_str(), file.filePath.c_str());
+		}
+		this->OwnFolderChange(file.folderStampBefore, file.folderStampAfter);
+		if (file.name.IsEmpty()) {
+			// the global profile, the profile index or the news cache
+			if (file.filePath == ProfileIndex::GetIndexFile().GetFullPath()) {
+				if (!file.success) {
+					this->profileIndex.MarkUnsaved();
+				}
+			} else if (file.filePath == NewsCache::GetCacheFile().GetFullPath()) {
+				if (!file.success) {
+					this->newsCache.MarkUnsaved();
+				}
+			} else if (file.conflict && this->globalProfile != NULL) {
+				this->MergeGlobalProfile();
+				this->SaveGlobalProfile();
+			} else if (file.success && !file.stat.filePath.IsEmpty()) {
+				this->globalFileStat = file.stat;
+			}
+			continue;
+		}
+
+		// the profile may have been deleted since it was saved, and exports have its name too
+		ProfileFileMap::const_iterator it = this->profileFiles.find(file.name);
+		const bool isProfileFile = it != this->profileFiles.end() && it->second == file.filePath;
+		if (isProfileFile) {
+			ProfileJournal entries;
+			this->FinishPendingSaves(file, entries);
+			if (file.conflict) {
+				this->SaveProfileAgain(file.name, entries, file.quiet);
+				continue;
+			}
+		}
+		if (file.success) {
+			if (isProfileFile && !file.stat.filePath.IsEmpty()) {
+				this->profileIndex.Put(file.name, file.stat);
+			} else if (isProfileFile) {
+				this->profileIndex.Put(file.name, file.filePath);
+			}
+			if (!file.quiet) {
+				wxLogStatus(_("Profile '%s' saved"), file.name.c_str());
+			}
+		}
+		if (notify) {
+			this->GenerateProfileSavedEvent(file.name, file.success);
+		}
+	}
+	return allWritten;
+}
+
+/** How many times saves that another launcher got in the way of are tried
+ again while waiting for the writer. */
+const int PROFILE_SAVE_ATTEMPTS = 3;
+
+/** Waits until everything that has been queued for saving is written, and
+ handles the outcomes, including writing again the files that another launcher
+ had changed. Returns false if any of the files could not be written. */
+bool ProMan::FlushWriter(bool notify) {
+	bool allWritten = true;
+	for (int attempt = 0; attempt < PROFILE_SAVE_ATTEMPTS && !this->writer.IsIdle(); attempt++) {
+		this->writer.Flush();
+		allWritten = this->HandleWrittenProfiles(notify) && allWritten;
+	}
+	if (!this->writer.IsIdle()) {
+		wxLogWarning(_("Other launchers kept changing the profiles while they were being saved, some changes may not have been saved"));
+		return false;
+	}
+	return allWritten;
+}
+
+/** Writes everything that has been queued for saving, then the profile index.
+ Returns false if any of the files could not be written. */
+bool ProMan::FlushToDisk() {
+	const bool allWritten = this->FlushWriter(true);
+	this->profileIndex.Save(this->writer);
+	return this->FlushWriter(true) && allWritten;
+}
+
+/** Remembers that the entry at key of the global profile has been written,
+ so that MergeGlobalProfile() keeps the value. */
+void ProMan::GlobalChanged(const wxString& key) {
+	InvalidateSlot(this->globalSlots, this->globalSlotIds, key);
+	if (this->changedGlobalEntries.Index(key) == wxNOT_FOUND) {
+		this->changedGlobalEntries.Add(key);
+	}
+}
+
+/** If another launcher has saved the global profile since it was loaded,
+ loads it again with the entries that this launcher has written put back. */
+void ProMan::MergeGlobalProfile() {
+	if (this->globalFileStat.filePath.IsEmpty() || this->globalFileStat.IsUpToDate()
+		|| !wxFileName::FileExists(this->globalFileStat.filePath)) {
+		return;
+	}
+	wxLogInfo(wxT_2("The global profile was saved by another launcher, merging with it"));
+
+	// the stat is taken first, so that a change made while reading is not missed
+	this->globalFileStat.ReadFileStat(this->globalFileStat.filePath);
+	wxFileConfig* merged = LoadProfileFromFile(this->globalFileStat.filePath);
+	for (size_t i = 0; i < this->changedGlobalEntries.GetCount(); i++) {
+		const wxString& key = this->changedGlobalEntries[i];
+		WriteEntry(*merged, key, ReadEntry(*this->globalProfile, key));
+	}
+	delete this->globalProfile;
+	this->globalProfile = merged;
+	InvalidateSlots(this->globalSlots, GLOBAL_KEY_COUNT);
+}
+
+/** Returns true if the profile file at filePath has changed since the profile
+ index last saw it, which, while the writer is idle, means another launcher
+ has written it. */
+bool ProMan::HasFileChanged(const wxString& filePath) const {
+	const ProfileIndexEntries& entries = this->profileIndex.GetEntries();
+	ProfileIndexEntries::const_iterator it = entries.find(filePath);
+	return it != entries.end() && !it->second.IsUpToDate();
+}
+
+/** Looks for changes that other launchers have made to the profile folder.
+ Only the files of the profiles that have been loaded are checked; the others
+ are read when they are first used anyway. The whole folder is only looked at
+ when files have been added, removed or replaced in it other than by this
+ launcher, whose own changes are recorded through OwnFolderChange(). */
+void ProMan::OnReloadTimer(wxTimerEvent& WXUNUSED(event)) {
+	if (!this->writer.IsIdle()) {
+		return; // this launcher's own writes would look like another's
+	}
+
+	wxArrayString changed;
+	for (ProfileMap::const_iterator it = this->profiles.begin(); it != this->profiles.end(); ++it) {
+		ProfileFileMap::const_iterator file = this->profileFiles.find(it->first);
+		if (it->second != NULL && file != this->profileFiles.end()
+			&& this->HasFileChanged(file->second)) {
+			changed.Add(it->first);
+		}
+	}
+	for (size_t i = 0; i < changed.GetCount(); i++) {
+		this->ReloadProfile(changed[i]);
+	}
+
+	const wxString folderStamp(GetProfileFolderStamp());
+	if (!changed.IsEmpty() || folderStamp != this->profileFolderStamp) {
+		this->profileFolderStamp = folderStamp;
+		this->RefreshProfileList();
+	}
+}
+
+/** Records that this launcher has changed the profile folder, given the folder's
+ stamps from right before and after the change, so that OnReloadTimer() does not
+ take the change for another launcher's. If the folder had already changed
+ before, the change is left for OnReloadTimer() to find. */
+void ProMan::OwnFolderChange(const wxString& stampBefore, const wxString& stampAfter) {
+	if (stampBefore == this->profileFolderStamp) {
+		this->profileFolderStamp = stampAfter;
+	}
+}
+
+/** Discards the loaded copy of a profile whose file another launcher has changed,
+ so that it is read again when it is next used. The current profile is reloaded now. */
+void ProMan::ReloadProfile(const wxString& name) {
+	if (name == this->currentProfileName) {
+		this->ReloadCurrentProfile();
+		return;
+	}
+	ProfileMap::iterator it = this->profiles.find(name);
+	if (it != this->profiles.end() && it->second != NULL) {
+		wxLogDebug(wxT_2("Profile '%s' was changed by another launcher, unloading it"),
+			name.c_str());
+		delete it->second;
+		it->second = NULL;
+	}
+}
+
+/** Reads the current profile again after another launcher has changed its file.
+ Entries with unsaved changes keep their values over the ones in the file,
+ and stay unsaved changes. */
+void ProMan::ReloadCurrentProfile() {
+	ProfileFileMap::const_iterator file = this->profileFiles.find(this->currentProfileName);
+	wxCHECK_RET(file != this->profileFiles.end(),
+		wxString::Format(wxT_2("No file is known for profile '%s'"), this->currentProfileName.c_str()));
+	if (!wxFileName::FileExists(file->second)) {
+		wxLogWarning(_("The file of profile '%s' was removed by another launcher. It will be written again when the profile is saved."),
+			this->currentProfileName.c_str());
+		return;
+	}
+	wxLogInfo(wxT_2("Profile '%s' was changed by another launcher, reloading it"),
+		this->currentProfileName.c_str());
+
+	// the stat is taken first, so that a change made while reading is not missed
+	ProfileIndexEntry stat;
+	if (stat.ReadFileStat(file->second)) {
+		this->profileIndex.Put(this->currentProfileName, stat);
+	}
+	wxFFileInputStream instream(file->second);
+	wxFileConfig* reloaded = new wxFileConfig(instream);
+	ProfileJournal reloadedJournal;
+	for (ProfileJournal::const_iterator it = this->journal.begin();
+		 it != this->journal.end(); ++it) {
+		const EntryState current(this->ReadCurrentEntry(it->first));
+		const EntryState saved(ReadEntry(*reloaded, it->first));
+		WriteEntry(*reloaded, it->first, current);
+		if (!(current == saved)) {
+			reloadedJournal[it->first] = saved;
+		}
+	}
+
+	// the unsaved changes were kept above, so their steps stay
+	this->DropEditsChangedIn(*reloaded);
+
+	wxFileConfig::Set(reloaded);
+	delete this->currentProfile;
+	this->currentProfile = reloaded;
+	this->profiles[this->currentProfileName] = reloaded;
+	this->journal.swap(reloadedJournal);
+	this->profileGeneration++;
+	InvalidateSlots(this->profileSlots, PROFILE_KEY_COUNT);
+	this->GenerateCurrentProfileChangedEvent();
+}
+
+/** Brings the list of profiles up to date with the profile folder, after other
+ launchers have added, removed or renamed profiles. Through the profile index,
+ only the files that have changed are parsed. */
+void ProMan::RefreshProfileList() {
+	this->profileIndex.Refresh();
+
+	ProfileFileMap found;
+	const ProfileIndexEntries& entries = this->profileIndex.GetEntries();
+	for (ProfileIndexEntries::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+		found[it->second.name] = it->first;
+	}
+
+	// the current profile stays, even if its file is gone, as it is written again when saved
+	wxArrayString removed;
+	for (ProfileFileMap::const_iterator it = this->profileFiles.begin();
+		 it != this->profileFiles.end(); ++it) {
+		ProfileFileMap::const_iterator now = found.find(it->first);
+		if ((now == found.end() || now->second != it->second)
+			&& it->first != this->currentProfileName) {
+			removed.Add(it->first);
+		}
+	}
+	for (size_t i = 0; i < removed.GetCount(); i++) {
+		wxLogInfo(wxT_2("Profile '%s' was removed by another launcher"), removed[i].c_str());
+		ProfileMap::iterator profile = this->profiles.find(removed[i]);
+		delete profile->second;
+		this->profiles.erase(profile);
+		this->profileFiles.erase(removed[i]);
+	}
+
+	ProfileFileMap::const_iterator current = this->profileFiles.find(this->currentProfileName);
+	const wxString currentFile(current != this->profileFiles.end() ? current->second : wxString());
+	size_t added = 0;
+	for (ProfileFileMap::const_iterator it = found.begin(); it != found.end(); ++it) {
+		if (this->profileFiles.find(it->first) == this->profileFiles.end()
+			&& it->second != currentFile) {
+			wxLogInfo(wxT_2("Profile '%s' was added by another launcher"), it->first.c_str());
+			this->profiles[it->first] = NULL;
+			this->profileFiles[it->first] = it->second;
+			added++;
+		}
+	}
+
+	if (added > 0 || !removed.IsEmpty()) {
+		this->GenerateChangeEvent();
+	}
+}
+
 /** Generates a filename for a new profile, where the name is of the form
  pro#####.ini with ##### being the least 5-digit number not yet taken. */
 wxString ProMan::GenerateNewProfileFileName() {
@@ -427,7 +970,7 @@ wxString ProMan::GenerateNewProfileFileName() {
 // global profile access functions
 
 /** Tests whether the key strName is in the global profile. */
-bool ProMan::GlobalExists(wxString& strName) const {
+bool ProMan::GlobalExists(const wxString& strName) const {
 	if (this->globalProfile == NULL) {
 		wxLogWarning(wxT_2("attempt to check existence of key %s in null global profile"),
 			strName.c_str());
@@ -476,7 +1019,7 @@ bool ProMan::GlobalRead(const wxString& key, bool* b, bool defaultVal, bool writ
 		if (!readSuccess && writeBackIfAbsent) {
 			wxLogDebug(wxT_2("entry %s in global profile is absent. writing default value %s to it."),
 				key.c_str(), defaultVal ? wxT_2("true") : wxT_2("false"));
-			this->globalProfile->Write(key, defaultVal);
+			this->GlobalWrite(key, defaultVal);
 		}
 		return readSuccess;
 	}
@@ -510,7 +1053,7 @@ bool ProMan::GlobalRead(const wxString& key, wxString* str, const wxString& defa
 		if (!readSuccess && writeBackIfAbsent) {
 			wxLogDebug(wxT_2("entry %s in global profile is absent. writing default value %s to it."),
 				key.c_str(), defaultVal.c_str());
-			this->globalProfile->Write(key, defaultVal);
+			this->GlobalWrite(key, defaultVal);
 		}
 		return readSuccess;
 	}
@@ -532,7 +1075,7 @@ bool ProMan::GlobalRead(const wxString& key, long* l, long defaultVal, bool writ
 		if (!readSuccess && writeBackIfAbsent) {
 			wxLogDebug(wxT_2("entry %s in global profile is absent. writing default value %ld to it."),
 				key.c_str(), defaultVal);
-			this->globalProfile->Write(key, defaultVal);
+			this->GlobalWrite(key, defaultVal);
 		}
 		return readSuccess;
 	}
@@ -546,6 +1089,7 @@ bool ProMan::GlobalWrite(const wxString& key, const wxString& value) {
 			value.c_str(), key.c_str());
 		return false;
 	} else {
+		this->GlobalChanged(key);
 		return this->globalProfile->Write(key, value);
 	}
 }
@@ -558,6 +1102,7 @@ bool ProMan::GlobalWrite(const wxString& key, const wxChar* value) {
 					 value, key.c_str());
 		return false;
 	} else {
+		this->GlobalChanged(key);
 		return this->globalProfile->Write(key, value);
 	}
 }
@@ -570,6 +1115,7 @@ bool ProMan::GlobalWrite(const wxString& key, long value) {
 			value, key.c_str());
 		return false;
 	} else {
+		this->GlobalChanged(key);
 		return this->globalProfile->Write(key, value);
 	}
 }
@@ -582,6 +1128,7 @@ bool ProMan::GlobalWrite(const wxString& key, bool value) {
 			value ? wxT_2("true") : wxT_2("false"), key.c_str());
 		return false;
 	} else {
+		this->GlobalChanged(key);
 		return this->globalProfile->Write(key, value);
 	}
 }
@@ -638,7 +1185,9 @@ bool ProMan::ProfileRead(const wxString& key, bool* b, bool defaultVal, bool wri
 		if (!readSuccess && writeBackIfAbsent) {
 			wxLogDebug(wxT_2("entry %s in current profile is absent. writing default value %s to it."),
 				key.c_str(), defaultVal ? wxT_2("true") : wxT_2("false"));
+			const EntryState before(this->ReadCurrentEntry(key));
 			this->currentProfile->Write(key, defaultVal);
+			this->JournalChange(key, before);
 		}
 		return readSuccess;
 	}
@@ -672,7 +1221,9 @@ bool ProMan::ProfileRead(const wxString& key, wxString* str, const wxString& def
 		if (!readSuccess && writeBackIfAbsent) {
 			wxLogDebug(wxT_2("entry %s in current profile is absent. writing default value %s to it."),
 				key.c_str(), defaultVal.c_str());
+			const EntryState before(this->ReadCurrentEntry(key));
 			this->currentProfile->Write(key, defaultVal);
+			this->JournalChange(key, before);
 		}
 		return readSuccess;
 	}
@@ -706,7 +1257,9 @@ bool ProMan::ProfileRead(const wxString& key, long* l, long defaultVal, bool wri
 		if (!readSuccess && writeBackIfAbsent) {
 			wxLogDebug(wxT_2("entry %s in current profile is absent. writing default value %ld to it."),
 				key.c_str(), defaultVal);
+			const EntryState before(this->ReadCurrentEntry(key));
 			this->currentProfile->Write(key, defaultVal);
+			this->JournalChange(key, before);
 		}
 		return readSuccess;
 	}
@@ -730,7 +1283,10 @@ bool ProMan::ProfileWrite(const wxString& key, const wxString& value) {
 					oldValue.c_str(), value.c_str(), key.c_str());
 			}
 		}
-		return this->currentProfile->Write(key, value);
+		const EntryState before(this->ReadCurrentEntry(key));
+		const bool written = this->currentProfile->Write(key, value);
+		this->JournalChange(key, before);
+		return written;
 	}
 }
 
@@ -752,7 +1308,10 @@ bool ProMan::ProfileWrite(const wxString& key, const wxChar* value) {
 						   oldValue.c_str(), value, key.c_str());
 			}
 		}
-		return this->currentProfile->Write(key, value);
+		const EntryState before(this->ReadCurrentEntry(key));
+		const bool written = this->currentProfile->Write(key, value);
+		this->JournalChange(key, before);
+		return written;
 	}
 }
 
@@ -774,7 +1333,10 @@ bool ProMan::ProfileWrite(const wxString& key, long value) {
 					oldValue, value, key.c_str());
 			}
 		}
-		return this->currentProfile->Write(key, value);
+		const EntryState before(this->ReadCurrentEntry(key));
+		const bool written = this->currentProfile->Write(key, value);
+		this->JournalChange(key, before);
+		return written;
 	}
 }
 
@@ -799,7 +1361,10 @@ bool ProMan::ProfileWrite(const wxString& key, bool value) {
 			}
 		}
 		
-		return this->currentProfile->Write(key, value);
+		const EntryState before(this->ReadCurrentEntry(key));
+		const bool written = this->currentProfile->Write(key, value);
+		this->JournalChange(key, before);
+		return written;
 	}
 }
 
@@ -812,31 +1377,202 @@ bool ProMan::ProfileDeleteEntry(const wxString& key, bool bDeleteGroupIfEmpty) {
 			key.c_str());
 		return false;
 	} else {
-		if (this-currentProfile->Exists(key)) {
+		if (this->currentProfile->Exists(key)) {
 			wxLogDebug(wxT_2("deleting key %s in profile"),
 				key.c_str());
 		}
-		return this->currentProfile->DeleteEntry(key, bDeleteGroupIfEmpty);
+		const EntryState before(this->ReadCurrentEntry(key));
+		const bool deleted = this->currentProfile->DeleteEntry(key, bDeleteGroupIfEmpty);
+		this->JournalChange(key, before);
+		return deleted;
 	}
 }
 
-const NewsData* ProMan::NewsRead(const wxString& newsSource) const {
-	wxCHECK_MSG(!newsSource.IsEmpty(), NULL, wxT_2("NewsRead: newsSource is empty!"));
-	
-	NewsMap::const_iterator it = newsMap.find(newsSource);
-	
-	if (it == newsMap.end()) {
-		return NULL;
-	} else {
-		return &(it->second);
+// typed access functions
+
+/** Marks every slot as unread, so that the next read of each key goes to the config file. */
+void ProMan::InvalidateSlots(KeySlot* slots, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		slots[i].state = KeySlot::UNREAD;
+	}
+}
+
+/** Marks the slot of the key at path as unread, if a typed key has that path. */
+void ProMan::InvalidateSlot(KeySlot* slots, const SlotIds& ids, const wxString& path) {
+	SlotIds::const_iterator it = ids.find(path);
+	if (it != ids.end()) {
+		slots[it->second].state = KeySlot::UNREAD;
+	}
+}
+
+/** Returns the slot with id. A slot that is about to be read from the config
+ file has its path remembered, so that InvalidateSlot() can find it. */
+ProMan::KeySlot& ProMan::GetSlot(KeySlot* slots, SlotIds& ids, size_t id, const wxString& path) {
+	KeySlot& slot = slots[id];
+	if (slot.state == KeySlot::UNREAD) {
+		ids[path] = id;
 	}
+	return slot;
+}
+
+/** Reads the value at path from its slot, reading it from config first
+ if the slot has been invalidated since. Returns true if config has a valid value. */
+template <typename T>
+bool ProMan::ReadSlot(const wxFileConfig& config, KeySlot& slot, const wxString& path, T* value) {
+	T& slotValue = SlotValue(slot, value);
+	if (slot.state == KeySlot::UNREAD) {
+		slot.state = config.Read(path, &slotValue) ? KeySlot::PRESENT : KeySlot::ABSENT;
+	}
+	if (slot.state == KeySlot::ABSENT) {
+		return false;
+	}
+	*value = slotValue;
+	return true;
+}
+
+/** Reads a value from the global profile through its slot. Absent entries are
+ handed to the untyped GlobalRead() only when the default has to be written back,
+ or to log that there is no global profile. */
+template <typename T>
+bool ProMan::ReadGlobalSlot(const GlobalKey<T>& key, T* value, const T& defaultVal, bool writeBackIfAbsent) {
+	if (this->globalProfile != NULL) {
+		if (ReadSlot(*this->globalProfile, GetSlot(this->globalSlots, this->globalSlotIds, key.GetId(), key.GetPath()), key.GetPath(), value)) {
+			return true;
+		} else if (!writeBackIfAbsent) {
+			*value = defaultVal;
+			return false;
+		}
+	}
+	return this->GlobalRead(key.GetPath(), value, defaultVal, writeBackIfAbsent);
+}
+
+/** Reads a value from the current profile through its slot. Absent entries are
+ handed to the untyped ProfileRead() only when the default has to be written back,
+ or to log that there is no current profile. */
+template <typename T>
+bool ProMan::ReadProfileSlot(const ProfileKey<T>& key, T* value, const T& defaultVal, bool writeBackIfAbsent) {
+	if (this->currentProfile != NULL) {
+		if (ReadSlot(*this->currentProfile, GetSlot(this->profileSlots, this->profileSlotIds, key.GetId(), key.GetPath()), key.GetPath(), value)) {
+			return true;
+		} else if (!writeBackIfAbsent) {
+			*value = defaultVal;
+			return false;
+		}
+	}
+	return this->ProfileRead(key.GetPath(), value, defaultVal, writeBackIfAbsent);
+}
+
+bool ProMan::GlobalRead(const GlobalKey<bool>& key, bool* b) const {
+	if (this->globalProfile == NULL) {
+		return this->GlobalRead(key.GetPath(), b);
+	}
+	return ReadSlot(*this->globalProfile, GetSlot(this->globalSlots, this->globalSlotIds, key.GetId(), key.GetPath()), key.GetPath(), b);
+}
+
+bool ProMan::GlobalRead(const GlobalKey<bool>& key, bool* b, bool defaultVal, bool writeBackIfAbsent) {
+	return this->ReadGlobalSlot(key, b, defaultVal, writeBackIfAbsent);
+}
+
+bool ProMan::GlobalRead(const GlobalKey<wxString>& key, wxString* str) const {
+	if (this->globalProfile == NULL) {
+		return this->GlobalRead(key.GetPath(), str);
+	}
+	return ReadSlot(*this->globalProfile, GetSlot(this->globalSlots, this->globalSlotIds, key.GetId(), key.GetPath()), key.GetPath(), str);
+}
+
+bool ProMan::GlobalRead(const GlobalKey<wxString>& key, wxString* str, const wxString& defaultVal, bool writeBackIfAbsent) {
+	return this->ReadGlobalSlot(key, str, defaultVal, writeBackIfAbsent);
+}
+
+bool ProMan::GlobalRead(const GlobalKey<long>& key, long* l) const {
+	if (this->globalProfile == NULL) {
+		wxLogWarning(
+			wxT_2("attempt to read long for key %s from null global profile"),
+			key.GetPath().c_str());
+		return false;
+	}
+	return ReadSlot(*this->globalProfile, GetSlot(this->globalSlots, this->globalSlotIds, key.GetId(), key.GetPath()), key.GetPath(), l);
+}
+
+bool ProMan::GlobalRead(const GlobalKey<long>& key, long* l, long defaultVal, bool writeBackIfAbsent) {
+	return this->ReadGlobalSlot(key, l, defaultVal, writeBackIfAbsent);
+}
+
+// the typed writes go through the untyped ones, which invalidate the slots
+
+bool ProMan::GlobalWrite(const GlobalKey<wxString>& key, const wxString& value) {
+	return this->GlobalWrite(key.GetPath(), value);
+}
+
+bool ProMan::GlobalWrite(const GlobalKey<wxString>& key, const wxChar* value) {
+	return this->GlobalWrite(key.GetPath(), value);
+}
+
+bool ProMan::GlobalWrite(const GlobalKey<long>& key, long value) {
+	return this->GlobalWrite(key.GetPath(), value);
+}
+
+bool ProMan::GlobalWrite(const GlobalKey<bool>& key, bool value) {
+	return this->GlobalWrite(key.GetPath(), value);
+}
+
+bool ProMan::ProfileRead(const ProfileKey<bool>& key, bool* b) const {
+	if (this->currentProfile == NULL) {
+		return this->ProfileRead(key.GetPath(), b);
+	}
+	return ReadSlot(*this->currentProfile, GetSlot(this->profileSlots, this->profileSlotIds, key.GetId(), key.GetPath()), key.GetPath(), b);
+}
+
+bool ProMan::ProfileRead(const ProfileKey<bool>& key, bool* b, bool defaultVal, bool writeBackIfAbsent) {
+	return this->ReadProfileSlot(key, b, defaultVal, writeBackIfAbsent);
+}
+
+bool ProMan::ProfileRead(const ProfileKey<wxString>& key, wxString* str) const {
+	if (this->currentProfile == NULL) {
+		return this->ProfileRead(key.GetPath(), str);
+	}
+	return ReadSlot(*this->currentProfile, GetSlot(this->profileSlots, this->profileSlotIds, key.GetId(), key.GetPath()), key.GetPath(), str);
+}
+
+bool ProMan::ProfileRead(const ProfileKey<wxString>& key, wxString* str, const wxString& defaultVal, bool writeBackIfAbsent) {
+	return this->ReadProfileSlot(key, str, defaultVal, writeBackIfAbsent);
+}
+
+bool ProMan::ProfileRead(const ProfileKey<long>& key, long* l) const {
+	if (this->currentProfile == NULL) {
+		return this->ProfileRead(key.GetPath(), l);
+	}
+	return ReadSlot(*this->currentProfile, GetSlot(this->profileSlots, this->profileSlotIds, key.GetId(), key.GetPath()), key.GetPath(), l);
+}
+
+bool ProMan::ProfileRead(const ProfileKey<long>& key, long* l, long defaultVal, bool writeBackIfAbsent) {
+	return this->ReadProfileSlot(key, l, defaultVal, writeBackIfAbsent);
+}
+
+// the typed writes go through the untyped ones, whose journal entries invalidate the slots
+
+bool ProMan::ProfileWrite(const ProfileKey<wxString>& key, const wxString& value) {
+	return this->ProfileWrite(key.GetPath(), value);
+}
+
+bool ProMan::ProfileWrite(const ProfileKey<wxString>& key, const wxChar* value) {
+	return this->ProfileWrite(key.GetPath(), value);
+}
+
+bool ProMan::ProfileWrite(const ProfileKey<long>& key, long value) {
+	return this->ProfileWrite(key.GetPath(), value);
+}
+
+bool ProMan::ProfileWrite(const ProfileKey<bool>& key, bool value) {
+	return this->ProfileWrite(key.GetPath(), value);
+}
+
+const NewsData* ProMan::NewsRead(const wxString& newsSource) const {
+	return this->newsCache.Read(newsSource);
 }
 
 void ProMan::NewsWrite(const wxString& newsSource, const NewsData& data) {
-	wxCHECK_RET(!newsSource.IsEmpty(), wxT_2("NewsWrite: newsSource is empty!"));
-	wxCHECK_RET(data.IsValid(), wxT_2("NewsWrite: data is not valid!"));
-	
-	newsMap[newsSource] = data;
+	this->newsCache.Write(newsSource, data);
 }
 
 /** Returns the text to use in the "save changes?" dialog's caption (window title) */
@@ -847,8 +1583,8 @@ const wxString ProMan::GetSaveDialogCaptionText(ProMan::SaveDialogContext contex
 	switch (context) {
 		case ON_PROFILE_SWITCH:
 #if PROFILE_DEBUGGING
-			wxLogDebug(wxT_2("contents of private copy at save prompt on profile switch:"));
-			LogConfigContents(*ProMan::proman->privateCopy);
+			wxLogDebug(wxT_2("unsaved changes at save prompt on profile switch:"));
+			ProMan::proman->LogUnsavedChanges();
 			wxLogDebug(wxT_2("contents of current profile at save prompt on profile switch:"));
 			LogConfigContents(*ProMan::proman->currentProfile);
 #endif
@@ -857,8 +1593,8 @@ const wxString ProMan::GetSaveDialogCaptionText(ProMan::SaveDialogContext contex
 
 		case ON_PROFILE_CREATE:
 #if PROFILE_DEBUGGING
-			wxLogDebug(wxT_2("contents of private copy at save prompt on profile create:"));
-			LogConfigContents(*ProMan::proman->privateCopy);
+			wxLogDebug(wxT_2("unsaved changes at save prompt on profile create:"));
+			ProMan::proman->LogUnsavedChanges();
 			wxLogDebug(wxT_2("contents of current profile at save prompt on profile create:"));
 			LogConfigContents(*ProMan::proman->currentProfile);
 #endif
@@ -867,8 +1603,8 @@ const wxString ProMan::GetSaveDialogCaptionText(ProMan::SaveDialogContext contex
 
 		case ON_EXIT:
 #if PROFILE_DEBUGGING
-			wxLogDebug(wxT_2("contents of private copy at save prompt on exit:"));
-			LogConfigContents(*ProMan::proman->privateCopy);
+			wxLogDebug(wxT_2("unsaved changes at save prompt on exit:"));
+			ProMan::proman->LogUnsavedChanges();
 			wxLogDebug(wxT_2("contents of current profile at save prompt on exit:"));
 			LogConfigContents(*ProMan::proman->currentProfile);
 #endif
@@ -931,26 +1667,41 @@ wxArrayString ProMan::GetAllProfileNames() {
 	return out;
 }
 
-void SaveProfileToDisk(wxFileConfig* toSave, const wxString& name)
+/** Queues the profile to be written to disk. The writer takes its contents now,
+ and the outcome is reported once the file has been written. If checkFile is
+ true, the file is not written if it has changed since the profile index last saw it.
+ Returns the writer's id for the save, or 0 if it could not be queued. */
+unsigned long ProMan::SaveProfileToDisk(wxFileConfig* toSave, const wxString& name, bool quiet,
+	bool checkFile)
 {
 	wxString profileFilename;
-	if ( !toSave->Read(PRO_CFG_MAIN_FILENAME, &profileFilename) ) {
+	if ( !toSave->Read(PRO_CFG_MAIN_FILENAME.GetPath(), &profileFilename) ) {
 		wxLogError(wxT_2("Profile '%s' does not have a file name. Cannot save it."),
 			name.c_str());
 		// FIXME maybe make a new file and save the current profile there
+		return 0;
 	} else {
 		wxFileName file;
 		file.Assign(GetProfileStorageFolder(), profileFilename);
 		wxASSERT( file.IsOk() );
-		wxFFileOutputStream configOutput(file.GetFullPath());
-		toSave->Save(configOutput);
-		wxLogDebug(wxT_2("Profile '%s' saved to '%s'"),
+		const ProfileIndexEntry* expected = NULL;
+		if (checkFile) {
+			const ProfileIndexEntries& entries = this->profileIndex.GetEntries();
+			ProfileIndexEntries::const_iterator it = entries.find(file.GetFullPath());
+			if (it != entries.end()) {
+				expected = &it->second;
+			}
+		}
+		const unsigned long id = this->writer.Save(*toSave, file.GetFullPath(), name, quiet, expected);
+		wxLogDebug(wxT_2("Profile '%s' queued for saving to '%s'"),
 			name.c_str(), file.GetFullPath().c_str());
+		return id;
 	}
 }
 
 /** Saves the current profile to disk, regardless of whether it has unsaved changes.
- Does not affect the global profile or any other profile. */
+ The file is written in the background; the status bar says so when it is done,
+ unless quiet is true. Does not affect the global profile or any other profile. */
 void ProMan::SaveCurrentProfile(bool quiet) {
 	wxConfigBase* configbase = wxFileConfig::Get(false);
 	if ( configbase == NULL ) {
@@ -959,26 +1710,210 @@ void ProMan::SaveCurrentProfile(bool quiet) {
 	}
 	wxFileConfig* config = dynamic_cast<wxFileConfig*>(configbase);
 	if ( config != NULL ) {
-		SaveProfileToDisk(config, this->currentProfileName.c_str());
-		this->ResetPrivateCopy();
-		if (!quiet) {
-			wxLogStatus(_("Profile '%s' saved"), this->currentProfileName.c_str());				
+		const wxArrayString changes(this->GetUnsavedChanges());
+		for (size_t i = 0; i < changes.GetCount(); i++) {
+			wxLogDebug(wxT_2(" saving changed entry %s"), changes[i].c_str());
 		}
-		wxLogDebug(wxT_2("Current config%s saved."),
+		// the journal is only emptied once the file has been written,
+		// so a save that fails leaves the changes unsaved.
+		// The entries of earlier pending saves are taken again, in case
+		// they have gone back to the state they had before those saves
+		ProfileJournal entries;
+		for (ProfileJournal::const_iterator it = this->journal.begin();
+			 it != this->journal.end(); ++it) {
+			entries[it->first] = this->ReadCurrentEntry(it->first);
+		}
+		for (size_t i = 0; i < this->pendingSaves.size(); i++) {
+			if (this->pendingSaves[i].name != this->currentProfileName) {
+				continue;
+			}
+			const ProfileJournal& earlier = this->pendingSaves[i].entries;
+			for (ProfileJournal::const_iterator it = earlier.begin(); it != earlier.end(); ++it) {
+				entries[it->first] = this->ReadCurrentEntry(it->first);
+			}
+		}
+		this->SaveProfileChanges(config, this->currentProfileName, entries, quiet);
+		wxLogDebug(wxT_2("Current config%s queued for saving."),
 			quiet ? wxT_2(" quietly") : wxT_2(""));
 	} else {
 		wxLogError(wxT_2("Configbase is not a wxFileConfig."));
 	}
 }
 
-/** Reverts any unsaved changes to the current profile. */
+/** Reverts any unsaved changes to the current profile, by restoring
+ the saved state of each entry in the journal and the pending saves. */
 void ProMan::RevertCurrentProfile() {
-	ClearConfig(*(this->currentProfile));
-	CopyConfig(*(this->privateCopy), *(this->currentProfile));
+	wxCHECK_RET(this->currentProfile != NULL, wxT_2("RevertCurrentProfile called with null current profile!"));
+	const wxArrayString changes(this->GetUnsavedChanges());
+	if (changes.IsEmpty()) {
+		return;
+	}
+	for (size_t i = 0; i < changes.GetCount(); i++) {
+		WriteEntry(*this->currentProfile, changes[i], this->SavedEntry(changes[i]));
+	}
+	// entries that a pending save changes stay in the journal until it is written
+	ProfileJournal::iterator it = this->journal.begin();
+	while (it != this->journal.end()) {
+		ProfileJournal::iterator next = it;
+		++next;
+		if (this->ReadCurrentEntry(it->first) == it->second) {
+			this->journal.erase(it);
+		}
+		it = next;
+	}
+	this->ClearUndoHistory();
+	this->profileGeneration++;
+	InvalidateSlots(this->profileSlots, PROFILE_KEY_COUNT);
 }
 
+/** Returns true if the current profile has changed since it was last saved.
+ Only looks at the journal of changes and the pending saves,
+ so it is cheap enough to call often. */
 bool ProMan::HasUnsavedChanges() {
-	return !AreConfigsEqual(*(this->currentProfile), *(this->privateCopy));
+	if (!this->HasPendingSaves(this->currentProfileName)) {
+		return !this->journal.empty();
+	}
+	return !this->GetUnsavedChanges().IsEmpty();
+}
+
+/** Returns the keys of the entries in the current profile
+ that have changed since it was last saved, sorted. */
+wxArrayString ProMan::GetUnsavedChanges() const {
+	wxSortedArrayString candidates;
+	for (ProfileJournal::const_iterator it = this->journal.begin();
+		 it != this->journal.end(); ++it) {
+		candidates.Add(it->first);
+	}
+	const bool hasPendingSaves = this->HasPendingSaves(this->currentProfileName);
+	for (size_t i = 0; i < this->pendingSaves.size(); i++) {
+		if (this->pendingSaves[i].name != this->currentProfileName) {
+			continue;
+		}
+		const ProfileJournal& entries = this->pendingSaves[i].entries;
+		for (ProfileJournal::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+			if (candidates.Index(it->first) == wxNOT_FOUND) {
+				candidates.Add(it->first);
+			}
+		}
+	}
+
+	wxArrayString keys;
+	for (size_t i = 0; i < candidates.GetCount(); i++) {
+		if (!hasPendingSaves
+			|| !(this->SavedEntry(candidates[i]) == this->ReadCurrentEntry(candidates[i]))) {
+			keys.Add(candidates[i]);
+		}
+	}
+	return keys;
+}
+
+/** Returns the state of the entry at key in the current profile as it was
+ last saved, counting saves that the writer has not written yet. */
+ProMan::EntryState ProMan::SavedEntry(const wxString& key) const {
+	for (size_t i = this->pendingSaves.size(); i > 0; i--) {
+		if (this->pendingSaves[i - 1].name != this->currentProfileName) {
+			continue;
+		}
+		const ProfileJournal& entries = this->pendingSaves[i - 1].entries;
+		ProfileJournal::const_iterator it = entries.find(key);
+		if (it != entries.end()) {
+			return it->second;
+		}
+	}
+	ProfileJournal::const_iterator it = this->journal.find(key);
+	return it != this->journal.end() ? it->second : this->ReadCurrentEntry(key);
+}
+
+/** Returns true if there are saves of the named profile that the writer has not written yet. */
+bool ProMan::HasPendingSaves(const wxString& name) const {
+	for (size_t i = 0; i < this->pendingSaves.size(); i++) {
+		if (this->pendingSaves[i].name == name) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/** Queues a save of the named profile, whose changed entries and the states
+ they are saved in are entries. The file is only written if another launcher
+ has not changed it since it was read; if it has, the save is tried again
+ with the entries written over the other launcher's changes. */
+void ProMan::SaveProfileChanges(wxFileConfig* config, const wxString& name,
+		const ProfileJournal& entries, bool quiet) {
+	const unsigned long id = this->SaveProfileToDisk(config, name, quiet, true);
+	if (id != 0) {
+		PendingSave pending;
+		pending.id = id;
+		pending.name = name;
+		pending.entries = entries;
+		this->pendingSaves.push_back(pending);
+	}
+}
+
+/** Removes the pending saves that a write of a profile's file covers, and puts
+ their entries in entries. If the write succeeded and the profile is the current
+ one, the states that the saves wrote become the saved states in the journal;
+ otherwise the journal still has the states that are on the disk. */
+void ProMan::FinishPendingSaves(const ProfileWriter::Written& written, ProfileJournal& entries) {
+	std::deque<PendingSave>::iterator pending = this->pendingSaves.begin();
+	while (pending != this->pendingSaves.end()) {
+		if (pending->name != written.name || pending->id > written.id) {
+			++pending;
+			continue;
+		}
+		for (ProfileJournal::const_iterator it = pending->entries.begin();
+			 it != pending->entries.end(); ++it) {
+			entries[it->first] = it->second;
+			if (!written.success || written.name != this->currentProfileName) {
+				continue;
+			}
+			if (this->ReadCurrentEntry(it->first) == it->second) {
+				this->journal.erase(it->first);
+			} else {
+				this->journal[it->first] = it->second;
+			}
+		}
+		pending = this->pendingSaves.erase(pending);
+	}
+}
+
+/** Saves a profile again after the writer found that another launcher had
+ changed its file. The file is read again, and the entries that the saves
+ changed are written over it. */
+void ProMan::SaveProfileAgain(const wxString& name, const ProfileJournal& entries, bool quiet) {
+	wxLogInfo(wxT_2("Profile '%s' was changed by another launcher while it was being saved, merging with it"),
+		name.c_str());
+	if (name == this->currentProfileName) {
+		// the journal's entries are kept through the reload, so it needs every changed entry
+		for (ProfileJournal::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+			if (this->journal.find(it->first) == this->journal.end()) {
+				this->journal[it->first] = it->second;
+			}
+		}
+		this->ReloadCurrentProfile();
+		this->SaveCurrentProfile(quiet);
+		return;
+	}
+
+	ProfileFileMap::const_iterator file = this->profileFiles.find(name);
+	ProfileMap::iterator profile = this->profiles.find(name);
+	if (file == this->profileFiles.end() || profile == this->profiles.end()) {
+		return; // deleted since
+	}
+	// the stat is taken first, so that a change made while reading is not missed
+	ProfileIndexEntry stat;
+	if (stat.ReadFileStat(file->second)) {
+		this->profileIndex.Put(name, stat);
+	}
+	delete profile->second;
+	profile->second = NULL;
+	wxFileConfig* merged = this->GetProfile(name);
+	wxCHECK_RET(merged != NULL,
+		wxString::Format(wxT_2("Unable to open profile '%s'"), name.c_str()));
+	for (ProfileJournal::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+		WriteEntry(*merged, it->first, it->second);
+	}
+	this->SaveProfileChanges(merged, name, entries, quiet);
 }
 
 wxString ProMan::GetCurrentName() {
@@ -1003,12 +1938,19 @@ bool ProMan::SwitchTo(wxString name) {
 				this->RevertCurrentProfile();
 			}
 		}
+		wxFileConfig* profile = this->GetProfile(name);
+		wxCHECK_MSG(profile != NULL, false,
+			wxString::Format(wxT_2("Unable to open profile '%s'"), name.c_str()));
 		this->currentProfileName = name;
-		this->currentProfile = this->profiles.find(name)->second;
+		this->currentProfile = profile;
 		wxFileConfig::Set(this->currentProfile);
+		this->profileGeneration++;
+		InvalidateSlots(this->profileSlots, PROFILE_KEY_COUNT);
 		if ( !(ProMan::flags & NoUpdateLastProfile) )
-			this->globalProfile->Write(GBL_CFG_MAIN_LASTPROFILE, name);
-		this->ResetPrivateCopy();
+			this->GlobalWrite(GBL_CFG_MAIN_LASTPROFILE, name);
+		// only the current profile can have unsaved changes, so the new one matches its file
+		this->journal.clear();
+		this->ClearUndoHistory();
 //		TestConfigFunctions(*this->currentProfile); // remove after testing on all platforms
 		this->GenerateCurrentProfileChangedEvent();
 		return true;
@@ -1051,7 +1993,7 @@ bool ProMan::CreateProfile(const wxString& newProfileName, const wxFileConfig *s
 #endif
 
 		CopyConfig(*sourceConfig, *newProfileConfig, false);
-		SaveProfileToDisk(newProfileConfig, newProfileName);
+		this->SaveProfileToDisk(newProfileConfig, newProfileName, true);
 
 #if PROFILE_DEBUGGING
 		wxLogDebug(wxT_2("contents of new profile '%s' after clone:"), newProfileName.c_str());
@@ -1085,7 +2027,7 @@ bool ProMan::CreateProfile(const wxString& newProfileName, const wxString& clone
 			wxLogWarning(_("Profile to clone from '%s' does not exist!"), cloneFromProfileName.c_str());
 			return false;
 		}
-		cloneSource = this->profiles[cloneFromProfileName];
+		cloneSource = this->GetProfile(cloneFromProfileName);
 		wxCHECK_MSG( cloneSource != NULL, false,
 			wxString::Format(wxT_2("Cannot find profile '%s' from which to clone"),
 				cloneFromProfileName.c_str()) );
@@ -1094,6 +2036,23 @@ bool ProMan::CreateProfile(const wxString& newProfileName, const wxString& clone
 	return this->CreateProfile(newProfileName, cloneSource);
 }
 
+/** Queues a copy of the named profile to be written to destination.
+ Call FlushToDisk() to find out whether it was written. */
+bool ProMan::ExportProfile(const wxString& name, const wxFileName& destination) {
+	wxFileConfig* config = this->GetProfile(name);
+	if (config == NULL) {
+		wxLogWarning(_("Profile '%s' does not exist. Cannot export it."), name.c_str());
+		return false;
+	}
+	wxLogDebug(wxT_2("Exporting profile '%s' to '%s'"),
+		name.c_str(), destination.GetFullPath().c_str());
+	this->writer.Save(*config, destination.GetFullPath(), name, true);
+	return true;
+}
+
+/** Removes the named profile and queues its file to be deleted by the writer,
+ so that the UI does not wait for the profile folder lock. If the file cannot be
+ deleted, the profile is brought back and EVT_PROFILE_CHANGE is generated again. */
 bool ProMan::DeleteProfile(wxString name) {
 	wxLogDebug(wxT_2("Deleting profile: %s"), name.c_str());
 	if ( name == ProMan::DEFAULT_PROFILE_NAME ) {
@@ -1108,38 +2067,60 @@ bool ProMan::DeleteProfile(wxString name) {
 	}
 	if ( this->DoesProfileExist(name) ) {
 		wxLogDebug(wxT_2(" Profile exists"));
-		wxFileConfig* config = this->profiles[name];
-
-		wxString filename;
-		if ( !config->Read(PRO_CFG_MAIN_FILENAME, &filename) ) {
+		// the profile may not have been parsed, so its file comes from the index
+		ProfileFileMap::iterator fileIter = this->profileFiles.find(name);
+		if ( fileIter == this->profileFiles.end() ) {
 			wxLogWarning(wxT_2("Unable to get filename to delete %s"), name.c_str());
 			return false;
 		}
 
-		wxFileName file;
-		file.Assign(GetProfileStorageFolder(), filename);
-
-		if ( file.FileExists() ) {
-			wxLogDebug(wxT_2(" Backing file exists"));
-			if ( wxRemoveFile(file.GetFullPath()) ) {
-				this->profiles.erase(this->profiles.find(name));
-				delete config;
-				
-				wxLogMessage(_("Profile '%s' deleted."), name.c_str());
-				this->GenerateChangeEvent();
-				return true;
+		// replaces a save of the file that is still queued, which would bring it back
+		const wxString filePath(fileIter->second);
+		this->writer.Remove(filePath, name);
+
+		ProfileMap::iterator profileIter = this->profiles.find(name);
+		delete profileIter->second;
+		this->profiles.erase(profileIter);
+		this->profileFiles.erase(fileIter);
+		this->profileIndex.Remove(filePath);
+		std::deque<PendingSave>::iterator pending = this->pendingSaves.begin();
+		while (pending != this->pendingSaves.end()) {
+			if (pending->name == name) {
+				pending = this->pendingSaves.erase(pending);
 			} else {
-				wxLogWarning(_("Unable to delete file for profile '%s'"), name.c_str());
+				++pending;
 			}
-		} else {
-			wxLogWarning(_("Backing file (%s) for profile '%s' does not exist"), file.GetFullPath().c_str(), name.c_str());
 		}
+
+		this->GenerateChangeEvent();
+		return true;
 	} else {
 		wxLogWarning(_("Profile %s does not exist. Cannot delete."), name.c_str());
 	}
 	return false;
 }
 
+/** Reports the outcome of deleting a profile's file. If the file could not be
+ deleted, the profile is brought back, unless a profile with its name has been
+ created since. */
+void ProMan::FinishDeletingProfile(const ProfileWriter::Written& written) {
+	if (written.success) {
+		wxLogMessage(_("Profile '%s' deleted."), written.name.c_str());
+		return;
+	}
+
+	wxLogWarning(_("Unable to delete file for profile '%s': %s"),
+		written.name.c_str(), written.error.c_str());
+	if (this->DoesProfileExist(written.name)) {
+		return;
+	}
+	// parsed again when it is next used
+	this->profiles[written.name] = NULL;
+	this->profileFiles[written.name] = written.filePath;
+	this->profileIndex.Put(written.name, written.filePath);
+	this->GenerateChangeEvent();
+}
+
 // the config manipulation functions are adapted from CopyEntriesRecursive and CopyEntry
 // from http://audacity.googlecode.com/svn/audacity-src/trunk/src/Prefs.cpp SVN r11245
 /** copies the contents of one wxConfigBase to another wxConfigBase.
@@ -1411,8 +2392,8 @@ void ProMan::TestConfigFunctions(wxConfigBase& src) {
 	wxLogDebug(_T("are configs src and dest equal? %s"), AreConfigsEqual(*dest, src) ? _T("true") : _T("false"));
 	
 	wxLogDebug(_T("deleting entry %s from dest"),
-		PRO_CFG_LIGHTING_PRESET.c_str());
-	dest->DeleteEntry(PRO_CFG_LIGHTING_PRESET, true);
+		PRO_CFG_LIGHTING_PRESET.GetPath().c_str());
+	dest->DeleteEntry(PRO_CFG_LIGHTING_PRESET.GetPath(), true);
 	
 	wxLogDebug(_T("contents of dest config after entry deletion:"));
 	LogConfigContents(*dest);
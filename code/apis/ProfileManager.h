@@ -19,33 +19,32 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #ifndef PROFILEMANAGER_H
 #define PROFILEMANAGER_H
 
+#include <deque>
+
 #include <wx/wx.h>
 #include <wx/event.h>
 #include <wx/fileconf.h>
 #include <wx/filename.h>
+#include <wx/timer.h>
 
 #include "apis/EventHandlers.h"
+#include "apis/ProfileWriter.h"
+#include "datastructures/NewsCache.h"
+#include "datastructures/ProfileIndex.h"
+#include "global/ProfileKeys.h"
 
 WX_DECLARE_STRING_HASH_MAP( wxFileConfig*, ProfileMap );
+WX_DECLARE_STRING_HASH_MAP( wxString, ProfileFileMap );
 
 /** event is generated anytime the number of profiles in the manager change. */
 LAUNCHER_DECLARE_EVENT_TYPE(EVT_PROFILE_CHANGE);
 /** Event is generated anytime the currently selected profile is changed. */
 LAUNCHER_DECLARE_EVENT_TYPE(EVT_CURRENT_PROFILE_CHANGED);
+/** Event is generated when a save of a profile has reached the disk, or has failed.
+ The event's string is the profile's name, the int is 1 if the save succeeded. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_PROFILE_SAVED);
 
-/** Stores data about downloaded news. */
-struct NewsData {
-	NewsData() { } // required for wxHashMap, unfortunately
-	NewsData(const wxString& theNews, const wxDateTime& lastDownloadNews);
-	bool IsValid() const { return (!theNews.IsEmpty()) && lastDownloadNews.IsValid(); }
-	wxString theNews;
-	wxDateTime lastDownloadNews;
-};
-
-/** Maps a news source by name to the locally stored data on it. */
-WX_DECLARE_STRING_HASH_MAP(NewsData, NewsMap);
-
-class ProMan {
+class ProMan: public wxEvtHandler {
 public:
 	enum Flags
 	{
@@ -62,38 +61,52 @@ public:
 	wxArrayString GetAllProfileNames();
 	wxString GetCurrentName();
 
-	bool GlobalExists(const wxChar* strName) const;
-	bool GlobalExists(wxString& strName) const;
-	
-	bool GlobalRead(const wxString& key, bool* b) const;
-	bool GlobalRead(const wxString& key, bool* b, bool defaultVal, bool writeBackIfAbsent = false);
-	bool GlobalRead(const wxString& key, wxString* str) const;
-	bool GlobalRead(const wxString& key, wxString* str, const wxString& defaultVal, bool writeBackIfAbsent = false);
-	bool GlobalRead(const wxString& key, long* l, long defaultVal, bool writeBackIfAbsent = false);
-	
-	bool GlobalWrite(const wxString& key, const wxString& value);
-	bool GlobalWrite(const wxString& key, const wxChar* value);
-	bool GlobalWrite(const wxString& key, long value);
-	bool GlobalWrite(const wxString& key, bool value);
-	
-	bool ProfileExists(const wxChar* strName) const;
-	bool ProfileExists(const wxString& strName) const;
-	
-	bool ProfileRead(const wxString& key, bool* b) const;
-	bool ProfileRead(const wxString& key, bool* b, bool defaultVal, bool writeBackIfAbsent = false);
-	bool ProfileRead(const wxString& key, wxString* str) const;
-	bool ProfileRead(const wxString& key, wxString* str, const wxString& defaultVal, bool writeBackIfAbsent = false);
-	bool ProfileRead(const wxString& key, long* l) const;
-	bool ProfileRead(const wxString& key, long* l, long defaultVal, bool writeBackIfAbsent = false);
-	
-	bool ProfileWrite(const wxString& key, const wxString& value);
-	bool ProfileWrite(const wxString& key, const wxChar* value);
-	bool ProfileWrite(const wxString& key, long value);
-	bool ProfileWrite(const wxString& key, bool value);
+	/** \name Typed access to the global profile and the current profile
+	 Values are cached in slots indexed by the key's id, so only the first read
+	 of a key after it changes goes to the config file. The overloads only take a
+	 key together with a value of the key's type. */
+	/** @{*/
+	template <typename T>
+	bool GlobalExists(const GlobalKey<T>& key) const {
+		T value;
+		return this->GlobalRead(key, &value);
+	}
+
+	bool GlobalRead(const GlobalKey<bool>& key, bool* b) const;
+	bool GlobalRead(const GlobalKey<bool>& key, bool* b, bool defaultVal, bool writeBackIfAbsent = false);
+	bool GlobalRead(const GlobalKey<wxString>& key, wxString* str) const;
+	bool GlobalRead(const GlobalKey<wxString>& key, wxString* str, const wxString& defaultVal, bool writeBackIfAbsent = false);
+	bool GlobalRead(const GlobalKey<long>& key, long* l) const;
+	bool GlobalRead(const GlobalKey<long>& key, long* l, long defaultVal, bool writeBackIfAbsent = false);
+
+	bool GlobalWrite(const GlobalKey<wxString>& key, const wxString& value);
+	bool GlobalWrite(const GlobalKey<wxString>& key, const wxChar* value);
+	bool GlobalWrite(const GlobalKey<long>& key, long value);
+	bool GlobalWrite(const GlobalKey<bool>& key, bool value);
+
+	template <typename T>
+	bool ProfileExists(const ProfileKey<T>& key) const {
+		T value;
+		return this->ProfileRead(key, &value);
+	}
+
+	bool ProfileRead(const ProfileKey<bool>& key, bool* b) const;
+	bool ProfileRead(const ProfileKey<bool>& key, bool* b, bool defaultVal, bool writeBackIfAbsent = false);
+	bool ProfileRead(const ProfileKey<wxString>& key, wxString* str) const;
+	bool ProfileRead(const ProfileKey<wxString>& key, wxString* str, const wxString& defaultVal, bool writeBackIfAbsent = false);
+	bool ProfileRead(const ProfileKey<long>& key, long* l) const;
+	bool ProfileRead(const ProfileKey<long>& key, long* l, long defaultVal, bool writeBackIfAbsent = false);
+
+	bool ProfileWrite(const ProfileKey<wxString>& key, const wxString& value);
+	bool ProfileWrite(const ProfileKey<wxString>& key, const wxChar* value);
+	bool ProfileWrite(const ProfileKey<long>& key, long value);
+	bool ProfileWrite(const ProfileKey<bool>& key, bool value);
+	/** @}*/
 	
 	bool ProfileDeleteEntry(const wxString& key, bool bDeleteGroupIfEmpty = true);
 	
-	/** Returns NULL if not found in global profile (or found but invalid). */
+	/** Returns NULL if not found in the news cache (or found but invalid).
+	 The news cache is read on the first call. */
 	const NewsData* NewsRead(const wxString& newsSource) const;
 	void NewsWrite(const wxString& newsSource, const NewsData& data);
 	
@@ -112,14 +125,36 @@ public:
 	bool CreateProfile(const wxString& newProfileName, const wxFileName& sourceFile);
 	bool CreateProfile(const wxString& newProfileName, const wxFileConfig *sourceConfig);
 	bool DeleteProfile(wxString name);
+	bool ExportProfile(const wxString& name, const wxFileName& destination);
+	bool FlushToDisk();
 	bool DoesProfileExist(wxString name);
 	bool SwitchTo(wxString name);
 	void SaveCurrentProfile(bool quiet = false);
 	void RevertCurrentProfile();
 	bool HasUnsavedChanges();
+	wxArrayString GetUnsavedChanges() const;
+	/** Changes whenever the contents of the current profile change,
+	 including when another profile becomes the current one. */
+	unsigned long GetProfileGeneration() const { return this->profileGeneration; }
 	inline bool NeedToPromptToSave() { return (!this->isAutoSaving) && this->HasUnsavedChanges(); }
 	void SetAutoSave(bool value) { this->isAutoSaving = value; }
 
+	/** \name Undo history
+	 Every change to an entry of the current profile is a step that can be undone
+	 and then redone. Changes to the same entry that follow each other, like
+	 typing in a text box, are a single step. The history is emptied when the
+	 current profile is reverted or another profile becomes the current one.
+	 When another launcher's changes are reloaded, the steps for the entries
+	 that it changed are dropped, so that undo cannot overwrite its changes. */
+	/** @{*/
+	bool CanUndo() const { return !this->undoHistory.empty(); }
+	bool CanRedo() const { return !this->redoHistory.empty(); }
+	bool Undo();
+	bool Redo();
+	/** Keeps at most depth steps, dropping the oldest ones. */
+	void SetUndoDepth(size_t depth);
+	/** @}*/
+
 	void AddEventHandler(wxEvtHandler *handler);
 	void RemoveEventHandler(wxEvtHandler *handler);
 
@@ -144,7 +179,84 @@ private:
 	wxFileConfig* currentProfile;
 	wxString currentProfileName;
 	
+	// the untyped access functions, which the typed ones use to reach the config files
+	bool GlobalExists(const wxChar* strName) const;
+	bool GlobalExists(const wxString& strName) const;
+	
+	bool GlobalRead(const wxString& key, bool* b) const;
+	bool GlobalRead(const wxString& key, bool* b, bool defaultVal, bool writeBackIfAbsent = false);
+	bool GlobalRead(const wxString& key, wxString* str) const;
+	bool GlobalRead(const wxString& key, wxString* str, const wxString& defaultVal, bool writeBackIfAbsent = false);
+	bool GlobalRead(const wxString& key, long* l, long defaultVal, bool writeBackIfAbsent = false);
+	
+	bool GlobalWrite(const wxString& key, const wxString& value);
+	bool GlobalWrite(const wxString& key, const wxChar* value);
+	bool GlobalWrite(const wxString& key, long value);
+	bool GlobalWrite(const wxString& key, bool value);
+	
+	bool ProfileExists(const wxChar* strName) const;
+	bool ProfileExists(const wxString& strName) const;
+	
+	bool ProfileRead(const wxString& key, bool* b) const;
+	bool ProfileRead(const wxString& key, bool* b, bool defaultVal, bool writeBackIfAbsent = false);
+	bool ProfileRead(const wxString& key, wxString* str) const;
+	bool ProfileRead(const wxString& key, wxString* str, const wxString& defaultVal, bool writeBackIfAbsent = false);
+	bool ProfileRead(const wxString& key, long* l) const;
+	bool ProfileRead(const wxString& key, long* l, long defaultVal, bool writeBackIfAbsent = false);
+	
+	bool ProfileWrite(const wxString& key, const wxString& value);
+	bool ProfileWrite(const wxString& key, const wxChar* value);
+	bool ProfileWrite(const wxString& key, long value);
+	bool ProfileWrite(const wxString& key, bool value);
+	
+	/** The value of a typed key as it was last read from the config file. */
+	struct KeySlot {
+		KeySlot(): state(UNREAD), boolValue(false), longValue(0) { }
+		enum State {
+			UNREAD, //!< the value has to be read from the config file
+			ABSENT, //!< the config file has no valid value for the key
+			PRESENT
+		} state;
+		bool boolValue;
+		long longValue;
+		wxString stringValue;
+	};
+	mutable KeySlot globalSlots[GLOBAL_KEY_COUNT];
+	mutable KeySlot profileSlots[PROFILE_KEY_COUNT];
+	WX_DECLARE_STRING_HASH_MAP(size_t, SlotIds);
+	/** The ids of the keys whose slots have been read, by path, so that an
+	 untyped write can invalidate only the slot of the key that it wrote. */
+	mutable SlotIds globalSlotIds;
+	mutable SlotIds profileSlotIds;
+	static KeySlot& GetSlot(KeySlot* slots, SlotIds& ids, size_t id, const wxString& path);
+	static inline bool& SlotValue(KeySlot& slot, bool*) { return slot.boolValue; }
+	static inline long& SlotValue(KeySlot& slot, long*) { return slot.longValue; }
+	static inline wxString& SlotValue(KeySlot& slot, wxString*) { return slot.stringValue; }
+	template <typename T>
+	static bool ReadSlot(const wxFileConfig& config, KeySlot& slot, const wxString& path, T* value);
+	template <typename T>
+	bool ReadGlobalSlot(const GlobalKey<T>& key, T* value, const T& defaultVal, bool writeBackIfAbsent);
+	template <typename T>
+	bool ReadProfileSlot(const ProfileKey<T>& key, T* value, const T& defaultVal, bool writeBackIfAbsent);
+	static void InvalidateSlots(KeySlot* slots, size_t count);
+	static void InvalidateSlot(KeySlot* slots, const SlotIds& ids, const wxString& path);
+
 	bool CreateNewProfile(wxString newName);
+	wxFileConfig* GetProfile(const wxString& name);
+	unsigned long SaveProfileToDisk(wxFileConfig* toSave, const wxString& name, bool quiet,
+		bool checkFile = false);
+	void SaveGlobalProfile();
+	void OnProfileFilesWritten(wxCommandEvent& event);
+	bool HandleWrittenProfiles(bool notify);
+	void FinishDeletingProfile(const ProfileWriter::Written& written);
+	bool FlushWriter(bool notify);
+	void OnReloadTimer(wxTimerEvent& event);
+	bool HasFileChanged(const wxString& filePath) const;
+	void ReloadProfile(const wxString& name);
+	void ReloadCurrentProfile();
+	void RefreshProfileList();
+	void MergeGlobalProfile();
+	void GlobalChanged(const wxString& key);
 	static wxString GenerateNewProfileFileName();
 
 	static RegistryCodes PushProfile(wxFileConfig *cfg); //!< push profile into registry
@@ -165,20 +277,90 @@ private:
 	ProMan();
 	void SaveProfilesBeforeExiting();
 	
-	NewsMap newsMap;
-	void LoadNewsMapFromGlobalProfile();
-	void SaveNewsMapToGlobalProfile();
+	mutable NewsCache newsCache; //!< loaded when the news is first read
+	void MoveNewsOutOfGlobalProfile();
 
-	ProfileMap profiles; //!< The profiles. Indexed by Name;
+	ProfileMap profiles; //!< The profiles. Indexed by Name; NULL until the profile is first used
+	ProfileFileMap profileFiles; //!< Full path of each profile's file. Indexed by Name;
+	ProfileIndex profileIndex;
+	ProfileWriter writer; //!< writes the profiles and the global profile to disk
 	wxFileConfig* globalProfile;  //!< Global profile settings, like language, or proxy
-	wxString privateCopyFilename; //!< Name of file used for private copy
-	wxFileConfig* privateCopy; //!< Private copy, used in determining whether current profile has unsaved changes
-	void ResetPrivateCopy();
+	/** The state of an entry in the current profile, as it is stored in the file. */
+	struct EntryState {
+		EntryState() : exists(false) { } // required for wxHashMap
+		EntryState(bool exists, const wxString& value) : exists(exists), value(value) { }
+		bool operator==(const EntryState& other) const {
+			return (this->exists == other.exists) && (!this->exists || this->value == other.value);
+		}
+		bool exists;
+		wxString value;
+	};
+	/** Maps each entry of the current profile that has changed since the
+	 profile was last saved to the entry's state at that save.
+	 The saved snapshot of the profile is the current profile with the journal
+	 applied over it, so it shares every unchanged entry with the current profile.
+	 A save only empties the journal once the writer has written the file,
+	 switching profiles empties it, and reverting only restores the entries in it. */
+	WX_DECLARE_STRING_HASH_MAP(EntryState, ProfileJournal);
+	ProfileJournal journal;
+	/** A save of changes to a profile that the writer has not written yet.
+	 If another launcher has changed the file in the meantime, the entries are
+	 written over its changes and the profile is saved again. */
+	struct PendingSave {
+		unsigned long id; //!< as returned by ProfileWriter::Save()
+		wxString name; //!< of the profile
+		ProfileJournal entries; //!< the state that each changed entry was saved in
+	};
+	std::deque<PendingSave> pendingSaves; //!< oldest first
+	EntryState SavedEntry(const wxString& key) const;
+	bool HasPendingSaves(const wxString& name) const;
+	void SaveProfileChanges(wxFileConfig* config, const wxString& name,
+		const ProfileJournal& entries, bool quiet);
+	void FinishPendingSaves(const ProfileWriter::Written& written, ProfileJournal& entries);
+	void SaveProfileAgain(const wxString& name, const ProfileJournal& entries, bool quiet);
+	unsigned long profileGeneration; //!< see GetProfileGeneration()
+	static EntryState ReadEntry(wxFileConfig& config, const wxString& key);
+	static void WriteEntry(wxFileConfig& config, const wxString& key, const EntryState& state);
+	EntryState ReadCurrentEntry(const wxString& key) const;
+	void JournalChange(const wxString& key, const EntryState& before);
+	void UpdateJournal(const wxString& key, const EntryState& before, const EntryState& after);
+
+	/** A step in the undo history: the entry at key went from before to after. */
+	struct ProfileEdit {
+		ProfileEdit(const wxString& key, const EntryState& before, const EntryState& after)
+			: key(key), before(before), after(after) { }
+		wxString key;
+		EntryState before;
+		EntryState after;
+	};
+	std::deque<ProfileEdit> undoHistory; //!< the most recent step is at the back
+	std::deque<ProfileEdit> redoHistory; //!< the most recently undone step is at the back
+	size_t undoDepth;
+	void ApplyEdit(const wxString& key, const EntryState& state);
+	void ClearUndoHistory();
+	void DropEditsChangedIn(wxFileConfig& reloaded);
+	void LogUnsavedChanges() const;
+
+	/** \name Changes made by other launchers
+	 Other launchers can use the same profile folder at the same time. Changes
+	 they make to the loaded profiles, and profiles they add or remove, are picked
+	 up by polling, and saving merges this launcher's changes into theirs. */
+	/** @{*/
+	wxTimer reloadTimer;
+	wxString profileFolderStamp; //!< modification time of the profile folder when it was last checked
+	void OwnFolderChange(const wxString& stampBefore, const wxString& stampAfter);
+	ProfileIndexEntry globalFileStat; //!< the global profile's file as it was last read or written
+	wxSortedArrayString changedGlobalEntries; //!< entries of the global profile written since it was loaded
+	/** @}*/
+
 	bool isAutoSaving; //!< Are we auto saving the profiles?
 	void GenerateChangeEvent();
 	void GenerateCurrentProfileChangedEvent();
+	void GenerateProfileSavedEvent(const wxString& name, bool success);
 
 	EventHandlers eventHandlers;
+
+	DECLARE_EVENT_TABLE()
 };
 
 // These operators should be refactored into a common
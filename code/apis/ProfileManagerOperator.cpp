@@ -19,10 +19,234 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "generated/configure_launcher.h"
 #include "apis/ProfileManager.h"
 #include "apis/ProfileManagerOperator.h"
+#include "global/ProfileKeys.h"
 #include "wxLauncherApp.h"
 
+#include <vector>
+
+#include <wx/dir.h>
+#include <wx/textfile.h>
+#include <wx/wfstream.h>
+
 #include "global/MemoryDebugging.h"
 
+/** One profile of a batch import or export, and the file it comes from or goes to. */
+struct BatchEntry
+{
+	wxString name;
+	wxFileName file;
+};
+
+/** Reads a manifest for a batch import or export. Each line holds a profile's
+ name and a file, separated by a tab. Relative paths are relative to the manifest.
+ Blank lines and lines starting with # are ignored. */
+static bool ReadManifest(const wxString& manifestPath, std::vector<BatchEntry>& entries)
+{
+	wxTextFile manifest;
+	if (!wxFileName::FileExists(manifestPath) || !manifest.Open(manifestPath))
+	{
+		wxLogError(_("Unable to read manifest %s"), manifestPath.c_str());
+		return false;
+	}
+	const wxString manifestFolder(wxFileName(manifestPath).GetPath());
+
+	bool valid = true;
+	for (size_t i = 0; i < manifest.GetLineCount(); i++)
+	{
+		const wxString line(manifest.GetLine(i).Strip(wxString::both));
+		if (line.IsEmpty() || line.StartsWith(wxT_2("#")))
+		{
+			continue;
+		}
+		BatchEntry entry;
+		entry.name = line.BeforeFirst(wxT_2('\t')).Strip(wxString::both);
+		const wxString path(line.AfterFirst(wxT_2('\t')).Strip(wxString::both));
+		if (entry.name.IsEmpty() || path.IsEmpty())
+		{
+			wxLogError(_("Line %lu of manifest %s is not a profile name and a file separated by a tab"),
+				static_cast<unsigned long>(i + 1), manifestPath.c_str());
+			valid = false;
+			continue;
+		}
+		entry.file.Assign(path);
+		entry.file.MakeAbsolute(manifestFolder);
+		entries.push_back(entry);
+	}
+	return valid;
+}
+
+/** Imports a batch of profiles. Every file is read and checked before
+ anything is imported, so a bad batch leaves the profiles as they were.
+ Profiles that already exist are not overwritten. An entry without a name takes
+ the name stored in its file, or failing that the file's name. */
+static int ImportProfiles(std::vector<BatchEntry>& entries)
+{
+	ProMan* proman = ProMan::GetProfileManager();
+
+	std::vector<wxFileConfig*> configs(entries.size(), static_cast<wxFileConfig*>(NULL));
+	wxSortedArrayString names;
+	bool valid = true;
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		BatchEntry& entry = entries[i];
+		wxFFileInputStream input(entry.file.GetFullPath());
+		if (!entry.file.FileExists() || !input.IsOk())
+		{
+			wxLogError(_("Unable to read profile file %s"), entry.file.GetFullPath().c_str());
+			valid = false;
+			continue;
+		}
+		configs[i] = new wxFileConfig(input);
+		if (entry.name.IsEmpty() && !configs[i]->Read(PRO_CFG_MAIN_NAME.GetPath(), &entry.name))
+		{
+			entry.name = entry.file.GetName();
+		}
+
+		if (names.Index(entry.name) != wxNOT_FOUND)
+		{
+			wxLogError(_("Profile '%s' is imported more than once"), entry.name.c_str());
+			valid = false;
+		}
+		names.Add(entry.name);
+	}
+
+	size_t imported = 0, skipped = 0;
+	bool succeeded = valid;
+	for (size_t i = 0; valid && i < entries.size(); i++)
+	{
+		if (proman->DoesProfileExist(entries[i].name))
+		{
+			wxLogInfo(_("Profile '%s' already exists, not importing %s"),
+				entries[i].name.c_str(), entries[i].file.GetFullPath().c_str());
+			skipped++;
+		}
+		else if (proman->CreateProfile(entries[i].name, configs[i]))
+		{
+			imported++;
+		}
+		else
+		{
+			succeeded = false;
+		}
+	}
+
+	for (size_t i = 0; i < configs.size(); i++)
+	{
+		delete configs[i];
+	}
+	if (!valid)
+	{
+		wxLogError(_("Nothing was imported"));
+		return 1;
+	}
+
+	// the profiles are written together, and the profile index once
+	if (!proman->FlushToDisk())
+	{
+		succeeded = false;
+	}
+	wxLogInfo(_("Imported %lu profile(s), %lu already existed"),
+		static_cast<unsigned long>(imported), static_cast<unsigned long>(skipped));
+	return succeeded ? 0 : 1;
+}
+
+/** Exports a batch of profiles. Every entry is checked before anything is
+ written, so a bad batch writes nothing. */
+static int ExportProfiles(const std::vector<BatchEntry>& entries)
+{
+	ProMan* proman = ProMan::GetProfileManager();
+
+	wxSortedArrayString destinations;
+	bool valid = true;
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		const BatchEntry& entry = entries[i];
+		if (!proman->DoesProfileExist(entry.name))
+		{
+			wxLogError(_("Profile '%s' does not exist"), entry.name.c_str());
+			valid = false;
+		}
+		if (destinations.Index(entry.file.GetFullPath()) != wxNOT_FOUND)
+		{
+			wxLogError(_("More than one profile is exported to %s"), entry.file.GetFullPath().c_str());
+			valid = false;
+		}
+		destinations.Add(entry.file.GetFullPath());
+		if (!entry.file.DirExists() && !wxFileName::Mkdir(entry.file.GetPath(), 0777, wxPATH_MKDIR_FULL))
+		{
+			wxLogError(_("Unable to create folder %s"), entry.file.GetPath().c_str());
+			valid = false;
+		}
+	}
+	if (!valid)
+	{
+		wxLogError(_("Nothing was exported"));
+		return 1;
+	}
+
+	bool succeeded = true;
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		if (!proman->ExportProfile(entries[i].name, entries[i].file))
+		{
+			succeeded = false;
+		}
+	}
+	// the profiles are written together
+	if (!proman->FlushToDisk())
+	{
+		succeeded = false;
+	}
+	wxLogInfo(_("Exported %lu profile(s)"), static_cast<unsigned long>(entries.size()));
+	return succeeded ? 0 : 1;
+}
+
+/** The profiles to import from a folder: every .ini file in it, named by its contents. */
+static void FindProfileFiles(const wxString& folder, std::vector<BatchEntry>& entries)
+{
+	wxArrayString files;
+	wxDir::GetAllFiles(folder, &files, wxT_2("*.ini"), wxDIR_FILES);
+	files.Sort();
+	for (size_t i = 0; i < files.GetCount(); i++)
+	{
+		BatchEntry entry;
+		entry.file.Assign(files[i]);
+		entries.push_back(entry);
+	}
+}
+
+/** The files to export every profile to a folder: the profile's name, with the
+ characters that cannot be in a file name replaced. */
+static void NameExportFiles(const wxString& folder, std::vector<BatchEntry>& entries)
+{
+	const wxArrayString names(ProMan::GetProfileManager()->GetAllProfileNames());
+	const wxString forbidden(wxFileName::GetForbiddenChars() + wxFileName::GetPathSeparators());
+	wxSortedArrayString used;
+	for (size_t i = 0; i < names.GetCount(); i++)
+	{
+		wxString fileName(names[i]);
+		for (size_t c = 0; c < fileName.Length(); c++)
+		{
+			if (forbidden.Find(fileName[c]) != wxNOT_FOUND)
+			{
+				fileName[c] = wxT_2('_');
+			}
+		}
+		// names that differ only in forbidden characters, or in case
+		wxString unique(fileName);
+		for (int n = 2; used.Index(unique.Lower()) != wxNOT_FOUND; n++)
+		{
+			unique = wxString::Format(wxT_2("%s (%d)"), fileName.c_str(), n);
+		}
+		used.Add(unique.Lower());
+
+		BatchEntry entry;
+		entry.name = names[i];
+		entry.file.Assign(folder, unique, wxT_2("ini"));
+		entries.push_back(entry);
+	}
+}
+
 int ProManOperator::RunProfileOperator(ProManOperator::profileOperator op)
 {
 	wxLauncher &app = wxGetApp();
@@ -42,6 +266,27 @@ int ProManOperator::RunProfileOperator(ProManOperator::profileOperator op)
 			SwitchTo(app.mProfileOperand);
 		return 0;
 	}
+	else if (op == importBatch || op == exportBatch)
+	{
+		std::vector<BatchEntry> entries;
+		if (!app.mFileOperand.IsEmpty())
+		{
+			if (!ReadManifest(app.mFileOperand, entries))
+			{
+				return 1;
+			}
+		}
+		else if (op == importBatch)
+		{
+			FindProfileFiles(app.mFolderOperand, entries);
+		}
+		else
+		{
+			NameExportFiles(app.mFolderOperand, entries);
+		}
+
+		return (op == importBatch) ? ImportProfiles(entries) : ExportProfiles(entries);
+	}
 
 	return 1;
 }
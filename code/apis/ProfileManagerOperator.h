@@ -30,6 +30,8 @@ enum profileOperator {
 	none = 0,
 	add,
 	select,
+	importBatch, //!< import the profiles in a manifest or folder
+	exportBatch, //!< export profiles as given by a manifest, or all of them to a folder
 	invalid
 };
 
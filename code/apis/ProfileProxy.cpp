@@ -177,10 +177,43 @@ void ProfileProxy::OnFlagFileProcessingStatusChanged(wxCommandEvent &event) {
 void ProfileProxy::SetFlag(const wxString& flag, const bool isChecked) {
 	wxCHECK_RET(this->IsFlagDataReady(),
 		_T("SetFlag() called when proxy flag data isn't ready."));
-	wxCHECK_RET(this->flagMap.count(flag) > 0,
+	const bool updated = this->UpdateEnabledFlag(flag, isChecked);
+	wxCHECK_RET(updated,
 		wxString::Format(_T("SetFlag(): given unknown flag %s."), flag.c_str()));
 	
-	const int flagIndex = this->flagMap.find(flag)->second;
+	this->WriteFlagLineToProfile();
+	CmdLineManager::GenerateCmdLineChanged();
+}
+
+void ProfileProxy::SetFlags(const std::vector<wxString>& flagsToDisable,
+		const std::vector<wxString>& flagsToEnable) {
+	wxCHECK_RET(this->IsFlagDataReady(),
+		_T("SetFlags() called when proxy flag data isn't ready."));
+	
+	for (std::vector<wxString>::const_iterator
+		 it = flagsToDisable.begin(), end = flagsToDisable.end(); it != end; ++it) {
+		if (!this->UpdateEnabledFlag(*it, false)) {
+			wxLogError(_T("SetFlags(): given unknown flag %s."), it->c_str());
+		}
+	}
+	for (std::vector<wxString>::const_iterator
+		 it = flagsToEnable.begin(), end = flagsToEnable.end(); it != end; ++it) {
+		if (!this->UpdateEnabledFlag(*it, true)) {
+			wxLogError(_T("SetFlags(): given unknown flag %s."), it->c_str());
+		}
+	}
+	
+	this->WriteFlagLineToProfile();
+	CmdLineManager::GenerateCmdLineChanged();
+}
+
+bool ProfileProxy::UpdateEnabledFlag(const wxString& flag, const bool isChecked) {
+	FlagStringToIndexMap::const_iterator found = this->flagMap.find(flag);
+	if (found == this->flagMap.end()) {
+		return false;
+	}
+	
+	const int flagIndex = found->second;
 	
 	wxASSERT_MSG(VerifyEnabledFlagsForFlag(flag, flagIndex).IsEmpty(),
 		VerifyEnabledFlagsForFlag(flag, flagIndex));
@@ -190,9 +223,7 @@ void ProfileProxy::SetFlag(const wxString& flag, const bool isChecked) {
 	} else {
 		this->enabledFlags.erase(flagIndex);
 	}
-	
-	this->WriteFlagLineToProfile();
-	CmdLineManager::GenerateCmdLineChanged();
+	return true;
 }
 
 std::vector<wxString> ProfileProxy::GetEnabledFlags() const {
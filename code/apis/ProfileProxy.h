@@ -65,6 +65,12 @@ public:
 	/** Sets a flag from the flag list. */
 	void SetFlag(const wxString& flag, bool isChecked);
 	
+	/** Disables and enables several flags from the flag list at once,
+	 writing the flag line and updating the command line only once.
+	 A flag in both lists ends up enabled. */
+	void SetFlags(const std::vector<wxString>& flagsToDisable,
+		const std::vector<wxString>& flagsToEnable);
+	
 	/** Gets the enabled flag list flags as individual flag strings. */
 	std::vector<wxString> GetEnabledFlags() const;
 	
@@ -109,6 +115,10 @@ private:
 	void GenerateProxyReset();
 	void GenerateProxyFlagDataReady();
 	
+	/** Updates enabledFlags for one flag, without writing it to the profile.
+	 Returns false if the flag is unknown. */
+	bool UpdateEnabledFlag(const wxString& flag, bool isChecked);
+	
 	/** Writes both flag list flags and custom flags to profile. */
 	void WriteFlagLineToProfile() const;
 	
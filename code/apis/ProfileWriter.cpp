@@ -0,0 +1,432 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "generated/configure_launcher.h"
+#include "apis/ProfileWriter.h"
+#include "apis/ProfileFolderLock.h"
+
+#include <wx/filefn.h>
+#include <wx/mstream.h>
+
+#if IS_WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#endif
+
+#include "global/MemoryDebugging.h"
+
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_PROFILE_FILES_WRITTEN);
+
+/** How long the worker waits after a save before writing, so that the
+ saves that follow it, such as when several settings change at once, are
+ written together with it. */
+const long PROFILE_WRITE_DELAY_MS = 500;
+
+// wxString is not guaranteed to be safe to share between threads,
+// so strings that cross a thread boundary are always deep copied.
+static inline wxString DeepCopy(const wxString& str) {
+	return wxString(str.c_str());
+}
+
+static ProfileIndexEntry DeepCopy(const ProfileIndexEntry& entry) {
+	ProfileIndexEntry copy;
+	copy.name = DeepCopy(entry.name);
+	copy.filePath = DeepCopy(entry.filePath);
+	copy.fileSize = DeepCopy(entry.fileSize);
+	copy.fileMtime = DeepCopy(entry.fileMtime);
+	return copy;
+}
+
+static void Swap(ProfileIndexEntry& a, ProfileIndexEntry& b) {
+	a.name.swap(b.name);
+	a.filePath.swap(b.filePath);
+	a.fileSize.swap(b.fileSize);
+	a.fileMtime.swap(b.fileMtime);
+}
+
+ProfileWriter::ProfileWriter(wxEvtHandler* owner, const wxString& lockFile)
+: owner(owner), lockFile(DeepCopy(lockFile)), folder(DeepCopy(wxPathOnly(lockFile))),
+worker(NULL), lastId(0),
+requestAdded(mutex), writesFinished(mutex), writing(false), flushing(false), stopping(false) {
+	wxASSERT(owner != NULL);
+}
+
+ProfileWriter::~ProfileWriter() {
+	this->StopWorker();
+}
+
+unsigned long ProfileWriter::Save(wxFileConfig& config, const wxString& filePath,
+		const wxString& name, bool quiet, const ProfileIndexEntry* expected) {
+	Request request;
+	request.id = ++this->lastId;
+	request.filePath = DeepCopy(filePath);
+	request.name = DeepCopy(name);
+	request.quiet = quiet;
+	request.checkStat = expected != NULL;
+	if (expected != NULL) {
+		request.expected = DeepCopy(*expected);
+	}
+	{
+		// wxFileConfig is not thread safe, so it is rendered here
+		wxMemoryOutputStream stream;
+		config.Save(stream);
+		request.contents.resize(stream.GetSize());
+		if (!request.contents.empty()) {
+			stream.CopyTo(&request.contents[0], request.contents.size());
+		}
+	}
+	return this->Queue(request);
+}
+
+unsigned long ProfileWriter::SaveContents(std::vector<char>& contents, const wxString& filePath,
+		const wxString& name, bool quiet) {
+	Request request;
+	request.id = ++this->lastId;
+	request.filePath = DeepCopy(filePath);
+	request.name = DeepCopy(name);
+	request.quiet = quiet;
+	request.contents.swap(contents);
+	return this->Queue(request);
+}
+
+unsigned long ProfileWriter::Remove(const wxString& filePath, const wxString& name) {
+	Request request;
+	request.id = ++this->lastId;
+	request.filePath = DeepCopy(filePath);
+	request.name = DeepCopy(name);
+	request.quiet = true;
+	request.remove = true;
+	return this->Queue(request);
+}
+
+unsigned long ProfileWriter::Queue(Request& request) {
+	if (!this->StartWorker()) {
+		std::vector<Request> requests(1, request);
+		std::vector<Written> written;
+		this->WriteAll(requests, written);
+		this->AddWritten(written);
+		return request.id;
+	}
+
+	wxMutexLocker lock(this->mutex);
+	Request* queued = NULL;
+	for (size_t i = 0; i < this->requests.size() && queued == NULL; i++) {
+		if (this->requests[i].filePath == request.filePath) {
+			wxLogDebug(_T("ProfileWriter: replacing the queued request for %s"),
+				request.filePath.c_str());
+			queued = &this->requests[i];
+		}
+	}
+	if (queued == NULL) {
+		this->requests.push_back(Request());
+		queued = &this->requests.back();
+	}
+	// swapped rather than copied, so that the strings the worker gets are not shared
+	queued->filePath.swap(request.filePath);
+	queued->name.swap(request.name);
+	queued->id = request.id;
+	queued->quiet = request.quiet;
+	queued->remove = request.remove;
+	queued->checkStat = request.checkStat;
+	Swap(queued->expected, request.expected);
+	queued->contents.swap(request.contents);
+	this->requestAdded.Signal();
+	return request.id;
+}
+
+void ProfileWriter::Flush() {
+	wxMutexLocker lock(this->mutex);
+	this->flushing = true;
+	this->requestAdded.Broadcast();
+	while (!this->requests.empty() || this->writing) {
+		this->writesFinished.Wait();
+	}
+	this->flushing = false;
+}
+
+void ProfileWriter::CollectWritten(std::vector<Written>& written) {
+	wxMutexLocker lock(this->mutex);
+	written.insert(written.end(), this->written.begin(), this->written.end());
+	this->written.clear();
+}
+
+bool ProfileWriter::IsIdle() {
+	wxMutexLocker lock(this->mutex);
+	return this->requests.empty() && !this->writing && this->written.empty();
+}
+
+// wxFile and wxRenameFile log their failures, and logging is not safe on the
+// worker thread, so the temporary file is written with the platform's own calls.
+#if IS_WIN32
+static bool WriteTempFile(const wxString& tempFile, const std::vector<char>& contents,
+		wxString& error) {
+	HANDLE file = ::CreateFileW(tempFile.wc_str(), GENERIC_WRITE, 0, NULL,
+		CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		error = wxString::Format(_T("unable to create %s (error %lu)"),
+			tempFile.c_str(), static_cast<unsigned long>(::GetLastError()));
+		return false;
+	}
+	DWORD written = 0;
+	bool ok = contents.empty()
+		|| (::WriteFile(file, &contents[0], static_cast<DWORD>(contents.size()), &written, NULL)
+			&& written == contents.size());
+	// flushed so that the rename cannot reach the disk before the contents do
+	ok = ok && ::FlushFileBuffers(file);
+	if (!ok) {
+		error = wxString::Format(_T("unable to write %s (error %lu)"),
+			tempFile.c_str(), static_cast<unsigned long>(::GetLastError()));
+	}
+	::CloseHandle(file);
+	return ok;
+}
+
+static bool RenameTempFile(const wxString& tempFile, const wxString& filePath, wxString& error) {
+	if (!::MoveFileExW(tempFile.wc_str(), filePath.wc_str(),
+			MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+		error = wxString::Format(_T("unable to replace %s (error %lu)"),
+			filePath.c_str(), static_cast<unsigned long>(::GetLastError()));
+		return false;
+	}
+	return true;
+}
+
+static void RemoveTempFile(const wxString& tempFile) {
+	::DeleteFileW(tempFile.wc_str());
+}
+
+static bool RemoveFile(const wxString& filePath, wxString& error) {
+	if (!::DeleteFileW(filePath.wc_str()) && ::GetLastError() != ERROR_FILE_NOT_FOUND) {
+		error = wxString::Format(_T("unable to delete %s (error %lu)"),
+			filePath.c_str(), static_cast<unsigned long>(::GetLastError()));
+		return false;
+	}
+	return true;
+}
+#else
+static bool WriteTempFile(const wxString& tempFile, const std::vector<char>& contents,
+		wxString& error) {
+	const int fd = ::open(tempFile.fn_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (fd < 0) {
+		error = wxString::Format(_T("unable to create %s (error %d)"), tempFile.c_str(), errno);
+		return false;
+	}
+	size_t done = 0;
+	while (done < contents.size()) {
+		const ssize_t written = ::write(fd, &contents[done], contents.size() - done);
+		if (written < 0 && errno == EINTR) {
+			continue;
+		} else if (written <= 0) {
+			break;
+		}
+		done += static_cast<size_t>(written);
+	}
+	// synced so that the rename cannot reach the disk before the contents do
+	const bool ok = done == contents.size() && ::fsync(fd) == 0;
+	if (!ok) {
+		error = wxString::Format(_T("unable to write %s (error %d)"), tempFile.c_str(), errno);
+	}
+	if (::close(fd) != 0 && ok) {
+		error = wxString::Format(_T("unable to write %s (error %d)"), tempFile.c_str(), errno);
+		return false;
+	}
+	return ok;
+}
+
+static bool RenameTempFile(const wxString& tempFile, const wxString& filePath, wxString& error) {
+	if (::rename(tempFile.fn_str(), filePath.fn_str()) != 0) {
+		error = wxString::Format(_T("unable to replace %s (error %d)"), filePath.c_str(), errno);
+		return false;
+	}
+	return true;
+}
+
+static void RemoveTempFile(const wxString& tempFile) {
+	::unlink(tempFile.fn_str());
+}
+
+static bool RemoveFile(const wxString& filePath, wxString& error) {
+	if (::unlink(filePath.fn_str()) != 0 && errno != ENOENT) {
+		error = wxString::Format(_T("unable to delete %s (error %d)"), filePath.c_str(), errno);
+		return false;
+	}
+	return true;
+}
+#endif
+
+bool ProfileWriter::WriteAtomically(const wxString& filePath, const std::vector<char>& contents,
+		wxString& error) {
+	const wxString tempFile(filePath + _T(".tmp"));
+	if (!WriteTempFile(tempFile, contents, error)) {
+		RemoveTempFile(tempFile);
+		return false;
+	}
+	if (!RenameTempFile(tempFile, filePath, error)) {
+		RemoveTempFile(tempFile);
+		return false;
+	}
+	return true;
+}
+
+void ProfileWriter::Write(const Request& request, Written& written) {
+	written.id = request.id;
+	written.filePath = DeepCopy(request.filePath);
+	written.name = DeepCopy(request.name);
+	written.quiet = request.quiet;
+	written.removed = request.remove;
+
+	if (request.remove) {
+		written.success = RemoveFile(request.filePath, written.error);
+		if (written.success) {
+			this->writtenStats.erase(request.filePath);
+		}
+		return;
+	}
+
+	ProfileIndexEntry current;
+	if (request.checkStat && current.ReadFileStat(request.filePath)
+		&& !current.HasSameStat(request.expected)) {
+		ProfileIndexEntries::const_iterator last = this->writtenStats.find(request.filePath);
+		if (last == this->writtenStats.end() || !current.HasSameStat(last->second)) {
+			written.conflict = true;
+			written.error = wxString::Format(_T("%s was changed by another launcher"),
+				request.filePath.c_str());
+			return;
+		}
+	}
+
+	written.success = WriteAtomically(request.filePath, request.contents, written.error);
+	if (written.success && written.stat.ReadFileStat(request.filePath)) {
+		// nothing in written may share a string with what this thread keeps
+		written.stat.filePath = written.filePath;
+		this->writtenStats[DeepCopy(request.filePath)] = DeepCopy(written.stat);
+	}
+}
+
+// the files are checked and written under a single lock,
+// so that no other launcher can write them in between
+void ProfileWriter::WriteAll(const std::vector<Request>& requests, std::vector<Written>& written) {
+	written.resize(requests.size());
+	ProfileFolderLock lock(this->lockFile);
+	for (size_t i = 0; i < requests.size(); i++) {
+		if (lock.IsLocked()) {
+			// taken under the lock, so that no other launcher's change is in between
+			written[i].folderStampBefore = ProfileIndex::GetFolderStamp(this->folder);
+			this->Write(requests[i], written[i]);
+			written[i].folderStampAfter = ProfileIndex::GetFolderStamp(this->folder);
+		} else {
+			// without the lock, another launcher could be writing the same file
+			written[i].id = requests[i].id;
+			written[i].filePath = DeepCopy(requests[i].filePath);
+			written[i].name = DeepCopy(requests[i].name);
+			written[i].quiet = requests[i].quiet;
+			written[i].removed = requests[i].remove;
+			written[i].error = DeepCopy(lock.GetError());
+		}
+	}
+}
+
+bool ProfileWriter::StartWorker() {
+	if (this->worker != NULL) {
+		return true;
+	}
+
+	Worker* worker = new Worker(this);
+	if (worker->Create() != wxTHREAD_NO_ERROR || worker->Run() != wxTHREAD_NO_ERROR) {
+		delete worker;
+		wxLogDebug(_T("ProfileWriter: unable to start the worker, writing on the main thread"));
+		return false;
+	}
+	this->worker = worker;
+	return true;
+}
+
+void ProfileWriter::StopWorker() {
+	this->Flush();
+	{
+		wxMutexLocker lock(this->mutex);
+		this->stopping = true;
+		this->requestAdded.Broadcast();
+	}
+
+	if (this->worker != NULL) {
+		this->worker->Wait();
+		delete this->worker;
+		this->worker = NULL;
+	}
+}
+
+bool ProfileWriter::TakeRequests(std::vector<Request>& requests) {
+	wxMutexLocker lock(this->mutex);
+	while (this->requests.empty() && !this->stopping) {
+		this->requestAdded.Wait();
+	}
+	if (this->requests.empty()) {
+		return false; // stopping, and everything has been written
+	}
+
+	const wxLongLong deadline(::wxGetLocalTimeMillis() + PROFILE_WRITE_DELAY_MS);
+	wxLongLong now(::wxGetLocalTimeMillis());
+	while (!this->flushing && !this->stopping && now < deadline) {
+		this->requestAdded.WaitTimeout(static_cast<unsigned long>((deadline - now).ToLong()));
+		now = ::wxGetLocalTimeMillis();
+	}
+
+	requests.swap(this->requests);
+	this->writing = true;
+	return true;
+}
+
+void ProfileWriter::AddWritten(std::vector<Written>& written) {
+	bool notify;
+	{
+		wxMutexLocker lock(this->mutex);
+		notify = this->written.empty() && !this->stopping;
+		this->written.insert(this->written.end(), written.begin(), written.end());
+		// let go of this thread's references while the mutex is still held
+		written.clear();
+		this->writing = false;
+		this->writesFinished.Broadcast();
+	}
+
+	// one event is enough for everything that finishes before it is handled
+	if (notify) {
+		wxCommandEvent event(EVT_PROFILE_FILES_WRITTEN, wxID_NONE);
+		this->owner->AddPendingEvent(event);
+	}
+}
+
+ProfileWriter::Worker::Worker(ProfileWriter* writer)
+: wxThread(wxTHREAD_JOINABLE), writer(writer) {
+}
+
+wxThread::ExitCode ProfileWriter::Worker::Entry() {
+	std::vector<Request> requests;
+	while (!this->TestDestroy() && this->writer->TakeRequests(requests)) {
+		std::vector<Written> written;
+		this->writer->WriteAll(requests, written);
+		requests.clear();
+		this->writer->AddWritten(written);
+	}
+	return 0;
+}
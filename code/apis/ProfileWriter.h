@@ -0,0 +1,156 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef PROFILEWRITER_H
+#define PROFILEWRITER_H
+
+#include <vector>
+
+#include <wx/wx.h>
+#include <wx/fileconf.h>
+#include <wx/thread.h>
+
+#include "apis/EventHandlers.h"
+#include "datastructures/ProfileIndex.h"
+
+/** Files that were queued on a ProfileWriter have been written.
+ The owner should call ProfileWriter::CollectWritten(). */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_PROFILE_FILES_WRITTEN);
+
+/** Writes profiles to disk on a worker thread.
+ A file is written to a temporary file next to it, flushed to the disk and then
+ renamed over the old file, so that a crash while writing leaves either the old
+ or the new file, never part of one. Saves of a file that arrive while an earlier
+ save of it is still queued replace the earlier one, so a burst of saves writes
+ the file once. The files are written while holding the ProfileFolderLock, so
+ launchers that run at the same time do not write them at once; if the lock
+ cannot be taken, the files are not written. A save can ask for its file to be
+ checked under the same lock, so that it does not overwrite what another
+ launcher has written since the file was read. Files are deleted the same way,
+ so that a save that is still queued cannot bring a deleted file back. */
+class ProfileWriter {
+public:
+	/** The outcome of writing one file. */
+	struct Written {
+		Written(): id(0), quiet(false), removed(false), success(false), conflict(false) { }
+		unsigned long id; //!< as returned by Save() or Remove()
+		wxString filePath;
+		wxString name; //!< as given to Save()
+		bool quiet; //!< as given to Save()
+		bool removed; //!< the file was queued by Remove() rather than saved
+		bool success;
+		/** The file was not written, because another launcher has changed it
+		 since the stat that was given to Save(). */
+		bool conflict;
+		wxString error; //!< why the file could not be written
+		ProfileIndexEntry stat; //!< of the file right after it was written
+		/** The stamps of the folder that the lock file is in, from
+		 ProfileIndex::GetFolderStamp(), right before and after the file was written. */
+		wxString folderStampBefore;
+		wxString folderStampAfter;
+	};
+
+	/** lockFile is the ProfileFolderLock's lock file. */
+	ProfileWriter(wxEvtHandler* owner, const wxString& lockFile);
+	/** Writes whatever is still queued before returning. */
+	~ProfileWriter();
+
+	/** Queues the contents of config to be written to filePath.
+	 The contents are taken now, so config can change or be deleted right after.
+	 name and quiet are handed back in the Written for the file.
+	 If expected is not NULL, the file is only written if it is missing, has
+	 the stat in expected, or was last written by this writer; otherwise the
+	 Written for it has conflict set.
+	 Returns the id of the save, which increases with every save. When a save
+	 replaces a queued one, its Written stands for both. */
+	unsigned long Save(wxFileConfig& config, const wxString& filePath,
+		const wxString& name, bool quiet = false, const ProfileIndexEntry* expected = NULL);
+	/** Queues contents to be written to filePath, like Save().
+	 contents is swapped with an empty vector. */
+	unsigned long SaveContents(std::vector<char>& contents, const wxString& filePath,
+		const wxString& name, bool quiet = false);
+	/** Queues the file at filePath to be deleted, replacing a queued save of it.
+	 name is handed back in the Written for the file. A file that is already
+	 gone counts as deleted. Returns the id of the removal, like Save(). */
+	unsigned long Remove(const wxString& filePath, const wxString& name);
+	/** Waits until everything that has been queued is written.
+	 Call CollectWritten() afterwards to get the outcomes. */
+	void Flush();
+	/** Moves the outcomes of the writes that have finished into written.
+	 Must be called on the main thread. */
+	void CollectWritten(std::vector<Written>& written);
+	/** Returns true if nothing is queued or being written, and every outcome
+	 has been collected, so that the files on disk are the ones last collected. */
+	bool IsIdle();
+
+	/** Replaces the file at filePath with contents, through a temporary file.
+	 Runs on the worker thread, so it does not log; failures are only reported
+	 through error. */
+	static bool WriteAtomically(const wxString& filePath, const std::vector<char>& contents,
+		wxString& error);
+
+private:
+	struct Request {
+		Request(): id(0), quiet(false), remove(false), checkStat(false) { }
+		unsigned long id;
+		wxString filePath;
+		wxString name;
+		bool quiet;
+		bool remove; //!< delete the file rather than write it
+		bool checkStat;
+		ProfileIndexEntry expected; //!< if checkStat
+		std::vector<char> contents; //!< the file as it is written
+	};
+
+	class Worker: public wxThread {
+	public:
+		Worker(ProfileWriter* writer);
+		virtual ExitCode Entry();
+	private:
+		ProfileWriter* writer;
+	};
+	friend class Worker;
+
+	unsigned long Queue(Request& request);
+	bool StartWorker();
+	void StopWorker();
+	bool TakeRequests(std::vector<Request>& requests);
+	void AddWritten(std::vector<Written>& written);
+	void Write(const Request& request, Written& written);
+	void WriteAll(const std::vector<Request>& requests, std::vector<Written>& written);
+
+	wxEvtHandler* owner;
+	const wxString lockFile;
+	const wxString folder; //!< that the lock file is in
+	Worker* worker; //!< NULL until the first save, or if it could not be started
+	unsigned long lastId; //!< of the most recent save
+	/** The stat of each file right after this writer last wrote it.
+	 Only used by the thread that writes. */
+	ProfileIndexEntries writtenStats;
+
+	wxMutex mutex; //!< guards everything below
+	wxCondition requestAdded;
+	wxCondition writesFinished;
+	std::vector<Request> requests; //!< at most one per file
+	std::vector<Written> written;
+	bool writing; //!< the worker has taken requests that it has not finished
+	bool flushing;
+	bool stopping;
+};
+
+#endif
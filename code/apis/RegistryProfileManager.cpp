@@ -262,9 +262,9 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 	// Video
 	int width, height, bitdepth;
-	cfg->Read(PRO_CFG_VIDEO_RESOLUTION_WIDTH, &width, DEFAULT_VIDEO_RESOLUTION_WIDTH);
-	cfg->Read(PRO_CFG_VIDEO_RESOLUTION_HEIGHT, &height, DEFAULT_VIDEO_RESOLUTION_HEIGHT);
-	cfg->Read(PRO_CFG_VIDEO_BIT_DEPTH, &bitdepth, DEFAULT_VIDEO_BIT_DEPTH);
+	cfg->Read(PRO_CFG_VIDEO_RESOLUTION_WIDTH.GetPath(), &width, DEFAULT_VIDEO_RESOLUTION_WIDTH);
+	cfg->Read(PRO_CFG_VIDEO_RESOLUTION_HEIGHT.GetPath(), &height, DEFAULT_VIDEO_RESOLUTION_HEIGHT);
+	cfg->Read(PRO_CFG_VIDEO_BIT_DEPTH.GetPath(), &bitdepth, DEFAULT_VIDEO_BIT_DEPTH);
 
 	wxString videocardValue = wxString::Format(_T("OGL -(%dx%d)x%d bit"), width, height, bitdepth);
 	ret = RegSetValueExW(
@@ -278,7 +278,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	wxString filterMethod;
-	cfg->Read(PRO_CFG_VIDEO_TEXTURE_FILTER, &filterMethod, DEFAULT_VIDEO_TEXTURE_FILTER);
+	cfg->Read(PRO_CFG_VIDEO_TEXTURE_FILTER.GetPath(), &filterMethod, DEFAULT_VIDEO_TEXTURE_FILTER);
 	int filterMethodValue = ( filterMethod.StartsWith(_T("Bilinear"))) ? 0 : 1;
 
 	ret = RegSetValueExW(
@@ -292,7 +292,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	int oglAnisotropicFilterInt;
-	cfg->Read(PRO_CFG_VIDEO_ANISOTROPIC,
+	cfg->Read(PRO_CFG_VIDEO_ANISOTROPIC.GetPath(),
 		&oglAnisotropicFilterInt,
 		DEFAULT_VIDEO_ANISOTROPIC);
 
@@ -311,7 +311,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	int oglAntiAliasSample;
-	cfg->Read(PRO_CFG_VIDEO_ANTI_ALIAS, &oglAntiAliasSample, DEFAULT_VIDEO_ANTI_ALIAS);
+	cfg->Read(PRO_CFG_VIDEO_ANTI_ALIAS.GetPath(), &oglAntiAliasSample, DEFAULT_VIDEO_ANTI_ALIAS);
 		
 	ret = RegSetValueExW(
 		regHandle,
@@ -325,7 +325,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 	// Audio
 	wxString soundDevice;
-	cfg->Read(PRO_CFG_OPENAL_DEVICE, &soundDevice, DEFAULT_AUDIO_OPENAL_DEVICE);
+	cfg->Read(PRO_CFG_OPENAL_DEVICE.GetPath(), &soundDevice, DEFAULT_AUDIO_OPENAL_DEVICE);
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -354,7 +354,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 	wxString playbackDevice;
 	cfg->Read(
-		PRO_CFG_OPENAL_DEVICE,
+		PRO_CFG_OPENAL_DEVICE.GetPath(),
 		&playbackDevice,
 		DEFAULT_AUDIO_OPENAL_PLAYBACK_DEVICE);
 
@@ -370,7 +370,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 	wxString captureDevice;
 	bool hasEntry = cfg->Read(
-		PRO_CFG_OPENAL_CAPTURE_DEVICE,
+		PRO_CFG_OPENAL_CAPTURE_DEVICE.GetPath(),
 		&captureDevice,
 		DEFAULT_AUDIO_OPENAL_CAPTURE_DEVICE);
 
@@ -387,7 +387,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	int enableEFX;
-	hasEntry = cfg->Read(PRO_CFG_OPENAL_EFX, &enableEFX, DEFAULT_AUDIO_OPENAL_EFX);
+	hasEntry = cfg->Read(PRO_CFG_OPENAL_EFX.GetPath(), &enableEFX, DEFAULT_AUDIO_OPENAL_EFX);
 
 	if (hasEntry) {
 		ret = RegSetValueExW(
@@ -403,7 +403,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 	int sampleRate;
 	cfg->Read(
-		PRO_CFG_OPENAL_SAMPLE_RATE,
+		PRO_CFG_OPENAL_SAMPLE_RATE.GetPath(),
 		&sampleRate,
 		DEFAULT_AUDIO_OPENAL_SAMPLE_RATE);
 
@@ -424,7 +424,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 	// Speech
 	int speechVoice;
-	cfg->Read(PRO_CFG_SPEECH_VOICE, &speechVoice, DEFAULT_SPEECH_VOICE);
+	cfg->Read(PRO_CFG_SPEECH_VOICE.GetPath(), &speechVoice, DEFAULT_SPEECH_VOICE);
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -437,7 +437,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	int speechVolume;
-	cfg->Read(PRO_CFG_SPEECH_VOLUME, &speechVolume, DEFAULT_SPEECH_VOLUME);
+	cfg->Read(PRO_CFG_SPEECH_VOLUME.GetPath(), &speechVolume, DEFAULT_SPEECH_VOLUME);
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -450,10 +450,10 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	int inTechroom, inBriefings, inGame, inMulti;
-	cfg->Read(PRO_CFG_SPEECH_IN_TECHROOM, &inTechroom, DEFAULT_SPEECH_IN_TECHROOM);
-	cfg->Read(PRO_CFG_SPEECH_IN_BRIEFINGS, &inBriefings, DEFAULT_SPEECH_IN_BRIEFINGS);
-	cfg->Read(PRO_CFG_SPEECH_IN_GAME, &inGame, DEFAULT_SPEECH_IN_GAME);
-	cfg->Read(PRO_CFG_SPEECH_IN_MULTI, &inMulti, DEFAULT_SPEECH_IN_MULTI);
+	cfg->Read(PRO_CFG_SPEECH_IN_TECHROOM.GetPath(), &inTechroom, DEFAULT_SPEECH_IN_TECHROOM);
+	cfg->Read(PRO_CFG_SPEECH_IN_BRIEFINGS.GetPath(), &inBriefings, DEFAULT_SPEECH_IN_BRIEFINGS);
+	cfg->Read(PRO_CFG_SPEECH_IN_GAME.GetPath(), &inGame, DEFAULT_SPEECH_IN_GAME);
+	cfg->Read(PRO_CFG_SPEECH_IN_MULTI.GetPath(), &inMulti, DEFAULT_SPEECH_IN_MULTI);
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -494,7 +494,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 	// Joystick
 	int currentJoystick;
-	cfg->Read(PRO_CFG_JOYSTICK_ID, &currentJoystick, DEFAULT_JOYSTICK_ID);
+	cfg->Read(PRO_CFG_JOYSTICK_ID.GetPath(), &currentJoystick, DEFAULT_JOYSTICK_ID);
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -520,7 +520,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 	
 	int joystickForceFeedback;
 	cfg->Read(
-		PRO_CFG_JOYSTICK_FORCE_FEEDBACK,
+		PRO_CFG_JOYSTICK_FORCE_FEEDBACK.GetPath(),
 		&joystickForceFeedback,
 		DEFAULT_JOYSTICK_FORCE_FEEDBACK);
 
@@ -535,7 +535,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	int joystickHit;
-	cfg->Read(PRO_CFG_JOYSTICK_DIRECTIONAL, &joystickHit, DEFAULT_JOYSTICK_DIRECTIONAL);
+	cfg->Read(PRO_CFG_JOYSTICK_DIRECTIONAL.GetPath(), &joystickHit, DEFAULT_JOYSTICK_DIRECTIONAL);
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -549,7 +549,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 	// Network
 	wxString networkConnectionValue;
-	cfg->Read(PRO_CFG_NETWORK_TYPE, &networkConnectionValue, DEFAULT_NETWORK_TYPE);
+	cfg->Read(PRO_CFG_NETWORK_TYPE.GetPath(), &networkConnectionValue, DEFAULT_NETWORK_TYPE);
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -562,7 +562,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	wxString connectionSpeedValue;
-	cfg->Read(PRO_CFG_NETWORK_SPEED, &connectionSpeedValue, DEFAULT_NETWORK_SPEED);
+	cfg->Read(PRO_CFG_NETWORK_SPEED.GetPath(), &connectionSpeedValue, DEFAULT_NETWORK_SPEED);
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -575,7 +575,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	int forcedport;
-	cfg->Read(PRO_CFG_NETWORK_PORT, &forcedport, DEFAULT_NETWORK_PORT);
+	cfg->Read(PRO_CFG_NETWORK_PORT.GetPath(), &forcedport, DEFAULT_NETWORK_PORT);
 
 	if (forcedport != DEFAULT_NETWORK_PORT) {
 		ret = RegSetValueExW(
@@ -600,7 +600,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	wxString networkIP;
-	cfg->Read(PRO_CFG_NETWORK_IP, &networkIP, DEFAULT_NETWORK_IP);
+	cfg->Read(PRO_CFG_NETWORK_IP.GetPath(), &networkIP, DEFAULT_NETWORK_IP);
 
 	// Network folder (for custom IP address)
 	HKEY networkRegHandle = 0;
@@ -739,13 +739,13 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 			}
 		}
 		if ( width > 0 ) {
-			cfg->Write(PRO_CFG_VIDEO_RESOLUTION_WIDTH, width);
+			cfg->Write(PRO_CFG_VIDEO_RESOLUTION_WIDTH.GetPath(), width);
 		} 
 		if ( height > 0 ) {
-			cfg->Write(PRO_CFG_VIDEO_RESOLUTION_HEIGHT, height);
+			cfg->Write(PRO_CFG_VIDEO_RESOLUTION_HEIGHT.GetPath(), height);
 		}
 		if ( bitdepth > 0 ) {
-			cfg->Write(PRO_CFG_VIDEO_BIT_DEPTH, bitdepth);
+			cfg->Write(PRO_CFG_VIDEO_BIT_DEPTH.GetPath(), bitdepth);
 		}
 	}
 
@@ -769,7 +769,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 	} else if ( type != REG_DWORD && ret == ERROR_SUCCESS) {
 		wxLogWarning(REG_DATA_NOT_DWORD, __LINE__);
 	} else {
-		cfg->Write(PRO_CFG_VIDEO_TEXTURE_FILTER, static_cast<long>(numberdata));
+		cfg->Write(PRO_CFG_VIDEO_TEXTURE_FILTER.GetPath(), static_cast<long>(numberdata));
 	}
 
 
@@ -795,7 +795,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 
 		long anisotropic;
 		if ( !ani.IsEmpty() && ani.ToLong(&anisotropic)) {
-			cfg->Write(PRO_CFG_VIDEO_ANISOTROPIC, anisotropic);
+			cfg->Write(PRO_CFG_VIDEO_ANISOTROPIC.GetPath(), anisotropic);
 		}
 	}
 
@@ -817,7 +817,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 	} else if ( type != REG_DWORD && ret == ERROR_SUCCESS) {
 		wxLogWarning(REG_DATA_NOT_DWORD, __LINE__);
 	} else {
-		cfg->Write(PRO_CFG_VIDEO_ANTI_ALIAS, static_cast<long>(numberdata));
+		cfg->Write(PRO_CFG_VIDEO_ANTI_ALIAS.GetPath(), static_cast<long>(numberdata));
 	}
 
 
@@ -843,7 +843,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 		wxString soundDevice(data1, textConv, dataSize);
 
 		if ( !soundDevice.IsEmpty() ) {
-			cfg->Write(PRO_CFG_OPENAL_DEVICE, soundDevice);
+			cfg->Write(PRO_CFG_OPENAL_DEVICE.GetPath(), soundDevice);
 		}
 	}
 
@@ -882,8 +882,8 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 		const char* data1 = reinterpret_cast<char*>(data);
 		wxString playbackDevice(data1, textConv, dataSize);
 
-		if ( !playbackDevice.IsEmpty() && !cfg->Exists(PRO_CFG_OPENAL_DEVICE)) {
-			cfg->Write(PRO_CFG_OPENAL_DEVICE, playbackDevice);
+		if ( !playbackDevice.IsEmpty() && !cfg->Exists(PRO_CFG_OPENAL_DEVICE.GetPath())) {
+			cfg->Write(PRO_CFG_OPENAL_DEVICE.GetPath(), playbackDevice);
 		}
 	}
 
@@ -909,7 +909,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 		wxString captureDevice(data1, textConv, dataSize);
 
 		if ( !captureDevice.IsEmpty() ) {
-			cfg->Write(PRO_CFG_OPENAL_CAPTURE_DEVICE, captureDevice);
+			cfg->Write(PRO_CFG_OPENAL_CAPTURE_DEVICE.GetPath(), captureDevice);
 		}
 	}
 
@@ -931,7 +931,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 	} else if ( type != REG_DWORD && ret == ERROR_SUCCESS) {
 		wxLogWarning(REG_DATA_NOT_DWORD, __LINE__);
 	} else {
-		cfg->Write(PRO_CFG_OPENAL_EFX, static_cast<long>(numberdata));
+		cfg->Write(PRO_CFG_OPENAL_EFX.GetPath(), static_cast<long>(numberdata));
 	}
 
 
@@ -952,7 +952,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 	} else if ( type != REG_DWORD && ret == ERROR_SUCCESS) {
 		wxLogWarning(REG_DATA_NOT_DWORD, __LINE__);
 	} else {
-		cfg->Write(PRO_CFG_OPENAL_SAMPLE_RATE, static_cast<long>(numberdata));
+		cfg->Write(PRO_CFG_OPENAL_SAMPLE_RATE.GetPath(), static_cast<long>(numberdata));
 	}
 
 
@@ -974,7 +974,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 	} else if ( type != REG_DWORD && ret == ERROR_SUCCESS) {
 		wxLogWarning(REG_DATA_NOT_DWORD, __LINE__);
 	} else {
-		cfg->Write(PRO_CFG_SPEECH_VOICE, static_cast<long>(numberdata));
+		cfg->Write(PRO_CFG_SPEECH_VOICE.GetPath(), static_cast<long>(numberdata));
 	}
 
 
@@ -995,7 +995,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 	} else if ( type != REG_DWORD && ret == ERROR_SUCCESS) {
 		wxLogWarning(REG_DATA_NOT_DWORD, __LINE__);
 	} else {
-		cfg->Write(PRO_CFG_SPEECH_VOLUME, static_cast<long>(numberdata));
+		cfg->Write(PRO_CFG_SPEECH_VOLUME.GetPath(), static_cast<long>(numberdata));
 	}
 
 
@@ -1016,7 +1016,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 	} else if ( type != REG_DWORD && ret == ERROR_SUCCESS) {
 		wxLogWarning(REG_DATA_NOT_DWORD, __LINE__);
 	} else {
-		cfg->Write(PRO_CFG_SPEECH_IN_TECHROOM, static_cast<long>(numberdata));
+		cfg->Write(PRO_CFG_SPEECH_IN_TECHROOM.GetPath(), static_cast<long>(numberdata));
 	}
 
 
@@ -1037,7 +1037,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 	} else if ( type != REG_DWORD && ret == ERROR_SUCCESS) {
 		wxLogWarning(REG_DATA_NOT_DWORD, __LINE__);
 	} else {
-		cfg->Write(PRO_CFG_SPEECH_IN_BRIEFINGS, static_cast<long>(numberdata));
+		cfg->Write(PRO_CFG_SPEECH_IN_BRIEFINGS.GetPath(), static_cast<long>(numberdata));
 	}
 
 
@@ -1058,7 +1058,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 	} else if ( type != REG_DWORD && ret == ERROR_SUCCESS) {
 		wxLogWarning(REG_DATA_NOT_DWORD, __LINE__);
 	} else {
-		cfg->Write(PRO_CFG_SPEECH_IN_GAME, static_cast<long>(numberdata));
+		cfg->Write(PRO_CFG_SPEECH_IN_GAME.GetPath(), static_cast<long>(numberdata));
 	}
 
 
@@ -1079,7 +1079,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 	} else if ( type != REG_DWORD && ret == ERROR_SUCCESS) {
 		wxLogWarning(REG_DATA_NOT_DWORD, __LINE__);
 	} else {
-		cfg->Write(PRO_CFG_SPEECH_IN_MULTI, static_cast<long>(numberdata));
+		cfg->Write(PRO_CFG_SPEECH_IN_MULTI.GetPath(), static_cast<long>(numberdata));
 	}
 
 		
@@ -1101,7 +1101,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 	} else if ( type != REG_DWORD && ret == ERROR_SUCCESS) {
 		wxLogWarning(REG_DATA_NOT_DWORD, __LINE__);
 	} else {
-		cfg->Write(PRO_CFG_JOYSTICK_ID, static_cast<long>(numberdata));
+		cfg->Write(PRO_CFG_JOYSTICK_ID.GetPath(), static_cast<long>(numberdata));
 	}
 
 
@@ -1122,7 +1122,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 	} else if ( type != REG_DWORD && ret == ERROR_SUCCESS) {
 		wxLogWarning(REG_DATA_NOT_DWORD, __LINE__);
 	} else {
-		cfg->Write(PRO_CFG_JOYSTICK_FORCE_FEEDBACK, static_cast<long>(numberdata));
+		cfg->Write(PRO_CFG_JOYSTICK_FORCE_FEEDBACK.GetPath(), static_cast<long>(numberdata));
 	}
 
 
@@ -1143,7 +1143,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 	} else if ( type != REG_DWORD && ret == ERROR_SUCCESS) {
 		wxLogWarning(REG_DATA_NOT_DWORD, __LINE__);
 	} else {
-		cfg->Write(PRO_CFG_JOYSTICK_DIRECTIONAL, static_cast<long>(numberdata));
+		cfg->Write(PRO_CFG_JOYSTICK_DIRECTIONAL.GetPath(), static_cast<long>(numberdata));
 	}
 		
 
@@ -1169,7 +1169,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 		wxString connection(data1, textConv, dataSize);
 
 		if ( !connection.IsEmpty() ) {
-			cfg->Write(PRO_CFG_NETWORK_TYPE, connection);
+			cfg->Write(PRO_CFG_NETWORK_TYPE.GetPath(), connection);
 		}
 	}
 
@@ -1195,7 +1195,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 		wxString speed(data1, textConv, dataSize);
 
 		if ( !speed.IsEmpty() ) {
-			cfg->Write(PRO_CFG_NETWORK_SPEED, speed);
+			cfg->Write(PRO_CFG_NETWORK_SPEED.GetPath(), speed);
 		}
 	}
 
@@ -1217,7 +1217,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 	} else if ( type != REG_DWORD && ret == ERROR_SUCCESS) {
 		wxLogWarning(REG_DATA_NOT_DWORD, __LINE__);
 	} else {
-		cfg->Write(PRO_CFG_NETWORK_PORT, static_cast<long>(numberdata));
+		cfg->Write(PRO_CFG_NETWORK_PORT.GetPath(), static_cast<long>(numberdata));
 	}
 
 
@@ -1257,7 +1257,7 @@ ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg) {
 		wxString ip(data1, textConv, dataSize);
 
 		if ( !ip.IsEmpty() ) {
-			cfg->Write(PRO_CFG_NETWORK_IP, ip);
+			cfg->Write(PRO_CFG_NETWORK_IP.GetPath(), ip);
 		}
 	}
 
@@ -127,13 +127,13 @@ bool Skin::SetModImage(const wxBitmap& modImage) {
 		wxImage tempModImage(modImage.ConvertToImage());
 		wxImage scaledTempModImage(
 			tempModImage.Scale(
-				SkinSystem::ModListImageWidth,
-				SkinSystem::ModListImageHeight,
+				SkinSystem::ModInfoDialogImageWidth,
+				SkinSystem::ModInfoDialogImageHeight,
 				wxIMAGE_QUALITY_HIGH));
 		
 		wxBitmap newModImage(scaledTempModImage);
-		wxASSERT(newModImage.GetWidth() == SkinSystem::ModListImageWidth);
-		wxASSERT(newModImage.GetHeight() == SkinSystem::ModListImageHeight);
+		wxASSERT(newModImage.GetWidth() == SkinSystem::ModInfoDialogImageWidth);
+		wxASSERT(newModImage.GetHeight() == SkinSystem::ModInfoDialogImageHeight);
 		
 		this->modImage = wxBitmap(newModImage);
 		return true;
@@ -142,6 +142,7 @@ bool Skin::SetModImage(const wxBitmap& modImage) {
 		wxLogDebug(_T("Provided mod image size %dx%d is smaller than expected size %dx%d. Using as is."),
 			modImage.GetWidth(), modImage.GetHeight(),
 			SkinSystem::ModInfoDialogImageWidth, SkinSystem::ModInfoDialogImageHeight);
+		this->modImage = modImage;
 		return true;
 	} else {
 		this->modImage = modImage;
@@ -702,31 +703,36 @@ bool SkinSystem::SearchFile(wxFileName& filename, wxString currentTC,
 }
 
 wxBitmap SkinSystem::MakeModListImage(const wxBitmap &orig) {
+	return wxBitmap(MakeModListImage(orig.ConvertToImage()));
+}
+
+wxBitmap SkinSystem::MakeModInfoDialogImage(const wxBitmap &orig) {
+	return wxBitmap(MakeModInfoDialogImage(orig.ConvertToImage()));
+}
+
+/** Unlike the wxBitmap versions, these can be used on any thread. */
+wxImage SkinSystem::MakeModListImage(const wxImage &orig) {
 	wxASSERT(orig.GetWidth() == SkinSystem::ModInfoDialogImageWidth);
 	wxASSERT(orig.GetHeight() == SkinSystem::ModInfoDialogImageHeight);
 	
-	wxImage temp(orig.ConvertToImage());
-	wxImage scaledTemp(temp.Scale(SkinSystem::ModListImageWidth,
+	wxImage outimg(orig.Scale(SkinSystem::ModListImageWidth,
 		SkinSystem::ModListImageHeight,
 		wxIMAGE_QUALITY_HIGH));
 	
-	wxBitmap outimg(scaledTemp);
 	wxASSERT(outimg.GetWidth() == SkinSystem::ModListImageWidth);
 	wxASSERT(outimg.GetHeight() == SkinSystem::ModListImageHeight);
 	
 	return outimg;
 }
 
-wxBitmap SkinSystem::MakeModInfoDialogImage(const wxBitmap &orig) {
+wxImage SkinSystem::MakeModInfoDialogImage(const wxImage &orig) {
 	wxASSERT(orig.GetWidth() == SkinSystem::ModListImageWidth);
 	wxASSERT(orig.GetHeight() == SkinSystem::ModListImageHeight);
 	
-	wxImage temp(orig.ConvertToImage());
-	wxImage scaledTemp(temp.Scale(SkinSystem::ModInfoDialogImageWidth,
+	wxImage outimg(orig.Scale(SkinSystem::ModInfoDialogImageWidth,
 		SkinSystem::ModInfoDialogImageHeight,
 		wxIMAGE_QUALITY_HIGH));
 	
-	wxBitmap outimg(scaledTemp);
 	wxASSERT(outimg.GetWidth() == SkinSystem::ModInfoDialogImageWidth);
 	wxASSERT(outimg.GetHeight() == SkinSystem::ModInfoDialogImageHeight);
 	
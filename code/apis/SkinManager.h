@@ -151,6 +151,8 @@ public:
 
 	static wxBitmap MakeModListImage(const wxBitmap &orig);
 	static wxBitmap MakeModInfoDialogImage(const wxBitmap &orig);
+	static wxImage MakeModListImage(const wxImage &orig);
+	static wxImage MakeModInfoDialogImage(const wxImage &orig);
 
 	static bool SearchFile(wxFileName& filename, wxString currentTC,
 		wxString shortmodname, wxString filepath);
@@ -0,0 +1,310 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "generated/configure_launcher.h"
+#include "apis/TCFolderWatcher.h"
+#include "datastructures/ModIniScanner.h"
+#include "global/ids.h"
+#include "global/Utils.h"
+
+#include <wx/dir.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+#include "global/MemoryDebugging.h"
+
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_TC_MOD_INIS_CHANGED);
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_TC_FOLDER_SCANNED);
+
+#if TC_FOLDER_WATCHER_NATIVE
+/** How long to wait before the first scan, which also sets up the watches.
+ wxFileSystemWatcher cannot be created before the event loop is running. */
+const int INITIAL_SCAN_DELAY_MS = 1000;
+/** How long to wait after the last change before scanning, so that unpacking
+ a mod causes one scan instead of one per file. */
+const int RESCAN_DELAY_MS = 500;
+#else
+/** How often the TC folder is scanned when changes are not reported by the
+ operating system. */
+const int POLL_INTERVAL_MS = 5000;
+#endif
+
+TCFolderWatcher::TCFolderWatcher(wxEvtHandler* owner)
+: owner(owner), timer(this, ID_TC_FOLDER_WATCHER_TIMER),
+scanner(NULL), scans(0), rescan(false)
+#if TC_FOLDER_WATCHER_NATIVE
+, watcher(NULL)
+#endif
+{
+	wxASSERT(owner != NULL);
+}
+
+TCFolderWatcher::~TCFolderWatcher() {
+	this->Stop();
+}
+
+BEGIN_EVENT_TABLE(TCFolderWatcher, wxEvtHandler)
+EVT_TIMER(ID_TC_FOLDER_WATCHER_TIMER, TCFolderWatcher::OnTimer)
+EVT_COMMAND(wxID_NONE, EVT_TC_FOLDER_SCANNED, TCFolderWatcher::OnScanFinished)
+#if TC_FOLDER_WATCHER_NATIVE
+EVT_FSWATCHER(wxID_ANY, TCFolderWatcher::OnFileSystemEvent)
+#endif
+END_EVENT_TABLE()
+
+void TCFolderWatcher::Start(const wxString& tcPath, const wxArrayString& modInis) {
+	this->Stop();
+	wxCHECK_RET(!tcPath.IsEmpty(), _T("TCFolderWatcher::Start(): tcPath is empty"));
+
+	this->tcPath = tcPath;
+	wxString signature;
+	for (size_t i = 0; i < modInis.GetCount(); i++) {
+		if (ReadSignature(modInis[i], signature)) {
+			this->modInis[modInis[i]] = signature;
+		}
+	}
+
+#if TC_FOLDER_WATCHER_NATIVE
+	this->timer.Start(INITIAL_SCAN_DELAY_MS, wxTIMER_ONE_SHOT);
+#else
+	this->timer.Start(POLL_INTERVAL_MS, wxTIMER_CONTINUOUS);
+#endif
+	wxLogDebug(_T("TCFolderWatcher: watching %s (") SZT _T(" mod.ini file(s))"),
+		this->tcPath.c_str(), this->modInis.size());
+}
+
+void TCFolderWatcher::Stop() {
+	this->timer.Stop();
+	this->StopScan();
+#if TC_FOLDER_WATCHER_NATIVE
+	if (this->watcher != NULL) {
+		delete this->watcher;
+		this->watcher = NULL;
+	}
+	this->watchedFolders.Clear();
+#endif
+	this->tcPath.Clear();
+	this->modInis.clear();
+	this->pending.added.Clear();
+	this->pending.changed.Clear();
+	this->pending.removed.Clear();
+}
+
+void TCFolderWatcher::TakeChanges(ModIniChanges& changes) {
+	changes = this->pending;
+	this->pending.added.Clear();
+	this->pending.changed.Clear();
+	this->pending.removed.Clear();
+}
+
+void TCFolderWatcher::OnTimer(wxTimerEvent& WXUNUSED(event)) {
+	this->StartScan();
+}
+
+#if TC_FOLDER_WATCHER_NATIVE
+void TCFolderWatcher::OnFileSystemEvent(wxFileSystemWatcherEvent& event) {
+	const int type = event.GetChangeType();
+	const wxFileName& path(event.GetPath());
+
+	// lost events could have been anything, a mod.ini is always interesting,
+	// and a path that is not a file may be a mod folder
+	if ((type & (wxFSW_EVENT_WARNING | wxFSW_EVENT_ERROR)) != 0
+		|| path.GetFullName().EndsWith(_T("mod.ini"))
+		|| (type != wxFSW_EVENT_MODIFY && !path.FileExists())) {
+		wxLogDebug(_T("TCFolderWatcher: %s"), event.ToString().c_str());
+		this->timer.Start(RESCAN_DELAY_MS, wxTIMER_ONE_SHOT);
+	}
+}
+#endif
+
+/** Gets a string that changes whenever the mod.ini's contents are likely to
+ have changed. Returns false if the mod.ini cannot be examined.
+ Also called on the scanner thread, so it does not log. */
+bool TCFolderWatcher::ReadSignature(const wxString& modIniPath, wxString& signature) {
+	wxStructStat stat;
+	if (wxStat(modIniPath, &stat) != 0 || (stat.st_mode & S_IFMT) != S_IFREG) {
+		return false;
+	}
+
+	signature = wxULongLong(static_cast<wxULongLong_t>(stat.st_size)).ToString()
+		+ _T(":") + wxLongLong(static_cast<wxLongLong_t>(stat.st_mtime)).ToString();
+	return true;
+}
+
+/** Starts scanning the TC folder on a worker thread, unless a scan is
+ already running. OnScanFinished() compares the results. */
+void TCFolderWatcher::StartScan() {
+	if (this->tcPath.IsEmpty()) {
+		return;
+	}
+	if (this->scanner != NULL) {
+#if TC_FOLDER_WATCHER_NATIVE
+		// the running scan may have missed the change
+		this->rescan = true;
+#endif
+		// when polling, the next poll catches whatever this one would have
+		return;
+	}
+
+	this->scans++;
+	Scanner* scanner = new Scanner(this, this->tcPath, this->scans);
+	if (scanner->Create() != wxTHREAD_NO_ERROR || scanner->Run() != wxTHREAD_NO_ERROR) {
+		wxLogDebug(_T("TCFolderWatcher: could not start the scanner thread"));
+		delete scanner;
+		return;
+	}
+	this->scanner = scanner;
+	this->rescan = false;
+}
+
+/** Stops the running scan, if there is one, and discards its results. */
+void TCFolderWatcher::StopScan() {
+	if (this->scanner != NULL) {
+		this->scanner->Delete();
+		delete this->scanner;
+		this->scanner = NULL;
+	}
+	this->rescan = false;
+}
+
+void TCFolderWatcher::OnScanFinished(wxCommandEvent& event) {
+	if (this->scanner == NULL || event.GetInt() != this->scanner->id) {
+		return; // from a scan that has been stopped
+	}
+
+	this->scanner->Wait();
+	Scanner* scanner = this->scanner;
+	this->scanner = NULL;
+
+	if (scanner->found) {
+		this->CompareModInis(scanner->modInis);
+#if TC_FOLDER_WATCHER_NATIVE
+		this->UpdateWatchedFolders(scanner->folders);
+#endif
+	} else {
+		wxLogDebug(_T("TCFolderWatcher: %s no longer exists"), this->tcPath.c_str());
+	}
+	delete scanner;
+
+	if (this->rescan) {
+		this->StartScan();
+	}
+}
+
+/** Compares the mod.ini files that a scan found against the ones that were
+ last seen. The owner is notified if any have changed. */
+void TCFolderWatcher::CompareModInis(const ModIniSignatures& current) {
+	bool changed = false;
+	for (ModIniSignatures::const_iterator it = current.begin(); it != current.end(); ++it) {
+		ModIniSignatures::const_iterator known = this->modInis.find(it->first);
+		if (known == this->modInis.end()) {
+			if (this->pending.added.Index(it->first) == wxNOT_FOUND) {
+				this->pending.added.Add(it->first);
+			}
+			changed = true;
+		} else if (known->second != it->second) {
+			if (this->pending.changed.Index(it->first) == wxNOT_FOUND) {
+				this->pending.changed.Add(it->first);
+			}
+			changed = true;
+		}
+	}
+	for (ModIniSignatures::const_iterator it = this->modInis.begin(); it != this->modInis.end(); ++it) {
+		if (current.find(it->first) == current.end()) {
+			if (this->pending.removed.Index(it->first) == wxNOT_FOUND) {
+				this->pending.removed.Add(it->first);
+			}
+			changed = true;
+		}
+	}
+	this->modInis = current;
+
+	if (changed) {
+		wxCommandEvent event(EVT_TC_MOD_INIS_CHANGED, wxID_NONE);
+		wxLogDebug(_T("Generating EVT_TC_MOD_INIS_CHANGED event (") SZT _T(" added, ")
+			SZT _T(" changed, ") SZT _T(" removed)"),
+			this->pending.added.GetCount(), this->pending.changed.GetCount(),
+			this->pending.removed.GetCount());
+		this->owner->AddPendingEvent(event);
+		wxLogDebug(_T(" Sent EVT_TC_MOD_INIS_CHANGED event to %p"), this->owner);
+	}
+}
+
+#if TC_FOLDER_WATCHER_NATIVE
+/** Watches the folders that the last scan searched, and stops watching the
+ ones that it no longer searched. */
+void TCFolderWatcher::UpdateWatchedFolders(const std::vector<wxString>& folders) {
+	if (this->watcher == NULL) {
+		this->watcher = new wxFileSystemWatcher();
+		this->watcher->SetOwner(this);
+	}
+
+	wxSortedArrayString wanted;
+	for (size_t i = 0; i < folders.size(); i++) {
+		wanted.Add(folders[i]);
+	}
+
+	{
+		// the folder may already be gone, in which case so is the watch,
+		// and the failure to remove it is not worth reporting
+		wxLogNull noLog;
+		for (size_t i = 0; i < this->watchedFolders.GetCount(); i++) {
+			if (wanted.Index(this->watchedFolders[i]) == wxNOT_FOUND) {
+				this->watcher->Remove(wxFileName::DirName(this->watchedFolders[i]));
+			}
+		}
+	}
+	for (size_t i = 0; i < wanted.GetCount(); i++) {
+		if (this->watchedFolders.Index(wanted[i]) == wxNOT_FOUND) {
+			if (!this->watcher->Add(wxFileName::DirName(wanted[i]),
+					wxFSW_EVENT_CREATE | wxFSW_EVENT_DELETE | wxFSW_EVENT_RENAME |
+					wxFSW_EVENT_MODIFY | wxFSW_EVENT_WARNING | wxFSW_EVENT_ERROR)) {
+				wxLogDebug(_T("TCFolderWatcher: unable to watch %s"), wanted[i].c_str());
+			}
+		}
+	}
+	this->watchedFolders = wanted;
+}
+#endif
+
+// wxString is not guaranteed to be safe to share between threads,
+// so the scanner gets its own copy of the path.
+TCFolderWatcher::Scanner::Scanner(TCFolderWatcher* watcher, const wxString& tcPath, int id)
+: wxThread(wxTHREAD_JOINABLE), found(false), id(id), watcher(watcher),
+tcPath(tcPath.c_str()) {
+}
+
+wxThread::ExitCode TCFolderWatcher::Scanner::Entry() {
+	this->found = wxDir::Exists(this->tcPath);
+	if (this->found) {
+		ModIniScanner scanner(this->tcPath);
+		scanner.Start();
+
+		wxString modIniPath, signature;
+		while (!this->TestDestroy() && scanner.GetNextModIni(modIniPath)) {
+			if (ReadSignature(modIniPath, signature)) {
+				this->modInis[modIniPath] = signature;
+			}
+		}
+		scanner.GetFolders(this->folders);
+	}
+
+	wxCommandEvent event(EVT_TC_FOLDER_SCANNED, wxID_NONE);
+	event.SetInt(this->id);
+	this->watcher->AddPendingEvent(event);
+	return 0;
+}
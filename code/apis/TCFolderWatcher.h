@@ -0,0 +1,129 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef TCFOLDERWATCHER_H
+#define TCFOLDERWATCHER_H
+
+#include <vector>
+
+#include <wx/wx.h>
+#include <wx/hashmap.h>
+#include <wx/thread.h>
+#include <wx/timer.h>
+
+#include "apis/EventHandlers.h"
+
+// wxFileSystemWatcher (inotify on Linux) is only available in wxWidgets 2.9.1
+// and later; older versions fall back to polling the TC folder.
+#if defined(wxUSE_FSWATCHER) && wxUSE_FSWATCHER
+#define TC_FOLDER_WATCHER_NATIVE 1
+#include <wx/fswatcher.h>
+#else
+#define TC_FOLDER_WATCHER_NATIVE 0
+#endif
+
+/** Mod.ini files in the watched TC folder have been added, changed or removed.
+ The changes are collected with TCFolderWatcher::TakeChanges(). */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_TC_MOD_INIS_CHANGED);
+/** Used internally: a scan of the TC folder has finished on the worker thread. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_TC_FOLDER_SCANNED);
+
+/** The mod.ini files that changed since the last call to TakeChanges(). */
+struct ModIniChanges {
+	wxArrayString added;
+	wxArrayString changed;
+	wxArrayString removed;
+
+	inline bool IsEmpty() const {
+		return this->added.IsEmpty() && this->changed.IsEmpty() && this->removed.IsEmpty();
+	}
+};
+
+/** Size and modification time of each known mod.ini, keyed by its full path. */
+WX_DECLARE_STRING_HASH_MAP(wxString, ModIniSignatures);
+
+/** Watches a TC folder for mod.ini files that are added, changed or removed
+ and notifies its owner with EVT_TC_MOD_INIS_CHANGED.
+ The same folders that ModIniScanner searches are watched. Where the
+ platform supports it the operating system reports changes to those folders,
+ otherwise the folders are polled. Either way the TC folder is scanned on a
+ worker thread and the mod.ini files are compared against the ones that were
+ last seen, so the owner is only told about mods that really changed. */
+class TCFolderWatcher: public wxEvtHandler {
+public:
+	TCFolderWatcher(wxEvtHandler* owner);
+	~TCFolderWatcher();
+
+	/** Starts watching tcPath. modInis are the mod.ini files that the owner
+	 already knows about. */
+	void Start(const wxString& tcPath, const wxArrayString& modInis);
+	/** Stops watching. Changes that have not been taken are discarded. */
+	void Stop();
+
+	/** Moves the changes found since the last call into changes. */
+	void TakeChanges(ModIniChanges& changes);
+
+	void OnTimer(wxTimerEvent& event);
+	void OnScanFinished(wxCommandEvent& event);
+#if TC_FOLDER_WATCHER_NATIVE
+	void OnFileSystemEvent(wxFileSystemWatcherEvent& event);
+#endif
+
+private:
+	/** Finds the mod.ini files in the TC folder and reads their signatures.
+	 Runs on its own thread, so it does not log. */
+	class Scanner: public wxThread {
+	public:
+		Scanner(TCFolderWatcher* watcher, const wxString& tcPath, int id);
+		virtual ExitCode Entry();
+
+		// the results, only to be read once the thread has exited
+		bool found; //!< false if the TC folder does not exist
+		ModIniSignatures modInis;
+		std::vector<wxString> folders; //!< that were searched
+		const int id;
+	private:
+		TCFolderWatcher* watcher;
+		const wxString tcPath;
+	};
+
+	static bool ReadSignature(const wxString& modIniPath, wxString& signature);
+
+	void StartScan();
+	void StopScan();
+	void CompareModInis(const ModIniSignatures& current);
+	void UpdateWatchedFolders(const std::vector<wxString>& folders);
+
+	wxEvtHandler* owner;
+	wxString tcPath; //!< empty if not watching
+	wxTimer timer; //!< delays the rescan after a change, or polls
+	ModIniSignatures modInis; //!< the mod.ini files that were last seen
+	ModIniChanges pending; //!< changes not yet taken by the owner
+	Scanner* scanner; //!< the scan that is running, or NULL
+	int scans; //!< number of scans that have been started, for telling them apart
+	bool rescan; //!< something changed while the scan was running
+
+#if TC_FOLDER_WATCHER_NATIVE
+	wxFileSystemWatcher* watcher; //!< created on the first rescan, once the event loop is running
+	wxSortedArrayString watchedFolders;
+#endif
+
+	DECLARE_EVENT_TABLE()
+};
+
+#endif
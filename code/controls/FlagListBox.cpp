@@ -22,50 +22,34 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "apis/SkinManager.h"
 #include "global/ids.h"
 
-#include "global/MemoryDebugging.h"
-
-FlagListCheckBox::FlagListCheckBox(
-	wxWindow* parent,
-	const wxString& label,
-	const wxString& flagString)
-: wxCheckBox(parent, wxID_ANY, label),
-  flagString(flagString) {
-	  wxASSERT(parent != NULL);
-	  wxASSERT(!flagString.IsEmpty());
-}
+#include <wx/renderer.h>
+#if wxUSE_ACCESSIBILITY
+#include <wx/access.h>
+#endif
 
-void FlagListCheckBox::OnClicked(wxCommandEvent &WXUNUSED(event)) {
-	ProfileProxy::GetProxy()->SetFlag(this->flagString, this->IsChecked());
-	
-	wxLogDebug(_T("flag %s is now %s"),
-		flagString.c_str(), this->IsChecked() ? _T("on") : _T("off"));
-}
+#include "global/MemoryDebugging.h"
 
 FlagListCheckBoxItem::FlagListCheckBoxItem(const wxString& fsoCategory)
-: fsoCategory(fsoCategory), checkBox(NULL), checkBoxSizer(NULL),
+: fsoCategory(fsoCategory),
   shortDescription(wxEmptyString), flagString(wxEmptyString),
   isRecommendedFlag(false) {
 	  wxASSERT(!fsoCategory.IsEmpty());
 }
 
 FlagListCheckBoxItem::FlagListCheckBoxItem(
-	FlagListCheckBox& checkBox, wxSizer& checkBoxSizer,
 	const wxString& shortDescription, const wxString& flagString,
 	const bool isRecommendedFlag)
-: fsoCategory(wxEmptyString), checkBox(&checkBox), checkBoxSizer(&checkBoxSizer),
+: fsoCategory(wxEmptyString),
   shortDescription(shortDescription), flagString(flagString),
   isRecommendedFlag(isRecommendedFlag) {
 	  // shortDescription can be empty
 	  wxASSERT(!flagString.IsEmpty());
 }
 
-FlagListCheckBoxItem::~FlagListCheckBoxItem() {
-	delete this->checkBoxSizer;
+const wxString& FlagListCheckBoxItem::GetLabel() const {
+	return this->shortDescription.IsEmpty() ? this->flagString : this->shortDescription;
 }
 
-#include <wx/listimpl.cpp> // Magic Incantation
-WX_DEFINE_LIST(FlagListCheckBoxItems);
-
 LAUNCHER_DEFINE_EVENT_TYPE(EVT_FLAG_LIST_BOX_READY);
 
 void FlagListBox::RegisterFlagListBoxReady(wxEvtHandler *handler) {
@@ -112,6 +96,13 @@ struct FlagInfo {
 
 #define WIDTH_OF_CHECKBOX 16
 
+/** Where a flag's check box is drawn in its row. */
+static wxRect GetCheckBoxRect(const wxRect& row) {
+	return wxRect(row.x + SkinSystem::IdealIconWidth,
+		row.y + (row.height - WIDTH_OF_CHECKBOX) / 2,
+		WIDTH_OF_CHECKBOX, WIDTH_OF_CHECKBOX);
+}
+
 // allows flag checkbox and text to be lined up, while avoiding
 // visual collisions with flag category lines
 const int ITEM_VERTICAL_OFFSET = 2; // in pixels
@@ -121,6 +112,89 @@ const int VERTICAL_OFFSET_MULTIPLIER = 2; // in pixels
 const int VERTICAL_OFFSET_MULTIPLIER = 1; // in pixels
 #endif
 
+#if wxUSE_ACCESSIBILITY
+/** Tells screen readers about the flag rows and their check boxes, which
+ are drawn by the flag list box and so are not windows that they can find.
+ Child ids are the row plus one; id 0 is the list itself. */
+class FlagListBoxAccessible: public wxWindowAccessible {
+public:
+	FlagListBoxAccessible(FlagListBox* flagListBox)
+	: wxWindowAccessible(flagListBox), flagListBox(flagListBox) { }
+	
+	virtual wxAccStatus GetChildCount(int* childCount) {
+		*childCount = static_cast<int>(this->flagListBox->GetItemCount());
+		return wxACC_OK;
+	}
+	virtual wxAccStatus GetChild(int childId, wxAccessible** child) {
+		// the rows are simple elements, not objects of their own
+		*child = (childId == wxACC_SELF) ? this : NULL;
+		return wxACC_OK;
+	}
+	virtual wxAccStatus GetName(int childId, wxString* name) {
+		const FlagListCheckBoxItem* item = this->GetItem(childId);
+		if (item == NULL) {
+			return wxWindowAccessible::GetName(childId, name);
+		}
+		*name = item->IsCategory() ? item->GetFsoCategory() : item->GetLabel();
+		return wxACC_OK;
+	}
+	virtual wxAccStatus GetRole(int childId, wxAccRole* role) {
+		const FlagListCheckBoxItem* item = this->GetItem(childId);
+		if (item == NULL) {
+			*role = wxROLE_SYSTEM_LIST;
+		} else {
+			*role = item->IsCategory() ? wxROLE_SYSTEM_STATICTEXT : wxROLE_SYSTEM_CHECKBUTTON;
+		}
+		return wxACC_OK;
+	}
+	virtual wxAccStatus GetState(int childId, long* state) {
+		const FlagListCheckBoxItem* item = this->GetItem(childId);
+		if (item == NULL) {
+			return wxWindowAccessible::GetState(childId, state);
+		}
+		const size_t n = static_cast<size_t>(childId - 1);
+		const size_t row = this->flagListBox->visibleRows[n];
+		*state = wxACC_STATE_SYSTEM_SELECTABLE | wxACC_STATE_SYSTEM_FOCUSABLE;
+		if (this->flagListBox->IsCurrent(n)) {
+			*state |= wxACC_STATE_SYSTEM_SELECTED | wxACC_STATE_SYSTEM_FOCUSED;
+		}
+		if (!item->IsCategory() && this->flagListBox->checkedFlags.Test(row)) {
+			*state |= wxACC_STATE_SYSTEM_CHECKED;
+		}
+		return wxACC_OK;
+	}
+	virtual wxAccStatus GetDefaultAction(int childId, wxString* actionName) {
+		const FlagListCheckBoxItem* item = this->GetItem(childId);
+		if (item == NULL || item->IsCategory()) {
+			return wxACC_NOT_SUPPORTED;
+		}
+		const size_t row = this->flagListBox->visibleRows[childId - 1];
+		*actionName = this->flagListBox->checkedFlags.Test(row) ? _("Uncheck") : _("Check");
+		return wxACC_OK;
+	}
+	virtual wxAccStatus DoDefaultAction(int childId) {
+		const FlagListCheckBoxItem* item = this->GetItem(childId);
+		if (item == NULL || item->IsCategory()) {
+			return wxACC_NOT_SUPPORTED;
+		}
+		this->flagListBox->ToggleFlag(static_cast<size_t>(childId - 1));
+		return wxACC_OK;
+	}
+	
+private:
+	/** Returns NULL for the list itself, or if there is no such row. */
+	const FlagListCheckBoxItem* GetItem(int childId) const {
+		if (!this->flagListBox->IsReady() || childId <= 0
+				|| static_cast<size_t>(childId) > this->flagListBox->visibleRows.size()) {
+			return NULL;
+		}
+		return this->flagListBox->FindFlagAt(childId - 1);
+	}
+	
+	FlagListBox* flagListBox;
+};
+#endif
+
 FlagListBox::FlagListBox(wxWindow* parent)
 : wxVListBox(parent,ID_FLAGLISTBOX),
   isReadyEventGenerated(false),
@@ -128,6 +202,9 @@ FlagListBox::FlagListBox(wxWindow* parent)
   flagsLoaded(false),
   flagData(NULL),
   areCheckBoxesGenerated(false) {
+#if wxUSE_ACCESSIBILITY
+	this->SetAccessible(new FlagListBoxAccessible(this));
+#endif
 }
 
 void FlagListBox::AcceptFlagData(FlagFileData* flagData) {
@@ -142,7 +219,7 @@ void FlagListBox::AcceptFlagData(FlagFileData* flagData) {
 	wxCHECK_RET(data != NULL,
 		_T("AcceptFlagData(): FlagFileData::GenerateFlagListBoxData() returned null."));
 	this->GenerateCheckBoxes(*data);
-	this->SetItemCount(flagData->GetItemCount());
+	this->SetFilter(wxEmptyString);
 
 	this->GenerateFlagListBoxReady();
 }
@@ -152,8 +229,8 @@ void FlagListBox::GenerateCheckBoxes(const FlagListBoxData& data) {
 	wxASSERT_MSG(!this->areCheckBoxesGenerated,
 		_T("Attempted to generate checkboxes a second time."));
 	
-	FlagListCheckBox* checkBox;
-	wxSizer* checkBoxSizer;
+	wxArrayString searchTexts;
+	wxString category;
 	
 	for (FlagListBoxData::const_iterator dataIter = data.begin();
 		 dataIter != data.end(); ++dataIter) {
@@ -161,33 +238,31 @@ void FlagListBox::GenerateCheckBoxes(const FlagListBoxData& data) {
 		FlagListBoxDataItem* item = *dataIter;
 		
 		if (!item->fsoCategory.IsEmpty()) {
-			this->checkBoxes.Append(
-				new FlagListCheckBoxItem(item->fsoCategory));
+			this->checkBoxes.push_back(
+				FlagListCheckBoxItem(item->fsoCategory));
+			// the category's flags are found through it instead
+			searchTexts.Add(wxEmptyString);
+			category = item->fsoCategory;
 			continue;
 		}
 		
-		checkBox =
-			new FlagListCheckBox(
-				this,
-				wxEmptyString,
-				item->flagString);
-		checkBox->Hide(); // we don't yet know where it should appear, so hide
-		
-		checkBox->Connect(
-			checkBox->GetId(),
-			wxEVT_COMMAND_CHECKBOX_CLICKED,
-			wxCommandEventHandler(FlagListCheckBox::OnClicked));
-		
-		checkBoxSizer = new wxBoxSizer(wxVERTICAL);
-		checkBoxSizer->AddSpacer(ITEM_VERTICAL_OFFSET);
-		checkBoxSizer->Add(checkBox);
-		
-		this->checkBoxes.Append(
-			new FlagListCheckBoxItem(*checkBox, *checkBoxSizer,
-				item->shortDescription, item->flagString,
+		const size_t row = this->checkBoxes.size();
+		this->checkBoxes.push_back(
+			FlagListCheckBoxItem(item->shortDescription, item->flagString,
 				item->isRecommendedFlag));
+		searchTexts.Add(item->flagString + _T(" ")
+			+ item->shortDescription + _T(" ") + category);
+		
+		if (this->flagRows.count(item->flagString) > 0) {
+			wxLogDebug(_T("Flag %s is listed more than once, only the first is used for flag sets."),
+				item->flagString.c_str());
+		} else {
+			this->flagRows[item->flagString] = row;
+		}
 	}
 	
+	this->checkedFlags = FlagBitset(this->checkBoxes.size());
+	this->searchIndex.Build(searchTexts);
 	this->areCheckBoxesGenerated = true;
 }
 
@@ -195,17 +270,15 @@ FlagListBox::~FlagListBox() {
 	FlagFileData* temp = this->flagData;
 	this->flagData = NULL;
 	delete temp;
-	
-	this->checkBoxes.Clear();
 }
 
-FlagListCheckBoxItem* FlagListBox::FindFlagAt(size_t n) const {
+const FlagListCheckBoxItem* FlagListBox::FindFlagAt(size_t n) const {
 	wxCHECK_MSG(this->IsReady(), NULL,
 		_T("FindFlagAt() called when flag list box is not ready"));
-	wxCHECK_MSG(n >= 0 && n < this->checkBoxes.GetCount(), NULL,
+	wxCHECK_MSG(n < this->visibleRows.size(), NULL,
 		wxString::Format(_T("FindFlagAt() called with out-of-range value %lu"), n));
 	
-	return this->checkBoxes[n];
+	return &this->checkBoxes[this->visibleRows[n]];
 }
 
 void FlagListBox::OnDrawItem(wxDC &dc, const wxRect &rect, size_t n) const {
@@ -215,10 +288,10 @@ void FlagListBox::OnDrawItem(wxDC &dc, const wxRect &rect, size_t n) const {
 #endif
 	
 	if (this->IsReady()) {
-		FlagListCheckBoxItem* item = this->FindFlagAt(n);
+		const FlagListCheckBoxItem* item = this->FindFlagAt(n);
 		wxCHECK_RET(item != NULL, _T("Flag pointer is null"));
 		
-		if (item->GetCheckBox() != NULL) {
+		if (!item->IsCategory()) {
 			if (item->IsRecommendedFlag()) {
 				dc.DrawBitmap(
 					SkinSystem::GetSkinSystem()->GetIdealIcon(),
@@ -226,21 +299,32 @@ void FlagListBox::OnDrawItem(wxDC &dc, const wxRect &rect, size_t n) const {
 					rect.y);
 			}
 			
-			item->GetCheckBox()->Show();
-			item->GetCheckBoxSizer()->SetDimension(
-				rect.x + SkinSystem::IdealIconWidth,
-				rect.y,
-				SkinSystem::IdealIconWidth,
-				rect.height);
+			// the check box is drawn rather than being a window of its own,
+			// so that only the rows on screen cost anything
+			const bool hasKeyboard =
+				this->IsCurrent(n) && (wxWindow::FindFocus() == this);
+			int flags = 0;
+			if (this->checkedFlags.Test(this->visibleRows[n])) {
+				flags |= wxCONTROL_CHECKED;
+			}
+			if (hasKeyboard) {
+				flags |= wxCONTROL_FOCUSED;
+			}
+			wxRendererNative::Get().DrawCheckBox(const_cast<FlagListBox*>(this), dc,
+				GetCheckBoxRect(rect), flags);
+			
+			const wxPoint textPos(rect.x + SkinSystem::IdealIconWidth + WIDTH_OF_CHECKBOX,
+				rect.y + (VERTICAL_OFFSET_MULTIPLIER*ITEM_VERTICAL_OFFSET));
+			dc.DrawText(wxString(_T(" ")) + item->GetLabel(), textPos);
 			
-			if (item->GetShortDescription().IsEmpty()) {
-				dc.DrawText(wxString(_T(" ")) + item->GetFlagString(),
-					rect.x + SkinSystem::IdealIconWidth + WIDTH_OF_CHECKBOX,
-					rect.y + (VERTICAL_OFFSET_MULTIPLIER*ITEM_VERTICAL_OFFSET));
-			} else {
-				dc.DrawText(wxString(_T(" ")) + item->GetShortDescription(),
-					rect.x + SkinSystem::IdealIconWidth + WIDTH_OF_CHECKBOX,
-					rect.y + (VERTICAL_OFFSET_MULTIPLIER*ITEM_VERTICAL_OFFSET));
+			// the background does not show the selection, so the row
+			// that the keyboard acts on is outlined instead
+			if (hasKeyboard) {
+				wxCoord textWidth, textHeight;
+				dc.GetTextExtent(wxString(_T(" ")) + item->GetLabel(), &textWidth, &textHeight);
+				dc.SetPen(wxPen(dc.GetTextForeground(), 1, wxDOT));
+				dc.SetBrush(*wxTRANSPARENT_BRUSH);
+				dc.DrawRectangle(textPos.x, textPos.y - 1, textWidth + 2, textHeight + 2);
 			}
 		} else { // draw a category
 			wxASSERT(!item->GetFsoCategory().IsEmpty());
@@ -273,8 +357,8 @@ void FlagListBox::OnDrawBackground(wxDC &dc, const wxRect &rect, size_t n) const
 	wxColour background = wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW);
 	
 	if (this->IsReady()) {
-		FlagListCheckBoxItem* item = FindFlagAt(n);
-		if (item != NULL && item->GetFlagString().IsEmpty()) { // category header
+		const FlagListCheckBoxItem* item = FindFlagAt(n);
+		if (item != NULL && item->IsCategory()) { // category header
 			background = wxSystemSettings::GetColour(wxSYS_COLOUR_HIGHLIGHT);
 		}
 	}
@@ -291,7 +375,12 @@ void FlagListBox::OnDoubleClickFlag(wxCommandEvent &WXUNUSED(event)) {
 	wxCHECK_RET(this->IsReady(),
 		_T("OnDoubleClickFlag() called when flag list box is not ready."));
 	
-	const wxString* webURL = this->flagData->GetWebURL(this->GetSelection());
+	const int selection = this->GetSelection();
+	if (selection == wxNOT_FOUND) {
+		return;
+	}
+	
+	const wxString* webURL = this->flagData->GetWebURL(this->visibleRows[selection]);
 	wxCHECK_RET(webURL != NULL,
 		_T("GetWebURL() returned NULL, which shouldn't happen."));
 	
@@ -316,44 +405,224 @@ void FlagListBox::LoadEnabledFlags() {
 		 it != end;
 		 ++it) {
 		const wxString& flag(*it);
+		FlagStringToRowMap::const_iterator row = this->flagRows.find(flag);
 		
-		wxCHECK_RET(this->SetFlag(flag, true),
+		wxCHECK_RET(row != this->flagRows.end(),
 			wxString::Format(
 				_T("LoadEnabledFlags(): Couldn't find flag %s"), flag.c_str()));
+		this->checkedFlags.Set(row->second);
 	}
+	this->RefreshAll();
 	
 	this->flagsLoaded = true;
 }
 
-bool FlagListBox::SetFlag(
-	 const wxString& flagString, const bool state, const bool updateProxy) {
-	wxCHECK_MSG(this->IsReady(), false,
-		_T("SetFlag() called when flag list box is not ready."));
-	wxCHECK_MSG(ProfileProxy::GetProxy()->IsFlagDataReady(), false,
-		_T("SetFlag() called when proxy flag data is not ready."));
-	wxCHECK_MSG(!flagString.IsEmpty(), false,
-		_T("SetFlag() called with empty flagString."));
-	
-	for (FlagListCheckBoxItems::iterator
-		 it = this->checkBoxes.begin(), end = this->checkBoxes.end();
-		 it != end;
-		 ++it) {
-		FlagListCheckBoxItem* item = *it;
-		
-		if (!item->GetFlagString().IsEmpty()
-				&& item->GetFlagString() == flagString) {
-			item->GetCheckBox()->SetValue(state);
-			if (updateProxy) {
-				ProfileProxy::GetProxy()->SetFlag(flagString, state);
+void FlagListBox::ToggleFlag(size_t n) {
+	wxCHECK_RET(n < this->visibleRows.size(),
+		wxString::Format(_T("ToggleFlag() called with out-of-range value %lu"), n));
+	
+	const size_t row = this->visibleRows[n];
+	const wxString& flagString(this->checkBoxes[row].GetFlagString());
+	wxCHECK_RET(!flagString.IsEmpty(),
+		_T("ToggleFlag() called for a category row."));
+	
+	const bool isChecked = !this->checkedFlags.Test(row);
+	this->checkedFlags.Set(row, isChecked);
+#if wxCHECK_VERSION(2, 9, 0)
+	this->RefreshRow(n);
+#else
+	this->RefreshLine(n);
+#endif
+	ProfileProxy::GetProxy()->SetFlag(flagString, isChecked);
+#if wxUSE_ACCESSIBILITY
+	wxAccessible::NotifyEvent(wxACC_EVENT_OBJECT_STATECHANGE,
+		this, wxOBJID_CLIENT, static_cast<int>(n) + 1);
+#endif
+	
+	wxLogDebug(_T("flag %s is now %s"),
+		flagString.c_str(), isChecked ? _T("on") : _T("off"));
+}
+
+void FlagListBox::ApplyCheckedFlags(const FlagBitset& changed) {
+	std::vector<wxString> flagsToDisable;
+	std::vector<wxString> flagsToEnable;
+	
+	for (size_t row = changed.FindNext(0); row < changed.GetSize();
+		 row = changed.FindNext(row + 1)) {
+		if (this->checkedFlags.Test(row)) {
+			flagsToEnable.push_back(this->checkBoxes[row].GetFlagString());
+		} else {
+			flagsToDisable.push_back(this->checkBoxes[row].GetFlagString());
+		}
+	}
+	
+	if (flagsToDisable.empty() && flagsToEnable.empty()) {
+		return;
+	}
+	ProfileProxy::GetProxy()->SetFlags(flagsToDisable, flagsToEnable);
+	this->RefreshAll();
+}
+
+int FlagListBox::HitTestCheckBox(const wxPoint& pos) const {
+	if (!this->IsReady()) {
+		return wxNOT_FOUND;
+	}
+#if wxCHECK_VERSION(2, 9, 0)
+	const int n = this->VirtualHitTest(pos.y);
+#else
+	const int n = this->HitTest(pos);
+#endif
+	if (n == wxNOT_FOUND || this->FindFlagAt(n)->IsCategory()) {
+		return wxNOT_FOUND;
+	}
+	
+	// only the column matters, so that clicks just above or below the box still count
+	const wxRect checkBox(GetCheckBoxRect(wxRect(this->GetMargins().x, 0,
+		this->GetClientSize().x, SkinSystem::IdealIconHeight)));
+	if (pos.x < checkBox.GetLeft() || pos.x > checkBox.GetRight()) {
+		return wxNOT_FOUND;
+	}
+	return n;
+}
+
+void FlagListBox::OnLeftDown(wxMouseEvent &event) {
+	const int n = this->HitTestCheckBox(event.GetPosition());
+	if (n != wxNOT_FOUND) {
+		this->ToggleFlag(n);
+	}
+	event.Skip(); // so that the row is also selected
+}
+
+void FlagListBox::OnLeftDoubleClick(wxMouseEvent &event) {
+	const int n = this->HitTestCheckBox(event.GetPosition());
+	if (n != wxNOT_FOUND) {
+		// the second click of a double click on a check box toggles it back,
+		// as it does with native check boxes, and does not open the flag's web page
+		this->ToggleFlag(n);
+	} else {
+		event.Skip();
+	}
+}
+
+void FlagListBox::OnFocusChanged(wxFocusEvent &event) {
+	// the current row is only outlined while the list has the focus
+	if (this->IsReady() && this->GetSelection() != wxNOT_FOUND) {
+#if wxCHECK_VERSION(2, 9, 0)
+		this->RefreshRow(this->GetSelection());
+#else
+		this->RefreshLine(this->GetSelection());
+#endif
+	}
+	event.Skip();
+}
+
+void FlagListBox::OnKeyDown(wxKeyEvent &event) {
+	const int n = this->GetSelection();
+	if (event.GetKeyCode() == WXK_SPACE && !event.HasModifiers()
+			&& this->IsReady() && n != wxNOT_FOUND
+			&& !this->FindFlagAt(n)->IsCategory()) {
+		this->ToggleFlag(n);
+	} else {
+		event.Skip();
+	}
+}
+
+void FlagListBox::SetFilter(const wxString& query) {
+	wxCHECK_RET(this->areCheckBoxesGenerated,
+		_T("SetFilter() called before the flags were added."));
+	
+	const int selection = this->GetSelection();
+	const size_t selectedRow = (selection == wxNOT_FOUND) ?
+		this->checkBoxes.size() : this->visibleRows[selection];
+	
+	this->visibleRows.clear();
+	if (query.Strip(wxString::both).IsEmpty()) {
+		for (size_t row = 0; row < this->checkBoxes.size(); row++) {
+			this->visibleRows.push_back(row);
+		}
+	} else {
+		const FlagBitset matches(this->searchIndex.Find(query));
+		// a category is shown above the first of its flags that matched
+		size_t category = this->checkBoxes.size();
+		for (size_t row = 0; row < this->checkBoxes.size(); row++) {
+			if (this->checkBoxes[row].IsCategory()) {
+				category = row;
+			} else if (matches.Test(row)) {
+				if (category < this->checkBoxes.size()) {
+					this->visibleRows.push_back(category);
+					category = this->checkBoxes.size();
+				}
+				this->visibleRows.push_back(row);
 			}
-			return true;
 		}
 	}
-	return false;
+	
+	this->SetItemCount(this->visibleRows.size());
+	
+	int newSelection = wxNOT_FOUND;
+	for (size_t n = 0; n < this->visibleRows.size() && newSelection == wxNOT_FOUND; n++) {
+		if (this->visibleRows[n] == selectedRow) {
+			newSelection = static_cast<int>(n);
+		}
+	}
+	this->SetSelection(newSelection); // also scrolls to it
+	if (newSelection == wxNOT_FOUND && !this->visibleRows.empty()) {
+#if wxCHECK_VERSION(2, 9, 0)
+		this->ScrollToRow(0);
+#else
+		this->ScrollToLine(0);
+#endif
+	}
+	this->RefreshAll();
+}
+
+const FlagListBox::FlagSetMasks* FlagListBox::GetFlagSetMasks(const wxString& setName) {
+	std::map<wxString, FlagSetMasks>::const_iterator cached =
+		this->flagSetMasks.find(setName);
+	if (cached != this->flagSetMasks.end()) {
+		return &cached->second;
+	}
+	
+	const FlagSet* flagSet = this->flagData->GetFlagSet(setName);
+	if (flagSet == NULL) {
+		return NULL;
+	}
+	
+	FlagSetMasks masks;
+	masks.disable = FlagBitset(this->checkBoxes.size());
+	masks.enable = FlagBitset(this->checkBoxes.size());
+	
+	for (wxArrayString::const_iterator it = flagSet->flagsToDisable.begin();
+		 it != flagSet->flagsToDisable.end(); ++it) {
+		FlagStringToRowMap::const_iterator row = this->flagRows.find(*it);
+		if (row == this->flagRows.end()) {
+			wxLogWarning(_T("Could not find flag %s to disable for flag set %s."),
+				it->c_str(), setName.c_str());
+		} else {
+			masks.disable.Set(row->second);
+		}
+	}
+	for (wxArrayString::const_iterator it = flagSet->flagsToEnable.begin();
+		 it != flagSet->flagsToEnable.end(); ++it) {
+		FlagStringToRowMap::const_iterator row = this->flagRows.find(*it);
+		if (row == this->flagRows.end()) {
+			wxLogWarning(_T("Could not find flag %s to enable for flag set %s."),
+				it->c_str(), setName.c_str());
+		} else {
+			masks.enable.Set(row->second);
+		}
+	}
+	
+	return &(this->flagSetMasks[setName] = masks);
 }
 
 BEGIN_EVENT_TABLE(FlagListBox, wxVListBox)
 EVT_LISTBOX_DCLICK(ID_FLAGLISTBOX, FlagListBox::OnDoubleClickFlag)
+EVT_LEFT_DOWN(FlagListBox::OnLeftDown)
+EVT_LEFT_DCLICK(FlagListBox::OnLeftDoubleClick)
+EVT_KEY_DOWN(FlagListBox::OnKeyDown)
+EVT_SET_FOCUS(FlagListBox::OnFocusChanged)
+EVT_KILL_FOCUS(FlagListBox::OnFocusChanged)
 END_EVENT_TABLE()
 
 bool FlagListBox::SetFlagSet(const wxString& setToFind) {
@@ -361,30 +630,15 @@ bool FlagListBox::SetFlagSet(const wxString& setToFind) {
 	wxCHECK_MSG(this->IsReady(), false,
 		_T("SetFlagSet() called when flag list box is not ready."));
 	
-	const FlagSet* flagSet = this->flagData->GetFlagSet(setToFind); 
+	const FlagSetMasks* masks = this->GetFlagSetMasks(setToFind);
 	
-	if ( flagSet == NULL ) {
+	if ( masks == NULL ) {
 		return false;
 	}
-
-	wxArrayString::const_iterator disableIter =
-		flagSet->flagsToDisable.begin();
-	while ( disableIter != flagSet->flagsToDisable.end() ) {
-		if (!this->SetFlag(*disableIter, false, true)) {
-			wxLogWarning(_T("Could not find flag %s to disable for flag set %s."),
-				disableIter->c_str(), setToFind.c_str());
-		}
-		disableIter++;
-	}
-	wxArrayString::const_iterator enableIter =
-		flagSet->flagsToEnable.begin();
-	while ( enableIter != flagSet->flagsToEnable.end() ) {
-		if (!this->SetFlag(*enableIter, true, true)) {
-			wxLogWarning(_T("Could not find flag %s to enable for flag set %s."),
-				enableIter->c_str(), setToFind.c_str());			
-		}
-		enableIter++;
-	}
+	
+	const FlagBitset before(this->checkedFlags);
+	this->checkedFlags.Apply(masks->disable, masks->enable);
+	this->ApplyCheckedFlags(before.Difference(this->checkedFlags));
 	return true;
 }
 
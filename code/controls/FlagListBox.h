@@ -19,48 +19,43 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #ifndef FLAGLISTBOX_H
 #define FLAGLISTBOX_H
 
+#include <map>
+#include <vector>
+
 #include <wx/wx.h>
 #include <wx/vlbox.h>
 
 #include "apis/EventHandlers.h"
 #include "apis/FlagListManager.h"
+#include "datastructures/FlagBitset.h"
+#include "datastructures/FlagSearchIndex.h"
 
-class FlagListCheckBox: public wxCheckBox {
-public:
-	FlagListCheckBox(
-		wxWindow* parent,
-		const wxString& label,
-		const wxString& flagString);
-	void OnClicked(wxCommandEvent &event);
-private:
-	FlagListCheckBox();
-	wxString flagString;
-};
-
+/** A row of the flag list box: either a category header or a flag, whose
+ check box the flag list box draws itself. */
 class FlagListCheckBoxItem {
 public:
 	FlagListCheckBoxItem(const wxString& fsoCategory);
-	FlagListCheckBoxItem(FlagListCheckBox& checkBox, wxSizer& checkBoxSizer,
-		const wxString& shortDescription, const wxString& flagString,
+	FlagListCheckBoxItem(const wxString& shortDescription, const wxString& flagString,
 		bool isRecommendedFlag);
-	~FlagListCheckBoxItem();
 	const wxString& GetFsoCategory() const { return this->fsoCategory; }
-	FlagListCheckBox* GetCheckBox() { return this->checkBox; }
-	wxSizer* GetCheckBoxSizer() { return this->checkBoxSizer; }
+	bool IsCategory() const { return this->flagString.IsEmpty(); }
 	const wxString& GetShortDescription() const { return this->shortDescription; }
+	/** The description if there is one, otherwise the flag itself. */
+	const wxString& GetLabel() const;
 	const wxString& GetFlagString() const { return this->flagString; }
 	bool IsRecommendedFlag() const { return this->isRecommendedFlag; }
 private:
 	FlagListCheckBoxItem();
 	wxString fsoCategory;
-	FlagListCheckBox* checkBox;
-	wxSizer* checkBoxSizer;
 	wxString shortDescription;
 	wxString flagString;
 	bool isRecommendedFlag;
 };
 
-WX_DECLARE_LIST(FlagListCheckBoxItem, FlagListCheckBoxItems);
+/** The rows of the flag list box, in order. */
+typedef std::vector<FlagListCheckBoxItem> FlagListCheckBoxItems;
+
+WX_DECLARE_STRING_HASH_MAP(size_t, FlagStringToRowMap);
 
 /** Flag list box is ready for use. */
 LAUNCHER_DECLARE_EVENT_TYPE(EVT_FLAG_LIST_BOX_READY);
@@ -78,6 +73,10 @@ public:
 	virtual wxCoord OnMeasureItem(size_t n) const;
 
 	void OnDoubleClickFlag(wxCommandEvent &event);
+	void OnLeftDown(wxMouseEvent &event);
+	void OnLeftDoubleClick(wxMouseEvent &event);
+	void OnKeyDown(wxKeyEvent &event);
+	void OnFocusChanged(wxFocusEvent &event);
 	
 	/** Loads enabled flags from the proxy and checks the corresponding boxes. */
 	void LoadEnabledFlags();
@@ -95,6 +94,11 @@ public:
 	bool IsReady() const { return this->isReady; }
 	
 	bool FlagsLoaded() const { return this->flagsLoaded; }
+	
+	/** Shows only the flags whose flag string, description or category
+	 contains every word of query, under their categories.
+	 An empty query shows every row. */
+	void SetFilter(const wxString& query);
 
 private:
 	EventHandlers flagListBoxReadyHandlers;
@@ -103,17 +107,37 @@ private:
 	bool isReady;
 	bool flagsLoaded;
 	
-	/** Tries to find flagString in the list of flags and set it to state.
-	 returns true on successful set, returns false if cannot find flag.
-	 Will update the proxy if updateProxy is true. */
-	bool SetFlag(const wxString& flagString, bool state, bool updateProxy = false);
+	/** The rows that a flag set disables and enables. */
+	struct FlagSetMasks {
+		FlagBitset disable;
+		FlagBitset enable;
+	};
+	
+	/** Returns the masks of the flag set, building them the first time
+	 the set is used. Returns NULL iff there is no such set. */
+	const FlagSetMasks* GetFlagSetMasks(const wxString& setName);
+	
+	/** Passes the rows in changed to the proxy in one go, and redraws the list. */
+	void ApplyCheckedFlags(const FlagBitset& changed);
+	
+	/** Checks or unchecks the flag in the nth shown row, as the user asked to. */
+	void ToggleFlag(size_t n);
+	
+	/** Returns the shown row whose check box is at pos, or wxNOT_FOUND. */
+	int HitTestCheckBox(const wxPoint& pos) const;
 	
 	FlagFileData* flagData;
 	FlagListCheckBoxItems checkBoxes;
+	FlagStringToRowMap flagRows; //!< flag string to its row in checkBoxes
+	FlagBitset checkedFlags; //!< one bit per row, set if the row's flag is checked
+	FlagSearchIndex searchIndex; //!< of the rows' flag strings, descriptions and categories
+	std::vector<size_t> visibleRows; //!< the rows in checkBoxes that match the filter, as shown
+	std::map<wxString, FlagSetMasks> flagSetMasks; //!< built as the sets are used
 	void GenerateCheckBoxes(const FlagListBoxData& data);
+	friend class FlagListBoxAccessible;
 	bool areCheckBoxesGenerated;
 
-	FlagListCheckBoxItem* FindFlagAt(size_t n) const;
+	const FlagListCheckBoxItem* FindFlagAt(size_t n) const;
 
 	DECLARE_EVENT_TABLE();
 
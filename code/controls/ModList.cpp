@@ -16,6 +16,8 @@ along with this program; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 
+#include "generated/configure_launcher.h"
+
 #include <algorithm>
 #include <vector>
 
@@ -29,6 +31,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <wx/arrstr.h>
 #include <wx/filename.h>
 #include <wx/dir.h>
+#include <wx/stopwatch.h>
 #include <wx/html/htmlwin.h>
 
 #include "apis/SkinManager.h"
@@ -38,6 +41,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "global/ModIniKeys.h"
 #include "global/Utils.h"
 #include "controls/ModList.h"
+#include "datastructures/ModCatalog.h"
+#include "datastructures/ModImageCache.h"
+#include "datastructures/ModIniFile.h"
+#include "datastructures/ModIniScanner.h"
+#include "datastructures/ResolutionMap.h"
+#include "datastructures/ThumbnailCache.h"
+#include "apis/TCFolderWatcher.h"
 #include "apis/ProfileManager.h"
 #include "apis/TCManager.h"
 
@@ -52,7 +62,7 @@ const size_t MAX_PRESET_NAME_LENGTH = 32;
 
 class ModInfoDialog: wxDialog {
 public:
-	ModInfoDialog(ModItem* item, wxWindow* parent);
+	ModInfoDialog(ModItem* item, const wxBitmap& image, wxWindow* parent);
 	void OnLinkClicked(wxHtmlLinkEvent &event);
 
 private:
@@ -70,12 +80,15 @@ private:
 	friend class ImageDrawer;
 
 	ModItem* item;
+	wxBitmap image; //!< the mod's image255x112, not Ok if it does not have one
 };
 
 
-ConfigPair::ConfigPair(const wxString &shortname, wxFileConfig *config)  {
+ConfigPair::ConfigPair(const wxString &shortname, ModIniFile *config,
+	const wxString& modIniPath)  {
 	this->shortname = shortname;
 	this->config = config;
+	this->modIniPath = modIniPath;
 }
 
 ConfigPair::~ConfigPair() {
@@ -120,444 +133,586 @@ bool CompareModItems(ModItem* item1, ModItem* item2) {
 
 const ModItem* ModList::activeMod = NULL;
 
-class ModIniFinder: public wxDirTraverser {
-public:
-	const wxArrayString& GetFiles() const {
-		return files;
-	}
-	virtual wxDirTraverseResult OnDir(const wxString& dirname) {
-		if (ShouldIgnore(dirname)) {
-			return wxDIR_IGNORE;
-		} else {
-			return wxDIR_CONTINUE;
-		}
-	}
-	virtual wxDirTraverseResult OnFile(const wxString& filename) {
-		if (filename.EndsWith(_T("mod.ini"))) {
-			files.Add(filename);
-		}
-		return wxDIR_CONTINUE;
-	}
-private:
-	bool ShouldIgnore(const wxString& dirname) {
-		const wxString realDirName(dirname.AfterLast(wxFileName::GetPathSeparator()));
-		return realDirName.EndsWith(_T(".app")) || realDirName.StartsWith(_T("."));
-	}
-	wxArrayString files;
-};
-
 void ModList::SetSkinBitmap(
-		const wxFileConfig& config,
+		const ModIniFile& config,
 		const wxString& modIniKey,
 		const wxString& tcPath,
 		const wxString& bitmapName,
 		bool (Skin::* setFnPtr)(const wxBitmap&)) {
-	wxCHECK_RET(!modIniKey.IsEmpty(), _T("SetSkinBitmap(): modIniKey is empty!"));
-	wxCHECK_RET(!tcPath.IsEmpty(), _T("SetSkinBitmap(): tcPath is empty!"));
-	wxCHECK_RET(!bitmapName.IsEmpty(), _T("SetSkinBitmap(): bitmapName is empty!"));
 	wxCHECK_RET(setFnPtr != NULL, _T("SetSkinBitmap(): setFnPtr is NULL!"));
 	wxCHECK_RET(this->TCSkin != NULL, _T("SetSkinBitmap(): TCSkin is NULL!"));
 
-	wxString bitmapPath;
-	readIniFileString(&config, modIniKey, bitmapPath);
+	const wxString bitmapPath(FindSkinFile(config, modIniKey, tcPath, bitmapName));
 	
 	if ( !bitmapPath.IsEmpty() ) {
-		wxFileName filename;
-		
-		if (SkinSystem::SearchFile(filename, tcPath, wxEmptyString, bitmapPath)) {
-			if ((this->TCSkin->*setFnPtr)(wxBitmap(filename.GetFullPath(), wxBITMAP_TYPE_ANY))) {
-				wxLogDebug(_T("Set skin %s to '%s'"),
-					bitmapName.c_str(),
-					filename.GetFullPath().c_str());
-			} else {
-				wxLogWarning(_T("Could not set skin %s to '%s'"),
-					bitmapName.c_str(),
-					filename.GetFullPath().c_str());
-			}
+		if ((this->TCSkin->*setFnPtr)(wxBitmap(bitmapPath, wxBITMAP_TYPE_ANY))) {
+			wxLogDebug(_T("Set skin %s to '%s'"),
+				bitmapName.c_str(),
+				bitmapPath.c_str());
 		} else {
-			wxLogWarning(_T("Could not find skin %s file '%s%c%s'."),
+			wxLogWarning(_T("Could not set skin %s to '%s'"),
 				bitmapName.c_str(),
-				tcPath.c_str(),
-				wxFileName::GetPathSeparator(),
 				bitmapPath.c_str());
 		}
 	}
 }
 
-ModList::ModList(wxWindow *parent, wxSize& size, wxString tcPath)
-: configFiles(new ConfigArray()), tableData(new ModItemArray()), TCSkin(NULL) {
-	this->Create(parent, ID_MODLISTBOX, wxDefaultPosition, size, 
-		wxLB_SINGLE | wxLB_ALWAYS_SB | wxBORDER);
-	this->SetMargins(10, 10);
-	
-	SkinSystem::RegisterTCSkinChanged(this);
+/** Looks up the skin file named by modIniKey in the TC folder.
+ Returns the full path to the file or an empty string if there is none. */
+wxString ModList::FindSkinFile(
+		const ModIniFile& config,
+		const wxString& modIniKey,
+		const wxString& tcPath,
+		const wxString& fileName) {
+	wxCHECK_MSG(!modIniKey.IsEmpty(), wxEmptyString, _T("FindSkinFile(): modIniKey is empty!"));
+	wxCHECK_MSG(!tcPath.IsEmpty(), wxEmptyString, _T("FindSkinFile(): tcPath is empty!"));
+	wxCHECK_MSG(!fileName.IsEmpty(), wxEmptyString, _T("FindSkinFile(): fileName is empty!"));
 
-	std::vector<ModItem*> modsTemp; // for use in presorting
+	wxString filePath;
+	readIniFileString(&config, modIniKey, filePath);
+	
+	if ( filePath.IsEmpty() ) {
+		return wxEmptyString;
+	}
+	
+	wxFileName filename;
+	if (SkinSystem::SearchFile(filename, tcPath, wxEmptyString, filePath)) {
+		return filename.GetFullPath();
+	}
+	
+	wxLogWarning(_T("Could not find skin %s file '%s%c%s'."),
+		fileName.c_str(),
+		tcPath.c_str(),
+		wxFileName::GetPathSeparator(),
+		filePath.c_str());
+	return wxEmptyString;
+}
 
-	// scan for mods in the current TCs directory
-	ModIniFinder iniFinder;
+/** Sets the TC skin's mod images. They are read through the thumbnail cache,
+ so that a large image is only decoded and scaled the first time it is used.
+ If only one of them is usable, the other one is made by scaling it. */
+void ModList::SetSkinModImages(const ModIniFile& config, const wxString& tcPath) {
+	wxCHECK_RET(this->TCSkin != NULL, _T("SetSkinModImages(): TCSkin is NULL!"));
+
+	const wxSize modImageSize(SkinSystem::ModInfoDialogImageWidth, SkinSystem::ModInfoDialogImageHeight);
+	const wxSize smallModImageSize(SkinSystem::ModListImageWidth, SkinSystem::ModListImageHeight);
+	const wxString thumbnailFolder(ThumbnailCache::PrepareCacheFolder());
+	const wxString modImagePath(FindSkinFile(config, MOD_INI_KEY_SKIN_MOD_IMAGE_255X112,
+		tcPath, _T("mod image")));
+	const wxString smallModImagePath(FindSkinFile(config, MOD_INI_KEY_SKIN_MOD_IMAGE_182X80,
+		tcPath, _T("small mod image")));
+	ThumbnailSource modImageSource(modImagePath, thumbnailFolder);
+	ThumbnailSource smallModImageSource(smallModImagePath, thumbnailFolder);
+	wxImage image;
 	
-	wxASSERT(wxDir::Exists(tcPath));
-	wxDir dir(tcPath);
-	dir.Traverse(iniFinder, _T("mod.ini"));
+	// Skin::SetModImage() would shrink a larger image, so shrink it here where it can be cached
+	if (!modImagePath.IsEmpty()) {
+		if (modImageSource.GetImage(modImageSize, ThumbnailCache::FIT_SHRINK, image)
+			&& this->TCSkin->SetModImage(wxBitmap(image))) {
+			wxLogDebug(_T("Set skin mod image to '%s'"), modImagePath.c_str());
+		} else {
+			wxLogWarning(_T("Could not set skin mod image to '%s'"), modImagePath.c_str());
+		}
+	}
 	
-	wxArrayString foundInis(iniFinder.GetFiles());
+	if (!smallModImagePath.IsEmpty()) {
+		if (smallModImageSource.GetImage(smallModImageSize, ThumbnailCache::FIT_EXACT, image)
+			&& this->TCSkin->SetSmallModImage(wxBitmap(image))) {
+			wxLogDebug(_T("Set skin small mod image to '%s'"), smallModImagePath.c_str());
+		} else if (smallModImageSource.GetSourceSize() != wxDefaultSize) {
+			wxLogWarning(_T("Provided small mod image size %dx%d is not expected size %dx%d."),
+				smallModImageSource.GetSourceSize().GetWidth(),
+				smallModImageSource.GetSourceSize().GetHeight(),
+				SkinSystem::ModListImageWidth, SkinSystem::ModListImageHeight);
+		} else {
+			wxLogWarning(_T("Could not set skin small mod image to '%s'"), smallModImagePath.c_str());
+		}
+	}
 	
-	if ( foundInis.Count() > 0 ) {
-		wxLogDebug(_T("I found %ld .ini files:"), foundInis.Count());
-	} else {
-		wxLogDebug(_T("I did not find any .ini files."));
+	// if one mod image is missing, create it by scaling the other one
+	if (this->TCSkin->GetModImage().IsOk() && !this->TCSkin->GetSmallModImage().IsOk()) {
+		if (modImageSource.GetImage(smallModImageSize, ThumbnailCache::FIT_SCALE, image)) {
+			this->TCSkin->SetSmallModImage(wxBitmap(image));
+		}
+	} else if (!this->TCSkin->GetModImage().IsOk() && this->TCSkin->GetSmallModImage().IsOk()) {
+		if (smallModImageSource.GetImage(modImageSize, ThumbnailCache::FIT_SCALE, image)) {
+			this->TCSkin->SetModImage(wxBitmap(image));
+		}
 	}
+}
 
-	// parse mod.ini's in all of the directories that contain one
+/** Looks up the image named by modIniKey in the mod's folder.
+ Returns the full path to the image or an empty string if there is none. */
+wxString ModList::FindModImage(
+		const ModIniFile* config,
+		const wxString& modIniKey,
+		const wxString& tcPath,
+		const wxString& searchShortname,
+		const wxString& imageName) {
+	wxString imagePath;
+	readIniFileString(config, modIniKey, imagePath);
+	
+	return ResolveModImage(imagePath, tcPath, searchShortname, imageName);
+}
 
-	wxLogDebug(_T("Inserting '(No mod)'"));
-	wxFileName tcmodini(tcPath, _T("mod.ini"));
-	if ( tcmodini.IsOk() && tcmodini.FileExists() ) {
-		wxLogDebug(_T(" Found a mod.ini in the root TC folder. (%s)"), tcmodini.GetFullPath().c_str());
+/** Looks up imagePath, as written in a mod.ini, in the mod's folder.
+ Returns the full path to the image or an empty string if there is none. */
+wxString ModList::ResolveModImage(
+		const wxString& imagePath,
+		const wxString& tcPath,
+		const wxString& searchShortname,
+		const wxString& imageName) {
+	if (imagePath.IsEmpty()) {
+		return wxEmptyString;
+	}
+	
+	wxFileName filename;
+	if (SkinSystem::SearchFile(filename, tcPath, searchShortname, imagePath)) {
+		return filename.GetFullPath();
+	}
+	
+	wxLogWarning(_T("Could not find %s file %s%s"),
+		imageName.c_str(),
+		(searchShortname.IsEmpty() ? wxEmptyString :
+			wxString(searchShortname + wxFileName::GetPathSeparator()).c_str()),
+		imagePath.c_str());
+	return wxEmptyString;
+}
 
-		if (!ParseModIni(tcmodini.GetFullPath(), tcPath, true)) {
-			wxLogError(_T(" Error parsing mod.ini in the root TC folder. (%s)"),
-				tcmodini.GetFullPath().c_str());
+/** Makes a catalog entry that holds everything the mod list needs from item.
+ The image names and the recommended lighting preset are taken as written
+ from config, since what they become depends on more than the mod.ini.
+ Returns NULL if the mod.ini cannot be examined. */
+ModCatalogEntry* ModList::MakeCatalogEntry(const ModItem& item,
+		const ModIniFile* config, const wxString& modIniPath) {
+	ModCatalogEntry* entry = new ModCatalogEntry();
+	if (!entry->ReadModIniStat(modIniPath)) {
+		delete entry;
+		return NULL;
+	}
+	
+	entry->name = item.name;
+	entry->image255x112 = readIniFileValue(config, MOD_INI_KEY_LAUNCHER_IMAGE_255X112);
+	entry->image182x80 = readIniFileValue(config, MOD_INI_KEY_LAUNCHER_IMAGE_182X80);
+	entry->infotext = item.infotext;
+	entry->author = item.author;
+	entry->notes = item.notes;
+	entry->warn = item.warn;
+	entry->website = item.website;
+	entry->forum = item.forum;
+	entry->bugs = item.bugs;
+	entry->support = item.support;
+	entry->minhorizontalres = item.minhorizontalres;
+	entry->minverticalres = item.minverticalres;
+	entry->forcedon = item.forcedon;
+	entry->forcedoff = item.forcedoff;
+	entry->primarylist = item.primarylist;
+	entry->secondarylist = item.secondarylist;
+	entry->recommendedlightingname =
+		readIniFileValue(config, MOD_INI_KEY_RECOMMENDED_LIGHTING_NAME);
+	entry->recommendedlightingflagset =
+		readIniFileValue(config, MOD_INI_KEY_RECOMMENDED_LIGHTING_FLAGSET);
+	
+	entry->hasFlagSets = (item.flagsets != NULL);
+	if (item.flagsets != NULL) {
+		for (size_t i = 0; i < item.flagsets->GetCount(); i++) {
+			ModCatalogFlagSet flagset;
+			flagset.name = item.flagsets->Item(i).name;
+			flagset.flagset = item.flagsets->Item(i).flagset;
+			flagset.notes = item.flagsets->Item(i).notes;
+			entry->flagsets.push_back(flagset);
 		}
+	}
+	return entry;
+}
 
-		// make sure that a mod.ini in the root TC folder is not apart of this set
-		// because it will be addressed shortly and specificly
-		int pos = foundInis.Index(tcmodini.GetFullPath());
-		if ( pos != wxNOT_FOUND ) {
-			foundInis.RemoveAt(pos);
+/** Rebuilds a mod list item from its catalog entry. */
+ModItem* ModList::MakeModItem(const ModCatalogEntry& entry, const wxString& tcPath) {
+	ModItem* item = new ModItem();
+	
+	// the short name depends on the TC folder, so it is not taken from the catalog
+	item->shortname = GetShortName(entry.modIniPath, tcPath);
+	item->name = entry.name;
+	item->image255x112path = ResolveModImage(entry.image255x112,
+		tcPath, item->shortname, _T("image255x112"));
+	item->image182x80path = ResolveModImage(entry.image182x80,
+		tcPath, item->shortname, _T("image182x80"));
+	item->infotext = entry.infotext;
+	item->author = entry.author;
+	item->notes = entry.notes;
+	item->warn = entry.warn;
+	item->website = entry.website;
+	item->forum = entry.forum;
+	item->bugs = entry.bugs;
+	item->support = entry.support;
+	item->minhorizontalres = entry.minhorizontalres;
+	item->minverticalres = entry.minverticalres;
+	item->forcedon = entry.forcedon;
+	item->forcedoff = entry.forcedoff;
+	item->primarylist = entry.primarylist;
+	item->secondarylist = entry.secondarylist;
+	item->recommendedlightingname = entry.recommendedlightingname;
+	item->recommendedlightingflagset = entry.recommendedlightingflagset;
+	// only mods below the TC come from the catalog
+	SetRecommendedLighting(*item, false);
+	
+	if (entry.hasFlagSets) {
+		item->flagsets = new FlagSets();
+		for (size_t i = 0; i < entry.flagsets.size(); i++) {
+			FlagSetItem* flagset = new FlagSetItem();
+			flagset->name = entry.flagsets[i].name;
+			flagset->flagset = entry.flagsets[i].flagset;
+			flagset->notes = entry.flagsets[i].notes;
+			item->flagsets->Add(flagset);
 		}
+	}
+	
+	return item;
+}
 
+/** Applies the defaults and the translated preset name to the recommended
+ lighting preset of item, which holds the values as written in the mod.ini. */
+void ModList::SetRecommendedLighting(ModItem& item, const bool isTC) {
+	if (!item.recommendedlightingflagset.IsEmpty()) {
+		if (item.recommendedlightingname.IsEmpty()) {
+			item.recommendedlightingname =
+				isTC ? _("TC recommended") : _("Mod recommended");
+			
+			// required because & is interpreted as setting keyboard shortcut
+			// see http://docs.wxwidgets.org/stable/wx_wxcontrol.html#wxcontrolsetlabel
+			item.recommendedlightingname.Replace(_T("&"), _T("&&"));
+		} else {
+			item.recommendedlightingname.Trim(true).Trim(false);
+			item.recommendedlightingname.Truncate(MAX_PRESET_NAME_LENGTH);
+		}
 	} else {
-		this->configFiles->Add(new ConfigPair(NO_MOD, new wxFileConfig()));
-		wxLogDebug(_T(" Using defaults for TC."));
+		wxLogDebug(_T("Recommended lighting flagset is missing or empty; using defaults."));
+		item.recommendedlightingname = DEFAULT_MOD_RECOMMENDED_LIGHTING_NAME;
+		item.recommendedlightingflagset = DEFAULT_MOD_RECOMMENDED_LIGHTING_FLAGSET;
 	}
+}
 
-	wxLogDebug(_T("Starting to parse mod.ini's..."));
-	for (size_t i = 0; i < foundInis.Count(); i++) {
-		wxLogDebug(_T("  Parsing %s"), foundInis.Item(i).c_str());
+/** Makes the mod list item for a parsed mod.ini.
+ isTC is true for the mod.ini in the root TC folder, which also holds the TC's skin. */
+ModItem* ModList::BuildModItem(const ConfigPair& pair, const wxString& tcPath, const bool isTC) {
+	const wxString& shortname(pair.shortname);
+	ModIniFile* config = pair.config;
+	ModItem* item = new ModItem();
+	wxLogDebug(_T(" %s"), shortname.c_str());
 
-		if (!ParseModIni(foundInis.Item(i), tcPath)) {
-			wxLogError(_T("  Parsing %s failed."), foundInis.Item(i).c_str());
-		}
-	}
+	item->shortname = shortname;
 
-	// create internal repesentation of the mod.ini's
-	wxLogDebug(_T("Transforming mod.ini's"));
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_MOD_NAME, item->name);
+
+	wxString searchShortname(isTC ? wxString(wxEmptyString) : shortname);
+	item->image255x112path = FindModImage(config, MOD_INI_KEY_LAUNCHER_IMAGE_255X112,
+		tcPath, searchShortname, _T("image255x112"));
+	item->image182x80path = FindModImage(config, MOD_INI_KEY_LAUNCHER_IMAGE_182X80,
+		tcPath, searchShortname, _T("image182x80"));
 	
-	for(size_t i = 0; i < this->configFiles->size(); i++) {
-		wxString shortname = this->configFiles->Item(i).shortname;
-		wxFileConfig* config = this->configFiles->Item(i).config;
-		ModItem* item = new ModItem();
-		wxLogDebug(_T(" %s"), shortname.c_str());
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_INFO_TEXT, item->infotext);
 
-		item->shortname = shortname;
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_AUTHOR, item->author);
 
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_MOD_NAME, item->name);
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_NOTES, item->notes);
 
-		wxString image255x112path;
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_IMAGE_255X112, image255x112path);
-		
-		if (!image255x112path.IsEmpty()) {
-			wxFileName filename;
-			wxString searchShortname((i == 0) ? wxString(wxEmptyString) : shortname);
+	config->Read(MOD_INI_KEY_LAUNCHER_WARN, &(item->warn), false);
+
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_WEBSITE, item->website);
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_FORUM, item->forum);
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_BUGS, item->bugs);
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_SUPPORT, item->support);
+	
+	config->Read(
+		MOD_INI_KEY_RESOLUTION_MIN_HORIZONTAL_RES,
+		&item->minhorizontalres,
+		DEFAULT_MOD_RESOLUTION_MIN_HORIZONTAL_RES);
+	config->Read(
+		MOD_INI_KEY_RESOLUTION_MIN_VERTICAL_RES,
+		&item->minverticalres,
+		DEFAULT_MOD_RESOLUTION_MIN_VERTICAL_RES);
+	
+	if ((item->minhorizontalres < DEFAULT_MOD_RESOLUTION_MIN_HORIZONTAL_RES) ||
+			(item->minverticalres < DEFAULT_MOD_RESOLUTION_MIN_VERTICAL_RES)) {
+		wxLogWarning(_T("Invalid minimum resolution %ldx%ld, using default"),
+			item->minhorizontalres, item->minverticalres);
+		item->minhorizontalres = DEFAULT_MOD_RESOLUTION_MIN_HORIZONTAL_RES;
+		item->minverticalres = DEFAULT_MOD_RESOLUTION_MIN_VERTICAL_RES;
+	}
+	
+	readIniFileString(
+		config,
+		MOD_INI_KEY_RECOMMENDED_LIGHTING_NAME,
+		item->recommendedlightingname);
+	readIniFileString(
+		config,
+		MOD_INI_KEY_RECOMMENDED_LIGHTING_FLAGSET,
+		item->recommendedlightingflagset);
+	SetRecommendedLighting(*item, isTC);
+
+	readIniFileString(config, MOD_INI_KEY_EXTREMEFORCE_FORCED_FLAGS_ON, item->forcedon);
+	readIniFileString(config, MOD_INI_KEY_EXTREMEFORCE_FORCED_FLAGS_OFF, item->forcedoff);
+
+	readIniFileString(config, MOD_INI_KEY_MULTIMOD_PRIMARY_LIST, item->primarylist);
+	// Log the warning for any mod authors, specifically for those who indicate
+	// that they are mod authors by their having FRED launching enabled
+	bool fredEnabled;
+	ProMan::GetProfileManager()->GlobalRead(GBL_CFG_OPT_CONFIG_FRED, &fredEnabled, false);
+	
+	if ( config->Exists(MOD_INI_KEY_MULTIMOD_SECONDRY_LIST) && fredEnabled) {
+		wxLogInfo(_T("  DEPRECATION WARNING: Mod '%s' uses deprecated mod.ini parameter 'secondrylist'"),
+			shortname.c_str());
+	}
+	readIniFileString(config, MOD_INI_KEY_MULTIMOD_SECONDARY_LIST, item->secondarylist);
+	if (item->secondarylist.IsEmpty()) {
+		readIniFileString(config, MOD_INI_KEY_MULTIMOD_SECONDRY_LIST, item->secondarylist);
+	}
+
+	// flag sets
+	if ( config->Exists(_T("/flagsetideal")) ) {
+		item->flagsets = new FlagSets();
+
+		FlagSetItem* flagset = new FlagSetItem();
+
+		readFlagSet(config, _T("/flagsetideal"), *flagset);
+
+		item->flagsets->Add(flagset);
+
+		unsigned int counter = 1;
+		bool done = false;
+		do {
+			wxString sectionname = wxString::Format(_T("/flagset%u"), counter);
+			if ( config->Exists( sectionname )) {
+				FlagSetItem* numberedflagset = new FlagSetItem();
+
+				readFlagSet(config, sectionname, *numberedflagset);
+				
+				item->flagsets->Add(numberedflagset);
+			} else {
+				done = true;
+			}
+			counter++;
+		} while ( !done );
+	} else {
+#if 0 // preprocessing out until this functionality is complete
+		wxLogDebug(_T("  Does Not Contain An idealflagset Section."));
+#endif
+	}
+
+	// skin (only available to TCs)
+	if ( isTC ) {
+		if ( config->Exists(_T("/skin")) ) {
+			// deleting any existing TCSkin will be handled by SkinSystem::ResetTCSkin()
+			// so it shouldn't be deleted here
+			this->TCSkin = new Skin();
+			
+			wxString windowTitle;
+			readIniFileString(config, MOD_INI_KEY_SKIN_WINDOW_TITLE, windowTitle);
 			
-			if (SkinSystem::SearchFile(filename, tcPath, searchShortname, image255x112path)) {
-				wxImage image(filename.GetFullPath());
+			if (!windowTitle.IsEmpty()) {
+				this->TCSkin->SetWindowTitle(windowTitle);
+			}
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_BANNER,
+				tcPath, _T("banner"), &Skin::SetBanner);
+			
+			wxString windowIconPath;
+			readIniFileString(config, MOD_INI_KEY_SKIN_WINDOW_ICON, windowIconPath);
+			
+			if (!windowIconPath.IsEmpty()) {
+				wxFileName filename;
 				
-				if (image.IsOk()) {
-					if ((image.GetWidth() == SkinSystem::ModInfoDialogImageWidth) &&
-						(image.GetHeight() == SkinSystem::ModInfoDialogImageHeight)) {
-						item->image255x112 = wxBitmap(image);
+				if (SkinSystem::SearchFile(filename, tcPath, wxEmptyString, windowIconPath)) {
+					if (this->TCSkin->SetWindowIcon(wxIcon(filename.GetFullPath(), wxBITMAP_TYPE_ICO))) {
+						wxLogDebug(_T("Set skin window icon to '%s'"),
+							filename.GetFullPath().c_str());
 					} else {
-						wxLogWarning(_T("image255x112 has invalid dimensions %dx%d"),
-							image.GetWidth(), image.GetHeight());
+						wxLogWarning(_T("Could not set skin window icon to '%s'"),
+							filename.GetFullPath().c_str());
 					}
 				} else {
-					wxLogWarning(_T("Could not set image255x112 file to '%s'"),
-						filename.GetFullPath().c_str());
+					wxLogWarning(_T("Could not find skin window icon file."));
 				}
-			} else {
-				wxLogWarning(_T("Could not find image255x112 file %s%s"),
-					(searchShortname.IsEmpty() ? wxEmptyString :
-						wxString(searchShortname + wxFileName::GetPathSeparator()).c_str()),
-					image255x112path.c_str());
 			}
-		}
-		
-		wxString image182x80path;
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_IMAGE_182X80, image182x80path);
-		
-		if (!image182x80path.IsEmpty()) {
-			wxFileName filename;
-			wxString searchShortname((i == 0) ? wxString(wxEmptyString) : shortname);
 			
-			if (SkinSystem::SearchFile(filename, tcPath, searchShortname, image182x80path)) {
-				wxImage image(filename.GetFullPath());
+			wxString welcomeText;
+			readIniFileString(config, MOD_INI_KEY_SKIN_WELCOME_TEXT, welcomeText);
+			
+			if (!welcomeText.IsEmpty()) {
+				this->TCSkin->SetWelcomeText(welcomeText);
+			}
+			
+			SetSkinModImages(*config, tcPath);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_OK,
+				tcPath, _T("ok icon"), &Skin::SetOkIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_WARNING,
+				tcPath, _T("warning icon"), &Skin::SetWarningIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_WARNING_BIG,
+				tcPath, _T("big warning icon"), &Skin::SetBigWarningIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_ERROR,
+				tcPath, _T("error icon"), &Skin::SetErrorIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_INFO,
+				tcPath, _T("info icon"), &Skin::SetInfoIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_INFO_BIG,
+				tcPath, _T("big info icon"), &Skin::SetBigInfoIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_HELP,
+				tcPath, _T("help icon"), &Skin::SetHelpIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_HELP_BIG,
+				tcPath, _T("big help icon"), &Skin::SetBigHelpIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_IDEAL,
+				tcPath, _T("ideal icon"), &Skin::SetIdealIcon);
+			
+			wxString newsSourceName;
+			readIniFileString(config, MOD_INI_KEY_SKIN_NEWS_SOURCE, newsSourceName);
+			
+			if (!newsSourceName.IsEmpty()) {
+				const NewsSource* source = NewsSource::FindSource(newsSourceName);
 				
-				if (image.IsOk()) {
-					if ((image.GetWidth() == SkinSystem::ModListImageWidth) &&
-						(image.GetHeight() == SkinSystem::ModListImageHeight)) {
-						item->image182x80 = wxBitmap(image);
-					} else {
-						wxLogWarning(_T("image182x80 has invalid dimensions %dx%d"),
-							image.GetWidth(), image.GetHeight());
-					}
-				} else {
-					wxLogWarning(_T("Could not set image182x80 file to '%s'"),
-						filename.GetFullPath().c_str());
+				if (source != NULL) {
+					this->TCSkin->SetNewsSource(source);
 				}
-			} else {
-				wxLogWarning(_T("Could not find image182x80 file %s%s"),
-					(searchShortname.IsEmpty() ? wxEmptyString :
-						wxString(searchShortname + wxFileName::GetPathSeparator()).c_str()),
-							image182x80path.c_str());
 			}
+			
+			SkinSystem::GetSkinSystem()->SetTCSkin(this->TCSkin);
+			this->TCSkin = NULL;
+		} else {
+			wxLogDebug(_T("  Does Not Contain A skin Section."));
+			SkinSystem::GetSkinSystem()->ResetTCSkin();
 		}
+	}
 
-		// other cases, which don't require handling here:
-		// if both images are Ok, then we just use them
-		// if both images are not Ok, then we use SkinSystem::modImage/smallModImage
-		if (item->image255x112.IsOk() && !item->image182x80.IsOk()) {
-			item->image182x80 = SkinSystem::MakeModListImage(item->image255x112);
-		} else if (!item->image255x112.IsOk() && item->image182x80.IsOk()) {
-			item->image255x112 = SkinSystem::MakeModInfoDialogImage(item->image182x80);
+#ifdef MOD_TEXT_LOCALIZATION // mod text localization is not supported for now
+	// langauges
+	for ( size_t i = 0;	i < SupportedLanguages.Count(); i++ ) {
+		wxString section = wxString::Format(_T("/%s"), SupportedLanguages[i].c_str());
+		if ( config->Exists(section) ) {
+			if ( item->i18n == NULL ) {
+				item->i18n = new I18nData();
+			}
 		}
+		I18nItem *temp = NULL;
 
-		wxASSERT(item->image255x112.IsOk() == item->image182x80.IsOk());
+		readTranslation(config, SupportedLanguages[i], &temp);
 		
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_INFO_TEXT, item->infotext);
-
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_AUTHOR, item->author);
+		if ( temp != NULL ) {
+			(*(item->i18n))[SupportedLanguages[i]] = temp;
+		}
+	}
+#endif
 
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_NOTES, item->notes);
+	return item;
+}
 
-		config->Read(MOD_INI_KEY_LAUNCHER_WARN, &(item->warn), false);
+ModList::ModList(wxWindow *parent, wxSize& size, wxString tcPath)
+: configFiles(new ConfigArray()), tableData(new ModItemArray()), TCSkin(NULL),
+tcPath(tcPath), watcher(NULL), images(NULL),
+rowStatesSelection(wxNOT_FOUND), rowStatesValid(false) {
+	this->Create(parent, ID_MODLISTBOX, wxDefaultPosition, size, 
+		wxLB_SINGLE | wxLB_ALWAYS_SB | wxBORDER);
+	this->SetMargins(10, 10);
+	
+	SkinSystem::RegisterTCSkinChanged(this);
+	this->images = new ModImageCache(this);
 
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_WEBSITE, item->website);
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_FORUM, item->forum);
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_BUGS, item->bugs);
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_SUPPORT, item->support);
-		
-		config->Read(
-			MOD_INI_KEY_RESOLUTION_MIN_HORIZONTAL_RES,
-			&item->minhorizontalres,
-			DEFAULT_MOD_RESOLUTION_MIN_HORIZONTAL_RES);
-		config->Read(
-			MOD_INI_KEY_RESOLUTION_MIN_VERTICAL_RES,
-			&item->minverticalres,
-			DEFAULT_MOD_RESOLUTION_MIN_VERTICAL_RES);
-		
-		if ((item->minhorizontalres < DEFAULT_MOD_RESOLUTION_MIN_HORIZONTAL_RES) ||
-				(item->minverticalres < DEFAULT_MOD_RESOLUTION_MIN_VERTICAL_RES)) {
-			wxLogWarning(_T("Invalid minimum resolution %ldx%ld, using default"),
-				item->minhorizontalres, item->minverticalres);
-			item->minhorizontalres = DEFAULT_MOD_RESOLUTION_MIN_HORIZONTAL_RES;
-			item->minverticalres = DEFAULT_MOD_RESOLUTION_MIN_VERTICAL_RES;
-		}
-		
-		readIniFileString(
-			config,
-			MOD_INI_KEY_RECOMMENDED_LIGHTING_NAME,
-			item->recommendedlightingname);
-		readIniFileString(
-			config,
-			MOD_INI_KEY_RECOMMENDED_LIGHTING_FLAGSET,
-			item->recommendedlightingflagset);
-		
-		if (!item->recommendedlightingflagset.IsEmpty()) {
-			if (item->recommendedlightingname.IsEmpty()) {
-				item->recommendedlightingname =
-					(i == 0) ? _("TC recommended") : _("Mod recommended");
-				
-				// required because & is interpreted as setting keyboard shortcut
-				// see http://docs.wxwidgets.org/stable/wx_wxcontrol.html#wxcontrolsetlabel
-				item->recommendedlightingname.Replace(_T("&"), _T("&&"));
-			} else {
-				item->recommendedlightingname.Trim(true).Trim(false);
-				item->recommendedlightingname.Truncate(MAX_PRESET_NAME_LENGTH);
-			}
-		} else {
-			wxLogDebug(_T("Recommended lighting flagset is missing or empty; using defaults."));
-			item->recommendedlightingname = DEFAULT_MOD_RECOMMENDED_LIGHTING_NAME;
-			item->recommendedlightingflagset = DEFAULT_MOD_RECOMMENDED_LIGHTING_FLAGSET;
-		}
+	std::vector<ModItem*> modsTemp; // for use in presorting
 
-		readIniFileString(config, MOD_INI_KEY_EXTREMEFORCE_FORCED_FLAGS_ON, item->forcedon);
-		readIniFileString(config, MOD_INI_KEY_EXTREMEFORCE_FORCED_FLAGS_OFF, item->forcedoff);
+	wxASSERT(wxDir::Exists(tcPath));
 
-		readIniFileString(config, MOD_INI_KEY_MULTIMOD_PRIMARY_LIST, item->primarylist);
-		// Log the warning for any mod authors, specifically for those who indicate
-		// that they are mod authors by their having FRED launching enabled
-		bool fredEnabled;
-		ProMan::GetProfileManager()->GlobalRead(GBL_CFG_OPT_CONFIG_FRED, &fredEnabled, false);
-		
-		if ( config->Exists(MOD_INI_KEY_MULTIMOD_SECONDRY_LIST) && fredEnabled) {
-			wxLogInfo(_T("  DEPRECATION WARNING: Mod '%s' uses deprecated mod.ini parameter 'secondrylist'"),
-				shortname.c_str());
-		}
-		readIniFileString(config, MOD_INI_KEY_MULTIMOD_SECONDARY_LIST, item->secondarylist);
-		if (item->secondarylist.IsEmpty()) {
-			readIniFileString(config, MOD_INI_KEY_MULTIMOD_SECONDRY_LIST, item->secondarylist);
-		}
+	// parse mod.ini's in all of the directories that contain one
 
-		// flag sets
-		if ( config->Exists(_T("/flagsetideal")) ) {
-			item->flagsets = new FlagSets();
+	wxLogDebug(_T("Inserting '(No mod)'"));
+	wxFileName tcmodini(tcPath, _T("mod.ini"));
+	const bool hasTCModIni = tcmodini.IsOk() && tcmodini.FileExists();
+	if ( hasTCModIni ) {
+		wxLogDebug(_T(" Found a mod.ini in the root TC folder. (%s)"), tcmodini.GetFullPath().c_str());
 
-			FlagSetItem* flagset = new FlagSetItem();
+		if (!ParseModIni(tcmodini.GetFullPath(), tcPath, true)) {
+			wxLogError(_T(" Error parsing mod.ini in the root TC folder. (%s)"),
+				tcmodini.GetFullPath().c_str());
+		}
+	} else {
+		this->configFiles->Add(new ConfigPair(NO_MOD, new ModIniFile()));
+		wxLogDebug(_T(" Using defaults for TC."));
+	}
 
-			readFlagSet(config, _T("/flagsetideal"), *flagset);
+	// scan for mods in the current TCs directory, parsing each mod.ini
+	// while the scanner is still looking for the rest
+	wxStopWatch scanTimer;
+	ModIniScanner scanner(tcPath);
+	scanner.Start();
 
-			item->flagsets->Add(flagset);
+	// mods whose mod.ini has not changed since the last scan are taken from the catalog
+	ModCatalog catalog;
+	catalog.Load();
+	catalog.BeginScan();
+	std::vector<const ModCatalogEntry*> cachedMods;
 
-			unsigned int counter = 1;
-			bool done = false;
-			do {
-				wxString sectionname = wxString::Format(_T("/flagset%u"), counter);
-				if ( config->Exists( sectionname )) {
-					FlagSetItem* numberedflagset = new FlagSetItem();
+	wxLogDebug(_T("Starting to parse mod.ini's..."));
+	size_t foundInis = 0;
+	wxArrayString knownModInis; // handed to the watcher
+	wxString modIniPath;
+	while (scanner.GetNextModIni(modIniPath)) {
+		knownModInis.Add(modIniPath);
+
+		// a mod.ini in the root TC folder has already been addressed above
+		if (hasTCModIni && modIniPath == tcmodini.GetFullPath()) {
+			continue;
+		}
+		foundInis++;
 
-					readFlagSet(config, sectionname, *numberedflagset);
-					
-					item->flagsets->Add(numberedflagset);
-				} else {
-					done = true;
-				}
-				counter++;
-			} while ( !done );
-		} else {
-#if 0 // preprocessing out until this functionality is complete
-			wxLogDebug(_T("  Does Not Contain An idealflagset Section."));
-#endif
+		const ModCatalogEntry* entry = catalog.Find(modIniPath);
+		if (entry != NULL) {
+			wxLogDebug(_T("  Using catalog entry for %s"), modIniPath.c_str());
+			cachedMods.push_back(entry);
+			continue;
 		}
+		wxLogDebug(_T("  Parsing %s"), modIniPath.c_str());
 
-		// skin (only available to TCs)
-		if ( i == 0 ) {
-			if ( config->Exists(_T("/skin")) ) {
-				// deleting any existing TCSkin will be handled by SkinSystem::ResetTCSkin()
-				// so it shouldn't be deleted here
-				this->TCSkin = new Skin();
-				
-				wxString windowTitle;
-				readIniFileString(config, MOD_INI_KEY_SKIN_WINDOW_TITLE, windowTitle);
-				
-				if (!windowTitle.IsEmpty()) {
-					this->TCSkin->SetWindowTitle(windowTitle);
-				}
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_BANNER,
-					tcPath, _T("banner"), &Skin::SetBanner);
-				
-				wxString windowIconPath;
-				readIniFileString(config, MOD_INI_KEY_SKIN_WINDOW_ICON, windowIconPath);
-				
-				if (!windowIconPath.IsEmpty()) {
-					wxFileName filename;
-					
-					if (SkinSystem::SearchFile(filename, tcPath, wxEmptyString, windowIconPath)) {
-						if (this->TCSkin->SetWindowIcon(wxIcon(filename.GetFullPath(), wxBITMAP_TYPE_ICO))) {
-							wxLogDebug(_T("Set skin window icon to '%s'"),
-								filename.GetFullPath().c_str());
-						} else {
-							wxLogWarning(_T("Could not set skin window icon to '%s'"),
-								filename.GetFullPath().c_str());
-						}
-					} else {
-						wxLogWarning(_T("Could not find skin window icon file."));
-					}
-				}
-				
-				wxString welcomeText;
-				readIniFileString(config, MOD_INI_KEY_SKIN_WELCOME_TEXT, welcomeText);
-				
-				if (!welcomeText.IsEmpty()) {
-					this->TCSkin->SetWelcomeText(welcomeText);
-				}
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_MOD_IMAGE_255X112,
-					tcPath, _T("mod image"), &Skin::SetModImage);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_MOD_IMAGE_182X80,
-					tcPath, _T("small mod image"), &Skin::SetSmallModImage);
-				
-				// if one mod image is missing, create it by scaling the other one
-				if (this->TCSkin->GetModImage().IsOk() && !this->TCSkin->GetSmallModImage().IsOk()) {
-					this->TCSkin->SetSmallModImage(
-						SkinSystem::MakeModListImage(this->TCSkin->GetModImage()));
-				} else if (!this->TCSkin->GetModImage().IsOk() && this->TCSkin->GetSmallModImage().IsOk()) {
-					this->TCSkin->SetModImage(
-						SkinSystem::MakeModInfoDialogImage(this->TCSkin->GetSmallModImage()));
-				}
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_OK,
-					tcPath, _T("ok icon"), &Skin::SetOkIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_WARNING,
-					tcPath, _T("warning icon"), &Skin::SetWarningIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_WARNING_BIG,
-					tcPath, _T("big warning icon"), &Skin::SetBigWarningIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_ERROR,
-					tcPath, _T("error icon"), &Skin::SetErrorIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_INFO,
-					tcPath, _T("info icon"), &Skin::SetInfoIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_INFO_BIG,
-					tcPath, _T("big info icon"), &Skin::SetBigInfoIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_HELP,
-					tcPath, _T("help icon"), &Skin::SetHelpIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_HELP_BIG,
-					tcPath, _T("big help icon"), &Skin::SetBigHelpIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_IDEAL,
-					tcPath, _T("ideal icon"), &Skin::SetIdealIcon);
-				
-				wxString newsSourceName;
-				readIniFileString(config, MOD_INI_KEY_SKIN_NEWS_SOURCE, newsSourceName);
-				
-				if (!newsSourceName.IsEmpty()) {
-					const NewsSource* source = NewsSource::FindSource(newsSourceName);
-					
-					if (source != NULL) {
-						this->TCSkin->SetNewsSource(source);
-					}
-				}
-				
-				SkinSystem::GetSkinSystem()->SetTCSkin(this->TCSkin);
-				this->TCSkin = NULL;
-			} else {
-				wxLogDebug(_T("  Does Not Contain A skin Section."));
-				SkinSystem::GetSkinSystem()->ResetTCSkin();
-			}
+		if (!ParseModIni(modIniPath, tcPath)) {
+			wxLogError(_T("  Parsing %s failed."), modIniPath.c_str());
 		}
+	}
 
-#ifdef MOD_TEXT_LOCALIZATION // mod text localization is not supported for now
-		// langauges
-		for ( size_t i = 0;	i < SupportedLanguages.Count(); i++ ) {
-			wxString section = wxString::Format(_T("/%s"), SupportedLanguages[i].c_str());
-			if ( config->Exists(section) ) {
-				if ( item->i18n == NULL ) {
-					item->i18n = new I18nData();
-				}
-			}
-			I18nItem *temp = NULL;
+	wxLogDebug(_T("Found ") SZT _T(" mod.ini file(s) in ") SZT _T(" folder(s) in %ld ms."),
+		foundInis, scanner.GetFolderCount(), scanTimer.Time());
 
-			readTranslation(config, SupportedLanguages[i], &temp);
-			
-			if ( temp != NULL ) {
-				(*(item->i18n))[SupportedLanguages[i]] = temp;
+	// create internal repesentation of the mod.ini's
+	wxLogDebug(_T("Transforming mod.ini's"));
+	
+	for(size_t i = 0; i < this->configFiles->size(); i++) {
+		ModItem* item = BuildModItem(this->configFiles->Item(i), tcPath, i == 0);
+
+		if (!this->configFiles->Item(i).modIniPath.IsEmpty()) {
+			ModCatalogEntry* entry = MakeCatalogEntry(*item,
+				this->configFiles->Item(i).config, this->configFiles->Item(i).modIniPath);
+			if (entry != NULL) {
+				catalog.Put(entry);
 			}
 		}
-#endif
 
 		modsTemp.push_back(item);
 	}
 	
+	for (std::vector<const ModCatalogEntry*>::const_iterator it = cachedMods.begin();
+		 it != cachedMods.end(); ++it) {
+		modsTemp.push_back(MakeModItem(**it, tcPath));
+	}
+	
+	catalog.EndScan(tcPath);
+	catalog.Save();
+	
+	wxLogDebug(_T("Mod list built in %ld ms (") SZT _T(" mod(s) from the catalog, ")
+		SZT _T(" parsed)."), scanTimer.Time(), cachedMods.size(), this->configFiles->size());
+	
 	std::sort(modsTemp.begin(), modsTemp.end(), CompareModItems);
 	
 	for (std::vector<ModItem*>::const_iterator it = modsTemp.begin();
@@ -599,7 +754,9 @@ ModList::ModList(wxWindow *parent, wxSize& size, wxString tcPath)
 	this->buttonSizer->Show(false);
 	this->warnBitmap->Show(false);
 
-
+	// keep the list up to date as mods are added, changed or removed
+	this->watcher = new TCFolderWatcher(this);
+	this->watcher->Start(tcPath, knownModInis);
 }
 
 /** the dtor.  Cleans up stuff. */
@@ -608,6 +765,14 @@ ModList::~ModList() {
 		SkinSystem::UnRegisterTCSkinChanged(this);
 	}
 	
+	if ( this->watcher != NULL ) {
+		delete this->watcher;
+	}
+	
+	if ( this->images != NULL ) {
+		delete this->images;
+	}
+	
 	if ( this->configFiles != NULL ) {
 		delete this->configFiles;
 	}
@@ -626,15 +791,12 @@ ModList::~ModList() {
 
 /** Takes the key to search for and sets location to key's value.
     If the key is not found, location is unchanged. */
-void ModList::readIniFileString(const wxFileConfig* config,
+void ModList::readIniFileString(const ModIniFile* config,
 		const wxString& key, wxString& location) {
 	wxASSERT(config != NULL);
 
 	if ( config->HasEntry(key) ) {
-		config->Read(key, &location);
-		if ( location.EndsWith(_T(";")) ) {
-			location.RemoveLast();
-		}
+		location = readIniFileValue(config, key);
 	}
 
 	wxLogDebug(wxT_2("  %s:'%s'"),
@@ -642,6 +804,20 @@ void ModList::readIniFileString(const wxFileConfig* config,
 		location.IsEmpty() ? wxT_2("Not Specified") : escapeSpecials(location).c_str());
 }
 
+/** Returns key's value without logging it, or an empty string if the key is not found. */
+wxString ModList::readIniFileValue(const ModIniFile* config, const wxString& key) {
+	wxASSERT(config != NULL);
+
+	wxString value;
+	if ( config->HasEntry(key) ) {
+		config->Read(key, &value);
+		if ( value.EndsWith(_T(";")) ) {
+			value.RemoveLast();
+		}
+	}
+	return value;
+}
+
 /** re-escape the newlines in the mod.ini values. */
 wxString ModList::escapeSpecials(const wxString& toEscape) {
 	wxString toEscapeTemp(toEscape);
@@ -667,7 +843,7 @@ wxString ModList::escapeSpecials(const wxString& toEscape) {
 
 
 /** */
-void ModList::readFlagSet(const wxFileConfig* config,
+void ModList::readFlagSet(const ModIniFile* config,
 		const wxString& keyprefix, FlagSetItem& set) {
 	wxCHECK_RET(config != NULL, _T("readFlagSet(): config is NULL!"));
 	
@@ -683,7 +859,7 @@ void ModList::readFlagSet(const wxFileConfig* config,
 }
 
 #ifdef MOD_TEXT_LOCALIZATION // mod text localization is not supported for now
-void ModList::readTranslation(wxFileConfig* config, wxString langaugename, I18nItem **trans) {
+void ModList::readTranslation(ModIniFile* config, wxString langaugename, I18nItem **trans) {
 	wxString section = wxString::Format(_T("/%s"), langaugename.c_str());
 	if ( config->Exists(section) ) {
 		*trans = new I18nItem();
@@ -705,63 +881,16 @@ void ModList::readTranslation(wxFileConfig* config, wxString langaugename, I18nI
 /** Parses the specified mod.ini file and adds it to configFiles.
     Returns true on success, false otherwise. */
 bool ModList::ParseModIni(const wxString& modIniPath, const wxString& tcPath, const bool isNoMod) {
-	wxFFileInputStream stream(modIniPath);
+	ModIniFile* config = new ModIniFile();
 
-	if ( stream.IsOk() ) {
+	if ( config->Load(modIniPath) ) {
 		wxLogDebug(_T("   Opened ok"));
 	} else {
 		wxLogError(_T("   Open failed!"));
+		delete config;
 		return false;
 	}
 
-	// check if the stream is a UTF-8 File (has a BOM)
-	char header[3];
-	stream.Read(reinterpret_cast<void*>(&header), sizeof(header));
-	stream.SeekI(0);
-	
-	bool isUTF8 = false;
-	if ( header[0] == '\357' && header[1] == '\273' && header[2] == '\277' ) {
-		// is a UTF-8 file
-		isUTF8 = true;
-	}
-
-	wxMemoryOutputStream tempStream;
-	tempStream.Write(stream);
-
-	wxStreamBuffer* buf = tempStream.GetOutputStreamBuffer();
-	const size_t size = buf->GetBufferSize();
-
-	char* characterBuffer = new char[size+1];
-	characterBuffer[size] = '\0';
-
-	buf->Seek(0, wxFromStart);
-
-	// don't try to read in buffer when there is nothing to read.
-	size_t read = (size == 0) ? 0 : buf->Read(reinterpret_cast<void*>(characterBuffer), size);
-	if ( read != size ) {
-		wxLogError(wxT("read (") SZT wxT(") not equal to size (") SZT wxT(")"), read, size);
-		delete[] characterBuffer;
-		return false;
-	}
-
-	const wxMBConv* conv = NULL;
-	if ( isUTF8 ) {
-		conv = &wxConvUTF8;
-	} else {
-		conv = &wxConvISO8859_1;
-	}
-
-	wxString stringBuffer(characterBuffer, *conv);
-
-	// A hack to insert a backslash into the stream so that when
-	// wxFileConfig escapes the backslashes, the one that is in 
-	// the file is returned
-	stringBuffer.Replace(_T("\\"), _T("\\\\"));
-	wxStringInputStream finalBuffer(stringBuffer);
-
-	wxFileConfig* config = new wxFileConfig(finalBuffer);
-	delete[] characterBuffer;
-
 	wxString shortname(isNoMod ? NO_MOD : GetShortName(modIniPath, tcPath));
 	
 	if (!isNoMod) {
@@ -771,7 +900,7 @@ bool ModList::ParseModIni(const wxString& modIniPath, const wxString& tcPath, co
 		wxLogDebug(_T("   Mod short name is: %s"), shortname.c_str());
 	} 
 
-	this->configFiles->Add(new ConfigPair(shortname, config));
+	this->configFiles->Add(new ConfigPair(shortname, config, isNoMod ? wxString(wxEmptyString) : modIniPath));
 
 	return true;
 }
@@ -824,8 +953,11 @@ wxString ModList::GetShortName(const wxString& modIniPath, const wxString& tcPat
 }
 
 void ModList::OnDrawItem(wxDC &dc, const wxRect &rect, size_t n) const {
-	wxLogDebug(_T(" Draw %04d,%04d = %04d,%04d"), rect.x, rect.y, rect.width, rect.height);
-	this->tableData->Item(n).Draw(dc, rect, this->IsSelected(n), this->sizer, this->buttonSizer, this->warnBitmap);
+	const ModItem& item = this->tableData->Item(n);
+	ModImages modImages;
+	const bool decoded = this->images->Get(item.image255x112path, item.image182x80path, modImages);
+	this->tableData->Item(n).Draw(dc, rect, this->IsSelected(n), this->sizer, this->buttonSizer, this->warnBitmap,
+		decoded ? &modImages.image182x80 : NULL);
 }
 
 void ModList::OnDrawSeparator(wxDC &WXUNUSED(dc), wxRect& WXUNUSED(rect), size_t WXUNUSED(n)) const {
@@ -833,23 +965,27 @@ void ModList::OnDrawSeparator(wxDC &WXUNUSED(dc), wxRect& WXUNUSED(rect), size_t
 }
 
 void ModList::OnDrawBackground(wxDC &dc, const wxRect& rect, size_t n) const {
-	wxLogDebug(_T(" Background %04d,%04d = %04d,%04d"), rect.x, rect.y, rect.width, rect.height);
+	// the selection can also be changed without an event, such as by SetSelection()
+	if ( !this->rowStatesValid || this->rowStatesSelection != this->GetSelection()
+		|| this->rowStates.size() != this->tableData->size() ) {
+		this->UpdateRowStates();
+	}
+	const int state = this->rowStates[n];
+	
 	dc.DestroyClippingRegion();
 	wxColour highlighted = wxSystemSettings::GetColour(wxSYS_COLOUR_HIGHLIGHT);
 	wxColour background = wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW);
-	wxString activeMod;
-	ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_CURRENT_MOD, &activeMod, NO_MOD, true);
 	wxBrush b;
 	wxRect selectedRect(rect.x+2, rect.y+2, rect.width-4, rect.height-4);
 	wxRect activeRect(selectedRect.x+3, selectedRect.y+3, selectedRect.width-7, selectedRect.height-7);
 
-	if ( this->IsSelected(n) ) {
+	if ( (state & ROW_SELECTED) != 0 ) {
 		b = wxBrush(highlighted, wxTRANSPARENT);
 		dc.SetPen(wxPen(highlighted, 4));
-	} else if ( this->isCurrentSelectionAnAppendMod(this->tableData->Item(n).shortname) ) {
+	} else if ( (state & ROW_SELECTION_APPEND) != 0 ) {
 		b = wxBrush(highlighted, wxBDIAGONAL_HATCH);
 		dc.SetPen(wxPen(highlighted, 1));
-	} else if ( this->isCurrentSelectionAPrependMod(this->tableData->Item(n).shortname) ) {
+	} else if ( (state & ROW_SELECTION_PREPEND) != 0 ) {
 		b = wxBrush(highlighted, wxFDIAGONAL_HATCH);
 		dc.SetPen(wxPen(highlighted, 1));
 	} else {
@@ -860,13 +996,13 @@ void ModList::OnDrawBackground(wxDC &dc, const wxRect& rect, size_t n) const {
 	dc.SetBrush(b);
 	dc.DrawRoundedRectangle(selectedRect, 10.0);
 
-	if ( activeMod == this->tableData->Item(n).shortname ) {
+	if ( (state & ROW_ACTIVE) != 0 ) {
 		b = wxBrush(highlighted, wxSOLID);
 		dc.SetPen(wxPen(highlighted, 1));
-	} else if ( this->isAnAppendMod(this->tableData->Item(n).shortname) ) {
+	} else if ( (state & ROW_ACTIVE_APPEND) != 0 ) {
 		b = wxBrush(highlighted, wxBDIAGONAL_HATCH);
 		dc.SetPen(wxPen(highlighted, 1));
-	} else if ( this->isAPrependMod(this->tableData->Item(n).shortname) ) {
+	} else if ( (state & ROW_ACTIVE_PREPEND) != 0 ) {
 		b = wxBrush(highlighted, wxFDIAGONAL_HATCH);
 		dc.SetPen(wxPen(highlighted, 1));
 	} else {
@@ -893,6 +1029,13 @@ void ModList::OnActivateMod(wxCommandEvent &WXUNUSED(event)) {
 	int selected = this->GetSelection();
 	wxCHECK_RET(selected != wxNOT_FOUND, _T("Do not have a valid selection."));
 	
+	this->ActivateMod(static_cast<size_t>(selected));
+}
+
+/** Makes the mod at index the active mod. */
+void ModList::ActivateMod(size_t selected) {
+	wxCHECK_RET(selected < this->tableData->size(), _T("ActivateMod(): index out of range."));
+	
 	ModList::activeMod = &this->tableData->Item(selected);
 
 	wxString modline;
@@ -934,64 +1077,254 @@ void ModList::OnActivateMod(wxCommandEvent &WXUNUSED(event)) {
 	ProMan::GetProfileManager()->ProfileWrite(PRO_CFG_TC_CURRENT_MODLINE, modline);
 	ProMan::GetProfileManager()->ProfileWrite(PRO_CFG_TC_CURRENT_MOD, shortname);
 
+	this->rowStatesValid = false;
 	TCManager::GenerateTCActiveModChanged();
 	this->Refresh();
 }
 
+/** Updates the list in place for the mod.ini files that the watcher found
+ to be added, changed or removed. The selection and the scroll position are
+ kept, and if the active mod changed, it is activated again. */
+void ModList::OnModInisChanged(wxCommandEvent &WXUNUSED(event)) {
+	ModIniChanges changes;
+	this->watcher->TakeChanges(changes);
+	if (changes.IsEmpty()) {
+		return;
+	}
+	
+	const int selected = this->GetSelection();
+	const wxString selectedShortname((selected == wxNOT_FOUND) ?
+		wxString(wxEmptyString) : this->tableData->Item(selected).shortname);
+#if wxCHECK_VERSION(2, 9, 0)
+	const size_t top = this->GetVisibleRowsBegin();
+#else
+	const size_t top = this->GetFirstVisibleLine();
+#endif
+	const wxString topShortname((top < this->tableData->size()) ?
+		this->tableData->Item(top).shortname : wxString(wxEmptyString));
+	const wxString activeShortname((ModList::activeMod == NULL) ?
+		wxString(wxEmptyString) : ModList::activeMod->shortname);
+	
+	// keep the catalog in step, so the next start does not use stale entries
+	ModCatalog catalog;
+	catalog.Load();
+	
+	bool activeModChanged = false;
+	for (size_t i = 0; i < changes.removed.GetCount(); i++) {
+		wxLogInfo(_T("Mod.ini %s was removed"), changes.removed[i].c_str());
+		activeModChanged |= this->UpdateModItem(changes.removed[i], catalog);
+	}
+	for (size_t i = 0; i < changes.changed.GetCount(); i++) {
+		wxLogInfo(_T("Mod.ini %s was changed"), changes.changed[i].c_str());
+		activeModChanged |= this->UpdateModItem(changes.changed[i], catalog);
+	}
+	for (size_t i = 0; i < changes.added.GetCount(); i++) {
+		wxLogInfo(_T("Mod.ini %s was added"), changes.added[i].c_str());
+		activeModChanged |= this->UpdateModItem(changes.added[i], catalog);
+	}
+	
+	catalog.Save();
+	
+	this->SetItemCount(this->tableData->size());
+	this->rowStatesValid = false;
+	
+	int newSelected = this->FindModItem(selectedShortname);
+	if (newSelected == wxNOT_FOUND) {
+		newSelected = this->FindModItem(NO_MOD);
+	}
+	this->SetSelection(newSelected);
+	
+	const int newTop = this->FindModItem(topShortname);
+	if (newTop != wxNOT_FOUND) {
+#if wxCHECK_VERSION(2, 9, 0)
+		this->ScrollToRow(static_cast<size_t>(newTop));
+#else
+		this->ScrollToLine(static_cast<size_t>(newTop));
+#endif
+	}
+	
+	if (activeModChanged) {
+		int active = this->FindModItem(activeShortname);
+		if (active == wxNOT_FOUND) {
+			wxLogInfo(_T("Active mod %s is gone, activating %s"),
+				activeShortname.c_str(), NO_MOD.c_str());
+			active = this->FindModItem(NO_MOD);
+		}
+		wxCHECK_RET(active != wxNOT_FOUND, _T("OnModInisChanged(): (No mod) is missing."));
+		this->ActivateMod(static_cast<size_t>(active));
+	}
+	
+	this->Refresh();
+}
+
+/** Replaces the list item for the mod.ini at modIniPath with one made from
+ the mod.ini's current contents, or removes it if the mod.ini no longer exists.
+ The mod's entry in catalog is replaced or removed to match.
+ Returns true if the item was the active mod's. */
+bool ModList::UpdateModItem(const wxString& modIniPath, ModCatalog& catalog) {
+	const bool isTC = (modIniPath == wxFileName(this->tcPath, _T("mod.ini")).GetFullPath());
+	const wxString shortname(isTC ? NO_MOD : GetShortName(modIniPath, this->tcPath));
+	bool wasActive = false;
+	wxArrayString oldImagePaths;
+	
+	const int index = this->FindModItem(shortname);
+	if (index != wxNOT_FOUND) {
+		wasActive = (ModList::activeMod == &this->tableData->Item(index));
+		if (wasActive) {
+			ModList::activeMod = NULL;
+		}
+		// the images may have been replaced along with the mod.ini
+		this->images->Forget(this->tableData->Item(index).image255x112path,
+			this->tableData->Item(index).image182x80path);
+		oldImagePaths.Add(this->tableData->Item(index).image255x112path);
+		oldImagePaths.Add(this->tableData->Item(index).image182x80path);
+		this->tableData->RemoveAt(static_cast<size_t>(index));
+	}
+	ResolutionMap::ResolutionErase(shortname);
+	
+	for (size_t i = 0; i < this->configFiles->size(); i++) {
+		if (this->configFiles->Item(i).shortname == shortname) {
+			this->configFiles->RemoveAt(i);
+			break;
+		}
+	}
+	
+	bool parsed = false;
+	if (wxFileName::FileExists(modIniPath)) {
+		parsed = ParseModIni(modIniPath, this->tcPath, isTC);
+		if (!parsed) {
+			wxLogError(_T("  Parsing %s failed."), modIniPath.c_str());
+		}
+	}
+	
+	ModCatalogEntry* entry = NULL;
+	if (parsed || isTC) {
+		if (!parsed) {
+			// the TC itself always has an entry, even without a mod.ini
+			this->configFiles->Add(new ConfigPair(NO_MOD, new ModIniFile()));
+		}
+		ModItem* item = BuildModItem(this->configFiles->Last(), this->tcPath, isTC);
+		if (!this->configFiles->Last().modIniPath.IsEmpty()) {
+			entry = MakeCatalogEntry(*item, this->configFiles->Last().config, modIniPath);
+		}
+		for (size_t i = oldImagePaths.GetCount(); i > 0; i--) {
+			if (oldImagePaths[i - 1] == item->image255x112path
+				|| oldImagePaths[i - 1] == item->image182x80path) {
+				oldImagePaths.RemoveAt(i - 1);
+			}
+		}
+		this->InsertModItem(item);
+	}
+	
+	// thumbnails of images that the mod no longer uses would never be read again
+	for (size_t i = 0; i < oldImagePaths.GetCount(); i++) {
+		if (!oldImagePaths[i].IsEmpty()) {
+			this->images->RemoveThumbnails(oldImagePaths[i]);
+		}
+	}
+	
+	if (entry != NULL) {
+		catalog.Put(entry);
+	} else {
+		catalog.Remove(modIniPath);
+	}
+	
+	return wasActive;
+}
+
+/** Returns the index of the mod with the given shortname, or wxNOT_FOUND. */
+int ModList::FindModItem(const wxString& shortname) const {
+	if (shortname.IsEmpty()) {
+		return wxNOT_FOUND;
+	}
+	for (size_t i = 0; i < this->tableData->size(); i++) {
+		if (this->tableData->Item(i).shortname == shortname) {
+			return static_cast<int>(i);
+		}
+	}
+	return wxNOT_FOUND;
+}
+
+/** Inserts item where it belongs in the sorted list. Takes ownership of item. */
+void ModList::InsertModItem(ModItem* item) {
+	size_t i = 0;
+	while (i < this->tableData->size() && !CompareModItems(item, &this->tableData->Item(i))) {
+		i++;
+	}
+	this->tableData->Insert(item, i);
+}
+
 void ModList::OnInfoMod(wxCommandEvent &WXUNUSED(event)) {
 	int selected = this->GetSelection();
 	wxCHECK_RET(selected != wxNOT_FOUND, _T("Do not have a valid selection."));
-	new ModInfoDialog(new ModItem(this->tableData->Item(selected)), this);
+	const ModItem& item = this->tableData->Item(selected);
+	new ModInfoDialog(new ModItem(item),
+		this->images->GetNow(item.image255x112path, item.image182x80path).image255x112, this);
 }
 
 void ModList::OnTCSkinChanged(wxCommandEvent &WXUNUSED(event)) {
 	Refresh();
 }
 
+void ModList::OnModImagesDecoded(wxCommandEvent &WXUNUSED(event)) {
+	this->images->CollectDecoded();
+	this->Refresh();
+}
+
 // comparison is case-insensitive, and mod names containing spaces are preserved
-bool ModList::isADependency(const wxString &mod, const wxString& modlist) {
-	wxCHECK_MSG(!mod.IsEmpty(), false, _T("isADependency() called with empty mod!"));
-	wxCHECK_MSG(!modlist.IsEmpty(), false, _T("isADependency() called with empty modlist!"));
-	
+static wxString NormalizeModName(const wxString& mod) {
 	wxString normalizedModName(mod);
 	normalizedModName.Trim(true).Trim(false).MakeLower();
+	return normalizedModName;
+}
 
+void ModList::ParseModList(const wxString& modlist, wxSortedArrayString& mods) {
 	wxStringTokenizer tokens(modlist, _T(","), wxTOKEN_STRTOK);
 	while ( tokens.HasMoreTokens() ) {
-		if ( tokens.GetNextToken().Trim(true).Trim(false).Lower() == normalizedModName ) {
-			return true;
-		}
+		mods.Add(NormalizeModName(tokens.GetNextToken()));
 	}
-	return false;
-}
-
-
-bool ModList::isAnAppendMod(const wxString &mod) const {
-	if ( this->appendmods.IsEmpty() ) return false; // no append mods, mod cannot be one
-	return ModList::isADependency(mod, this->appendmods);
 }
 
-bool ModList::isAPrependMod(const wxString &mod) const {
-	if ( this->prependmods.IsEmpty() ) return false;	// no prepend mods, mod cannot be one
-	return ModList::isADependency(mod, this->prependmods);
-}
-
-bool ModList::isCurrentSelectionAnAppendMod(const wxString &mod) const {
-	int selection = this->GetSelection();
-	if ( selection == wxNOT_FOUND
-		|| this->tableData->Item(selection).secondarylist.IsEmpty()) {
-			return false;
+/** Works out how each row relates to the selected and the active mod. */
+void ModList::UpdateRowStates() const {
+	const int selection = this->GetSelection();
+	wxSortedArrayString selectionPrepends, selectionAppends, activePrepends, activeAppends;
+	if ( selection != wxNOT_FOUND ) {
+		ParseModList(this->tableData->Item(selection).primarylist, selectionPrepends);
+		ParseModList(this->tableData->Item(selection).secondarylist, selectionAppends);
 	}
-	return ModList::isADependency(mod, this->tableData->Item(selection).secondarylist);
-}
-
-bool ModList::isCurrentSelectionAPrependMod(const wxString &mod) const {
-	int selection = this->GetSelection();
-	if ( selection == wxNOT_FOUND
-		|| this->tableData->Item(selection).primarylist.IsEmpty()) {
-		return false;
+	ParseModList(this->prependmods, activePrepends);
+	ParseModList(this->appendmods, activeAppends);
+
+	this->rowStates.assign(this->tableData->size(), 0);
+	for ( size_t i = 0; i < this->tableData->size(); i++ ) {
+		const ModItem& item = this->tableData->Item(i);
+		const wxString mod(NormalizeModName(item.shortname));
+		int state = 0;
+		
+		if ( static_cast<int>(i) == selection ) {
+			state |= ROW_SELECTED;
+		}
+		if ( selectionPrepends.Index(mod) != wxNOT_FOUND ) {
+			state |= ROW_SELECTION_PREPEND;
+		}
+		if ( selectionAppends.Index(mod) != wxNOT_FOUND ) {
+			state |= ROW_SELECTION_APPEND;
+		}
+		if ( ModList::activeMod != NULL && ModList::activeMod->shortname == item.shortname ) {
+			state |= ROW_ACTIVE;
+		}
+		if ( activePrepends.Index(mod) != wxNOT_FOUND ) {
+			state |= ROW_ACTIVE_PREPEND;
+		}
+		if ( activeAppends.Index(mod) != wxNOT_FOUND ) {
+			state |= ROW_ACTIVE_APPEND;
+		}
+		this->rowStates[i] = state;
 	}
-	return ModList::isADependency(mod, this->tableData->Item(selection).primarylist);
+	
+	this->rowStatesSelection = selection;
+	this->rowStatesValid = true;
 }
 
 
@@ -999,6 +1332,8 @@ BEGIN_EVENT_TABLE(ModList, wxVListBox)
 EVT_LISTBOX(ID_MODLISTBOX, ModList::OnSelectionChange)
 EVT_BUTTON(ID_MODLISTBOX_ACTIVATE_BUTTON, ModList::OnActivateMod)
 EVT_BUTTON(ID_MODLISTBOX_INFO_BUTTON, ModList::OnInfoMod)
+EVT_COMMAND(wxID_NONE, EVT_TC_MOD_INIS_CHANGED, ModList::OnModInisChanged)
+EVT_COMMAND(wxID_NONE, EVT_MOD_IMAGES_DECODED, ModList::OnModImagesDecoded)
 END_EVENT_TABLE()
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1094,7 +1429,8 @@ ModItem::~ModItem() {
 	if (this->modNamePanel != NULL) delete this->modNamePanel;
 }
 
-void ModItem::Draw(wxDC &dc, const wxRect &rect, bool selected, wxSizer* mainSizer, wxSizer* buttons, wxStaticBitmap* warn) {
+void ModItem::Draw(wxDC &dc, const wxRect &rect, bool selected, wxSizer* mainSizer, wxSizer* buttons,
+		wxStaticBitmap* warn, const wxBitmap* image182x80) {
 	wxRect titlerect = rect;
 	titlerect.width = 150;
 
@@ -1113,7 +1449,7 @@ void ModItem::Draw(wxDC &dc, const wxRect &rect, bool selected, wxSizer* mainSiz
 	dc.SetFont(titlefont);
 	this->modNamePanel->Draw(dc, titlerect);
 	dc.SetFont(SkinSystem::GetSkinSystem()->GetFont());
-	this->modImagePanel->Draw(dc, imgrect);
+	this->modImagePanel->Draw(dc, imgrect, image182x80);
 
 	if ( selected ) { /* If I am selected do not have info panel draw because 
 					  I am going to put the buttons over the info text. */
@@ -1144,45 +1480,54 @@ ModItem::InfoText::InfoText(ModItem *myData) {
 
 void ModItem::InfoText::Draw(wxDC &dc, const wxRect &rect) {
 	if ( !this->myData->infotext.IsEmpty() ) {
-		// to keep "\n" from appearing in the mod list info text
-		wxString escapedInfoText(this->myData->infotext);
-		escapedInfoText.Replace(_T("\\n"), _T(" "));
-		
-		wxStringTokenizer tokens(escapedInfoText);
-		ArrayOfWords words;
-		words.Alloc(tokens.CountTokens());
+		if ( !this->layout.IsValidFor(this->myData->infotext, dc.GetFont(), rect.GetSize()) ) {
+			this->Layout(dc, this->myData->infotext, rect.GetSize());
+		}
+		this->layout.Draw(dc, rect.GetPosition());
+	}
+}
 
-		FillArrayOfWordsFromTokens(tokens, dc, NULL, words);
+/** Wraps the info text to the width of the row, dropping the lines that do
+ not fit in its height. */
+void ModItem::InfoText::Layout(wxDC &dc, const wxString& text, const wxSize& size) {
+	this->layout.Reset(text, dc.GetFont(), size);
 
-		const int maxwidth = rect.width;
-		int currentx = rect.x, currenty = rect.y;
+	// to keep "\n" from appearing in the mod list info text
+	wxString escapedInfoText(text);
+	escapedInfoText.Replace(_T("\\n"), _T(" "));
+	
+	wxStringTokenizer tokens(escapedInfoText);
+	ArrayOfWords words;
+	words.Alloc(tokens.CountTokens());
 
-		wxSize spaceSize = dc.GetTextExtent(_T(" "));
-		int currentwidth  = 0;
-		wxString string;
-		for( size_t i = 0; i < words.Count(); i++) {
-			if ( currentwidth + words[i].size.x + spaceSize.x > maxwidth ) {
-				dc.DrawText(string, currentx, currenty);
+	FillArrayOfWordsFromTokens(tokens, dc, NULL, words);
 
-				string.Empty();
-				currentwidth = 0;
+	const int maxwidth = size.x;
+	int currenty = 0;
 
-				currenty += words[i].size.y;
-				if (currenty + words[i].size.y> rect.y + rect.height) {
-					break;
-				}
-			} else {
-				if (!(string.IsEmpty())) { // prevent leading space in info text
-					string.append(_T(" "));	
-				}
+	wxSize spaceSize = dc.GetTextExtent(_T(" "));
+	int currentwidth  = 0;
+	wxString string;
+	for( size_t i = 0; i < words.Count(); i++) {
+		if ( currentwidth + words[i].size.x + spaceSize.x > maxwidth ) {
+			this->layout.AddLine(string, wxPoint(0, currenty));
+
+			string.Empty();
+			currentwidth = 0;
+
+			currenty += words[i].size.y;
+			if (currenty + words[i].size.y > size.y) {
+				break;
+			}
+		} else {
+			if (!(string.IsEmpty())) { // prevent leading space in info text
+				string.append(_T(" "));	
 			}
-			string.append(words[i].word);
-			currentwidth += words[i].size.x + spaceSize.x;
-		}
-		if ( !string.IsEmpty()) {
-			dc.DrawText(string, currentx, currenty);
 		}
+		string.append(words[i].word);
+		currentwidth += words[i].size.x + spaceSize.x;
 	}
+	this->layout.AddLine(string, wxPoint(0, currenty));
 }
 
 ///////////////////////////////////////////
@@ -1196,13 +1541,18 @@ ModItem::ModName::ModName(ModItem *myData) {
 }
 
 void ModItem::ModName::Draw(wxDC &dc, const wxRect &rect) {
-	wxString name;
+	const wxString& name(
+		this->myData->name.IsEmpty() ? this->myData->shortname : this->myData->name);
 
-	if ( !this->myData->name.IsEmpty() ) {
-		name = this->myData->name;
-	} else {
-		name = this->myData->shortname;
+	if ( !this->layout.IsValidFor(name, dc.GetFont(), rect.GetSize()) ) {
+		this->Layout(dc, name, rect.GetSize());
 	}
+	this->layout.Draw(dc, rect.GetPosition());
+}
+
+/** Centers the name in the title column, wrapping it if it is too wide. */
+void ModItem::ModName::Layout(wxDC &dc, const wxString& name, const wxSize& size) {
+	this->layout.Reset(name, dc.GetFont(), size);
 
 	wxCoord width, height;
 	wxFont testFont(dc.GetFont());	/* font to use to compensate for
@@ -1211,7 +1561,7 @@ void ModItem::ModName::Draw(wxDC &dc, const wxRect &rect) {
 	testFont.SetPointSize(testFont.GetPointSize() + 2);
 	dc.GetMultiLineTextExtent(name, &width, &height, NULL, &testFont);
 
-	if ( width > rect.width ) {
+	if ( width > size.x ) {
 		// too wide need to wrap if possible.
 		ArrayOfWords titleWords;
 		wxStringTokenizer tokens(name);
@@ -1220,8 +1570,8 @@ void ModItem::ModName::Draw(wxDC &dc, const wxRect &rect) {
 
 		FillArrayOfWordsFromTokens(tokens, dc, &testFont, words);
 
-		const int maxwidth = rect.width;
-		int currentx = rect.x, currenty = rect.y;
+		const int maxwidth = size.x;
+		int currenty = 0;
 
 		wxCoord spaceX, spaceY;
 		dc.GetTextExtent(_T(" "), &spaceX, &spaceY, NULL, NULL, &testFont);
@@ -1242,7 +1592,7 @@ void ModItem::ModName::Draw(wxDC &dc, const wxRect &rect) {
 				currentwidth = 0;
 
 				currenty += words[i].size.y;
-				if (currenty + words[i].size.y > rect.y + rect.height) {
+				if (currenty + words[i].size.y > size.y) {
 					break;
 				}
 			} else if ( string.size() > 0 ) {
@@ -1260,7 +1610,7 @@ void ModItem::ModName::Draw(wxDC &dc, const wxRect &rect) {
 		temp->word = string;
 		titleWords.Add(temp);
 
-		// draw the words properly centered
+		// lay the words out properly centered
 
 		// Find the hight of all of the lines of text
 		int totalHeight = 0;
@@ -1270,16 +1620,53 @@ void ModItem::ModName::Draw(wxDC &dc, const wxRect &rect) {
 
 		int currentHeightOffset = 0;
 		for( size_t i = 0; i < titleWords.Count(); i++ ) {
-			dc.DrawText(titleWords[i].word,
-				rect.x + rect.width/2 - titleWords[i].size.x/2,
-				rect.y + rect.height/2 - titleWords[i].size.y/2 + currentHeightOffset - totalHeight/2);
+			this->layout.AddLine(titleWords[i].word,
+				wxPoint(size.x/2 - titleWords[i].size.x/2,
+					size.y/2 - titleWords[i].size.y/2 + currentHeightOffset - totalHeight/2));
 			currentHeightOffset += titleWords[i].size.y;
 		}
 
 	} else {
-		dc.DrawText(name,
-			rect.x + rect.width/2 - width/2,
-			rect.y + rect.height/2 - height/2);
+		this->layout.AddLine(name, wxPoint(size.x/2 - width/2, size.y/2 - height/2));
+	}
+}
+
+///////////////////////////////////////////
+/** \class ModItem::TextLayout
+Remembers where the lines of a piece of text go, so that rows can be painted
+without measuring their text again. A layout is only valid for the text, font
+and size that it was made for.
+*/
+/** Constructor. Makes a layout that is not valid for anything. */
+ModItem::TextLayout::TextLayout(): size(wxDefaultSize) {
+}
+
+bool ModItem::TextLayout::IsValidFor(const wxString& text, const wxFont& font, const wxSize& size) const {
+	return this->size == size
+		&& this->text == text
+		&& this->fontDesc == font.GetNativeFontInfoDesc();
+}
+
+void ModItem::TextLayout::Reset(const wxString& text, const wxFont& font, const wxSize& size) {
+	this->text = text;
+	this->fontDesc = font.GetNativeFontInfoDesc();
+	this->size = size;
+	this->lines.clear();
+}
+
+void ModItem::TextLayout::AddLine(const wxString& line, const wxPoint& offset) {
+	if ( !line.IsEmpty() ) {
+		Line newLine;
+		newLine.text = line;
+		newLine.offset = offset;
+		this->lines.push_back(newLine);
+	}
+}
+
+void ModItem::TextLayout::Draw(wxDC &dc, const wxPoint& origin) const {
+	for( size_t i = 0; i < this->lines.size(); i++ ) {
+		dc.DrawText(this->lines[i].text,
+			origin.x + this->lines[i].offset.x, origin.y + this->lines[i].offset.y);
 	}
 }
 
@@ -1293,9 +1680,12 @@ ModItem::ModImage::ModImage(ModItem *myData) {
 	this->myData = myData;
 }
 
-void ModItem::ModImage::Draw(wxDC &dc, const wxRect &rect) {
-	if ( this->myData->image182x80.IsOk() ) {
-		dc.DrawBitmap(this->myData->image182x80, rect.x, rect.y);
+void ModItem::ModImage::Draw(wxDC &dc, const wxRect &rect, const wxBitmap* image182x80) {
+	if ( image182x80 == NULL ) {
+		// still being decoded, the list is redrawn when it is ready
+		dc.DrawRectangle(rect.x, rect.y, SkinSystem::ModListImageWidth, SkinSystem::ModListImageHeight);
+	} else if ( image182x80->IsOk() ) {
+		dc.DrawBitmap(*image182x80, rect.x, rect.y);
 	} else if ( this->myData->shortname != NO_MOD ) {
 		dc.DrawBitmap(SkinSystem::GetSkinSystem()->GetSmallModImage(), rect.x, rect.y);
 	} else {
@@ -1309,9 +1699,10 @@ void ModItem::ModImage::Draw(wxDC &dc, const wxRect &rect) {
 	}
 }
 
-ModInfoDialog::ModInfoDialog(ModItem* item, wxWindow* parent) {
+ModInfoDialog::ModInfoDialog(ModItem* item, const wxBitmap& image, wxWindow* parent) {
 	wxASSERT(item != NULL);
 	this->item = item;
+	this->image = image;
 
 	wxASSERT(!item->name.IsEmpty() || !item->shortname.IsEmpty());
 	wxString modName = 
@@ -1447,20 +1838,20 @@ ModInfoDialog::ImageDrawer::ImageDrawer(ModInfoDialog* parent):
 wxPanel(parent) {
 	this->parent = parent;
 
-	if (!parent->item->image255x112.IsOk()) {
+	if (!parent->image.IsOk()) {
 		this->SetSize(SkinSystem::ModInfoDialogImageWidth, SkinSystem::ModInfoDialogImageHeight);
 	} else {
 		this->SetSize(
-			parent->item->image255x112.GetWidth(),
-			parent->item->image255x112.GetHeight());
+			parent->image.GetWidth(),
+			parent->image.GetHeight());
 	}
 	this->GetEventHandler()->Connect(wxEVT_PAINT, wxPaintEventHandler(ModInfoDialog::ImageDrawer::OnDraw));
 }
 
 void ModInfoDialog::ImageDrawer::OnDraw(wxPaintEvent &WXUNUSED(event)) {
 	wxPaintDC dc(this);
-	if ( parent->item->image255x112.IsOk() ) {
-		dc.DrawBitmap(parent->item->image255x112, 0, 0);
+	if ( parent->image.IsOk() ) {
+		dc.DrawBitmap(parent->image, 0, 0);
 	} else if ( parent->item->shortname != NO_MOD ) {
 		dc.DrawBitmap(SkinSystem::GetSkinSystem()->GetModImage(), 0, 0);
 	} else {
@@ -19,21 +19,30 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #ifndef MODLIST_H
 #define MODLIST_H
 
+#include <vector>
+
 #include <wx/wx.h>
 #include <wx/vlbox.h>
-#include <wx/fileconf.h>
 #include <wx/arrstr.h>
 
 #include "apis/SkinManager.h"
 
 #include "controls/LightingPresets.h"
 
+class ModCatalog;
+class ModCatalogEntry;
+class ModImageCache;
+class ModIniFile;
+class TCFolderWatcher;
+
 class ConfigPair {
 public:
-	ConfigPair(const wxString &shortname, wxFileConfig* config);
+	ConfigPair(const wxString &shortname, ModIniFile* config,
+		const wxString& modIniPath = wxEmptyString);
 	~ConfigPair();
 	wxString shortname;
-	wxFileConfig* config;
+	ModIniFile* config;
+	wxString modIniPath; //!< empty if the config did not come from a mod.ini
 };
 WX_DECLARE_OBJARRAY(ConfigPair, ConfigArray);
 
@@ -70,8 +79,8 @@ public:
 	~ModItem();
 	wxString name;
 	wxString shortname;
-	wxBitmap image255x112;
-	wxBitmap image182x80;
+	wxString image255x112path; //!< full path, empty if not specified or not found
+	wxString image182x80path; //!< full path, empty if not specified or not found
 	wxString infotext;
 	wxString author;
 	wxString notes;
@@ -99,16 +108,41 @@ public:
 	I18nData* i18n;
 #endif
 
-	void Draw(wxDC &dc, const wxRect &rect, bool selected, wxSizer *mainSizer, wxSizer *buttons, wxStaticBitmap* warn);
+	/** image182x80 is the mod's list image, NULL if it is still being decoded. */
+	void Draw(wxDC &dc, const wxRect &rect, bool selected, wxSizer *mainSizer, wxSizer *buttons,
+		wxStaticBitmap* warn, const wxBitmap* image182x80);
 
 private:
+	/** Text that has been wrapped and measured for a particular font and size,
+	 so that drawing it again does not have to measure it again. */
+	class TextLayout{
+	public:
+		TextLayout();
+		bool IsValidFor(const wxString& text, const wxFont& font, const wxSize& size) const;
+		void Reset(const wxString& text, const wxFont& font, const wxSize& size);
+		/** offset is from the top left corner of where the text is drawn. */
+		void AddLine(const wxString& line, const wxPoint& offset);
+		void Draw(wxDC &dc, const wxPoint& origin) const;
+	private:
+		struct Line {
+			wxString text;
+			wxPoint offset;
+		};
+		wxString text;
+		wxString fontDesc;
+		wxSize size;
+		std::vector<Line> lines;
+	};
+
 	class InfoText{
 	public:
 		InfoText(ModItem *myData);
 		
 		void Draw(wxDC &dc, const wxRect &rect);
 	private:
+		void Layout(wxDC &dc, const wxString& text, const wxSize& size);
 		ModItem *myData;
+		TextLayout layout;
 	};
 	
 	InfoText *infoTextPanel;
@@ -117,7 +151,7 @@ private:
 	public:
 		ModImage(ModItem *myData);
 
-		void Draw(wxDC &dc, const wxRect &rect);
+		void Draw(wxDC &dc, const wxRect &rect, const wxBitmap* image182x80);
 	private:
 		ModItem *myData;
 	};
@@ -130,7 +164,9 @@ private:
 
 		void Draw(wxDC &dc, const wxRect &rect);
 	private:
+		void Layout(wxDC &dc, const wxString& name, const wxSize& size);
 		ModItem *myData;
+		TextLayout layout;
 	};
 
 	ModName* modNamePanel;
@@ -154,11 +190,13 @@ public:
 	void OnActivateMod(wxCommandEvent &event);
 	void OnInfoMod(wxCommandEvent &event);
 	void OnTCSkinChanged(wxCommandEvent &event);
+	void OnModInisChanged(wxCommandEvent &event);
+	void OnModImagesDecoded(wxCommandEvent &event);
 	
 	static const ModItem* GetActiveMod() { return ModList::activeMod; }
 
 private:
-	/** A hash map of the wxFileConfigs that represent the mod.ini files for
+	/** A hash map of the ModIniFiles that represent the mod.ini files for
 	each mod.  The key is the the mod's folder name which is used as the mod's
 	internal name. */
 	ConfigArray* configFiles;
@@ -167,6 +205,12 @@ private:
 	
 	Skin* TCSkin;
 	
+	wxString tcPath;
+	/** Reports mods that are added, changed or removed while the list is shown. */
+	TCFolderWatcher* watcher;
+	/** The mods' images, decoded when their rows are first drawn. */
+	ModImageCache* images;
+	
 	wxButton *infoButton, *activateButton;
 	wxStaticBitmap *warnBitmap;
 	wxBoxSizer *buttonSizer, *sizer;
@@ -175,18 +219,38 @@ private:
 	
 	/** Sets a bitmap of the ModList's TCSkin. */
 	void SetSkinBitmap(
-		const wxFileConfig& config,
+		const ModIniFile& config,
 		const wxString& modIniKey,
 		const wxString& tcPath,
 		const wxString& bitmapName,
 		bool (Skin::* setFnPtr)(const wxBitmap&));
-
-	void readIniFileString(const wxFileConfig* config,
+	wxString FindSkinFile(const ModIniFile& config, const wxString& modIniKey,
+		const wxString& tcPath, const wxString& fileName);
+	void SetSkinModImages(const ModIniFile& config, const wxString& tcPath);
+
+	wxString FindModImage(const ModIniFile* config, const wxString& modIniKey,
+		const wxString& tcPath, const wxString& searchShortname, const wxString& imageName);
+	static wxString ResolveModImage(const wxString& imagePath,
+		const wxString& tcPath, const wxString& searchShortname, const wxString& imageName);
+	static void SetRecommendedLighting(ModItem& item, bool isTC);
+
+	static ModCatalogEntry* MakeCatalogEntry(const ModItem& item,
+		const ModIniFile* config, const wxString& modIniPath);
+	static ModItem* MakeModItem(const ModCatalogEntry& entry, const wxString& tcPath);
+	ModItem* BuildModItem(const ConfigPair& pair, const wxString& tcPath, bool isTC);
+
+	bool UpdateModItem(const wxString& modIniPath, ModCatalog& catalog);
+	int FindModItem(const wxString& shortname) const;
+	void InsertModItem(ModItem* item);
+	void ActivateMod(size_t index);
+
+	void readIniFileString(const ModIniFile* config,
 		const wxString& key, wxString& location);
-	void readFlagSet(const wxFileConfig* config,
+	static wxString readIniFileValue(const ModIniFile* config, const wxString& key);
+	void readFlagSet(const ModIniFile* config,
 		const wxString& keyprefix, FlagSetItem& set);
 #ifdef MOD_TEXT_LOCALIZATION // mod text localization is not supported for now
-	void readTranslation(wxFileConfig* config,
+	void readTranslation(ModIniFile* config,
 		wxString langaugename, I18nItem ** trans);
 #endif
 	wxString escapeSpecials(const wxString& toEscape);
@@ -198,16 +262,24 @@ private:
 	/** The active mod's prepend mods and append mods. */
 	wxString prependmods, appendmods;
 	
-	/** Tests whether a mod is a prepend/append mod of the active mod. */
-	bool isAPrependMod(const wxString& mod) const;
-	bool isAnAppendMod(const wxString& mod) const;
-
-	/** Tests whether a mod appears in the specified mod list. */
-	static bool isADependency(const wxString& mod, const wxString& modlist);
-	
-	/** Tests whether a mod is a prepend/append mod of the selected mod. */
-	bool isCurrentSelectionAPrependMod(const wxString &mod) const;
-	bool isCurrentSelectionAnAppendMod(const wxString &mod) const;
+	/** How a row relates to the selected and the active mod. */
+	enum RowState {
+		ROW_SELECTED = 1,
+		ROW_SELECTION_PREPEND = 2, //!< a prepend mod of the selected mod
+		ROW_SELECTION_APPEND = 4,  //!< an append mod of the selected mod
+		ROW_ACTIVE = 8,
+		ROW_ACTIVE_PREPEND = 16,   //!< a prepend mod of the active mod
+		ROW_ACTIVE_APPEND = 32     //!< an append mod of the active mod
+	};
+	/** The RowState flags of each row, so that painting does not have to
+	 compare mod lists. Rebuilt when the selection or the active mod changes. */
+	mutable std::vector<int> rowStates;
+	mutable int rowStatesSelection; //!< the selection that rowStates was built for
+	mutable bool rowStatesValid;
+	void UpdateRowStates() const;
+
+	/** Adds the normalized names of the mods in a comma-separated mod list. */
+	static void ParseModList(const wxString& modlist, wxSortedArrayString& mods);
 
 	DECLARE_EVENT_TABLE();
 };
@@ -18,6 +18,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include <wx/wx.h>
 #include <wx/filename.h>
+#include "apis/FlagFilePrewarmer.h"
 #include "apis/SkinManager.h"
 #include "controls/StatusBar.h"
 #include "global/ids.h"
@@ -39,18 +40,25 @@ const int ICON_FIELD_WIDTH = 18;
 #else
 const int ICON_FIELD_WIDTH = 25;
 #endif
+/** Widths of the fields that show the flag file prewarm job while it runs. */
+const int PREWARM_BUTTON_FIELD_WIDTH = 60;
+const int PREWARM_TEXT_FIELD_WIDTH = 200;
 
 BEGIN_EVENT_TABLE(StatusBar, wxStatusBar)
 EVT_SIZE(StatusBar::OnSize)
 EVT_COMMAND(wxID_NONE, EVT_TC_SKIN_CHANGED, StatusBar::OnTCSkinChanged)
+EVT_COMMAND(wxID_NONE, EVT_FLAG_FILE_PREWARM_PROGRESS, StatusBar::OnFlagFilePrewarmProgress)
+EVT_BUTTON(ID_STATUSBAR_PREWARM_CANCEL_BUTTON, StatusBar::OnPrewarmCancelPressed)
 END_EVENT_TABLE()
 
 StatusBar::StatusBar(wxWindow *parent)
 		:wxStatusBar(parent) {
 	this->parent = parent;
 	this->showingToolTip = false;
+	this->showingPrewarm = false;
 	
 	SkinSystem::RegisterTCSkinChanged(this);
+	FlagFilePrewarmer::RegisterPrewarmProgress(this);
 	
 	wxCommandEvent nullEvent;
 	OnTCSkinChanged(nullEvent);
@@ -60,16 +68,14 @@ StatusBar::StatusBar(wxWindow *parent)
 #if 0 // this progress bar doesn't need to be here
 	new wxGauge(this, ID_STATUSBAR_PROGRESS_BAR, 100);
 #endif
-	// eliminate (by zeroing the width) the fields we're currently not using
-	// FIXME and when we start using those fields, add the width back!
-	int widths[] = { ICON_FIELD_WIDTH, -1, 0, 0 };
+	// the progress bar field holds the button that stops the flag file prewarm job
+	wxButton* cancelButton = new wxButton(this, ID_STATUSBAR_PREWARM_CANCEL_BUTTON,
+		_("Stop"), wxDefaultPosition, wxDefaultSize, wxBU_EXACTFIT);
+	cancelButton->SetToolTip(_("Stop caching the flag lists of the other executables in the root folder"));
+	cancelButton->Hide();
 
-	wxASSERT_MSG( sizeof(widths)/sizeof(int) == SB_FIELD_MAX,
-		wxString::Format(
-			_T("Number of fields (%d) and number of widths (%d) do not match"),
-			SB_FIELD_MAX, sizeof(widths)/sizeof(int)));
-
-	this->SetFieldsCount(SB_FIELD_MAX, widths);
+	this->SetFieldsCount(SB_FIELD_MAX);
+	this->SetFieldWidths();
 
 	this->SetStatusText(_T("Status bar created"), SB_FIELD_MAINTEXT);
 
@@ -81,9 +87,28 @@ StatusBar::~StatusBar() {
 	Logger* logger = dynamic_cast<Logger*>(wxLog::GetActiveTarget());
 	if (logger) {
 		logger->SetStatusBarTarget(NULL);
+	}	if (FlagFilePrewarmer::IsInitialized()) {
+		FlagFilePrewarmer::UnRegisterPrewarmProgress(this);
 	}
 }
 
+/** Gives the prewarm fields their width while the job runs, and eliminates
+ them (by zeroing the width) otherwise. */
+void StatusBar::SetFieldWidths() {
+	int widths[] = { ICON_FIELD_WIDTH, -1, 0, 0 };
+	if (this->showingPrewarm) {
+		widths[SB_FIELD_PROGRESS_BAR] = PREWARM_BUTTON_FIELD_WIDTH;
+		widths[SB_FIELD_PROGRESS_TEXT] = PREWARM_TEXT_FIELD_WIDTH;
+	}
+
+	wxASSERT_MSG( sizeof(widths)/sizeof(int) == SB_FIELD_MAX,
+		wxString::Format(
+			_T("Number of fields (%d) and number of widths (%d) do not match"),
+			SB_FIELD_MAX, sizeof(widths)/sizeof(int)));
+
+	this->SetStatusWidths(SB_FIELD_MAX, widths);
+}
+
 void StatusBar::OnSize(wxSizeEvent& WXUNUSED(event)) {
 	wxWindow* icon = dynamic_cast<wxWindow*>(wxWindow::FindWindowById(ID_STATUSBAR_STATUS_ICON, this));
 	wxCHECK_RET( icon != NULL, _T("Cannot find status bar icon control"));
@@ -97,6 +122,13 @@ void StatusBar::OnSize(wxSizeEvent& WXUNUSED(event)) {
 #endif
 	icon->SetSize(iconrect);
 
+	wxWindow* cancelButton = wxWindow::FindWindowById(ID_STATUSBAR_PREWARM_CANCEL_BUTTON, this);
+	wxCHECK_RET( cancelButton != NULL, _T("Cannot find status bar prewarm cancel button"));
+
+	wxRect buttonrect;
+	this->GetFieldRect(SB_FIELD_PROGRESS_BAR, buttonrect);
+	cancelButton->SetSize(buttonrect);
+
 #if 0 // this progress bar doesn't need to be here
 	wxWindow* bar = dynamic_cast<wxWindow*>(wxWindow::FindWindowById(ID_STATUSBAR_PROGRESS_BAR, this));
 	wxCHECK_RET( bar != NULL, _T("Cannot find status bar progress bar"));
@@ -139,6 +171,40 @@ void StatusBar::SetMainStatusText(wxString msg, int icon) {
 	}
 }
 
+/** Shows how far the flag file prewarm job has got, with a button to stop it,
+ while the job runs. */
+void StatusBar::OnFlagFilePrewarmProgress(wxCommandEvent &event) {
+	// the event may be stale, so the current status decides whether to show it
+	const bool running = FlagFilePrewarmer::IsInitialized()
+		&& FlagFilePrewarmer::GetFlagFilePrewarmer()->IsRunning();
+
+	if (running) {
+		this->SetStatusText(wxString::Format(_("Caching flag lists: %lu of %lu"),
+			static_cast<unsigned long>(event.GetInt()),
+			static_cast<unsigned long>(event.GetExtraLong())),
+			SB_FIELD_PROGRESS_TEXT);
+	} else {
+		this->SetStatusText(wxEmptyString, SB_FIELD_PROGRESS_TEXT);
+	}
+
+	if (running != this->showingPrewarm) {
+		this->showingPrewarm = running;
+		this->SetFieldWidths();
+		wxWindow* cancelButton = wxWindow::FindWindowById(ID_STATUSBAR_PREWARM_CANCEL_BUTTON, this);
+		wxCHECK_RET( cancelButton != NULL, _T("Cannot find status bar prewarm cancel button"));
+		cancelButton->Show(running);
+		wxSizeEvent sizeEvent;
+		this->OnSize(sizeEvent);
+	}
+}
+
+void StatusBar::OnPrewarmCancelPressed(wxCommandEvent &WXUNUSED(event)) {
+	wxCHECK_RET(FlagFilePrewarmer::IsInitialized(),
+		_T("Prewarm cancel pressed, but the flag file prewarmer is not initialized."));
+	wxLogInfo(_T("Flag file prewarm cancelled by the user."));
+	FlagFilePrewarmer::GetFlagFilePrewarmer()->Cancel();
+}
+
 /** Causes the status bar to show the msg until EndToolTipStatusText() is
 called.  When EndToolTipStatusText() is called the status text will be returned
 to the original text. */
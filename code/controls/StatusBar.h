@@ -32,6 +32,8 @@ public:
 
 	void OnSize(wxSizeEvent& event);
 	void OnTCSkinChanged(wxCommandEvent& event);
+	void OnFlagFilePrewarmProgress(wxCommandEvent& event);
+	void OnPrewarmCancelPressed(wxCommandEvent& event);
 
 	void SetMainStatusText(wxString msg, int icon=ID_SB_NO_CHANGE);
 	void SetJobStatusText(int value, wxString msg=_T(""));
@@ -42,6 +44,9 @@ private:
 	wxWindow* parent;
 	wxBitmap icons[ID_SB_MAX_ID];
 	bool showingToolTip;
+	bool showingPrewarm; //!< whether the prewarm fields have their width
+
+	void SetFieldWidths();
 	
 	DECLARE_EVENT_TABLE();
 };
@@ -0,0 +1,109 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef FLAGBITSET_H
+#define FLAGBITSET_H
+
+#include <vector>
+
+#include <wx/defs.h>
+
+/** A fixed number of bits packed into 32-bit words, one for each row of
+ the flag list. Operations on whole sets work a word at a time, in loops
+ simple enough for the compiler to vectorise. */
+class FlagBitset {
+public:
+	FlagBitset(): size(0) { }
+	explicit FlagBitset(size_t size): size(size), words((size + WORD_BITS - 1) / WORD_BITS, 0) { }
+
+	inline size_t GetSize() const { return this->size; }
+
+	inline bool Test(size_t i) const {
+		wxASSERT(i < this->size);
+		return (this->words[i / WORD_BITS] & Mask(i)) != 0;
+	}
+	inline void Set(size_t i, bool value = true) {
+		wxASSERT(i < this->size);
+		if (value) {
+			this->words[i / WORD_BITS] |= Mask(i);
+		} else {
+			this->words[i / WORD_BITS] &= ~Mask(i);
+		}
+	}
+
+	/** Clears the bits that are in disable, then sets the bits that are in enable. */
+	void Apply(const FlagBitset& disable, const FlagBitset& enable) {
+		wxASSERT(disable.size == this->size && enable.size == this->size);
+		for (size_t w = 0; w < this->words.size(); w++) {
+			this->words[w] = (this->words[w] & ~disable.words[w]) | enable.words[w];
+		}
+	}
+
+	/** Clears the bits that are not in other. */
+	void Intersect(const FlagBitset& other) {
+		wxASSERT(other.size == this->size);
+		for (size_t w = 0; w < this->words.size(); w++) {
+			this->words[w] &= other.words[w];
+		}
+	}
+
+	/** Returns true if no bit is set. */
+	bool IsEmpty() const {
+		for (size_t w = 0; w < this->words.size(); w++) {
+			if (this->words[w] != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Returns the bits that differ between this and other. */
+	FlagBitset Difference(const FlagBitset& other) const {
+		wxASSERT(other.size == this->size);
+		FlagBitset changed(this->size);
+		for (size_t w = 0; w < this->words.size(); w++) {
+			changed.words[w] = this->words[w] ^ other.words[w];
+		}
+		return changed;
+	}
+
+	/** Returns the first set bit at or after i, or GetSize() if there is none,
+	 skipping a whole word at a time where no bit is set. */
+	size_t FindNext(size_t i) const {
+		while (i < this->size) {
+			const wxUint32 word = this->words[i / WORD_BITS] >> (i % WORD_BITS);
+			if (word == 0) {
+				i = (i / WORD_BITS + 1) * WORD_BITS;
+			} else if (word & 1) {
+				return i;
+			} else {
+				i++;
+			}
+		}
+		return this->size;
+	}
+
+private:
+	enum { WORD_BITS = 32 };
+	static inline wxUint32 Mask(size_t i) { return static_cast<wxUint32>(1) << (i % WORD_BITS); }
+
+	size_t size;
+	std::vector<wxUint32> words;
+};
+
+#endif
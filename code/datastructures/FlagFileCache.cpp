@@ -0,0 +1,224 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "generated/configure_launcher.h"
+#include "datastructures/FlagFileCache.h"
+#include "global/ProfileKeys.h"
+#include "global/Utils.h"
+
+#include <wx/ffile.h>
+#include <wx/fileconf.h>
+#include <wx/sstream.h>
+#include <wx/wfstream.h>
+
+#include "global/MemoryDebugging.h"
+
+#define FLAG_CACHE_FOLDER_NAME	_T("flagcache")
+#define FLAG_CACHE_VERSION		1L
+
+#define FLAG_CACHE_KEY_VERSION	_T("/cache/version")
+#define FLAG_CACHE_KEY_PATH		_T("/executable/path")
+#define FLAG_CACHE_KEY_SIZE		_T("/executable/size")
+#define FLAG_CACHE_KEY_MTIME	_T("/executable/mtime")
+#define FLAG_CACHE_KEY_HASH		_T("/executable/hash")
+
+namespace {
+	/** The name (without extension) of the cache entry for an executable. */
+	wxString GetEntryName(const wxFileName& exeFilename) {
+		const wxCharBuffer path(exeFilename.GetFullPath().utf8_str());
+		return HashUtils::HashBuffer(path.data(), strlen(path.data()));
+	}
+
+	wxFileName GetEntryIniFile(const wxFileName& exeFilename) {
+		return wxFileName(FlagFileCache::GetCacheFolder().GetPath(),
+			GetEntryName(exeFilename), _T("ini"));
+	}
+
+	wxFileName GetEntryFlagFile(const wxFileName& exeFilename) {
+		return wxFileName(FlagFileCache::GetCacheFolder().GetPath(),
+			GetEntryName(exeFilename), _T("lch"));
+	}
+}
+
+ExecutableFingerprint::ExecutableFingerprint() {
+}
+
+bool ExecutableFingerprint::ReadFromFile(const wxFileName& exeFilename, bool computeHash) {
+	if (!exeFilename.FileExists()) {
+		return false;
+	}
+
+	this->path = exeFilename.GetFullPath();
+	this->size = exeFilename.GetSize().ToString();
+
+	wxDateTime modTime(exeFilename.GetModificationTime());
+	if (!modTime.IsValid()) {
+		return false;
+	}
+	this->mtime = modTime.GetValue().ToString();
+
+	if (computeHash) {
+		this->contentHash = HashUtils::HashFileContents(this->path);
+		if (this->contentHash.IsEmpty()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool ExecutableFingerprint::StatMatches(const ExecutableFingerprint& other) const {
+	return this->path == other.path
+		&& this->size == other.size
+		&& this->mtime == other.mtime;
+}
+
+bool ExecutableFingerprint::operator==(const ExecutableFingerprint& other) const {
+	return this->StatMatches(other)
+		&& !this->contentHash.IsEmpty()
+		&& this->contentHash == other.contentHash;
+}
+
+wxFileName FlagFileCache::GetCacheFolder() {
+	wxFileName folder;
+	folder.AssignDir(GetProfileStorageFolder());
+	folder.AppendDir(FLAG_CACHE_FOLDER_NAME);
+	return folder;
+}
+
+/** Reads the fingerprint stored in the cache entry for exeFilename.
+ Returns false and removes the entry if it is missing or unusable. */
+static bool ReadEntry(const wxFileName& exeFilename, ExecutableFingerprint& cached) {
+	wxFileName iniFile(GetEntryIniFile(exeFilename));
+	wxFileName flagFile(GetEntryFlagFile(exeFilename));
+
+	if (!iniFile.FileExists() || !flagFile.FileExists()) {
+		wxLogDebug(_T(" No cached flag file for %s"), exeFilename.GetFullPath().c_str());
+		return false;
+	}
+
+	wxFFileInputStream iniInput(iniFile.GetFullPath());
+	wxFileConfig entry(iniInput);
+
+	long version;
+	entry.Read(FLAG_CACHE_KEY_VERSION, &version, 0L);
+	entry.Read(FLAG_CACHE_KEY_PATH, &cached.path);
+	entry.Read(FLAG_CACHE_KEY_SIZE, &cached.size);
+	entry.Read(FLAG_CACHE_KEY_MTIME, &cached.mtime);
+	entry.Read(FLAG_CACHE_KEY_HASH, &cached.contentHash);
+
+	if (version != FLAG_CACHE_VERSION) {
+		wxLogDebug(_T(" Cached flag file for %s has unsupported version %ld"),
+			exeFilename.GetFullPath().c_str(), version);
+		FlagFileCache::Invalidate(exeFilename);
+		return false;
+	}
+	return true;
+}
+
+bool FlagFileCache::HasEntry(const wxFileName& exeFilename) {
+	ExecutableFingerprint cached, current;
+	return ReadEntry(exeFilename, cached)
+		&& current.ReadFromFile(exeFilename, false)
+		&& current.StatMatches(cached);
+}
+
+bool FlagFileCache::Lookup(const wxFileName& exeFilename, wxFileName& cachedFlagFile) {
+	ExecutableFingerprint cached;
+	if (!ReadEntry(exeFilename, cached)) {
+		return false;
+	}
+
+	// compare cheap attributes first so that the executable is only hashed
+	// when it could still be the same file
+	ExecutableFingerprint current;
+	if (!current.ReadFromFile(exeFilename, false) || !current.StatMatches(cached)) {
+		wxLogDebug(_T(" Cached flag file for %s is stale"), exeFilename.GetFullPath().c_str());
+		Invalidate(exeFilename);
+		return false;
+	}
+
+	current.contentHash = HashUtils::HashFileContents(current.path);
+	if (!(current == cached)) {
+		wxLogDebug(_T(" Contents of %s have changed since its flag file was cached"),
+			exeFilename.GetFullPath().c_str());
+		Invalidate(exeFilename);
+		return false;
+	}
+
+	wxFileName flagFile(GetEntryFlagFile(exeFilename));
+	wxLogDebug(_T(" Using cached flag file %s for %s"),
+		flagFile.GetFullPath().c_str(), exeFilename.GetFullPath().c_str());
+	cachedFlagFile = flagFile;
+	return true;
+}
+
+bool FlagFileCache::Store(const wxFileName& exeFilename, const wxFileName& flagFile) {
+	wxFileName folder(GetCacheFolder());
+	if (!folder.DirExists() && !folder.Mkdir()) {
+		wxLogWarning(_T("Unable to create flag file cache folder at %s"),
+			folder.GetFullPath().c_str());
+		return false;
+	}
+
+	ExecutableFingerprint fingerprint;
+	if (!fingerprint.ReadFromFile(exeFilename)) {
+		wxLogDebug(_T(" Unable to fingerprint %s, not caching its flag file"),
+			exeFilename.GetFullPath().c_str());
+		return false;
+	}
+
+	wxFileName cachedFlagFile(GetEntryFlagFile(exeFilename));
+	if (!::wxCopyFile(flagFile.GetFullPath(), cachedFlagFile.GetFullPath(), true)) {
+		wxLogDebug(_T(" Unable to copy flag file to %s"), cachedFlagFile.GetFullPath().c_str());
+		Invalidate(exeFilename);
+		return false;
+	}
+
+	wxStringInputStream emptyInput(wxEmptyString);
+	wxFileConfig entry(emptyInput);
+	entry.Write(FLAG_CACHE_KEY_VERSION, FLAG_CACHE_VERSION);
+	entry.Write(FLAG_CACHE_KEY_PATH, fingerprint.path);
+	entry.Write(FLAG_CACHE_KEY_SIZE, fingerprint.size);
+	entry.Write(FLAG_CACHE_KEY_MTIME, fingerprint.mtime);
+	entry.Write(FLAG_CACHE_KEY_HASH, fingerprint.contentHash);
+
+	wxFileName iniFile(GetEntryIniFile(exeFilename));
+	wxFFileOutputStream iniOutput(iniFile.GetFullPath());
+	if (!iniOutput.IsOk() || !entry.Save(iniOutput)) {
+		wxLogDebug(_T(" Unable to write flag file cache entry %s"), iniFile.GetFullPath().c_str());
+		iniOutput.Close();
+		Invalidate(exeFilename);
+		return false;
+	}
+
+	wxLogDebug(_T(" Cached flag file for %s as %s"),
+		exeFilename.GetFullPath().c_str(), cachedFlagFile.GetFullPath().c_str());
+	return true;
+}
+
+void FlagFileCache::Invalidate(const wxFileName& exeFilename) {
+	wxFileName iniFile(GetEntryIniFile(exeFilename));
+	wxFileName flagFile(GetEntryFlagFile(exeFilename));
+
+	if (iniFile.FileExists()) {
+		::wxRemoveFile(iniFile.GetFullPath());
+	}
+	if (flagFile.FileExists()) {
+		::wxRemoveFile(flagFile.GetFullPath());
+	}
+}
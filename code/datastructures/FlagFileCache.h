@@ -0,0 +1,69 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef FLAGFILECACHE_H
+#define FLAGFILECACHE_H
+
+#include <wx/wx.h>
+#include <wx/filename.h>
+
+/** Identifies a particular build of an FS2 Open executable on disk. */
+class ExecutableFingerprint {
+public:
+	ExecutableFingerprint();
+
+	/** Fills in the fingerprint from the file on disk.
+	 The content hash is only computed when computeHash is true. */
+	bool ReadFromFile(const wxFileName& exeFilename, bool computeHash = true);
+
+	/** Returns true when path, size and modification time match. */
+	bool StatMatches(const ExecutableFingerprint& other) const;
+	bool operator==(const ExecutableFingerprint& other) const;
+
+	wxString path;
+	wxString size; //!< size in bytes, as a string
+	wxString mtime; //!< milliseconds since the epoch, as a string
+	wxString contentHash; //!< hex string, empty if not computed
+};
+
+/** Stores flag files generated by FS2 Open executables so that the executable
+ does not have to be run with -get_flags again until it changes.
+ Each entry consists of a copy of the flag file and a small ini describing the
+ fingerprint of the executable that generated it. */
+namespace FlagFileCache {
+	/** Returns true and sets cachedFlagFile if a flag file for the given
+	 executable is in the cache and the executable has not changed since.
+	 Stale entries are removed. */
+	bool Lookup(const wxFileName& exeFilename, wxFileName& cachedFlagFile);
+
+	/** Returns true if there is an entry for exeFilename whose path, size and
+	 modification time still match. Does not hash the executable, so it is cheap
+	 enough to call for every executable in a folder. */
+	bool HasEntry(const wxFileName& exeFilename);
+
+	/** Copies flagFile into the cache as the flag file for exeFilename. */
+	bool Store(const wxFileName& exeFilename, const wxFileName& flagFile);
+
+	/** Removes any cached flag file for exeFilename. */
+	void Invalidate(const wxFileName& exeFilename);
+
+	/** Returns the folder in which the cache entries are stored. */
+	wxFileName GetCacheFolder();
+}
+
+#endif
@@ -0,0 +1,225 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "generated/configure_launcher.h"
+#include "datastructures/FlagFileView.h"
+#include "global/Utils.h"
+
+#include <cstring>
+
+#include <wx/file.h>
+
+#include "global/MemoryDebugging.h"
+
+/** The size of an "easy setup" name. */
+const wxInt32 EASY_FLAG_SIZE = 32;
+/** The size of each integer in the header. */
+const size_t FLAG_FILE_INT_SIZE = 4;
+
+/** The flag records that are known. The fields that the launcher does not
+ use, like fso_only, are left out. */
+const FlagFileView::RecordLayout FlagFileView::LAYOUTS[] = {
+	// char name[20], desc[40]; int fso_only, on_flags, off_flags; char type[16], web_url[256]
+	{ 344, 0, 20, 20, 40, 64, 68, 72, 16, 88, 256 },
+};
+
+FlagFileView::FlagFileView()
+: easyFlagSize(0), flagSize(0), easyFlagCount(0), easyFlagsOffset(0),
+  flagCount(0), flagsOffset(0), hasBuildCaps(false) {
+	memset(&this->layout, 0, sizeof(this->layout));
+}
+
+/** Finds the layout of records of recordSize. A size that is not in LAYOUTS is
+ taken to be the first layout with web_url, the last field, resized to fill the
+ record, as long as that leaves web_url at least a byte. */
+bool FlagFileView::FindLayout(wxInt32 recordSize, RecordLayout& layout) {
+	for (size_t i = 0; i < WXSIZEOF(LAYOUTS); i++) {
+		if (LAYOUTS[i].recordSize == recordSize) {
+			layout = LAYOUTS[i];
+			return true;
+		}
+	}
+	const RecordLayout& known = LAYOUTS[0];
+	if (recordSize <= 0 || static_cast<size_t>(recordSize) <= known.webURL) {
+		return false;
+	}
+	layout = known;
+	layout.recordSize = recordSize;
+	layout.webURLSize = static_cast<size_t>(recordSize) - known.webURL;
+	wxLogDebug(_T(" Exe flag structure size %d is not known, reading it as %d with ")
+		SZT _T(" bytes for web_url"), recordSize, known.recordSize, layout.webURLSize);
+	return true;
+}
+
+FlagFileView::Result FlagFileView::Load(const wxString& filePath) {
+	wxFile file;
+	if (!file.Open(filePath)) {
+		wxLogError(_T(" Unable to open flag file %s"), filePath.c_str());
+		return VIEW_CANNOT_READ;
+	}
+	const wxFileOffset length = file.Length();
+	if (length == wxInvalidOffset) {
+		wxLogError(_T(" Unable to get the size of flag file %s"), filePath.c_str());
+		return VIEW_CANNOT_READ;
+	}
+
+	// read straight into the view, so that the contents are never copied
+	*this = FlagFileView();
+	this->contents.resize(static_cast<size_t>(length));
+	if (!this->contents.empty()) {
+		const size_t bytesRead = file.Read(&this->contents[0], this->contents.size());
+		if ((size_t)wxInvalidOffset == bytesRead || bytesRead != this->contents.size()) {
+			wxLogError(_T(" Unable to read flag file %s"), filePath.c_str());
+			this->contents.clear();
+			return VIEW_CANNOT_READ;
+		}
+	}
+	return this->ParseContents();
+}
+
+FlagFileView::Result FlagFileView::Parse(std::vector<char>& contents) {
+	*this = FlagFileView();
+	this->contents.swap(contents);
+	return this->ParseContents();
+}
+
+FlagFileView::Result FlagFileView::ParseContents() {
+	wxInt32 numEasyFlags, numFlags;
+	size_t offset = 0;
+	if (!this->ReadInt32(offset, this->easyFlagSize)) {
+		wxLogError(_T(" Flag file is too short (failed to read easy_flag_size)"));
+		return VIEW_TOO_SHORT;
+	}
+	if (this->easyFlagSize != EASY_FLAG_SIZE) {
+		wxLogError(_T("  Easy flag size (%d) is not supported"), this->easyFlagSize);
+		return VIEW_NOT_SUPPORTED;
+	}
+	offset += FLAG_FILE_INT_SIZE;
+
+	if (!this->ReadInt32(offset, this->flagSize)) {
+		wxLogError(_T(" Flag file is too short (failed to read flag_size)"));
+		return VIEW_TOO_SHORT;
+	}
+	RecordLayout layout;
+	if (!FindLayout(this->flagSize, layout)) {
+		wxLogError(_T(" Exe flag structure (%d) size is not supported"), this->flagSize);
+		return VIEW_NOT_SUPPORTED;
+	}
+	offset += FLAG_FILE_INT_SIZE;
+
+	if (!this->ReadInt32(offset, numEasyFlags)) {
+		wxLogError(_T(" Flag file is too short (failed to read num_easy_flags)"));
+		return VIEW_TOO_SHORT;
+	}
+	if (numEasyFlags < 0) {
+		wxLogError(_T(" Flag file has an invalid count of easy flags (%d)"), numEasyFlags);
+		return VIEW_INVALID_COUNT;
+	}
+	offset += FLAG_FILE_INT_SIZE;
+
+	// sizes are checked against what is left, so that a corrupt count cannot overflow
+	const size_t easyFlagsOffset = offset;
+	if (static_cast<size_t>(numEasyFlags) > (this->contents.size() - offset) / EASY_FLAG_SIZE) {
+		wxLogError(_T(" Flag file is too short for %d easy flags"), numEasyFlags);
+		return VIEW_TOO_SHORT;
+	}
+	offset += static_cast<size_t>(numEasyFlags) * EASY_FLAG_SIZE;
+
+	if (!this->ReadInt32(offset, numFlags)) {
+		wxLogError(_T(" Flag file is too short (failed to read num_flags)"));
+		return VIEW_TOO_SHORT;
+	}
+	if (numFlags < 0) {
+		wxLogError(_T(" Flag file has an invalid count of flags (%d)"), numFlags);
+		return VIEW_INVALID_COUNT;
+	}
+	offset += FLAG_FILE_INT_SIZE;
+
+	const size_t flagsOffset = offset;
+	const size_t recordSize = static_cast<size_t>(layout.recordSize);
+	if (static_cast<size_t>(numFlags) > (this->contents.size() - offset) / recordSize) {
+		wxLogError(_T(" Flag file is too short for %d flags"), numFlags);
+		return VIEW_TOO_SHORT;
+	}
+	offset += static_cast<size_t>(numFlags) * recordSize;
+
+	this->layout = layout;
+	this->easyFlagCount = static_cast<size_t>(numEasyFlags);
+	this->easyFlagsOffset = easyFlagsOffset;
+	this->flagCount = static_cast<size_t>(numFlags);
+	this->flagsOffset = flagsOffset;
+	this->hasBuildCaps = offset < this->contents.size();
+	wxLogDebug(_T(" easy_flag_size: %d; flag_size: %d; num_easy_flags: %d; num_flags: %d; build caps: %s"),
+		this->easyFlagSize, this->flagSize, numEasyFlags, numFlags,
+		this->hasBuildCaps ? _T("yes") : _T("no"));
+	return VIEW_OK;
+}
+
+wxString FlagFileView::GetEasyFlag(size_t i) const {
+	wxCHECK_MSG(i < this->easyFlagCount, wxEmptyString, _T("easy flag index out of range"));
+	return this->ReadString(this->easyFlagsOffset + i * EASY_FLAG_SIZE, EASY_FLAG_SIZE);
+}
+
+Flag* FlagFileView::CreateFlag(size_t i) const {
+	wxCHECK_MSG(i < this->flagCount && this->layout.recordSize > 0, NULL, _T("flag index out of range"));
+	const RecordLayout& layout = this->layout;
+	const size_t record = this->flagsOffset + i * layout.recordSize;
+
+	wxInt32 easyOnFlags = 0, easyOffFlags = 0;
+	this->ReadInt32(record + layout.easyOnFlags, easyOnFlags);
+	this->ReadInt32(record + layout.easyOffFlags, easyOffFlags);
+
+	Flag* flag = new Flag();
+	flag->flagString = this->ReadString(record + layout.flagString, layout.flagStringSize);
+	flag->shortDescription = this->ReadString(record + layout.description, layout.descriptionSize);
+	flag->webURL = this->ReadString(record + layout.webURL, layout.webURLSize);
+	flag->fsoCatagory = this->ReadString(record + layout.category, layout.categorySize);
+	flag->isRecomendedFlag = false; // much better from a UI point of view than "true"
+	flag->easyEnable = static_cast<wxUint32>(easyOnFlags);
+	flag->easyDisable = static_cast<wxUint32>(easyOffFlags);
+	return flag;
+}
+
+wxByte FlagFileView::GetBuildCaps() const {
+	if (!this->hasBuildCaps) {
+		return 0;
+	}
+	return static_cast<wxByte>(this->contents[this->flagsOffset + this->flagCount * this->layout.recordSize]);
+}
+
+/** Reads the little-endian 32-bit integer at offset. Returns false if it is past the end. */
+bool FlagFileView::ReadInt32(size_t offset, wxInt32& value) const {
+	if (offset > this->contents.size() || this->contents.size() - offset < FLAG_FILE_INT_SIZE) {
+		return false;
+	}
+	wxUint32 raw;
+	memcpy(&raw, &this->contents[offset], FLAG_FILE_INT_SIZE);
+	value = static_cast<wxInt32>(wxUINT32_SWAP_ON_BE(raw));
+	return true;
+}
+
+/** Reads the string in the field of size bytes at offset. The string ends at the
+ first NUL, or at the last byte of the field, as FS2 Open does not always end it. */
+wxString FlagFileView::ReadString(size_t offset, size_t size) const {
+	wxCHECK_MSG(size > 0 && offset <= this->contents.size() && this->contents.size() - offset >= size,
+		wxEmptyString, _T("flag file field out of range"));
+	const char* field = &this->contents[offset];
+	const void* end = memchr(field, '\0', size - 1);
+	const size_t length = (end != NULL) ? static_cast<const char*>(end) - field : size - 1;
+	return wxString(field, wxConvUTF8, length);
+}
@@ -0,0 +1,101 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef FLAGFILEVIEW_H
+#define FLAGFILEVIEW_H
+
+#include <vector>
+
+#include <wx/wx.h>
+
+#include "datastructures/FlagFileData.h"
+
+/** A bounds-checked view of a flag file (flags.lch), as written by an FS2 Open
+ executable run with -get_flags. The whole file is read at once, and the fixed
+ size records in it are only looked at through the view, which checks that
+ every record lies within the file before anything is read from it.
+
+ The file is a header of little-endian 32-bit integers, the "easy setup" names,
+ the flag records and an optional byte of build capabilities:
+ easy_flag_size, flag_size, num_easy_flags, easy flags, num_flags, flags, caps.
+ The layout of a flag record is looked up by flag_size, so a build that writes
+ a different record only needs a new entry in the table of known layouts. A
+ record of any other size is read as the known one with a longer or shorter
+ web_url, which is its last field. */
+class FlagFileView {
+public:
+	enum Result {
+		VIEW_OK = 0,
+		VIEW_CANNOT_READ,
+		VIEW_TOO_SHORT,
+		VIEW_INVALID_COUNT,
+		VIEW_NOT_SUPPORTED
+	};
+
+	FlagFileView();
+
+	/** Reads the flag file at filePath and checks its header and size. */
+	Result Load(const wxString& filePath);
+	/** Checks the header and size of a flag file that has already been read.
+	 Takes the contents over, leaving contents empty. */
+	Result Parse(std::vector<char>& contents);
+
+	size_t GetEasyFlagCount() const { return this->easyFlagCount; }
+	wxString GetEasyFlag(size_t i) const;
+
+	size_t GetFlagCount() const { return this->flagCount; }
+	/** Creates the Flag for the record at i. The caller owns the Flag. */
+	Flag* CreateFlag(size_t i) const;
+
+	/** Older builds do not write their capabilities, which means they have none. */
+	bool HasBuildCaps() const { return this->hasBuildCaps; }
+	wxByte GetBuildCaps() const;
+
+	wxInt32 GetEasyFlagSize() const { return this->easyFlagSize; }
+	wxInt32 GetFlagSize() const { return this->flagSize; }
+
+private:
+	/** Offsets and sizes of the fields of a flag record. */
+	struct RecordLayout {
+		wxInt32 recordSize;
+		size_t flagString, flagStringSize;
+		size_t description, descriptionSize;
+		size_t easyOnFlags;
+		size_t easyOffFlags;
+		size_t category, categorySize;
+		size_t webURL, webURLSize;
+	};
+	static const RecordLayout LAYOUTS[];
+	static bool FindLayout(wxInt32 recordSize, RecordLayout& layout);
+	Result ParseContents();
+
+	bool ReadInt32(size_t offset, wxInt32& value) const;
+	wxString ReadString(size_t offset, size_t size) const;
+
+	std::vector<char> contents;
+	RecordLayout layout; //!< recordSize is 0 until a file has been parsed
+	wxInt32 easyFlagSize;
+	wxInt32 flagSize;
+	size_t easyFlagCount;
+	size_t easyFlagsOffset;
+	size_t flagCount;
+	size_t flagsOffset;
+	bool hasBuildCaps;
+};
+
+#endif
@@ -0,0 +1,112 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "generated/configure_launcher.h"
+#include "datastructures/FlagSearchIndex.h"
+#include "global/Utils.h"
+
+#include <wx/tokenzr.h>
+
+#include "global/MemoryDebugging.h"
+
+const size_t TRIGRAM_LENGTH = 3;
+
+static inline bool IsSpace(wxChar c) {
+	return c == _T(' ') || c == _T('\t') || c == _T('\r') || c == _T('\n');
+}
+
+FlagSearchIndex::FlagSearchIndex() {
+}
+
+void FlagSearchIndex::Build(const wxArrayString& texts) {
+	const size_t rowCount = texts.GetCount();
+	this->texts.Clear();
+	this->texts.Alloc(rowCount);
+	this->searchable = FlagBitset(rowCount);
+	this->trigrams.clear();
+
+	for (size_t row = 0; row < rowCount; row++) {
+		const wxString text(texts[row].Lower());
+		this->texts.Add(text);
+		if (text.IsEmpty()) {
+			continue;
+		}
+		this->searchable.Set(row);
+
+		for (size_t i = 0; i + TRIGRAM_LENGTH <= text.length(); i++) {
+			// the words of a query have no spaces in them, so neither do their trigrams
+			if (IsSpace(text[i]) || IsSpace(text[i + 1]) || IsSpace(text[i + 2])) {
+				continue;
+			}
+			FlagBitset& rows = this->trigrams[text.Mid(i, TRIGRAM_LENGTH)];
+			if (rows.GetSize() == 0) {
+				rows = FlagBitset(rowCount);
+			}
+			rows.Set(row);
+		}
+	}
+
+	wxLogDebug(_T("FlagSearchIndex: ") SZT _T(" trigrams in ") SZT _T(" rows"),
+		this->trigrams.size(), rowCount);
+}
+
+FlagBitset FlagSearchIndex::Find(const wxString& query) const {
+	FlagBitset matches(this->searchable);
+
+	wxArrayString words;
+	wxStringTokenizer tokens(query.Lower(), _T(" \t\r\n"), wxTOKEN_STRTOK);
+	while (tokens.HasMoreTokens()) {
+		words.Add(tokens.GetNextToken());
+	}
+
+	for (size_t i = 0; i < words.GetCount() && !matches.IsEmpty(); i++) {
+		matches.Intersect(this->FindCandidates(words[i]));
+	}
+
+	// a row can have all of a word's trigrams without having the word itself
+	for (size_t row = matches.FindNext(0); row < matches.GetSize();
+		 row = matches.FindNext(row + 1)) {
+		for (size_t i = 0; i < words.GetCount(); i++) {
+			if (this->texts[row].Find(words[i]) == wxNOT_FOUND) {
+				matches.Set(row, false);
+				break;
+			}
+		}
+	}
+	return matches;
+}
+
+FlagBitset FlagSearchIndex::FindCandidates(const wxString& word) const {
+	wxASSERT(!word.IsEmpty());
+	FlagBitset candidates(this->searchable);
+	if (word.length() < TRIGRAM_LENGTH) {
+		return candidates; // too short to have a trigram, so every row is checked
+	}
+
+	for (size_t i = 0; i + TRIGRAM_LENGTH <= word.length(); i++) {
+		FlagTrigramMap::const_iterator rows = this->trigrams.find(word.Mid(i, TRIGRAM_LENGTH));
+		if (rows == this->trigrams.end()) {
+			return FlagBitset(this->searchable.GetSize());
+		}
+		candidates.Intersect(rows->second);
+		if (candidates.IsEmpty()) {
+			break;
+		}
+	}
+	return candidates;
+}
@@ -0,0 +1,58 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef FLAGSEARCHINDEX_H
+#define FLAGSEARCHINDEX_H
+
+#include <wx/wx.h>
+#include <wx/hashmap.h>
+
+#include "datastructures/FlagBitset.h"
+
+WX_DECLARE_STRING_HASH_MAP(FlagBitset, FlagTrigramMap);
+
+/** Finds the rows of the flag list whose text contains every word of a query.
+ Each row's text is split into overlapping three letter pieces (trigrams), and
+ for each trigram the index keeps the rows it appears in, so a query only has
+ to AND together the rows of its words' trigrams and then check the few rows
+ that are left, instead of searching the text of every row. Matching ignores
+ case. */
+class FlagSearchIndex {
+public:
+	FlagSearchIndex();
+
+	/** Replaces the index with one of texts, which has one entry for each row.
+	 Rows whose text is empty never match. */
+	void Build(const wxArrayString& texts);
+
+	/** Returns the rows that contain every whitespace separated word of query.
+	 An empty query matches every row that has text. */
+	FlagBitset Find(const wxString& query) const;
+
+	size_t GetRowCount() const { return this->texts.GetCount(); }
+
+private:
+	/** The rows that contain word, which must be lowercase and not empty. */
+	FlagBitset FindCandidates(const wxString& word) const;
+
+	wxArrayString texts; //!< lowercase, one per row
+	FlagBitset searchable; //!< the rows that have text
+	FlagTrigramMap trigrams; //!< trigram to the rows that contain it
+};
+
+#endif
@@ -0,0 +1,305 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "generated/configure_launcher.h"
+#include "datastructures/ModCatalog.h"
+#include "global/ModDefaults.h"
+#include "global/ProfileKeys.h"
+#include "global/Utils.h"
+
+#include <wx/datstrm.h>
+#include <wx/wfstream.h>
+
+#include "global/MemoryDebugging.h"
+
+#define MOD_CATALOG_FILE_NAME	_T("modcatalog.dat")
+#define MOD_CATALOG_MAGIC		_T("wxLauncher mod catalog")
+/** Increment whenever the layout of an entry changes. */
+const wxUint32 MOD_CATALOG_VERSION = 2;
+/** Sanity limits so that a corrupt catalog cannot cause huge allocations. */
+const wxUint32 MAX_CATALOG_ENTRIES = 100000;
+const wxUint32 MAX_CATALOG_FLAGSETS = 1000;
+
+ModCatalogEntry::ModCatalogEntry()
+: warn(false),
+minhorizontalres(DEFAULT_MOD_RESOLUTION_MIN_HORIZONTAL_RES),
+minverticalres(DEFAULT_MOD_RESOLUTION_MIN_VERTICAL_RES),
+hasFlagSets(false), seen(false) {
+}
+
+bool ModCatalogEntry::ReadModIniStat(const wxString& modIniPath) {
+	wxFileName modIni(modIniPath);
+	if (!modIni.FileExists()) {
+		return false;
+	}
+	wxDateTime modTime(modIni.GetModificationTime());
+	if (!modTime.IsValid()) {
+		return false;
+	}
+
+	this->modIniPath = modIniPath;
+	this->modIniSize = modIni.GetSize().ToString();
+	this->modIniMtime = modTime.GetValue().ToString();
+	return true;
+}
+
+bool ModCatalogEntry::IsUpToDate() const {
+	ModCatalogEntry current;
+	return current.ReadModIniStat(this->modIniPath)
+		&& current.modIniSize == this->modIniSize
+		&& current.modIniMtime == this->modIniMtime;
+}
+
+ModCatalog::ModCatalog(): dirty(false) {
+}
+
+ModCatalog::~ModCatalog() {
+	this->Clear();
+}
+
+void ModCatalog::Clear() {
+	for (ModCatalogEntries::iterator it = this->entries.begin();
+		 it != this->entries.end(); ++it) {
+		delete it->second;
+	}
+	this->entries.clear();
+}
+
+wxFileName ModCatalog::GetCatalogFile() {
+	return wxFileName(GetProfileStorageFolder(), MOD_CATALOG_FILE_NAME);
+}
+
+static void WriteEntry(wxDataOutputStream& out, const ModCatalogEntry& entry) {
+	out.WriteString(entry.modIniPath);
+	out.WriteString(entry.modIniSize);
+	out.WriteString(entry.modIniMtime);
+	out.WriteString(entry.name);
+	out.WriteString(entry.image255x112);
+	out.WriteString(entry.image182x80);
+	out.WriteString(entry.infotext);
+	out.WriteString(entry.author);
+	out.WriteString(entry.notes);
+	out.Write8(entry.warn ? 1 : 0);
+	out.WriteString(entry.website);
+	out.WriteString(entry.forum);
+	out.WriteString(entry.bugs);
+	out.WriteString(entry.support);
+	out.Write32(static_cast<wxUint32>(entry.minhorizontalres));
+	out.Write32(static_cast<wxUint32>(entry.minverticalres));
+	out.WriteString(entry.forcedon);
+	out.WriteString(entry.forcedoff);
+	out.WriteString(entry.primarylist);
+	out.WriteString(entry.secondarylist);
+	out.WriteString(entry.recommendedlightingname);
+	out.WriteString(entry.recommendedlightingflagset);
+	out.Write8(entry.hasFlagSets ? 1 : 0);
+	out.Write32(static_cast<wxUint32>(entry.flagsets.size()));
+	for (size_t i = 0; i < entry.flagsets.size(); i++) {
+		out.WriteString(entry.flagsets[i].name);
+		out.WriteString(entry.flagsets[i].flagset);
+		out.WriteString(entry.flagsets[i].notes);
+	}
+}
+
+static bool ReadEntry(wxDataInputStream& in, wxInputStream& stream, ModCatalogEntry& entry) {
+	entry.modIniPath = in.ReadString();
+	entry.modIniSize = in.ReadString();
+	entry.modIniMtime = in.ReadString();
+	entry.name = in.ReadString();
+	entry.image255x112 = in.ReadString();
+	entry.image182x80 = in.ReadString();
+	entry.infotext = in.ReadString();
+	entry.author = in.ReadString();
+	entry.notes = in.ReadString();
+	entry.warn = in.Read8() != 0;
+	entry.website = in.ReadString();
+	entry.forum = in.ReadString();
+	entry.bugs = in.ReadString();
+	entry.support = in.ReadString();
+	entry.minhorizontalres = static_cast<wxInt32>(in.Read32());
+	entry.minverticalres = static_cast<wxInt32>(in.Read32());
+	entry.forcedon = in.ReadString();
+	entry.forcedoff = in.ReadString();
+	entry.primarylist = in.ReadString();
+	entry.secondarylist = in.ReadString();
+	entry.recommendedlightingname = in.ReadString();
+	entry.recommendedlightingflagset = in.ReadString();
+	entry.hasFlagSets = in.Read8() != 0;
+
+	const wxUint32 flagsetCount = in.Read32();
+	if (!stream.IsOk() || flagsetCount > MAX_CATALOG_FLAGSETS) {
+		return false;
+	}
+	entry.flagsets.resize(flagsetCount);
+	for (wxUint32 i = 0; i < flagsetCount; i++) {
+		entry.flagsets[i].name = in.ReadString();
+		entry.flagsets[i].flagset = in.ReadString();
+		entry.flagsets[i].notes = in.ReadString();
+	}
+	return stream.IsOk() && !entry.modIniPath.IsEmpty();
+}
+
+bool ModCatalog::Load() {
+	this->Clear();
+	this->dirty = false;
+
+	wxFileName file(GetCatalogFile());
+	if (!file.FileExists()) {
+		wxLogDebug(_T("No mod catalog at %s"), file.GetFullPath().c_str());
+		return false;
+	}
+
+	wxFFileInputStream stream(file.GetFullPath());
+	if (!stream.IsOk()) {
+		wxLogDebug(_T("Unable to open mod catalog %s"), file.GetFullPath().c_str());
+		return false;
+	}
+	wxDataInputStream in(stream, wxConvUTF8);
+
+	const wxString magic(in.ReadString());
+	const wxUint32 version = in.Read32();
+	const wxUint32 count = in.Read32();
+	if (!stream.IsOk() || magic != MOD_CATALOG_MAGIC
+		|| version != MOD_CATALOG_VERSION || count > MAX_CATALOG_ENTRIES) {
+		wxLogDebug(_T("Mod catalog %s is unsupported or corrupt, ignoring it."),
+			file.GetFullPath().c_str());
+		return false;
+	}
+
+	for (wxUint32 i = 0; i < count; i++) {
+		ModCatalogEntry* entry = new ModCatalogEntry();
+		if (!ReadEntry(in, stream, *entry)) {
+			wxLogDebug(_T("Mod catalog %s is truncated, ignoring it."),
+				file.GetFullPath().c_str());
+			delete entry;
+			this->Clear();
+			return false;
+		}
+		this->Put(entry);
+	}
+
+	this->dirty = false;
+	wxLogDebug(_T("Loaded ") SZT _T(" entries from mod catalog %s"),
+		this->entries.size(), file.GetFullPath().c_str());
+	return true;
+}
+
+bool ModCatalog::Save() {
+	if (!this->dirty) {
+		return true;
+	}
+
+	wxFileName file(GetCatalogFile());
+	const wxString tempFile(file.GetFullPath() + _T(".tmp"));
+	{
+		wxFFileOutputStream stream(tempFile);
+		if (!stream.IsOk()) {
+			wxLogDebug(_T("Unable to write mod catalog to %s"), tempFile.c_str());
+			return false;
+		}
+		wxDataOutputStream out(stream, wxConvUTF8);
+
+		out.WriteString(MOD_CATALOG_MAGIC);
+		out.Write32(MOD_CATALOG_VERSION);
+		out.Write32(static_cast<wxUint32>(this->entries.size()));
+		for (ModCatalogEntries::const_iterator it = this->entries.begin();
+			 it != this->entries.end(); ++it) {
+			WriteEntry(out, *(it->second));
+		}
+
+		if (!stream.IsOk() || !stream.Close()) {
+			wxLogDebug(_T("Error while writing mod catalog to %s"), tempFile.c_str());
+			::wxRemoveFile(tempFile);
+			return false;
+		}
+	}
+
+	if (!::wxRenameFile(tempFile, file.GetFullPath(), true)) {
+		wxLogDebug(_T("Unable to replace mod catalog %s"), file.GetFullPath().c_str());
+		::wxRemoveFile(tempFile);
+		return false;
+	}
+
+	this->dirty = false;
+	wxLogDebug(_T("Saved ") SZT _T(" entries to mod catalog %s"),
+		this->entries.size(), file.GetFullPath().c_str());
+	return true;
+}
+
+const ModCatalogEntry* ModCatalog::Find(const wxString& modIniPath) {
+	ModCatalogEntries::iterator it = this->entries.find(modIniPath);
+	if (it == this->entries.end()) {
+		return NULL;
+	}
+
+	it->second->seen = true;
+	if (!it->second->IsUpToDate()) {
+		wxLogDebug(_T(" Mod catalog entry for %s is stale"), modIniPath.c_str());
+		return NULL;
+	}
+	return it->second;
+}
+
+void ModCatalog::Put(ModCatalogEntry* entry) {
+	wxCHECK_RET(entry != NULL, _T("ModCatalog::Put(): entry is NULL"));
+
+	ModCatalogEntries::iterator it = this->entries.find(entry->modIniPath);
+	if (it != this->entries.end()) {
+		if (it->second == entry) {
+			return;
+		}
+		delete it->second;
+	}
+	entry->seen = true;
+	this->entries[entry->modIniPath] = entry;
+	this->dirty = true;
+}
+
+void ModCatalog::Remove(const wxString& modIniPath) {
+	ModCatalogEntries::iterator it = this->entries.find(modIniPath);
+	if (it != this->entries.end()) {
+		delete it->second;
+		this->entries.erase(it);
+		this->dirty = true;
+	}
+}
+
+void ModCatalog::BeginScan() {
+	for (ModCatalogEntries::iterator it = this->entries.begin();
+		 it != this->entries.end(); ++it) {
+		it->second->seen = false;
+	}
+}
+
+void ModCatalog::EndScan(const wxString& tcPath) {
+	wxFileName tcFolder;
+	tcFolder.AssignDir(tcPath);
+	const wxString prefix(tcFolder.GetPath(wxPATH_GET_VOLUME | wxPATH_GET_SEPARATOR));
+
+	wxArrayString removed;
+	for (ModCatalogEntries::iterator it = this->entries.begin();
+		 it != this->entries.end(); ++it) {
+		if (!it->second->seen && it->first.StartsWith(prefix)) {
+			removed.Add(it->first);
+		}
+	}
+	for (size_t i = 0; i < removed.GetCount(); i++) {
+		wxLogDebug(_T(" Removing %s from mod catalog"), removed[i].c_str());
+		this->Remove(removed[i]);
+	}
+}
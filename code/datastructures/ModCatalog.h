@@ -0,0 +1,115 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef MODCATALOG_H
+#define MODCATALOG_H
+
+#include <vector>
+
+#include <wx/wx.h>
+#include <wx/filename.h>
+
+/** A flag set from a mod.ini, as stored in the catalog. */
+struct ModCatalogFlagSet {
+	wxString name;
+	wxString flagset;
+	wxString notes;
+};
+
+/** The values that the mod list uses from one mod.ini. */
+class ModCatalogEntry {
+public:
+	ModCatalogEntry();
+
+	/** Records the size and modification time of the mod.ini. */
+	bool ReadModIniStat(const wxString& modIniPath);
+	/** Returns true if the mod.ini has not changed since the entry was made. */
+	bool IsUpToDate() const;
+
+	wxString modIniPath;
+	wxString modIniSize; //!< size in bytes, as a string
+	wxString modIniMtime; //!< milliseconds since the epoch, as a string
+
+	wxString name;
+	wxString image255x112; //!< as written in the mod.ini, resolved when the entry is used
+	wxString image182x80; //!< as written in the mod.ini, resolved when the entry is used
+	wxString infotext;
+	wxString author;
+	wxString notes;
+	bool warn;
+	wxString website;
+	wxString forum;
+	wxString bugs;
+	wxString support;
+	long minhorizontalres;
+	long minverticalres;
+	wxString forcedon;
+	wxString forcedoff;
+	wxString primarylist;
+	wxString secondarylist;
+	wxString recommendedlightingname; //!< as written in the mod.ini, before defaults and translation
+	wxString recommendedlightingflagset; //!< as written in the mod.ini, before defaults
+	bool hasFlagSets;
+	std::vector<ModCatalogFlagSet> flagsets; //!< set 0 is the ideal set
+
+	bool seen; //!< not stored; set when the entry's mod.ini was found by the current scan
+};
+
+WX_DECLARE_STRING_HASH_MAP(ModCatalogEntry*, ModCatalogEntries);
+
+/** Persistent index of parsed mod.ini files, stored in the profile storage
+ folder so that unchanged mods do not have to be parsed on every start.
+ Entries are keyed by the full path of the mod.ini and are only used while
+ the size and modification time of the mod.ini still match. Values that
+ depend on anything besides the mod.ini (image files, the UI language)
+ are stored as written and worked out again each time an entry is used. */
+class ModCatalog {
+public:
+	ModCatalog();
+	~ModCatalog();
+
+	/** Reads the catalog from disk. A missing or unreadable catalog is treated as empty. */
+	bool Load();
+	/** Writes the catalog to disk if it has changed. */
+	bool Save();
+
+	/** Returns the entry for modIniPath if it is up to date, otherwise NULL.
+	 The entry remains owned by the catalog. */
+	const ModCatalogEntry* Find(const wxString& modIniPath);
+	/** Adds or replaces the entry for entry->modIniPath. Takes ownership of entry. */
+	void Put(ModCatalogEntry* entry);
+	/** Removes the entry for modIniPath, if there is one. */
+	void Remove(const wxString& modIniPath);
+
+	/** Clears the seen marks before a scan of a TC folder. */
+	void BeginScan();
+	/** Removes the entries below tcPath that were not seen since BeginScan(). */
+	void EndScan(const wxString& tcPath);
+
+	inline size_t GetCount() const { return this->entries.size(); }
+
+	static wxFileName GetCatalogFile();
+
+private:
+	void Clear();
+
+	ModCatalogEntries entries;
+	bool dirty; //!< has changed since it was loaded
+};
+
+#endif
@@ -0,0 +1,337 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "generated/configure_launcher.h"
+#include "datastructures/ModImageCache.h"
+#include "datastructures/ThumbnailCache.h"
+#include "apis/SkinManager.h"
+#include "global/Utils.h"
+
+#include "global/MemoryDebugging.h"
+
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_MOD_IMAGES_DECODED);
+
+/** Enough for the images of about a hundred mods. */
+const size_t ModImageCache::DEFAULT_MAX_BYTES = 16 * 1024 * 1024;
+/** Upper bound on the number of worker threads. */
+const int MAX_DECODE_WORKERS = 4;
+
+// wxString and wxImage are not guaranteed to be safe to share between
+// threads, so strings that cross a thread boundary are always deep copied
+// and images are only handed over while the mutex is held.
+static inline wxString DeepCopy(const wxString& str) {
+	return wxString(str.c_str());
+}
+
+static inline size_t BitmapBytes(const wxBitmap& bitmap) {
+	return bitmap.IsOk() ? static_cast<size_t>(bitmap.GetWidth() * bitmap.GetHeight() * 4) : 0;
+}
+
+ModImageCache::Request::Request(const wxString& image255x112path, const wxString& image182x80path)
+: key(MakeKey(image255x112path, image182x80path)),
+image255x112path(DeepCopy(image255x112path)), image182x80path(DeepCopy(image182x80path)) {
+}
+
+ModImageCache::ModImageCache(wxEvtHandler* owner, size_t maxBytes)
+: owner(owner), maxBytes(maxBytes), bytes(0), workersStarted(false),
+requestAdded(mutex), stopping(false) {
+	wxASSERT(owner != NULL);
+	this->thumbnailFolder = ThumbnailCache::PrepareCacheFolder();
+	ThumbnailCache::Trim(this->thumbnailFolder);
+}
+
+ModImageCache::~ModImageCache() {
+	this->StopWorkers();
+}
+
+wxString ModImageCache::MakeKey(const wxString& image255x112path, const wxString& image182x80path) {
+	return image255x112path + _T("\n") + image182x80path;
+}
+
+bool ModImageCache::Get(const wxString& image255x112path, const wxString& image182x80path,
+		ModImages& images) {
+	if (image255x112path.IsEmpty() && image182x80path.IsEmpty()) {
+		images = ModImages();
+		return true;
+	}
+
+	const wxString key(MakeKey(image255x112path, image182x80path));
+	Entries::iterator it = this->entries.find(key);
+	if (it != this->entries.end()) {
+		this->Touch(it->second);
+		images = it->second.images;
+		return true;
+	}
+
+	if (this->queued.find(key) == this->queued.end()) {
+		this->StartWorkers();
+		if (this->workers.empty()) {
+			images = this->GetNow(image255x112path, image182x80path);
+			return true;
+		}
+		this->queued.insert(key);
+
+		wxMutexLocker lock(this->mutex);
+		this->requests.push_back(Request(image255x112path, image182x80path));
+		this->requestAdded.Signal();
+	}
+	return false;
+}
+
+ModImages ModImageCache::GetNow(const wxString& image255x112path, const wxString& image182x80path) {
+	ModImages images;
+	if (image255x112path.IsEmpty() && image182x80path.IsEmpty()) {
+		return images;
+	}
+
+	Entries::iterator cached = this->entries.find(MakeKey(image255x112path, image182x80path));
+	if (cached != this->entries.end()) {
+		this->Touch(cached->second);
+		return cached->second.images;
+	}
+
+	// the user is waiting for these, so do not wait for the workers
+	Decoded decoded;
+	Decode(Request(image255x112path, image182x80path), this->thumbnailFolder, decoded);
+	for (size_t i = 0; i < decoded.warnings.GetCount(); i++) {
+		wxLogWarning(decoded.warnings[i]);
+	}
+	this->Insert(decoded);
+
+	Entries::iterator it = this->entries.find(decoded.key);
+	wxCHECK_MSG(it != this->entries.end(), images, _T("GetNow(): decoded images were not cached"));
+	return it->second.images;
+}
+
+void ModImageCache::CollectDecoded() {
+	std::vector<Decoded> finished;
+	{
+		wxMutexLocker lock(this->mutex);
+		finished.swap(this->decoded);
+	}
+
+	for (size_t i = 0; i < finished.size(); i++) {
+		for (size_t j = 0; j < finished[i].warnings.GetCount(); j++) {
+			wxLogWarning(finished[i].warnings[j]);
+		}
+		this->Insert(finished[i]);
+		this->queued.erase(finished[i].key);
+	}
+	wxLogDebug(_T("ModImageCache: collected ") SZT _T(" decoded mod(s), ")
+		SZT _T(" cached using ") SZT _T(" bytes"),
+		finished.size(), this->entries.size(), this->bytes);
+}
+
+void ModImageCache::Forget(const wxString& image255x112path, const wxString& image182x80path) {
+	Entries::iterator it = this->entries.find(MakeKey(image255x112path, image182x80path));
+	if (it != this->entries.end()) {
+		this->bytes -= it->second.bytes;
+		this->lru.erase(it->second.lruPosition);
+		this->entries.erase(it);
+	}
+}
+
+void ModImageCache::RemoveThumbnails(const wxString& imagePath) {
+	ThumbnailCache::Remove(this->thumbnailFolder, imagePath);
+}
+
+void ModImageCache::Insert(const Decoded& decoded) {
+	Entries::iterator existing = this->entries.find(decoded.key);
+	if (existing != this->entries.end()) {
+		this->bytes -= existing->second.bytes;
+		this->lru.erase(existing->second.lruPosition);
+		this->entries.erase(existing);
+	}
+
+	Entry entry;
+	if (decoded.image255x112.IsOk()) {
+		entry.images.image255x112 = wxBitmap(decoded.image255x112);
+	}
+	if (decoded.image182x80.IsOk()) {
+		entry.images.image182x80 = wxBitmap(decoded.image182x80);
+	}
+	// mods without usable images still take up room, so count them too
+	entry.bytes = sizeof(Entry) + decoded.key.length() * sizeof(wxChar)
+		+ BitmapBytes(entry.images.image255x112) + BitmapBytes(entry.images.image182x80);
+
+	this->lru.push_front(decoded.key);
+	entry.lruPosition = this->lru.begin();
+	this->entries[decoded.key] = entry;
+	this->bytes += entry.bytes;
+
+	this->Trim();
+}
+
+void ModImageCache::Touch(Entry& entry) {
+	this->lru.splice(this->lru.begin(), this->lru, entry.lruPosition);
+}
+
+/** Drops the least recently used images until the cache fits in maxBytes.
+ The most recently used images are always kept. */
+void ModImageCache::Trim() {
+	while (this->bytes > this->maxBytes && this->lru.size() > 1) {
+		Entries::iterator it = this->entries.find(this->lru.back());
+		wxCHECK_RET(it != this->entries.end(), _T("Trim(): LRU list and cache disagree"));
+		this->bytes -= it->second.bytes;
+		this->entries.erase(it);
+		this->lru.pop_back();
+	}
+}
+
+static void AddImageWarning(wxArrayString& warnings, const wxString& imageName,
+		const wxString& path, const ThumbnailSource& source) {
+	const wxSize sourceSize(source.GetSourceSize());
+	if (sourceSize == wxDefaultSize) {
+		warnings.Add(wxString::Format(_T("Could not set %s file to '%s': %s"),
+			imageName.c_str(), path.c_str(), source.GetError().c_str()));
+	} else {
+		warnings.Add(wxString::Format(_T("%s has invalid dimensions %dx%d"),
+			imageName.c_str(), sourceSize.GetWidth(), sourceSize.GetHeight()));
+	}
+}
+
+/** Decodes the images and makes the missing one from the other, like the
+ mod list always has. Images that were made before are taken from the
+ thumbnail cache instead. Runs on the worker threads, so it must not log;
+ what went wrong is put in decoded's warnings instead. */
+void ModImageCache::Decode(const Request& request, const wxString& thumbnailFolder,
+		Decoded& decoded) {
+	decoded.key = request.key;
+
+	const wxSize size255x112(SkinSystem::ModInfoDialogImageWidth, SkinSystem::ModInfoDialogImageHeight);
+	const wxSize size182x80(SkinSystem::ModListImageWidth, SkinSystem::ModListImageHeight);
+	ThumbnailSource source255x112(request.image255x112path, thumbnailFolder);
+	ThumbnailSource source182x80(request.image182x80path, thumbnailFolder);
+
+	if (!request.image255x112path.IsEmpty()
+		&& !source255x112.GetImage(size255x112, ThumbnailCache::FIT_EXACT, decoded.image255x112)) {
+		AddImageWarning(decoded.warnings, _T("image255x112"), request.image255x112path, source255x112);
+	}
+	if (!request.image182x80path.IsEmpty()
+		&& !source182x80.GetImage(size182x80, ThumbnailCache::FIT_EXACT, decoded.image182x80)) {
+		AddImageWarning(decoded.warnings, _T("image182x80"), request.image182x80path, source182x80);
+	}
+
+	// if both images are Ok, then we just use them
+	// if both images are not Ok, then the mod list uses SkinSystem::modImage/smallModImage
+	if (decoded.image255x112.IsOk() && !decoded.image182x80.IsOk()) {
+		source255x112.GetImage(size182x80, ThumbnailCache::FIT_SCALE, decoded.image182x80);
+	} else if (!decoded.image255x112.IsOk() && decoded.image182x80.IsOk()) {
+		source182x80.GetImage(size255x112, ThumbnailCache::FIT_SCALE, decoded.image255x112);
+	}
+}
+
+/** Starts the workers on the first request. If none can be started, the
+ images are decoded on the main thread as they are asked for. */
+void ModImageCache::StartWorkers() {
+	if (this->workersStarted) {
+		return;
+	}
+	this->workersStarted = true;
+
+	int workerCount = wxThread::GetCPUCount();
+	if (workerCount < 1) {
+		workerCount = 1;
+	} else if (workerCount > MAX_DECODE_WORKERS) {
+		workerCount = MAX_DECODE_WORKERS;
+	}
+
+	for (int i = 0; i < workerCount; i++) {
+		Worker* worker = new Worker(this, this->thumbnailFolder);
+		if (worker->Create() != wxTHREAD_NO_ERROR || worker->Run() != wxTHREAD_NO_ERROR) {
+			delete worker;
+			break;
+		}
+		this->workers.push_back(worker);
+	}
+	if (this->workers.empty()) {
+		wxLogDebug(_T("ModImageCache: unable to start any decode workers, decoding on the main thread"));
+	} else {
+		wxLogDebug(_T("ModImageCache: started ") SZT _T(" decode worker(s)"), this->workers.size());
+	}
+}
+
+void ModImageCache::StopWorkers() {
+	{
+		wxMutexLocker lock(this->mutex);
+		this->stopping = true;
+		this->requests.clear();
+		this->requestAdded.Broadcast();
+	}
+
+	for (size_t i = 0; i < this->workers.size(); i++) {
+		this->workers[i]->Wait();
+		delete this->workers[i];
+	}
+	this->workers.clear();
+}
+
+bool ModImageCache::TakeRequest(Request& request) {
+	wxMutexLocker lock(this->mutex);
+	while (this->requests.empty() && !this->stopping) {
+		this->requestAdded.Wait();
+	}
+	if (this->stopping) {
+		return false;
+	}
+
+	const Request& next = this->requests.back();
+	request.key = DeepCopy(next.key);
+	request.image255x112path = DeepCopy(next.image255x112path);
+	request.image182x80path = DeepCopy(next.image182x80path);
+	this->requests.pop_back();
+	return true;
+}
+
+void ModImageCache::AddDecoded(Decoded& decoded) {
+	bool first;
+	{
+		wxMutexLocker lock(this->mutex);
+		if (this->stopping) {
+			return;
+		}
+		first = this->decoded.empty();
+		this->decoded.push_back(decoded);
+
+		// let go of this thread's references while the mutex is still held
+		decoded.key = wxEmptyString;
+		decoded.image255x112 = wxImage();
+		decoded.image182x80 = wxImage();
+		decoded.warnings.Clear();
+	}
+
+	// one event is enough for everything that finishes before it is handled
+	if (first) {
+		wxCommandEvent event(EVT_MOD_IMAGES_DECODED, wxID_NONE);
+		this->owner->AddPendingEvent(event);
+	}
+}
+
+ModImageCache::Worker::Worker(ModImageCache* cache, const wxString& thumbnailFolder)
+: wxThread(wxTHREAD_JOINABLE), cache(cache), thumbnailFolder(DeepCopy(thumbnailFolder)) {
+}
+
+wxThread::ExitCode ModImageCache::Worker::Entry() {
+	Request request(wxEmptyString, wxEmptyString);
+	while (!this->TestDestroy() && this->cache->TakeRequest(request)) {
+		Decoded decoded;
+		ModImageCache::Decode(request, this->thumbnailFolder, decoded);
+		this->cache->AddDecoded(decoded);
+	}
+	return 0;
+}
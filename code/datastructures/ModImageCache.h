@@ -0,0 +1,132 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef MODIMAGECACHE_H
+#define MODIMAGECACHE_H
+
+#include <list>
+#include <vector>
+
+#include <wx/wx.h>
+#include <wx/hashmap.h>
+#include <wx/hashset.h>
+#include <wx/thread.h>
+
+#include "apis/EventHandlers.h"
+
+/** Images that were requested from a ModImageCache have been decoded.
+ The owner should call ModImageCache::CollectDecoded() and redraw. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_MOD_IMAGES_DECODED);
+
+/** The two images of a mod, decoded and at their expected sizes. */
+struct ModImages {
+	wxBitmap image255x112;
+	wxBitmap image182x80;
+};
+
+/** Decodes the mod list's images on a pool of worker threads, and keeps
+ recently used ones in a cache that is bounded by the memory the bitmaps use.
+ Images are only decoded when they are asked for, so the cost of the mod list
+ depends on the rows that are drawn, not on the number of mods. */
+class ModImageCache {
+public:
+	/** Default bound on the memory used by the cached bitmaps. */
+	static const size_t DEFAULT_MAX_BYTES;
+
+	ModImageCache(wxEvtHandler* owner, size_t maxBytes = DEFAULT_MAX_BYTES);
+	~ModImageCache();
+
+	/** Sets images and returns true if the mod's images have been decoded.
+	 Otherwise queues them for decoding and returns false; the owner gets an
+	 EVT_MOD_IMAGES_DECODED when they are ready. A mod without images, or whose
+	 images cannot be used, gets images that are not Ok. */
+	bool Get(const wxString& image255x112path, const wxString& image182x80path, ModImages& images);
+	/** Like Get(), but decodes the images on this thread if they are not cached. */
+	ModImages GetNow(const wxString& image255x112path, const wxString& image182x80path);
+
+	/** Moves images that the workers have finished into the cache.
+	 Must be called on the main thread. */
+	void CollectDecoded();
+	/** Removes the mod's images from the cache, such as when they have changed. */
+	void Forget(const wxString& image255x112path, const wxString& image182x80path);
+	/** Removes the stored thumbnails of the image at imagePath, when no mod
+	 uses it any more. */
+	void RemoveThumbnails(const wxString& imagePath);
+
+private:
+	struct Request {
+		Request(const wxString& image255x112path, const wxString& image182x80path);
+		wxString key;
+		wxString image255x112path;
+		wxString image182x80path;
+	};
+	struct Decoded {
+		wxString key;
+		wxImage image255x112;
+		wxImage image182x80;
+		wxArrayString warnings; //!< logged on the main thread
+	};
+	struct Entry {
+		ModImages images;
+		size_t bytes;
+		std::list<wxString>::iterator lruPosition;
+	};
+	WX_DECLARE_STRING_HASH_MAP(Entry, Entries);
+	WX_DECLARE_HASH_SET(wxString, wxStringHash, wxStringEqual, KeySet);
+
+	class Worker: public wxThread {
+	public:
+		Worker(ModImageCache* cache, const wxString& thumbnailFolder);
+		virtual ExitCode Entry();
+	private:
+		ModImageCache* cache;
+		const wxString thumbnailFolder; //!< this thread's own copy
+	};
+	friend class Worker;
+
+	static wxString MakeKey(const wxString& image255x112path, const wxString& image182x80path);
+	static void Decode(const Request& request, const wxString& thumbnailFolder, Decoded& decoded);
+
+	void StartWorkers();
+	void StopWorkers();
+	bool TakeRequest(Request& request);
+	void AddDecoded(Decoded& decoded);
+	void Insert(const Decoded& decoded);
+	void Touch(Entry& entry);
+	void Trim();
+
+	wxEvtHandler* owner;
+	const size_t maxBytes;
+	wxString thumbnailFolder; //!< empty if the thumbnail cache cannot be used
+
+	// only used on the main thread
+	Entries entries;
+	std::list<wxString> lru; //!< most recently used first
+	size_t bytes;
+	KeySet queued; //!< requested but not yet collected
+	std::vector<Worker*> workers;
+	bool workersStarted; //!< whether StartWorkers() has tried to start them
+
+	wxMutex mutex; //!< guards everything below
+	wxCondition requestAdded;
+	std::vector<Request> requests; //!< the most recent request is decoded first
+	std::vector<Decoded> decoded;
+	bool stopping;
+};
+
+#endif
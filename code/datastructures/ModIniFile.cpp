@@ -0,0 +1,234 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "generated/configure_launcher.h"
+#include "datastructures/ModIniFile.h"
+#include "global/Utils.h"
+
+#include <vector>
+
+#include <wx/config.h>
+#include <wx/file.h>
+#include <wx/tokenzr.h>
+
+#include "global/MemoryDebugging.h"
+
+ModIniFile::ModIniFile() {
+}
+
+void ModIniFile::Clear() {
+	this->entries.clear();
+	this->groups.clear();
+}
+
+bool ModIniFile::Load(const wxString& filename) {
+	this->Clear();
+
+	wxFile file;
+	if (!file.Open(filename, wxFile::read)) {
+		return false;
+	}
+
+	const wxFileOffset length = file.Length();
+	if (length == wxInvalidOffset) {
+		return false;
+	}
+
+	const size_t size = static_cast<size_t>(length);
+	std::vector<char> buffer(size + 1, '\0');
+	if (size > 0 && file.Read(&buffer[0], size) != static_cast<ssize_t>(size)) {
+		wxLogError(_T("Unable to read all ") SZT _T(" bytes of %s"), size, filename.c_str());
+		return false;
+	}
+
+	this->Parse(&buffer[0], size);
+	return true;
+}
+
+void ModIniFile::Parse(const char* data, size_t size) {
+	this->Clear();
+
+	wxString text;
+	if (size >= 3 && data[0] == '\357' && data[1] == '\273' && data[2] == '\277') {
+		text = wxString(data + 3, wxConvUTF8, size - 3);
+	} else {
+		text = wxString(data, wxConvISO8859_1, size);
+	}
+
+	const wxChar* p = text.c_str();
+	const wxChar* const end = p + text.length();
+	wxString group; // the current group, "" for the root
+	size_t lineNumber = 0;
+
+	while (p < end) {
+		const wxChar* lineEnd = p;
+		while (lineEnd < end && *lineEnd != wxT('\n') && *lineEnd != wxT('\r')) {
+			lineEnd++;
+		}
+		lineNumber++;
+		this->ParseLine(p, lineEnd, group, lineNumber);
+
+		// lines end with \n, \r\n or \r
+		p = lineEnd;
+		if (p < end && *p == wxT('\r')) {
+			p++;
+		}
+		if (p < end && *p == wxT('\n') && (p == lineEnd || *lineEnd == wxT('\r'))) {
+			p++;
+		}
+	}
+}
+
+/** Quoted values lose their quotes, and environment variables are expanded.
+ Backslashes are not escape characters in mod.ini files. */
+static wxString FilterValue(const wxString& raw, size_t lineNumber) {
+	wxString value;
+	if (raw.StartsWith(_T("\""))) {
+		value.Alloc(raw.length());
+		for (size_t i = 1; i < raw.length(); i++) {
+			if (raw[i] != wxT('"')) {
+				value += raw[i];
+			} else if (i != raw.length() - 1) {
+				wxLogWarning(_T("mod.ini line ") SZT _T(": unexpected \" at position ") SZT _T(" in '%s'."),
+					lineNumber, i, raw.c_str());
+			}
+		}
+	} else {
+		value = raw;
+	}
+
+	if (value.find(wxT('$')) != wxString::npos || value.find(wxT('%')) != wxString::npos) {
+		value = wxExpandEnvVars(value);
+	}
+	return value;
+}
+
+void ModIniFile::ParseLine(const wxChar* begin, const wxChar* end, wxString& group, size_t lineNumber) {
+	while (begin < end && wxIsspace(*begin)) {
+		begin++;
+	}
+	if (begin == end || *begin == wxT(';') || *begin == wxT('#')) {
+		return;
+	}
+
+	if (*begin == wxT('[')) {
+		const wxChar* close = begin + 1;
+		while (close < end && *close != wxT(']')) {
+			close++;
+		}
+		if (close == end) {
+			wxLogError(_T("mod.ini line ") SZT _T(": ']' expected."), lineNumber);
+			return;
+		}
+
+		group = NormalizePath(wxString(begin + 1, static_cast<size_t>(close - begin - 1)));
+		// like wxFileConfig, a group's parents exist too
+		for (size_t slash = group.rfind(wxT('/')); slash != wxString::npos && slash > 0;
+			 slash = group.rfind(wxT('/'), slash - 1)) {
+			this->groups.insert(group.Left(slash));
+		}
+		if (!group.IsEmpty()) {
+			this->groups.insert(group);
+		}
+		return;
+	}
+
+	const wxChar* equals = begin;
+	while (equals < end && *equals != wxT('=')) {
+		equals++;
+	}
+	if (equals == end) {
+		wxLogError(_T("mod.ini line ") SZT _T(": '=' expected."), lineNumber);
+		return;
+	}
+
+	wxString key(begin, static_cast<size_t>(equals - begin));
+	key.Trim();
+	if (key.IsEmpty()) {
+		return;
+	}
+
+	const wxChar* valueBegin = equals + 1;
+	while (valueBegin < end && wxIsspace(*valueBegin)) {
+		valueBegin++;
+	}
+
+	this->entries[group + _T("/") + key.Lower()] =
+		FilterValue(wxString(valueBegin, static_cast<size_t>(end - valueBegin)), lineNumber);
+}
+
+/** Gives path the form that entries and groups are stored with:
+ lower case, starting with a slash, and without empty components. */
+wxString ModIniFile::NormalizePath(const wxString& path) {
+	wxString normalized;
+	wxStringTokenizer tokens(path, _T("/"), wxTOKEN_STRTOK);
+	while (tokens.HasMoreTokens()) {
+		normalized += _T("/");
+		normalized += tokens.GetNextToken();
+	}
+	return normalized.Lower();
+}
+
+bool ModIniFile::HasEntry(const wxString& key) const {
+	return this->entries.find(NormalizePath(key)) != this->entries.end();
+}
+
+bool ModIniFile::HasGroup(const wxString& path) const {
+	return this->groups.find(NormalizePath(path)) != this->groups.end();
+}
+
+bool ModIniFile::Read(const wxString& key, wxString* value) const {
+	wxCHECK_MSG(value != NULL, false, _T("ModIniFile::Read(): value is NULL"));
+
+	ModIniEntries::const_iterator it = this->entries.find(NormalizePath(key));
+	if (it == this->entries.end()) {
+		return false;
+	}
+	*value = it->second;
+	return true;
+}
+
+wxString ModIniFile::Read(const wxString& key, const wxString& defaultValue) const {
+	wxString value;
+	return this->Read(key, &value) ? value : defaultValue;
+}
+
+bool ModIniFile::Read(const wxString& key, long* value, long defaultValue) const {
+	wxCHECK_MSG(value != NULL, false, _T("ModIniFile::Read(): value is NULL"));
+
+	wxString str;
+	long number;
+	if (this->Read(key, &str) && str.Trim().ToLong(&number)) {
+		*value = number;
+		return true;
+	}
+	*value = defaultValue;
+	return false;
+}
+
+bool ModIniFile::Read(const wxString& key, bool* value, bool defaultValue) const {
+	wxCHECK_MSG(value != NULL, false, _T("ModIniFile::Read(): value is NULL"));
+
+	long number;
+	if (this->Read(key, &number, 0)) {
+		*value = (number != 0);
+		return true;
+	}
+	*value = defaultValue;
+	return false;
+}
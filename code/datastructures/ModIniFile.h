@@ -0,0 +1,73 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef MODINIFILE_H
+#define MODINIFILE_H
+
+#include <wx/wx.h>
+#include <wx/hashmap.h>
+#include <wx/hashset.h>
+
+WX_DECLARE_STRING_HASH_MAP(wxString, ModIniEntries);
+WX_DECLARE_HASH_SET(wxString, wxStringHash, wxStringEqual, ModIniGroups);
+
+/** The contents of a mod.ini file.
+ The file is read with a single read and parsed in a single pass into a table
+ of values keyed by their full path, so that looking up a key is one hash
+ lookup. Keys and the values they return are the same as they would be from
+ wxFileConfig: paths such as "/launcher/modname" are case-insensitive, quoted
+ values lose their quotes, environment variables are expanded, and
+ backslashes are kept as they are. */
+class ModIniFile {
+public:
+	ModIniFile();
+
+	/** Reads and parses filename. Returns false if it cannot be read. */
+	bool Load(const wxString& filename);
+	/** Parses the contents of a mod.ini. A UTF-8 byte order mark means the
+	 contents are UTF-8, otherwise they are taken to be ISO-8859-1. */
+	void Parse(const char* data, size_t size);
+
+	bool HasEntry(const wxString& key) const;
+	bool HasGroup(const wxString& path) const;
+	/** Returns true if path is either an entry or a group. */
+	inline bool Exists(const wxString& path) const {
+		return this->HasEntry(path) || this->HasGroup(path);
+	}
+
+	/** Sets value and returns true if key exists, otherwise leaves value unchanged. */
+	bool Read(const wxString& key, wxString* value) const;
+	wxString Read(const wxString& key, const wxString& defaultValue) const;
+	/** Sets value to the key's value if it is a number, otherwise to defaultValue. */
+	bool Read(const wxString& key, long* value, long defaultValue) const;
+	/** Sets value to whether the key's value is a non-zero number,
+	 or to defaultValue if it is not a number. */
+	bool Read(const wxString& key, bool* value, bool defaultValue) const;
+
+	inline size_t GetEntryCount() const { return this->entries.size(); }
+
+private:
+	void Clear();
+	void ParseLine(const wxChar* begin, const wxChar* end, wxString& group, size_t lineNumber);
+	static wxString NormalizePath(const wxString& path);
+
+	ModIniEntries entries; //!< keyed by the lower case full path of the entry
+	ModIniGroups groups; //!< lower case full paths of the groups
+};
+
+#endif
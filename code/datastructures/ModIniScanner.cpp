@@ -0,0 +1,265 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "generated/configure_launcher.h"
+#include "datastructures/ModIniScanner.h"
+#include "global/Utils.h"
+
+#include <wx/dir.h>
+#include <wx/filename.h>
+
+#include "global/MemoryDebugging.h"
+
+/** Mods are normally directly below the TC folder, but mods that are grouped
+ together (such as "modpack/mod") are also found. */
+const int ModIniScanner::DEFAULT_MAX_DEPTH = 3;
+/** Upper bound on the number of worker threads. */
+const int MAX_SCANNER_WORKERS = 8;
+
+// wxString is not guaranteed to be safe to share between threads,
+// so strings that cross a thread boundary are always deep copied.
+static inline wxString DeepCopy(const wxString& str) {
+	return wxString(str.c_str());
+}
+
+ModIniScanner::Subtree::Subtree(const wxString& path, int depth)
+: path(path), depth(depth) {
+}
+
+ModIniScanner::ModIniScanner(const wxString& tcPath, int maxDepth)
+: tcPath(tcPath), maxDepth(maxDepth), modIniFound(mutex),
+nextModIni(0), folderCount(0), runningWorkers(0), cancelled(false) {
+}
+
+ModIniScanner::~ModIniScanner() {
+	this->Cancel();
+}
+
+bool ModIniScanner::ShouldIgnoreFolder(const wxString& dirname) {
+	const wxString realDirName(dirname.AfterLast(wxFileName::GetPathSeparator()));
+	return realDirName.EndsWith(_T(".app")) || realDirName.StartsWith(_T("."));
+}
+
+bool ModIniScanner::IsDataFolder(const wxString& dirname) {
+	const wxString realDirName(dirname.AfterLast(wxFileName::GetPathSeparator()));
+	return realDirName.CmpNoCase(_T("data")) == 0;
+}
+
+void ModIniScanner::Start() {
+	wxCHECK_RET(this->workers.empty(), _T("ModIniScanner::Start() called twice"));
+
+	// TCFolderWatcher starts scans on its own thread, where nothing may be logged
+	const bool canLog = wxThread::IsMain();
+
+	wxDir dir(this->tcPath);
+	if (!dir.IsOpened()) {
+		if (canLog) {
+			wxFAIL_MSG(_T("ModIniScanner::Start(): cannot open TC folder"));
+		}
+		return;
+	}
+
+	// the TC folder itself is searched here, its subfolders by the workers
+	wxString filename;
+	for (bool cont = dir.GetFirst(&filename, wxEmptyString, wxDIR_FILES | wxDIR_HIDDEN);
+		 cont; cont = dir.GetNext(&filename)) {
+		if (filename.EndsWith(_T("mod.ini"))) {
+			this->modInis.push_back(wxFileName(this->tcPath, filename).GetFullPath());
+		}
+	}
+	for (bool cont = dir.GetFirst(&filename, wxEmptyString, wxDIR_DIRS | wxDIR_HIDDEN);
+		 cont; cont = dir.GetNext(&filename)) {
+		const wxString subdir(wxFileName(this->tcPath, filename).GetFullPath());
+		if (!ShouldIgnoreFolder(subdir) && !IsDataFolder(subdir)) {
+			this->subtrees.push_back(Subtree(subdir, 1));
+		}
+	}
+	this->folderCount = 1;
+	this->folders.push_back(this->tcPath);
+
+	if (this->maxDepth < 1 || this->subtrees.empty()) {
+		this->subtrees.clear();
+		return;
+	}
+
+	int workerCount = wxThread::GetCPUCount();
+	if (workerCount < 1) {
+		workerCount = 1;
+	} else if (workerCount > MAX_SCANNER_WORKERS) {
+		workerCount = MAX_SCANNER_WORKERS;
+	}
+	const size_t subtreeCount = this->subtrees.size();
+	if (static_cast<size_t>(workerCount) > subtreeCount) {
+		workerCount = static_cast<int>(subtreeCount);
+	}
+
+	for (int i = 0; i < workerCount; i++) {
+		Worker* worker = new Worker(this);
+		if (worker->Create() != wxTHREAD_NO_ERROR) {
+			delete worker;
+			break;
+		}
+		{
+			wxMutexLocker lock(this->mutex);
+			this->runningWorkers++;
+		}
+		if (worker->Run() != wxTHREAD_NO_ERROR) {
+			wxMutexLocker lock(this->mutex);
+			this->runningWorkers--;
+			delete worker;
+			break;
+		}
+		this->workers.push_back(worker);
+	}
+
+	if (this->workers.empty()) {
+		if (canLog) {
+			wxLogDebug(_T("ModIniScanner: could not start worker threads, scanning on this thread."));
+		}
+		wxString path;
+		int depth;
+		while (this->TakeSubtree(path, depth)) {
+			this->ScanSubtree(path, depth);
+		}
+	} else if (canLog) {
+		wxLogDebug(_T("ModIniScanner: scanning ") SZT _T(" folders with %d workers."),
+			subtreeCount, static_cast<int>(this->workers.size()));
+	}
+}
+
+bool ModIniScanner::GetNextModIni(wxString& modIniPath) {
+	wxMutexLocker lock(this->mutex);
+
+	while (this->nextModIni >= this->modInis.size()
+		&& this->runningWorkers > 0 && !this->cancelled) {
+		this->modIniFound.Wait();
+	}
+
+	if (this->nextModIni >= this->modInis.size() || this->cancelled) {
+		return false;
+	}
+
+	modIniPath = DeepCopy(this->modInis[this->nextModIni]);
+	this->nextModIni++;
+	return true;
+}
+
+void ModIniScanner::Cancel() {
+	{
+		wxMutexLocker lock(this->mutex);
+		this->cancelled = true;
+		this->subtrees.clear();
+	}
+
+	for (size_t i = 0; i < this->workers.size(); i++) {
+		this->workers[i]->Wait();
+		delete this->workers[i];
+	}
+	this->workers.clear();
+}
+
+size_t ModIniScanner::GetFolderCount() {
+	wxMutexLocker lock(this->mutex);
+	return this->folderCount;
+}
+
+void ModIniScanner::GetFolders(std::vector<wxString>& folders) {
+	wxMutexLocker lock(this->mutex);
+	folders.clear();
+	for (size_t i = 0; i < this->folders.size(); i++) {
+		folders.push_back(DeepCopy(this->folders[i]));
+	}
+}
+
+bool ModIniScanner::TakeSubtree(wxString& path, int& depth) {
+	wxMutexLocker lock(this->mutex);
+	if (this->cancelled || this->subtrees.empty()) {
+		return false;
+	}
+	path = DeepCopy(this->subtrees.back().path);
+	depth = this->subtrees.back().depth;
+	this->subtrees.pop_back();
+	return true;
+}
+
+void ModIniScanner::ScanSubtree(const wxString& path, int depth) {
+	std::vector<Subtree> pending;
+	pending.push_back(Subtree(path, depth));
+	std::vector<wxString> scanned;
+
+	while (!pending.empty()) {
+		const Subtree current(pending.back());
+		pending.pop_back();
+
+		wxDir dir(current.path);
+		if (!dir.IsOpened()) {
+			continue;
+		}
+		scanned.push_back(DeepCopy(current.path));
+
+		wxString filename;
+		for (bool cont = dir.GetFirst(&filename, wxEmptyString, wxDIR_FILES | wxDIR_HIDDEN);
+			 cont; cont = dir.GetNext(&filename)) {
+			if (filename.EndsWith(_T("mod.ini"))) {
+				this->AddModIni(wxFileName(current.path, filename).GetFullPath());
+			}
+		}
+
+		if (current.depth >= this->maxDepth) {
+			continue;
+		}
+
+		for (bool cont = dir.GetFirst(&filename, wxEmptyString, wxDIR_DIRS | wxDIR_HIDDEN);
+			 cont; cont = dir.GetNext(&filename)) {
+			const wxString subdir(wxFileName(current.path, filename).GetFullPath());
+			if (!ShouldIgnoreFolder(subdir) && !IsDataFolder(subdir)) {
+				pending.push_back(Subtree(subdir, current.depth + 1));
+			}
+		}
+	}
+
+	wxMutexLocker lock(this->mutex);
+	this->folderCount += scanned.size();
+	this->folders.insert(this->folders.end(), scanned.begin(), scanned.end());
+}
+
+void ModIniScanner::AddModIni(const wxString& modIniPath) {
+	wxMutexLocker lock(this->mutex);
+	this->modInis.push_back(DeepCopy(modIniPath));
+	this->modIniFound.Broadcast();
+}
+
+void ModIniScanner::WorkerFinished() {
+	wxMutexLocker lock(this->mutex);
+	this->runningWorkers--;
+	this->modIniFound.Broadcast();
+}
+
+ModIniScanner::Worker::Worker(ModIniScanner* scanner)
+: wxThread(wxTHREAD_JOINABLE), scanner(scanner) {
+}
+
+wxThread::ExitCode ModIniScanner::Worker::Entry() {
+	wxString path;
+	int depth;
+	while (!this->TestDestroy() && this->scanner->TakeSubtree(path, depth)) {
+		this->scanner->ScanSubtree(path, depth);
+	}
+	this->scanner->WorkerFinished();
+	return 0;
+}
@@ -0,0 +1,100 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef MODINISCANNER_H
+#define MODINISCANNER_H
+
+#include <vector>
+
+#include <wx/wx.h>
+#include <wx/thread.h>
+
+/** Finds the mod.ini files in a TC folder.
+ Every folder directly below the TC folder is searched by a pool of worker
+ threads. The search does not go deeper than maxDepth folders below the TC
+ folder and does not enter FS2 Open data folders, which is where nearly all
+ of the files in a TC are. Found files are handed to the calling thread as
+ soon as they are found through GetNextModIni(). */
+class ModIniScanner {
+public:
+	/** Default maximum depth of a mod folder below the TC folder. */
+	static const int DEFAULT_MAX_DEPTH;
+
+	ModIniScanner(const wxString& tcPath, int maxDepth = DEFAULT_MAX_DEPTH);
+	~ModIniScanner();
+
+	/** Starts the worker threads. Can be called on any thread, but only logs
+	 on the main thread. */
+	void Start();
+	/** Blocks until another mod.ini has been found or the scan has finished.
+	 Returns false when there are no more mod.ini files. */
+	bool GetNextModIni(wxString& modIniPath);
+	/** Stops the workers and waits for them to exit. */
+	void Cancel();
+
+	/** Number of folders that were searched, for logging. */
+	size_t GetFolderCount();
+	/** The folders that were searched, including the TC folder.
+	 Only complete once GetNextModIni() has returned false. */
+	void GetFolders(std::vector<wxString>& folders);
+
+	/** Returns true for folders that can never contain a mod.ini
+	 (.app bundles and hidden folders). */
+	static bool ShouldIgnoreFolder(const wxString& dirname);
+	/** Returns true for "data" folders, which hold game files rather than
+	 mods, so they are skipped entirely: neither searched nor descended into. */
+	static bool IsDataFolder(const wxString& dirname);
+
+private:
+	class Worker: public wxThread {
+	public:
+		Worker(ModIniScanner* scanner);
+		virtual ExitCode Entry();
+	private:
+		ModIniScanner* scanner;
+	};
+	friend class Worker;
+
+	struct Subtree {
+		Subtree(const wxString& path, int depth);
+		wxString path;
+		int depth; //!< depth of path below the TC folder
+	};
+
+	bool TakeSubtree(wxString& path, int& depth);
+	void ScanSubtree(const wxString& path, int depth);
+	void AddModIni(const wxString& modIniPath);
+	void WorkerFinished();
+
+	const wxString tcPath;
+	const int maxDepth;
+
+	wxMutex mutex; //!< guards everything below
+	wxCondition modIniFound; //!< signalled on every result and when a worker exits
+	std::vector<Subtree> subtrees; //!< folders waiting for a worker
+	std::vector<wxString> modInis;
+	size_t nextModIni; //!< index of the next result to hand out
+	size_t folderCount;
+	std::vector<wxString> folders; //!< folders that were searched
+	int runningWorkers;
+	bool cancelled;
+
+	std::vector<Worker*> workers;
+};
+
+#endif
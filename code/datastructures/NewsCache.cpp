@@ -0,0 +1,192 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "generated/configure_launcher.h"
+#include "datastructures/NewsCache.h"
+#include "apis/ProfileWriter.h"
+#include "global/ProfileKeys.h"
+#include "global/Utils.h"
+
+#include <algorithm>
+
+#include <wx/datstrm.h>
+#include <wx/mstream.h>
+#include <wx/wfstream.h>
+#if wxUSE_ZLIB
+#include <wx/zstream.h>
+#endif
+
+#include "global/MemoryDebugging.h"
+
+#define NEWS_CACHE_FILE_NAME	_T("newscache.dat")
+#define NEWS_CACHE_MAGIC		_T("wxLauncher news cache")
+/** Increment whenever the layout of an entry changes. */
+const wxUint32 NEWS_CACHE_VERSION = 1;
+/** Sanity limit so that a corrupt cache cannot cause a long loop. */
+const wxUint32 MAX_NEWS_CACHE_ENTRIES = 1000;
+
+/** Whether the entries that follow the header are compressed. */
+enum NewsCacheEncoding {
+	NEWS_CACHE_PLAIN = 0,
+	NEWS_CACHE_ZLIB = 1
+};
+
+NewsData::NewsData(const wxString& theNews, const wxDateTime& lastDownloadNews)
+: theNews(theNews), lastDownloadNews(lastDownloadNews) {
+	wxASSERT(!theNews.IsEmpty());
+	wxASSERT(lastDownloadNews.IsValid());
+}
+
+NewsCache::NewsCache(): loaded(false), dirty(false) {
+}
+
+wxFileName NewsCache::GetCacheFile() {
+	return wxFileName(GetProfileStorageFolder(), NEWS_CACHE_FILE_NAME);
+}
+
+const NewsData* NewsCache::Read(const wxString& newsSource) {
+	wxCHECK_MSG(!newsSource.IsEmpty(), NULL, _T("NewsCache::Read: newsSource is empty!"));
+	this->Load();
+
+	NewsMap::const_iterator it = this->news.find(newsSource);
+	if (it == this->news.end()) {
+		return NULL;
+	} else {
+		return &(it->second);
+	}
+}
+
+void NewsCache::Write(const wxString& newsSource, const NewsData& data) {
+	wxCHECK_RET(!newsSource.IsEmpty(), _T("NewsCache::Write: newsSource is empty!"));
+	wxCHECK_RET(data.IsValid(), _T("NewsCache::Write: data is not valid!"));
+	// loaded first, so that saving does not drop the news of the other sources
+	this->Load();
+
+	this->news[newsSource] = data;
+	this->dirty = true;
+}
+
+void NewsCache::Load() {
+	if (this->loaded) {
+		return;
+	}
+	this->loaded = true;
+
+	wxFileName file(GetCacheFile());
+	if (!file.FileExists()) {
+		wxLogDebug(_T("No news cache at %s"), file.GetFullPath().c_str());
+		return;
+	}
+
+	wxFFileInputStream stream(file.GetFullPath());
+	if (!stream.IsOk()) {
+		wxLogDebug(_T("Unable to open news cache %s"), file.GetFullPath().c_str());
+		return;
+	}
+	wxDataInputStream header(stream, wxConvUTF8);
+
+	const wxString magic(header.ReadString());
+	const wxUint32 version = header.Read32();
+	const wxUint8 encoding = header.Read8();
+	if (!stream.IsOk() || magic != NEWS_CACHE_MAGIC || version != NEWS_CACHE_VERSION
+		|| (encoding != NEWS_CACHE_PLAIN && encoding != NEWS_CACHE_ZLIB)) {
+		wxLogDebug(_T("News cache %s is unsupported or corrupt, ignoring it."),
+			file.GetFullPath().c_str());
+		return;
+	}
+
+	wxInputStream* body = &stream;
+	if (encoding == NEWS_CACHE_ZLIB) {
+#if wxUSE_ZLIB
+		body = new wxZlibInputStream(stream, wxZLIB_ZLIB);
+#else
+		wxLogDebug(_T("News cache %s is compressed, which this build cannot read, ignoring it."),
+			file.GetFullPath().c_str());
+		return;
+#endif
+	}
+	{
+		wxDataInputStream in(*body, wxConvUTF8);
+
+		const wxUint32 count = std::min(in.Read32(), MAX_NEWS_CACHE_ENTRIES);
+		for (wxUint32 i = 0; i < count; i++) {
+			NewsData data;
+			const wxString newsSource(in.ReadString());
+			data.theNews = in.ReadString();
+			data.lastDownloadNews = wxDateTime(wxLongLong(static_cast<wxLongLong_t>(in.Read64())));
+			if (!body->IsOk()) {
+				wxLogDebug(_T("News cache %s is truncated, keeping the entries before the end."),
+					file.GetFullPath().c_str());
+				break;
+			}
+			if (!newsSource.IsEmpty() && data.IsValid()) {
+				this->news[newsSource] = data;
+			}
+		}
+	}
+	if (body != &stream) {
+		delete body;
+	}
+
+	wxLogDebug(_T("Loaded ") SZT _T(" entries from news cache %s"),
+		this->news.size(), file.GetFullPath().c_str());
+}
+
+void NewsCache::Save(ProfileWriter& writer) {
+	if (!this->dirty) {
+		return;
+	}
+
+	wxMemoryOutputStream stream;
+	{
+		wxDataOutputStream header(stream, wxConvUTF8);
+
+		header.WriteString(NEWS_CACHE_MAGIC);
+		header.Write32(NEWS_CACHE_VERSION);
+#if wxUSE_ZLIB
+		header.Write8(NEWS_CACHE_ZLIB);
+		wxZlibOutputStream body(stream, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB);
+#else
+		header.Write8(NEWS_CACHE_PLAIN);
+		wxOutputStream& body = stream;
+#endif
+		wxDataOutputStream out(body, wxConvUTF8);
+
+		out.Write32(static_cast<wxUint32>(this->news.size()));
+		for (NewsMap::const_iterator it = this->news.begin(); it != this->news.end(); ++it) {
+			out.WriteString(it->first);
+			out.WriteString(it->second.theNews);
+			out.Write64(static_cast<wxUint64>(it->second.lastDownloadNews.GetValue().GetValue()));
+		}
+
+#if wxUSE_ZLIB
+		body.Close(); // writes the end of the compressed data
+#endif
+	}
+	std::vector<char> contents(stream.GetSize());
+	if (!contents.empty()) {
+		stream.CopyTo(&contents[0], contents.size());
+	}
+
+	// other launchers write the cache as well, so it goes through the writer,
+	// which writes it under the profile folder lock
+	writer.SaveContents(contents, GetCacheFile().GetFullPath(), wxEmptyString, true);
+	this->dirty = false;
+	wxLogDebug(_T("Queued ") SZT _T(" entries to be saved to news cache %s"),
+		this->news.size(), GetCacheFile().GetFullPath().c_str());
+}
@@ -0,0 +1,69 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef NEWSCACHE_H
+#define NEWSCACHE_H
+
+#include <wx/wx.h>
+#include <wx/filename.h>
+
+class ProfileWriter;
+
+/** Stores data about downloaded news. */
+struct NewsData {
+	NewsData() { } // required for wxHashMap, unfortunately
+	NewsData(const wxString& theNews, const wxDateTime& lastDownloadNews);
+	bool IsValid() const { return (!theNews.IsEmpty()) && lastDownloadNews.IsValid(); }
+	wxString theNews;
+	wxDateTime lastDownloadNews;
+};
+
+/** Maps a news source by name to the locally stored data on it. */
+WX_DECLARE_STRING_HASH_MAP(NewsData, NewsMap);
+
+/** The news that has been downloaded, kept in its own file in the profile
+ storage folder rather than in the global profile, so that the global profile
+ only holds settings. The file is only read when the news is first asked for,
+ and only written if the news has changed. Where zlib is available the file is
+ compressed; either kind of file can be read. */
+class NewsCache {
+public:
+	NewsCache();
+
+	/** Returns NULL if there is no valid news from newsSource. */
+	const NewsData* Read(const wxString& newsSource);
+	void Write(const wxString& newsSource, const NewsData& data);
+
+	/** Queues the cache to be written by writer if it has changed.
+	 Call MarkUnsaved() if the writer could not write it. */
+	void Save(ProfileWriter& writer);
+	void MarkUnsaved() { this->dirty = true; }
+	/** Returns true if the cache has changed since it was last saved. */
+	bool IsUnsaved() const { return this->dirty; }
+
+	static wxFileName GetCacheFile();
+
+private:
+	void Load();
+
+	NewsMap news;
+	bool loaded;
+	bool dirty; //!< has changed since it was loaded or last saved
+};
+
+#endif
@@ -0,0 +1,248 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "generated/configure_launcher.h"
+#include "datastructures/ProfileIndex.h"
+#include "apis/ProfileWriter.h"
+#include "global/ProfileKeys.h"
+#include "global/Utils.h"
+
+#include <wx/datstrm.h>
+#include <wx/dir.h>
+#include <wx/fileconf.h>
+#include <wx/filefn.h>
+#include <wx/mstream.h>
+#include <wx/wfstream.h>
+
+#if IS_WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif
+
+#include "global/MemoryDebugging.h"
+
+#define PROFILE_INDEX_FILE_NAME	_T("profileindex.dat")
+#define PROFILE_INDEX_MAGIC		_T("wxLauncher profile index")
+/** Increment whenever the layout of an entry changes. */
+const wxUint32 PROFILE_INDEX_VERSION = 2;
+/** Sanity limit so that a corrupt index cannot cause huge allocations.
+ Profile files are numbered with five digits. */
+const wxUint32 MAX_PROFILE_INDEX_ENTRIES = 100000;
+
+/** Returns the modification time of the file or folder at path, of which stat
+ is the result of wxStat(), in nanoseconds, as a string. A stamp in whole
+ seconds would not tell apart two saves made within the same second. Stamps
+ are only compared with each other, so on Windows they count from 1601. */
+static wxString GetModificationStamp(const wxString& path, const wxStructStat& stat) {
+	const wxLongLong NANOSECONDS_PER_SECOND(1000000000);
+#if IS_WIN32
+	// wxStat() only has whole seconds on Windows
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (::GetFileAttributesExW(path.wc_str(), GetFileExInfoStandard, &data)) {
+		const wxLongLong ticks(static_cast<long>(data.ftLastWriteTime.dwHighDateTime),
+			static_cast<unsigned long>(data.ftLastWriteTime.dwLowDateTime));
+		return (ticks * 100).ToString(); // FILETIME counts 100 ns ticks
+	}
+	return (wxLongLong(static_cast<wxLongLong_t>(stat.st_mtime)) * NANOSECONDS_PER_SECOND).ToString();
+#else
+	wxUnusedVar(path);
+#if IS_APPLE
+	const long nanoseconds = stat.st_mtimespec.tv_nsec;
+#else
+	const long nanoseconds = stat.st_mtim.tv_nsec;
+#endif
+	return (wxLongLong(static_cast<wxLongLong_t>(stat.st_mtime)) * NANOSECONDS_PER_SECOND
+		+ nanoseconds).ToString();
+#endif
+}
+
+// wxFileName logs when it cannot read the times of a file,
+// and ProfileWriter's worker thread must not log
+bool ProfileIndexEntry::ReadFileStat(const wxString& filePath) {
+	wxStructStat stat;
+	if (wxStat(filePath, &stat) != 0 || (stat.st_mode & S_IFMT) != S_IFREG) {
+		return false;
+	}
+
+	this->filePath = filePath;
+	this->fileSize = wxULongLong(static_cast<wxULongLong_t>(stat.st_size)).ToString();
+	this->fileMtime = GetModificationStamp(filePath, stat);
+	return true;
+}
+
+bool ProfileIndexEntry::IsUpToDate() const {
+	ProfileIndexEntry current;
+	return current.ReadFileStat(this->filePath) && current.HasSameStat(*this);
+}
+
+ProfileIndex::ProfileIndex(): dirty(false) {
+}
+
+wxFileName ProfileIndex::GetIndexFile() {
+	return wxFileName(GetProfileStorageFolder(), PROFILE_INDEX_FILE_NAME);
+}
+
+wxString ProfileIndex::GetFolderStamp(const wxString& folder) {
+	wxStructStat stat;
+	if (wxStat(folder, &stat) != 0) {
+		return wxEmptyString;
+	}
+	return GetModificationStamp(folder, stat);
+}
+
+bool ProfileIndex::Load() {
+	this->entries.clear();
+	this->dirty = false;
+
+	wxFileName file(GetIndexFile());
+	if (!file.FileExists()) {
+		wxLogDebug(_T("No profile index at %s"), file.GetFullPath().c_str());
+		return false;
+	}
+
+	wxFFileInputStream stream(file.GetFullPath());
+	if (!stream.IsOk()) {
+		wxLogDebug(_T("Unable to open profile index %s"), file.GetFullPath().c_str());
+		return false;
+	}
+	wxDataInputStream in(stream, wxConvUTF8);
+
+	const wxString magic(in.ReadString());
+	const wxUint32 version = in.Read32();
+	const wxUint32 count = in.Read32();
+	if (!stream.IsOk() || magic != PROFILE_INDEX_MAGIC
+		|| version != PROFILE_INDEX_VERSION || count > MAX_PROFILE_INDEX_ENTRIES) {
+		wxLogDebug(_T("Profile index %s is unsupported or corrupt, ignoring it."),
+			file.GetFullPath().c_str());
+		return false;
+	}
+
+	for (wxUint32 i = 0; i < count; i++) {
+		ProfileIndexEntry entry;
+		entry.name = in.ReadString();
+		entry.filePath = in.ReadString();
+		entry.fileSize = in.ReadString();
+		entry.fileMtime = in.ReadString();
+		if (!stream.IsOk() || entry.filePath.IsEmpty()) {
+			wxLogDebug(_T("Profile index %s is truncated, ignoring it."),
+				file.GetFullPath().c_str());
+			this->entries.clear();
+			return false;
+		}
+		this->entries[entry.filePath] = entry;
+	}
+
+	wxLogDebug(_T("Loaded ") SZT _T(" entries from profile index %s"),
+		this->entries.size(), file.GetFullPath().c_str());
+	return true;
+}
+
+void ProfileIndex::Save(ProfileWriter& writer) {
+	if (!this->dirty) {
+		return;
+	}
+
+	wxMemoryOutputStream stream;
+	{
+		wxDataOutputStream out(stream, wxConvUTF8);
+
+		out.WriteString(PROFILE_INDEX_MAGIC);
+		out.Write32(PROFILE_INDEX_VERSION);
+		out.Write32(static_cast<wxUint32>(this->entries.size()));
+		for (ProfileIndexEntries::const_iterator it = this->entries.begin();
+			 it != this->entries.end(); ++it) {
+			out.WriteString(it->second.name);
+			out.WriteString(it->second.filePath);
+			out.WriteString(it->second.fileSize);
+			out.WriteString(it->second.fileMtime);
+		}
+	}
+	std::vector<char> contents(stream.GetSize());
+	if (!contents.empty()) {
+		stream.CopyTo(&contents[0], contents.size());
+	}
+
+	// other launchers write the index as well, so it goes through the writer,
+	// which writes it under the profile folder lock
+	writer.SaveContents(contents, GetIndexFile().GetFullPath(), wxEmptyString, true);
+	this->dirty = false;
+	wxLogDebug(_T("Queued ") SZT _T(" entries to be saved to profile index %s"),
+		this->entries.size(), GetIndexFile().GetFullPath().c_str());
+}
+
+void ProfileIndex::Refresh() {
+	wxArrayString foundProfiles;
+	wxDir::GetAllFiles(GetProfileStorageFolder(), &foundProfiles, _T("pro?????.ini"), wxDIR_FILES);
+	foundProfiles.Sort();
+
+	ProfileIndexEntries found;
+	size_t parsed = 0;
+	for (size_t i = 0; i < foundProfiles.GetCount(); i++) {
+		ProfileIndexEntries::const_iterator it = this->entries.find(foundProfiles[i]);
+		if (it != this->entries.end() && it->second.IsUpToDate()) {
+			found[foundProfiles[i]] = it->second;
+			continue;
+		}
+
+		ProfileIndexEntry entry;
+		if (!entry.ReadFileStat(foundProfiles[i])) {
+			continue;
+		}
+		wxLogDebug(_T("  Indexing %s"), foundProfiles[i].c_str());
+		wxFFileInputStream instream(foundProfiles[i]);
+		wxFileConfig config(instream);
+		config.Read(PRO_CFG_MAIN_NAME.GetPath(), &entry.name, wxString::Format(_T("Profile %05lu"),
+			static_cast<unsigned long>(i)));
+		found[foundProfiles[i]] = entry;
+		parsed++;
+	}
+
+	if (parsed > 0 || found.size() != this->entries.size()) {
+		this->entries = found;
+		this->dirty = true;
+	}
+	wxLogDebug(_T("Profile index has ") SZT _T(" profile(s), ") SZT _T(" of them parsed again"),
+		this->entries.size(), parsed);
+}
+
+void ProfileIndex::Put(const wxString& name, const wxString& filePath) {
+	ProfileIndexEntry entry;
+	if (!entry.ReadFileStat(filePath)) {
+		wxLogDebug(_T("Unable to index profile file %s"), filePath.c_str());
+		this->Remove(filePath);
+		return;
+	}
+	entry.name = name;
+	this->entries[filePath] = entry;
+	this->dirty = true;
+}
+
+void ProfileIndex::Put(const wxString& name, const ProfileIndexEntry& stat) {
+	ProfileIndexEntry entry(stat);
+	entry.name = name;
+	this->entries[entry.filePath] = entry;
+	this->dirty = true;
+}
+
+void ProfileIndex::Remove(const wxString& filePath) {
+	ProfileIndexEntries::iterator it = this->entries.find(filePath);
+	if (it != this->entries.end()) {
+		this->entries.erase(it);
+		this->dirty = true;
+	}
+}
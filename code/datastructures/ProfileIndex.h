@@ -0,0 +1,90 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef PROFILEINDEX_H
+#define PROFILEINDEX_H
+
+#include <wx/wx.h>
+#include <wx/filename.h>
+
+class ProfileWriter;
+
+/** What the profile index knows about one profile file. */
+class ProfileIndexEntry {
+public:
+	/** Records the size and modification time of the profile file.
+	 Does not log, so it can be used on any thread. */
+	bool ReadFileStat(const wxString& filePath);
+	/** Returns true if the profile file has not changed since the entry was made. */
+	bool IsUpToDate() const;
+	/** Returns true if other has the same size and modification time. */
+	bool HasSameStat(const ProfileIndexEntry& other) const {
+		return this->fileSize == other.fileSize && this->fileMtime == other.fileMtime;
+	}
+
+	wxString name; //!< the profile's name, from its main/name entry
+	wxString filePath;
+	wxString fileSize; //!< size in bytes, as a string
+	wxString fileMtime; //!< in nanoseconds, as a string; see ReadFileStat()
+};
+
+/** Entries keyed by the full path of the profile file. */
+WX_DECLARE_STRING_HASH_MAP(ProfileIndexEntry, ProfileIndexEntries);
+
+/** Persistent index of the profile files in the profile storage folder, so that
+ the names of the profiles are known without parsing every profile on startup.
+ An entry is only used while the size and modification time of its file still
+ match; other files are parsed again when the index is refreshed. */
+class ProfileIndex {
+public:
+	ProfileIndex();
+
+	/** Reads the index from disk. A missing or unreadable index is treated as empty. */
+	bool Load();
+	/** Queues the index to be written by writer if it has changed.
+	 Call MarkUnsaved() if the writer could not write it. */
+	void Save(ProfileWriter& writer);
+	void MarkUnsaved() { this->dirty = true; }
+
+	/** Brings the index up to date with the profile files in the profile storage
+	 folder. Entries of files that are gone are removed, and files that are new or
+	 have changed are parsed to read their names. */
+	void Refresh();
+
+	/** Adds or replaces the entry for the profile file at filePath,
+	 such as after the file has been written. */
+	void Put(const wxString& name, const wxString& filePath);
+	/** Adds or replaces the entry for the profile file that stat was read from,
+	 such as when the file has changed since then. */
+	void Put(const wxString& name, const ProfileIndexEntry& stat);
+	/** Removes the entry for the profile file at filePath, if there is one. */
+	void Remove(const wxString& filePath);
+
+	inline const ProfileIndexEntries& GetEntries() const { return this->entries; }
+
+	static wxFileName GetIndexFile();
+	/** Returns a string that changes whenever files are added to, removed from
+	 or replaced in folder. Does not log, so it can be used on any thread. */
+	static wxString GetFolderStamp(const wxString& folder);
+
+private:
+	ProfileIndexEntries entries;
+	bool dirty; //!< has changed since it was loaded or last saved
+};
+
+#endif
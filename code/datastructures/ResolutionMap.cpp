@@ -45,6 +45,13 @@ void ResolutionMap::ResolutionWrite(const wxString& shortname, const ResolutionD
 	GenerateResolutionMapChanged();
 }
 
+void ResolutionMap::ResolutionErase(const wxString& shortname) {
+	if (prefResMap.erase(shortname) > 0) {
+		wxLogDebug(_T("Erased resolution for mod %s"), shortname.c_str());
+		GenerateResolutionMapChanged();
+	}
+}
+
 bool ResolutionMap::HasEntryForActiveMod() {
 	const ModItem* activeMod = ModList::GetActiveMod();
 	wxCHECK_MSG(activeMod != NULL, false,
@@ -25,9 +25,9 @@
 #include "global/ModDefaults.h"
 #include "apis/EventHandlers.h"
 
-/** Maps a mod shortname to its user-preferred resolution. */
-// TODO FIXME: Once the refresh button for the mod list is added,
-// then this map will need to be cleared whenever the user presses the button.
+/** Maps a mod shortname to its user-preferred resolution.
+ The mod list erases a mod's entry when the mod's mod.ini changes or the mod
+ is removed, since the mod's minimum resolution may no longer be the same. */
 
 /** ResolutionMap has changed. */
 LAUNCHER_DECLARE_EVENT_TYPE(EVT_RESOLUTION_MAP_CHANGED);
@@ -51,6 +51,7 @@ class ResolutionMap {
 public:
 	static const ResolutionData* ResolutionRead(const wxString& shortname);
 	static void ResolutionWrite(const wxString& shortname, const ResolutionData& resData);
+	static void ResolutionErase(const wxString& shortname);
 	static bool HasEntryForActiveMod();
 	
 	static void RegisterResolutionMapChanged(wxEvtHandler *handler);
@@ -0,0 +1,362 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "generated/configure_launcher.h"
+#include "datastructures/ThumbnailCache.h"
+#include "global/ProfileKeys.h"
+#include "global/Utils.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <wx/datstrm.h>
+#include <wx/dir.h>
+#include <wx/filefn.h>
+#include <wx/mstream.h>
+#include <wx/thread.h>
+
+#include "global/MemoryDebugging.h"
+
+#define THUMBNAIL_CACHE_FOLDER_NAME	_T("thumbnails")
+/** "wxLT" */
+const wxUint32 THUMBNAIL_MAGIC = 0x544C7877;
+/** Increment whenever the layout of a thumbnail file changes. */
+const wxUint32 THUMBNAIL_VERSION = 1;
+/** Sanity limit so that a corrupt thumbnail cannot cause huge allocations. */
+const wxUint32 MAX_THUMBNAIL_DIMENSION = 4096;
+
+const wxUint32 THUMBNAIL_HAS_ALPHA = 1;
+const wxUint32 THUMBNAIL_HAS_MASK = 2;
+
+/** Enough for the images of about three hundred mods. */
+const size_t ThumbnailCache::DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+/** The part of the entry names that is the same for all thumbnails of the
+ image at sourcePath, whatever its contents. */
+static wxString GetPathHash(const wxString& sourcePath) {
+	const wxCharBuffer path(sourcePath.utf8_str());
+	return HashUtils::HashBuffer(path.data(), strlen(path.data()));
+}
+
+static wxString GetEntryPath(const wxString& cacheFolder, const wxString& sourceHash,
+		const wxSize& size, ThumbnailCache::Fit fit) {
+	return wxString::Format(_T("%s%c%s-%dx%d-%d.thumb"),
+		cacheFolder.c_str(), wxFileName::GetPathSeparator(), sourceHash.c_str(),
+		size.GetWidth(), size.GetHeight(), static_cast<int>(fit));
+}
+
+// Thumbnails are read and written on ModImageCache's worker threads, where
+// nothing may be logged, so files are accessed through the C library rather
+// than wxFFile, which logs its failures.
+
+/** Reads the whole file at path into contents. */
+static bool ReadWholeFile(const wxString& path, std::vector<char>& contents) {
+	FILE* file = wxFopen(path, _T("rb"));
+	if (file == NULL) {
+		return false;
+	}
+	contents.clear();
+	char buffer[64*1024];
+	size_t bytesRead;
+	do {
+		bytesRead = fread(buffer, 1, sizeof(buffer), file);
+		contents.insert(contents.end(), buffer, buffer + bytesRead);
+	} while (bytesRead == sizeof(buffer));
+	const bool ok = (ferror(file) == 0);
+	fclose(file);
+	return ok;
+}
+
+/** Writes size bytes at data to a new file at path. */
+static bool WriteWholeFile(const wxString& path, const void* data, size_t size) {
+	FILE* file = wxFopen(path, _T("wb"));
+	if (file == NULL) {
+		return false;
+	}
+	bool ok = (size == 0 || fwrite(data, 1, size, file) == size);
+	ok = (fclose(file) == 0) && ok;
+	if (!ok) {
+		wxRemove(path);
+	}
+	return ok;
+}
+
+wxFileName ThumbnailCache::GetCacheFolder() {
+	wxFileName folder;
+	folder.AssignDir(GetProfileStorageFolder());
+	folder.AppendDir(THUMBNAIL_CACHE_FOLDER_NAME);
+	return folder;
+}
+
+wxString ThumbnailCache::PrepareCacheFolder() {
+	wxFileName folder(GetCacheFolder());
+	if (!folder.DirExists() && !folder.Mkdir(0777, wxPATH_MKDIR_FULL)) {
+		wxLogDebug(_T("Unable to create thumbnail cache folder at %s"),
+			folder.GetFullPath().c_str());
+		return wxEmptyString;
+	}
+	return folder.GetPath();
+}
+
+struct ThumbnailFile {
+	wxString path;
+	time_t mtime;
+	size_t bytes;
+	bool operator<(const ThumbnailFile& other) const { return this->mtime < other.mtime; }
+};
+
+void ThumbnailCache::Trim(const wxString& cacheFolder, size_t maxBytes) {
+	if (cacheFolder.IsEmpty()) {
+		return;
+	}
+	wxArrayString paths;
+	wxDir::GetAllFiles(cacheFolder, &paths, _T("*.thumb"), wxDIR_FILES);
+
+	std::vector<ThumbnailFile> files;
+	size_t totalBytes = 0;
+	for (size_t i = 0; i < paths.GetCount(); i++) {
+		wxStructStat stat;
+		if (wxStat(paths[i], &stat) != 0) {
+			continue;
+		}
+		ThumbnailFile file;
+		file.path = paths[i];
+		file.mtime = stat.st_mtime;
+		file.bytes = static_cast<size_t>(stat.st_size);
+		files.push_back(file);
+		totalBytes += file.bytes;
+	}
+	if (totalBytes <= maxBytes) {
+		return;
+	}
+
+	std::sort(files.begin(), files.end());
+	size_t removed = 0;
+	for (size_t i = 0; i < files.size() && totalBytes > maxBytes; i++) {
+		// a thumbnail that is being read on Windows cannot be removed, which is fine
+		if (wxRemove(files[i].path) == 0) {
+			totalBytes -= files[i].bytes;
+			removed++;
+		}
+	}
+	wxLogDebug(_T("Removed ") SZT _T(" thumbnail(s), ") SZT _T(" bytes are left"),
+		removed, totalBytes);
+}
+
+void ThumbnailCache::Remove(const wxString& cacheFolder, const wxString& sourcePath) {
+	if (cacheFolder.IsEmpty() || sourcePath.IsEmpty()) {
+		return;
+	}
+	wxArrayString paths;
+	wxDir::GetAllFiles(cacheFolder, &paths, GetPathHash(sourcePath) + _T("-*.thumb"), wxDIR_FILES);
+	for (size_t i = 0; i < paths.GetCount(); i++) {
+		wxRemove(paths[i]);
+	}
+	if (!paths.IsEmpty()) {
+		wxLogDebug(_T("Removed ") SZT _T(" thumbnail(s) of %s"),
+			paths.GetCount(), sourcePath.c_str());
+	}
+}
+
+bool ThumbnailCache::Load(const wxString& cacheFolder, const wxString& sourceHash,
+		const wxSize& size, Fit fit, wxImage& image) {
+	if (cacheFolder.IsEmpty() || sourceHash.IsEmpty()) {
+		return false;
+	}
+	std::vector<char> contents;
+	if (!ReadWholeFile(GetEntryPath(cacheFolder, sourceHash, size, fit), contents)
+		|| contents.empty()) {
+		return false;
+	}
+
+	wxMemoryInputStream stream(&contents[0], contents.size());
+	wxDataInputStream in(stream);
+
+	const wxUint32 magic = in.Read32();
+	const wxUint32 version = in.Read32();
+	const wxUint32 width = in.Read32();
+	const wxUint32 height = in.Read32();
+	const wxUint32 flags = in.Read32();
+	if (!stream.IsOk() || magic != THUMBNAIL_MAGIC || version != THUMBNAIL_VERSION
+		|| width == 0 || height == 0
+		|| width > MAX_THUMBNAIL_DIMENSION || height > MAX_THUMBNAIL_DIMENSION) {
+		return false;
+	}
+
+	// only FIT_SHRINK can leave an image smaller than it was asked for
+	const bool sizeOk = (fit == FIT_SHRINK) ?
+		(static_cast<int>(width) <= size.GetWidth() && static_cast<int>(height) <= size.GetHeight()) :
+		(static_cast<int>(width) == size.GetWidth() && static_cast<int>(height) == size.GetHeight());
+	if (!sizeOk) {
+		return false;
+	}
+
+	wxImage loaded(static_cast<int>(width), static_cast<int>(height), false);
+	const size_t pixels = static_cast<size_t>(width) * height;
+	if (!stream.Read(loaded.GetData(), pixels * 3).IsOk() || stream.LastRead() != pixels * 3) {
+		return false;
+	}
+	if ((flags & THUMBNAIL_HAS_ALPHA) != 0) {
+		loaded.SetAlpha();
+		if (!stream.Read(loaded.GetAlpha(), pixels).IsOk() || stream.LastRead() != pixels) {
+			return false;
+		}
+	}
+	if ((flags & THUMBNAIL_HAS_MASK) != 0) {
+		const wxUint8 red = in.Read8();
+		const wxUint8 green = in.Read8();
+		const wxUint8 blue = in.Read8();
+		if (!stream.IsOk()) {
+			return false;
+		}
+		loaded.SetMaskColour(red, green, blue);
+	}
+
+	image = loaded;
+	return true;
+}
+
+bool ThumbnailCache::Store(const wxString& cacheFolder, const wxString& sourceHash,
+		const wxSize& size, Fit fit, const wxImage& image) {
+	if (cacheFolder.IsEmpty() || sourceHash.IsEmpty() || !image.IsOk()) {
+		return false;
+	}
+
+	// several threads may store the same thumbnail, as when mods share an image,
+	// so each writes its own temporary file and the last rename wins
+	const wxString entryPath(GetEntryPath(cacheFolder, sourceHash, size, fit));
+	const wxString tempPath(entryPath + wxString::Format(_T(".%lu.tmp"),
+		static_cast<unsigned long>(wxThread::GetCurrentId())));
+
+	wxMemoryOutputStream stream;
+	{
+		wxDataOutputStream out(stream);
+
+		const size_t pixels = static_cast<size_t>(image.GetWidth()) * image.GetHeight();
+		const wxUint32 flags = (image.HasAlpha() ? THUMBNAIL_HAS_ALPHA : 0)
+			| (image.HasMask() ? THUMBNAIL_HAS_MASK : 0);
+		out.Write32(THUMBNAIL_MAGIC);
+		out.Write32(THUMBNAIL_VERSION);
+		out.Write32(static_cast<wxUint32>(image.GetWidth()));
+		out.Write32(static_cast<wxUint32>(image.GetHeight()));
+		out.Write32(flags);
+		stream.Write(image.GetData(), pixels * 3);
+		if (image.HasAlpha()) {
+			stream.Write(image.GetAlpha(), pixels);
+		}
+		if (image.HasMask()) {
+			out.Write8(image.GetMaskRed());
+			out.Write8(image.GetMaskGreen());
+			out.Write8(image.GetMaskBlue());
+		}
+	}
+	const wxStreamBuffer* buffer = stream.GetOutputStreamBuffer();
+	if (!stream.IsOk() || !WriteWholeFile(tempPath, buffer->GetBufferStart(), stream.GetSize())) {
+		return false;
+	}
+
+	// rename() does not replace an existing file on Windows
+	if (wxRename(tempPath, entryPath) != 0
+		&& (wxRemove(entryPath) != 0 || wxRename(tempPath, entryPath) != 0)) {
+		wxRemove(tempPath);
+		return false;
+	}
+	return true;
+}
+
+ThumbnailSource::ThumbnailSource(const wxString& path, const wxString& cacheFolder)
+: path(path), cacheFolder(cacheFolder), hashed(false), decoded(false),
+sourceSize(wxDefaultSize) {
+}
+
+bool ThumbnailSource::GetImage(const wxSize& size, ThumbnailCache::Fit fit, wxImage& image) {
+	image = wxImage();
+	if (this->path.IsEmpty()) {
+		return false;
+	}
+
+	if (!this->cacheFolder.IsEmpty() && !this->hashed) {
+		const wxString contentHash(HashUtils::HashFileContents(this->path));
+		if (!contentHash.IsEmpty()) {
+			this->hash = GetPathHash(this->path) + _T("-") + contentHash;
+		}
+		this->hashed = true;
+	}
+	if (ThumbnailCache::Load(this->cacheFolder, this->hash, size, fit, image)) {
+		return true;
+	}
+
+	if (!this->Decode()) {
+		return false;
+	}
+
+	const bool fits = (this->sourceSize == size)
+		|| (fit == ThumbnailCache::FIT_SHRINK
+			&& this->sourceSize.GetWidth() <= size.GetWidth()
+			&& this->sourceSize.GetHeight() <= size.GetHeight());
+	if (fits) {
+		image = this->source;
+	} else if (fit == ThumbnailCache::FIT_EXACT) {
+		return false;
+	} else {
+		image = this->source.Scale(size.GetWidth(), size.GetHeight(), wxIMAGE_QUALITY_HIGH);
+	}
+
+	ThumbnailCache::Store(this->cacheFolder, this->hash, size, fit, image);
+	return true;
+}
+
+/** Decodes the source with the first image handler that recognizes it.
+ wxImage::LoadFile() would have the handler log its errors, so the handler is
+ called directly with verbose off and the failure is kept in error instead. */
+bool ThumbnailSource::Decode() {
+	if (this->decoded) {
+		return this->source.IsOk();
+	}
+	this->decoded = true;
+
+	std::vector<char> contents;
+	if (!ReadWholeFile(this->path, contents) || contents.empty()) {
+		this->error = _T("the file cannot be read");
+		return false;
+	}
+	wxMemoryInputStream stream(&contents[0], contents.size());
+
+	wxImageHandler* handler = NULL;
+	for (wxList::compatibility_iterator node = wxImage::GetHandlers().GetFirst();
+		 node != NULL; node = node->GetNext()) {
+		wxImageHandler* current = static_cast<wxImageHandler*>(node->GetData());
+		if (current->CanRead(stream)) {
+			handler = current;
+			break;
+		}
+	}
+	if (handler == NULL) {
+		this->error = _T("the file is not in a known image format");
+		return false;
+	}
+
+	if (!handler->LoadFile(&this->source, stream, false) || !this->source.IsOk()) {
+		this->source = wxImage();
+		this->error = wxString::Format(_T("the file is not a valid %s image"),
+			handler->GetName().c_str());
+		return false;
+	}
+	this->sourceSize = this->source.GetSize();
+	return true;
+}
@@ -0,0 +1,98 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <wx/wx.h>
+#include <wx/filename.h>
+
+/** Stores mod and skin images as the pixels that the launcher ends up using,
+ so that an image does not have to be decoded and scaled again until the file
+ changes. Entries are keyed by hashes of the source file's path and contents
+ and by the size and fit they were made for.
+
+ Failures are reported by returning false rather than by logging, so that
+ these can be used on worker threads once the cache folder has been prepared
+ on the main thread. */
+namespace ThumbnailCache {
+	/** What to do with a source image that is not the requested size. */
+	enum Fit {
+		FIT_EXACT,  //!< reject it
+		FIT_SHRINK, //!< scale it down if it is larger, otherwise use it as is
+		FIT_SCALE   //!< scale it to the requested size
+	};
+
+	/** Returns the folder in which the thumbnails are stored. */
+	wxFileName GetCacheFolder();
+	/** Creates the cache folder if it does not exist yet. Returns its path,
+	 or an empty string if it could not be created. Call on the main thread. */
+	wxString PrepareCacheFolder();
+
+	/** Default bound on the total size of the stored thumbnails. */
+	extern const size_t DEFAULT_MAX_BYTES;
+
+	/** Removes the oldest thumbnails until the rest fit in maxBytes.
+	 Call on the main thread. */
+	void Trim(const wxString& cacheFolder, size_t maxBytes = DEFAULT_MAX_BYTES);
+	/** Removes the thumbnails of the image at sourcePath, such as when the mod
+	 that used it is gone. Call on the main thread. */
+	void Remove(const wxString& cacheFolder, const wxString& sourcePath);
+
+	/** Sets image to the stored thumbnail. Returns false if there is none. */
+	bool Load(const wxString& cacheFolder, const wxString& sourceHash,
+		const wxSize& size, Fit fit, wxImage& image);
+	/** Stores image as the thumbnail of the source at size with fit. */
+	bool Store(const wxString& cacheFolder, const wxString& sourceHash,
+		const wxSize& size, Fit fit, const wxImage& image);
+}
+
+/** An image file that is read through the thumbnail cache.
+ The file is only hashed and decoded when it is needed, and then only once,
+ so asking for several sizes of the same image is cheap. */
+class ThumbnailSource {
+public:
+	/** cacheFolder is from ThumbnailCache::PrepareCacheFolder().
+	 If it is empty, images are always decoded. */
+	ThumbnailSource(const wxString& path, const wxString& cacheFolder);
+
+	/** Sets image to the source at size, applying fit.
+	 Returns false if the source cannot be decoded, or if fit is FIT_EXACT and
+	 the source is a different size. */
+	bool GetImage(const wxSize& size, ThumbnailCache::Fit fit, wxImage& image);
+
+	/** The size of the decoded source, or wxDefaultSize if it could not be
+	 decoded. Only meaningful after GetImage() returned false. */
+	wxSize GetSourceSize() const { return this->sourceSize; }
+	/** Why the source could not be decoded, for the user. */
+	const wxString& GetError() const { return this->error; }
+
+private:
+	bool Decode();
+
+	wxString path;
+	wxString cacheFolder;
+	wxString hash; //!< of path and contents; empty until needed or if the file cannot be read
+	bool hashed;
+	wxImage source;
+	bool decoded;
+	wxSize sourceSize;
+	wxString error; //!< empty unless decoding failed
+};
+
+#endif
@@ -19,61 +19,66 @@
 #include "ProfileKeys.h"
 
 // Global profile keys and constants
-const wxString GBL_CFG_MAIN_AUTOSAVEPROFILES	(_T("/main/autosaveprofiles"));
-const wxString GBL_CFG_MAIN_LASTPROFILE			(_T("/main/lastprofile"));
+const GlobalKey<bool> GBL_CFG_MAIN_AUTOSAVEPROFILES			(GBL_MAIN_AUTOSAVEPROFILES_ID, _T("/main/autosaveprofiles"));
+const GlobalKey<wxString> GBL_CFG_MAIN_LASTPROFILE			(GBL_MAIN_LASTPROFILE_ID, _T("/main/lastprofile"));
+const GlobalKey<long> GBL_CFG_MAIN_UNDODEPTH				(GBL_MAIN_UNDODEPTH_ID, _T("/main/undodepth"));
 
-const wxString GBL_CFG_PROXY_TYPE				(_T("/proxy/type"));
-const wxString GBL_CFG_PROXY_SERVER				(_T("/proxy/server"));
-const wxString GBL_CFG_PROXY_PORT				(_T("/proxy/port"));
+const GlobalKey<wxString> GBL_CFG_PROXY_TYPE				(GBL_PROXY_TYPE_ID, _T("/proxy/type"));
+const GlobalKey<wxString> GBL_CFG_PROXY_SERVER				(GBL_PROXY_SERVER_ID, _T("/proxy/server"));
+const GlobalKey<long> GBL_CFG_PROXY_PORT					(GBL_PROXY_PORT_ID, _T("/proxy/port"));
 
 const wxString GBL_CFG_NET_FOLDER				(_T("/net"));
-const wxString GBL_CFG_NET_DOWNLOAD_NEWS		(_T("/net/downloadnews"));
+const GlobalKey<bool> GBL_CFG_NET_DOWNLOAD_NEWS				(GBL_NET_DOWNLOAD_NEWS_ID, _T("/net/downloadnews"));
 const wxString NEWS_LAST_TIME_FORMAT			(_T("%Y %j %H %M %S"));
 const wxString GBL_CFG_NET_NEWS_LAST_TIME		(_T("lastdownloadnews"));
 const wxString GBL_CFG_NET_THE_NEWS				(_T("thenews"));
 
-const wxString GBL_CFG_OPT_CONFIG_FRED			(_T("/opt/configfred"));
+const GlobalKey<bool> GBL_CFG_OPT_CONFIG_FRED				(GBL_OPT_CONFIG_FRED_ID, _T("/opt/configfred"));
+const GlobalKey<long> GBL_CFG_OPT_FLAG_PROBE_TIMEOUT		(GBL_OPT_FLAG_PROBE_TIMEOUT_ID, _T("/opt/flagprobetimeout"));
+
+const GlobalKey<wxString> GBL_CFG_PUSHED_FSO_INI			(GBL_PUSHED_FSO_INI_ID, _T("/pushed/fs2openini"));
+const GlobalKey<wxString> GBL_CFG_PUSHED_CMDLINE			(GBL_PUSHED_CMDLINE_ID, _T("/pushed/cmdlinefso"));
 
 // Profile keys and constants
-const wxString PRO_CFG_MAIN_NAME				(_T("/main/name"));
-const wxString PRO_CFG_MAIN_FILENAME			(_T("/main/filename"));
-const wxString PRO_CFG_MAIN_INITIALIZED			(_T("/main/initialized"));
+const ProfileKey<wxString> PRO_CFG_MAIN_NAME				(PRO_MAIN_NAME_ID, _T("/main/name"));
+const ProfileKey<wxString> PRO_CFG_MAIN_FILENAME			(PRO_MAIN_FILENAME_ID, _T("/main/filename"));
+const ProfileKey<bool> PRO_CFG_MAIN_INITIALIZED				(PRO_MAIN_INITIALIZED_ID, _T("/main/initialized"));
 
-const wxString PRO_CFG_TC_ROOT_FOLDER			(_T("/tc/folder"));
-const wxString PRO_CFG_TC_CURRENT_BINARY		(_T("/tc/currentbinary"));
-const wxString PRO_CFG_TC_CURRENT_MODLINE		(_T("/tc/currentmodline"));
-const wxString PRO_CFG_TC_CURRENT_MOD			(_T("/tc/currentmod"));
-const wxString PRO_CFG_TC_CURRENT_FLAG_LINE		(_T("/tc/flags"));
-const wxString PRO_CFG_TC_CURRENT_FRED			(_T("/tc/currentfred"));
+const ProfileKey<wxString> PRO_CFG_TC_ROOT_FOLDER			(PRO_TC_ROOT_FOLDER_ID, _T("/tc/folder"));
+const ProfileKey<wxString> PRO_CFG_TC_CURRENT_BINARY		(PRO_TC_CURRENT_BINARY_ID, _T("/tc/currentbinary"));
+const ProfileKey<wxString> PRO_CFG_TC_CURRENT_MODLINE		(PRO_TC_CURRENT_MODLINE_ID, _T("/tc/currentmodline"));
+const ProfileKey<wxString> PRO_CFG_TC_CURRENT_MOD			(PRO_TC_CURRENT_MOD_ID, _T("/tc/currentmod"));
+const ProfileKey<wxString> PRO_CFG_TC_CURRENT_FLAG_LINE		(PRO_TC_CURRENT_FLAG_LINE_ID, _T("/tc/flags"));
+const ProfileKey<wxString> PRO_CFG_TC_CURRENT_FRED			(PRO_TC_CURRENT_FRED_ID, _T("/tc/currentfred"));
 
-const wxString PRO_CFG_VIDEO_RESOLUTION_WIDTH	(_T("/video/width"));
-const wxString PRO_CFG_VIDEO_RESOLUTION_HEIGHT	(_T("/video/height"));
+const ProfileKey<long> PRO_CFG_VIDEO_RESOLUTION_WIDTH		(PRO_VIDEO_RESOLUTION_WIDTH_ID, _T("/video/width"));
+const ProfileKey<long> PRO_CFG_VIDEO_RESOLUTION_HEIGHT		(PRO_VIDEO_RESOLUTION_HEIGHT_ID, _T("/video/height"));
 const wxString CFG_RES_FORMAT_STRING			(_T("%d x %d"));
-const wxString PRO_CFG_VIDEO_BIT_DEPTH			(_T("/video/depth"));
-const wxString PRO_CFG_VIDEO_ANISOTROPIC		(_T("/video/anisotropic"));
-const wxString PRO_CFG_VIDEO_ANTI_ALIAS			(_T("/video/antialias"));
-const wxString PRO_CFG_VIDEO_TEXTURE_FILTER		(_T("/video/texturefilter"));
+const ProfileKey<long> PRO_CFG_VIDEO_BIT_DEPTH				(PRO_VIDEO_BIT_DEPTH_ID, _T("/video/depth"));
+const ProfileKey<long> PRO_CFG_VIDEO_ANISOTROPIC			(PRO_VIDEO_ANISOTROPIC_ID, _T("/video/anisotropic"));
+const ProfileKey<long> PRO_CFG_VIDEO_ANTI_ALIAS				(PRO_VIDEO_ANTI_ALIAS_ID, _T("/video/antialias"));
+const ProfileKey<wxString> PRO_CFG_VIDEO_TEXTURE_FILTER		(PRO_VIDEO_TEXTURE_FILTER_ID, _T("/video/texturefilter"));
 
-const wxString PRO_CFG_LIGHTING_PRESET			(_T("/lighting/preset"));
+const ProfileKey<wxString> PRO_CFG_LIGHTING_PRESET			(PRO_LIGHTING_PRESET_ID, _T("/lighting/preset"));
 
-const wxString PRO_CFG_SPEECH_VOICE				(_T("/speech/voice"));
-const wxString PRO_CFG_SPEECH_VOLUME			(_T("/speech/volume"));
-const wxString PRO_CFG_SPEECH_IN_TECHROOM		(_T("/speech/intechroom"));
-const wxString PRO_CFG_SPEECH_IN_BRIEFINGS		(_T("/speech/inbriefings"));
-const wxString PRO_CFG_SPEECH_IN_GAME			(_T("/speech/ingame"));
-const wxString PRO_CFG_SPEECH_IN_MULTI			(_T("/speech/inmulti"));
+const ProfileKey<long> PRO_CFG_SPEECH_VOICE					(PRO_SPEECH_VOICE_ID, _T("/speech/voice"));
+const ProfileKey<long> PRO_CFG_SPEECH_VOLUME				(PRO_SPEECH_VOLUME_ID, _T("/speech/volume"));
+const ProfileKey<bool> PRO_CFG_SPEECH_IN_TECHROOM			(PRO_SPEECH_IN_TECHROOM_ID, _T("/speech/intechroom"));
+const ProfileKey<bool> PRO_CFG_SPEECH_IN_BRIEFINGS			(PRO_SPEECH_IN_BRIEFINGS_ID, _T("/speech/inbriefings"));
+const ProfileKey<bool> PRO_CFG_SPEECH_IN_GAME				(PRO_SPEECH_IN_GAME_ID, _T("/speech/ingame"));
+const ProfileKey<bool> PRO_CFG_SPEECH_IN_MULTI				(PRO_SPEECH_IN_MULTI_ID, _T("/speech/inmulti"));
 
-const wxString PRO_CFG_NETWORK_TYPE				(_T("/network/type"));
-const wxString PRO_CFG_NETWORK_SPEED			(_T("/network/speed"));
-const wxString PRO_CFG_NETWORK_PORT				(_T("/network/port"));
-const wxString PRO_CFG_NETWORK_IP				(_T("/network/ip"));
+const ProfileKey<wxString> PRO_CFG_NETWORK_TYPE				(PRO_NETWORK_TYPE_ID, _T("/network/type"));
+const ProfileKey<wxString> PRO_CFG_NETWORK_SPEED			(PRO_NETWORK_SPEED_ID, _T("/network/speed"));
+const ProfileKey<long> PRO_CFG_NETWORK_PORT					(PRO_NETWORK_PORT_ID, _T("/network/port"));
+const ProfileKey<wxString> PRO_CFG_NETWORK_IP				(PRO_NETWORK_IP_ID, _T("/network/ip"));
 
-const wxString PRO_CFG_OPENAL_DEVICE			(_T("/openal/device"));
-const wxString PRO_CFG_OPENAL_CAPTURE_DEVICE	(_T("/openal/capturedevice"));
-const wxString PRO_CFG_OPENAL_EFX				(_T("/openal/efx"));
-const wxString PRO_CFG_OPENAL_SAMPLE_RATE		(_T("/openal/samplerate"));
+const ProfileKey<wxString> PRO_CFG_OPENAL_DEVICE			(PRO_OPENAL_DEVICE_ID, _T("/openal/device"));
+const ProfileKey<wxString> PRO_CFG_OPENAL_CAPTURE_DEVICE	(PRO_OPENAL_CAPTURE_DEVICE_ID, _T("/openal/capturedevice"));
+const ProfileKey<bool> PRO_CFG_OPENAL_EFX					(PRO_OPENAL_EFX_ID, _T("/openal/efx"));
+const ProfileKey<long> PRO_CFG_OPENAL_SAMPLE_RATE			(PRO_OPENAL_SAMPLE_RATE_ID, _T("/openal/samplerate"));
 
-const wxString PRO_CFG_JOYSTICK_ID				(_T("/joystick/id"));
-const wxString PRO_CFG_JOYSTICK_FORCE_FEEDBACK	(_T("/joystick/forcefeedback"));
-const wxString PRO_CFG_JOYSTICK_DIRECTIONAL		(_T("/joystick/directional"));
+const ProfileKey<long> PRO_CFG_JOYSTICK_ID					(PRO_JOYSTICK_ID_ID, _T("/joystick/id"));
+const ProfileKey<bool> PRO_CFG_JOYSTICK_FORCE_FEEDBACK		(PRO_JOYSTICK_FORCE_FEEDBACK_ID, _T("/joystick/forcefeedback"));
+const ProfileKey<bool> PRO_CFG_JOYSTICK_DIRECTIONAL			(PRO_JOYSTICK_DIRECTIONAL_ID, _T("/joystick/directional"));
 /** @}*/
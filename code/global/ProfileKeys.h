@@ -32,68 +32,166 @@ inline const wxString GetProfileStorageFolder() { return wxStandardPaths::Get().
 #define INT_CONFIG_FILE_LOCATION			_T("/wxlauncher/configlocation")	//!< string
 /** @} */
 
+/** \defgroup keytypes Typed keys */
+/** @{*/
+/** Dense ids of the typed keys in the global config file. */
+enum GlobalKeyId {
+	GBL_MAIN_AUTOSAVEPROFILES_ID,
+	GBL_MAIN_LASTPROFILE_ID,
+	GBL_MAIN_UNDODEPTH_ID,
+	GBL_PROXY_TYPE_ID,
+	GBL_PROXY_SERVER_ID,
+	GBL_PROXY_PORT_ID,
+	GBL_NET_DOWNLOAD_NEWS_ID,
+	GBL_OPT_CONFIG_FRED_ID,
+	GBL_OPT_FLAG_PROBE_TIMEOUT_ID,
+	GBL_PUSHED_FSO_INI_ID,
+	GBL_PUSHED_CMDLINE_ID,
+	GLOBAL_KEY_COUNT
+};
+
+/** Dense ids of the typed keys in profiles. */
+enum ProfileKeyId {
+	PRO_MAIN_NAME_ID,
+	PRO_MAIN_FILENAME_ID,
+	PRO_MAIN_INITIALIZED_ID,
+	PRO_TC_ROOT_FOLDER_ID,
+	PRO_TC_CURRENT_BINARY_ID,
+	PRO_TC_CURRENT_MODLINE_ID,
+	PRO_TC_CURRENT_MOD_ID,
+	PRO_TC_CURRENT_FLAG_LINE_ID,
+	PRO_TC_CURRENT_FRED_ID,
+	PRO_VIDEO_RESOLUTION_WIDTH_ID,
+	PRO_VIDEO_RESOLUTION_HEIGHT_ID,
+	PRO_VIDEO_BIT_DEPTH_ID,
+	PRO_VIDEO_ANISOTROPIC_ID,
+	PRO_VIDEO_ANTI_ALIAS_ID,
+	PRO_VIDEO_TEXTURE_FILTER_ID,
+	PRO_LIGHTING_PRESET_ID,
+	PRO_SPEECH_VOICE_ID,
+	PRO_SPEECH_VOLUME_ID,
+	PRO_SPEECH_IN_TECHROOM_ID,
+	PRO_SPEECH_IN_BRIEFINGS_ID,
+	PRO_SPEECH_IN_GAME_ID,
+	PRO_SPEECH_IN_MULTI_ID,
+	PRO_NETWORK_TYPE_ID,
+	PRO_NETWORK_SPEED_ID,
+	PRO_NETWORK_PORT_ID,
+	PRO_NETWORK_IP_ID,
+	PRO_OPENAL_DEVICE_ID,
+	PRO_OPENAL_CAPTURE_DEVICE_ID,
+	PRO_OPENAL_EFX_ID,
+	PRO_OPENAL_SAMPLE_RATE_ID,
+	PRO_JOYSTICK_ID_ID,
+	PRO_JOYSTICK_FORCE_FEEDBACK_ID,
+	PRO_JOYSTICK_DIRECTIONAL_ID,
+	PROFILE_KEY_COUNT
+};
+
+/** A key whose value always has the type T (bool, long or wxString).
+ The id lets ProMan keep the value in a slot of an array instead of looking
+ the path up in the config file on every read; the path is only used when the
+ value is read from or written to the config file. */
+template <typename Id, typename T>
+class TypedConfigKey {
+public:
+	typedef T ValueType;
+	TypedConfigKey(Id id, const wxChar* path): id(id), path(path) { }
+	inline Id GetId() const { return this->id; }
+	/** For code that works on the config files directly, like pushing profiles.
+	 There is deliberately no conversion to wxString, so that a key cannot be
+	 handed to an untyped read or write by accident. */
+	inline const wxString& GetPath() const { return this->path; }
+private:
+	Id id;
+	wxString path;
+};
+
+/** A key in the global config file. Only ProMan's matching Global* overloads take it,
+ so reading or writing a value of the wrong type does not compile. */
+template <typename T>
+class GlobalKey: public TypedConfigKey<GlobalKeyId, T> {
+public:
+	GlobalKey(GlobalKeyId id, const wxChar* path): TypedConfigKey<GlobalKeyId, T>(id, path) { }
+};
+
+/** A key in a profile. Only ProMan's matching Profile* overloads take it,
+ so reading or writing a value of the wrong type does not compile. */
+template <typename T>
+class ProfileKey: public TypedConfigKey<ProfileKeyId, T> {
+public:
+	ProfileKey(ProfileKeyId id, const wxChar* path): TypedConfigKey<ProfileKeyId, T>(id, path) { }
+};
+/** @}*/
+
 /** \defgroup globalkeys Keys used in global config file */
 /** @{*/
-extern const wxString GBL_CFG_MAIN_AUTOSAVEPROFILES;	//!< bool
-extern const wxString GBL_CFG_MAIN_LASTPROFILE;			//!< string, internal profile name
+extern const GlobalKey<bool> GBL_CFG_MAIN_AUTOSAVEPROFILES;				//!< bool
+extern const GlobalKey<wxString> GBL_CFG_MAIN_LASTPROFILE;				//!< string, internal profile name
+extern const GlobalKey<long> GBL_CFG_MAIN_UNDODEPTH;					//!< long, number of changes to the current profile that can be undone
 
-extern const wxString GBL_CFG_PROXY_TYPE;				//!< string
-extern const wxString GBL_CFG_PROXY_SERVER;				//!< string
-extern const wxString GBL_CFG_PROXY_PORT;				//!< int
+extern const GlobalKey<wxString> GBL_CFG_PROXY_TYPE;					//!< string
+extern const GlobalKey<wxString> GBL_CFG_PROXY_SERVER;					//!< string
+extern const GlobalKey<long> GBL_CFG_PROXY_PORT;						//!< long
 
 extern const wxString GBL_CFG_NET_FOLDER;				//!< string (folder name)
-extern const wxString GBL_CFG_NET_DOWNLOAD_NEWS;		//!< bool, true means autodownload
+extern const GlobalKey<bool> GBL_CFG_NET_DOWNLOAD_NEWS;					//!< bool, true means autodownload
 extern const wxString NEWS_LAST_TIME_FORMAT;
-// these two are entries relative to news source folders, not absolute paths
+// these two are entries relative to news source folders, not absolute paths.
+// the news is now kept in the NewsCache, they are only read to move old news there
 extern const wxString GBL_CFG_NET_NEWS_LAST_TIME;		//!< string, formated time as NEWS_LAST_TIME_FORMAT
 extern const wxString GBL_CFG_NET_THE_NEWS;				//!< string, the formatted text (workin' for a livin'!)
 
-extern const wxString GBL_CFG_OPT_CONFIG_FRED;			//!< bool, true means show the user the FRED button and allow user to select FRED executable
+extern const GlobalKey<bool> GBL_CFG_OPT_CONFIG_FRED;					//!< bool, true means show the user the FRED button and allow user to select FRED executable
+extern const GlobalKey<long> GBL_CFG_OPT_FLAG_PROBE_TIMEOUT;			//!< long, seconds an executable has to write its flag file before it is killed
+
+extern const GlobalKey<wxString> GBL_CFG_PUSHED_FSO_INI;				//!< string, PushedFileRecord of fs2_open.ini
+extern const GlobalKey<wxString> GBL_CFG_PUSHED_CMDLINE;				//!< string, PushedFileRecord of cmdline_fso.cfg
 /** @}*/
 
 /** \defgroup profilekeys Keys used in profiles */
 /** @{*/
-extern const wxString PRO_CFG_MAIN_NAME;				//!< string, name of profile
-extern const wxString PRO_CFG_MAIN_FILENAME;			//!< string, full path to profile
-extern const wxString PRO_CFG_MAIN_INITIALIZED;			//!< bool, indicates whether profile has been saved with initial GUI values
-
-extern const wxString PRO_CFG_TC_ROOT_FOLDER;			//!< string, absolute path
-extern const wxString PRO_CFG_TC_CURRENT_BINARY;		//!< string, binary name
-extern const wxString PRO_CFG_TC_CURRENT_MODLINE;		//!< string, the entire line that should follow -mod
-extern const wxString PRO_CFG_TC_CURRENT_MOD;			//!< string, the mod shortname (for modlist)
-extern const wxString PRO_CFG_TC_CURRENT_FLAG_LINE;		//!< string, the flags that we as the modline to to make the cmdline
-extern const wxString PRO_CFG_TC_CURRENT_FRED;			//!< string, FRED binary's name
-
-extern const wxString PRO_CFG_VIDEO_RESOLUTION_WIDTH;	//!< int
-extern const wxString PRO_CFG_VIDEO_RESOLUTION_HEIGHT;	//!< int
+extern const ProfileKey<wxString> PRO_CFG_MAIN_NAME;					//!< string, name of profile
+extern const ProfileKey<wxString> PRO_CFG_MAIN_FILENAME;				//!< string, full path to profile
+extern const ProfileKey<bool> PRO_CFG_MAIN_INITIALIZED;					//!< bool, indicates whether profile has been saved with initial GUI values
+
+extern const ProfileKey<wxString> PRO_CFG_TC_ROOT_FOLDER;				//!< string, absolute path
+extern const ProfileKey<wxString> PRO_CFG_TC_CURRENT_BINARY;			//!< string, binary name
+extern const ProfileKey<wxString> PRO_CFG_TC_CURRENT_MODLINE;			//!< string, the entire line that should follow -mod
+extern const ProfileKey<wxString> PRO_CFG_TC_CURRENT_MOD;				//!< string, the mod shortname (for modlist)
+extern const ProfileKey<wxString> PRO_CFG_TC_CURRENT_FLAG_LINE;			//!< string, the flags that we as the modline to to make the cmdline
+extern const ProfileKey<wxString> PRO_CFG_TC_CURRENT_FRED;				//!< string, FRED binary's name
+
+extern const ProfileKey<long> PRO_CFG_VIDEO_RESOLUTION_WIDTH;			//!< long
+extern const ProfileKey<long> PRO_CFG_VIDEO_RESOLUTION_HEIGHT;			//!< long
 extern const wxString CFG_RES_FORMAT_STRING;
-extern const wxString PRO_CFG_VIDEO_BIT_DEPTH;			//!< int
-extern const wxString PRO_CFG_VIDEO_ANISOTROPIC;		//!< int
-extern const wxString PRO_CFG_VIDEO_ANTI_ALIAS;			//!< int
-extern const wxString PRO_CFG_VIDEO_TEXTURE_FILTER;		//!< string
-
-extern const wxString PRO_CFG_LIGHTING_PRESET;			//!< string
-
-extern const wxString PRO_CFG_SPEECH_VOICE;				//!< int, same as what the current engine uses
-extern const wxString PRO_CFG_SPEECH_VOLUME;			//!< int
-extern const wxString PRO_CFG_SPEECH_IN_TECHROOM;		//!< bool
-extern const wxString PRO_CFG_SPEECH_IN_BRIEFINGS;		//!< bool
-extern const wxString PRO_CFG_SPEECH_IN_GAME;			//!< bool
-extern const wxString PRO_CFG_SPEECH_IN_MULTI;			//!< bool
-
-extern const wxString PRO_CFG_NETWORK_TYPE;				//!< string
-extern const wxString PRO_CFG_NETWORK_SPEED;			//!< string
-extern const wxString PRO_CFG_NETWORK_PORT;				//!< int
-extern const wxString PRO_CFG_NETWORK_IP;				//!< string
-
-extern const wxString PRO_CFG_OPENAL_DEVICE;			//!< string
-extern const wxString PRO_CFG_OPENAL_CAPTURE_DEVICE;	//!< string
-extern const wxString PRO_CFG_OPENAL_EFX;				//!< bool
-extern const wxString PRO_CFG_OPENAL_SAMPLE_RATE;		//!< int
-
-extern const wxString PRO_CFG_JOYSTICK_ID;				//!< int
-extern const wxString PRO_CFG_JOYSTICK_FORCE_FEEDBACK;	//!< bool
-extern const wxString PRO_CFG_JOYSTICK_DIRECTIONAL;		//!< bool
+extern const ProfileKey<long> PRO_CFG_VIDEO_BIT_DEPTH;					//!< long
+extern const ProfileKey<long> PRO_CFG_VIDEO_ANISOTROPIC;				//!< long
+extern const ProfileKey<long> PRO_CFG_VIDEO_ANTI_ALIAS;					//!< long
+extern const ProfileKey<wxString> PRO_CFG_VIDEO_TEXTURE_FILTER;			//!< string
+
+extern const ProfileKey<wxString> PRO_CFG_LIGHTING_PRESET;				//!< string
+
+extern const ProfileKey<long> PRO_CFG_SPEECH_VOICE;						//!< long, same as what the current engine uses
+extern const ProfileKey<long> PRO_CFG_SPEECH_VOLUME;					//!< long
+extern const ProfileKey<bool> PRO_CFG_SPEECH_IN_TECHROOM;				//!< bool
+extern const ProfileKey<bool> PRO_CFG_SPEECH_IN_BRIEFINGS;				//!< bool
+extern const ProfileKey<bool> PRO_CFG_SPEECH_IN_GAME;					//!< bool
+extern const ProfileKey<bool> PRO_CFG_SPEECH_IN_MULTI;					//!< bool
+
+extern const ProfileKey<wxString> PRO_CFG_NETWORK_TYPE;					//!< string
+extern const ProfileKey<wxString> PRO_CFG_NETWORK_SPEED;				//!< string
+extern const ProfileKey<long> PRO_CFG_NETWORK_PORT;						//!< long
+extern const ProfileKey<wxString> PRO_CFG_NETWORK_IP;					//!< string
+
+extern const ProfileKey<wxString> PRO_CFG_OPENAL_DEVICE;				//!< string
+extern const ProfileKey<wxString> PRO_CFG_OPENAL_CAPTURE_DEVICE;		//!< string
+extern const ProfileKey<bool> PRO_CFG_OPENAL_EFX;						//!< bool
+extern const ProfileKey<long> PRO_CFG_OPENAL_SAMPLE_RATE;				//!< long
+
+extern const ProfileKey<long> PRO_CFG_JOYSTICK_ID;						//!< long
+extern const ProfileKey<bool> PRO_CFG_JOYSTICK_FORCE_FEEDBACK;			//!< bool
+extern const ProfileKey<bool> PRO_CFG_JOYSTICK_DIRECTIONAL;				//!< bool
 /** @}*/
 
 #endif
@@ -57,3 +57,47 @@ namespace TextUtils {
 		}
 	}
 }
+
+namespace HashUtils {
+	const wxUint64 FNV_OFFSET_BASIS = wxULL(14695981039346656037);
+	const wxUint64 FNV_PRIME = wxULL(1099511628211);
+
+	inline void HashBytes(wxUint64& hash, const unsigned char* bytes, size_t count) {
+		for (size_t i = 0; i < count; i++) {
+			hash ^= bytes[i];
+			hash *= FNV_PRIME;
+		}
+	}
+
+	inline wxString HashToString(wxUint64 hash) {
+		return wxString::Format(_T("%08x%08x"),
+			static_cast<unsigned int>((hash >> 32) & 0xFFFFFFFF),
+			static_cast<unsigned int>(hash & 0xFFFFFFFF));
+	}
+
+	wxString HashBuffer(const void* data, size_t size) {
+		wxUint64 hash = FNV_OFFSET_BASIS;
+		HashBytes(hash, static_cast<const unsigned char*>(data), size);
+		return HashToString(hash);
+	}
+
+	// the file is read through the C library, because wxFFile logs its failures
+	wxString HashFileContents(const wxString& filename) {
+		FILE* file = wxFopen(filename, _T("rb"));
+		if (file == NULL) {
+			return wxEmptyString;
+		}
+
+		wxUint64 hash = FNV_OFFSET_BASIS;
+		unsigned char buffer[64*1024];
+		size_t bytesRead;
+		do {
+			bytesRead = fread(buffer, 1, sizeof(buffer), file);
+			HashBytes(hash, buffer, bytesRead);
+		} while (bytesRead == sizeof(buffer));
+
+		const bool ok = (ferror(file) == 0);
+		fclose(file);
+		return ok ? HashToString(hash) : wxString(wxEmptyString);
+	}
+}
@@ -39,6 +39,16 @@ namespace TextUtils {
 									bool useAppleDebugFilter = false);
 }
 
+/** 64-bit FNV-1a hashes, as hex strings, for telling whether contents have
+ changed. They do not log, so they can be used on worker threads. */
+namespace HashUtils {
+	/** Hashes size bytes at data. */
+	wxString HashBuffer(const void* data, size_t size);
+	/** Hashes the contents of a file.
+	 Returns an empty string if the file could not be read. */
+	wxString HashFileContents(const wxString& filename);
+}
+
 #if _WIN32
 #define SZT wxT("%Iu")
 #else
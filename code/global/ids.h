@@ -44,6 +44,8 @@ enum WindowIDS {
 	ID_FRED2_PROCESS,
 	
 	ID_F3_PRESSED,
+	ID_UNDO_PRESSED,
+	ID_REDO_PRESSED,
 
 	ID_PROFILE_COMBO,
 	ID_NEW_PROFILE,
@@ -112,9 +114,11 @@ enum WindowIDS {
 	ID_MODLISTBOX,
 	ID_MODLISTBOX_ACTIVATE_BUTTON,
 	ID_MODLISTBOX_INFO_BUTTON,
+	ID_TC_FOLDER_WATCHER_TIMER,
 
 	ID_STATUSBAR_STATUS_ICON,
 	ID_STATUSBAR_PROGRESS_BAR,
+	ID_STATUSBAR_PREWARM_CANCEL_BUTTON,
 
 	ID_EXE_ROOT_FOLDER_BOX_TEXT,
 	ID_EXE_ROOT_FOLDER_BOX,
@@ -129,13 +133,20 @@ enum WindowIDS {
 	ID_CLONE_PROFILE_NEWNAME,
 	ID_CLONE_PROFILE_CHECKBOX,
 	ID_DELETE_PROFILE_DIALOG,
+	ID_PROFILE_RELOAD_TIMER,
 
 	// Advanced settings page
 	ID_FLAGLISTBOX,
+	ID_FLAG_SEARCH_TEXT,
 	ID_SELECT_FLAG_SET,
 	ID_CUSTOM_FLAGS_TEXT,
 	ID_COMMAND_LINE_TEXT,
 	ID_FLAG_SET_NOTES_TEXT,
+	ID_CANCEL_FLAG_FILE_BUTTON,
+	ID_FLAG_FILE_PREWARM_TIMER,
+	ID_FLAG_FILE_PREWARM_DEADLINE_TIMER,
+	ID_FLAG_FILE_PROBE_DEADLINE_TIMER,
+	ID_FLAG_FILE_PROBE_RETRY_TIMER,
 
 	ID_NET_DOWNLOAD_NEWS,
 	ID_EVENT_NET_DOWNLOAD_NEWS,
@@ -32,13 +32,15 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "global/Utils.h"
 
 #include <wx/html/htmlwin.h>
+#include <wx/srchctrl.h>
 #include <wx/tokenzr.h>
 
 #include "global/MemoryDebugging.h" // Last include for memory debugging
 
 const size_t TOP_SIZER_INDEX = 0;
 const size_t TOP_LEFT_SIZER_INDEX = 0;
-const size_t WIKI_LINK_SIZER_INDEX = 1;
+const size_t FLAG_SEARCH_INDEX = 0;
+const size_t WIKI_LINK_SIZER_INDEX = 2;
 const size_t TOP_RIGHT_SIZER_INDEX = 1;
 const size_t BOTTOM_SIZER_INDEX = 1;
 
@@ -47,6 +49,8 @@ AdvSettingsPage::AdvSettingsPage(wxWindow* parent): wxPanel(parent, wxID_ANY), f
 	this->errorText =
 		new wxStaticText(this, wxID_ANY, wxEmptyString, wxDefaultPosition,
 			wxDefaultSize, wxALIGN_CENTER);
+	this->cancelButton = new wxButton(this, ID_CANCEL_FLAG_FILE_BUTTON, _("Cancel"));
+	this->cancelButton->Hide();
 	
 	wxLogDebug(_T("AdvSettingsPage is at %p."), this);
 
@@ -67,7 +71,10 @@ EVT_COMMAND(wxID_NONE, EVT_CMD_LINE_CHANGED, AdvSettingsPage::OnNeedUpdateComman
 EVT_COMMAND(wxID_NONE, EVT_CUSTOM_FLAGS_CHANGED, AdvSettingsPage::OnNeedUpdateCustomFlags)
 EVT_COMMAND(wxID_NONE, EVT_FLAG_LIST_BOX_READY, AdvSettingsPage::OnFlagListBoxReady)
 EVT_TEXT(ID_CUSTOM_FLAGS_TEXT, AdvSettingsPage::OnCustomFlagsBoxChanged)
+EVT_TEXT(ID_FLAG_SEARCH_TEXT, AdvSettingsPage::OnFlagSearchChanged)
+EVT_SEARCHCTRL_CANCEL_BTN(ID_FLAG_SEARCH_TEXT, AdvSettingsPage::OnFlagSearchCancelled)
 EVT_CHOICE(ID_SELECT_FLAG_SET, AdvSettingsPage::OnSelectFlagSet)
+EVT_BUTTON(ID_CANCEL_FLAG_FILE_BUTTON, AdvSettingsPage::OnCancelFlagFileProcessing)
 END_EVENT_TABLE()
 
 // FIXME HACK for now, hard-code flag list box height (sigh)
@@ -93,6 +100,10 @@ void AdvSettingsPage::OnExeChanged(wxCommandEvent& event) {
 	this->flagListBox = new FlagListBox(this);
 	this->flagListBox->RegisterFlagListBoxReady(this);
 	FlagListManager::GetFlagListManager()->BeginFlagFileProcessing();
+	
+	wxSearchCtrl* flagSearch = new wxSearchCtrl(this, ID_FLAG_SEARCH_TEXT);
+	flagSearch->ShowCancelButton(true);
+	flagSearch->SetDescriptiveText(_("Search flags"));
 
 #if 0 // doesn't do anything
 	wxHtmlWindow* description = new wxHtmlWindow(this);
@@ -117,6 +128,7 @@ void AdvSettingsPage::OnExeChanged(wxCommandEvent& event) {
 #endif
 
 	wxBoxSizer* topLeftSizer = new wxBoxSizer(wxVERTICAL);
+	topLeftSizer->Add(flagSearch, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
 	topLeftSizer->Add(this->flagListBox, wxSizerFlags().Proportion(1).Expand());
 	topLeftSizer->Add(wikiLinkSizer, 0, wxALIGN_CENTER_HORIZONTAL|wxTOP, 5);
 
@@ -207,6 +219,7 @@ void AdvSettingsPage::OnFlagFileProcessingStatusChanged(wxCommandEvent &event) {
 	this->UpdateComponents();
 	
 	if (status == FlagListManager::FLAG_FILE_PROCESSING_OK) {
+		this->cancelButton->Hide();
 		FlagFileData* flagData = FlagListManager::GetFlagListManager()->GetFlagFileData();
 		wxCHECK_RET(flagData != NULL,
 			_T("Flag file processing succeeded but could not retrieve extracted data."));
@@ -216,6 +229,12 @@ void AdvSettingsPage::OnFlagFileProcessingStatusChanged(wxCommandEvent &event) {
 	}
 }
 
+/** Stops waiting for an executable that hangs when asked for its flag file,
+ rather than waiting for it to time out. */
+void AdvSettingsPage::OnCancelFlagFileProcessing(wxCommandEvent &WXUNUSED(event)) {
+	FlagListManager::GetFlagListManager()->CancelFlagFileProcessing();
+}
+
 void AdvSettingsPage::OnNeedUpdateCustomFlags(wxCommandEvent &event) {
 	wxASSERT((this->flagListBox != NULL) && this->flagListBox->IsReady());
 	wxASSERT(ProfileProxy::GetProxy()->IsFlagDataReady());
@@ -265,13 +284,16 @@ void AdvSettingsPage::UpdateComponents() {
 	
 	if (this->flagListBox->IsReady()) {
 		topSizer->Show(TOP_RIGHT_SIZER_INDEX);
+		topLeftSizer->Show(FLAG_SEARCH_INDEX);
 		topLeftSizer->Show(WIKI_LINK_SIZER_INDEX);
 		this->GetSizer()->Show(BOTTOM_SIZER_INDEX);
 		this->flagListBox->Show();
 		this->errorText->Hide();
+		this->cancelButton->Hide();
 		this->Layout();
 	} else {
 		topSizer->Hide(TOP_RIGHT_SIZER_INDEX);
+		topLeftSizer->Hide(FLAG_SEARCH_INDEX);
 		topLeftSizer->Hide(WIKI_LINK_SIZER_INDEX);
 		this->GetSizer()->Hide(BOTTOM_SIZER_INDEX);
 		this->flagListBox->Hide();
@@ -297,6 +319,15 @@ void AdvSettingsPage::UpdateErrorText() {
 	this->errorText->SetSize(rect, wxSIZE_FORCE);
 	this->errorText->Wrap(rect.width - 225); // to match mods page
 	this->errorText->Center();
+	
+	if (FlagListManager::GetFlagListManager()->IsWaitingForFlagFile()) {
+		const wxRect textRect(this->errorText->GetRect());
+		this->cancelButton->Move(
+			(rect.width - this->cancelButton->GetSize().x) / 2, textRect.GetBottom() + 10);
+		this->cancelButton->Show();
+	} else {
+		this->cancelButton->Hide();
+	}
 }
 
 void AdvSettingsPage::OnCustomFlagsBoxChanged(wxCommandEvent &WXUNUSED(event)) {
@@ -311,6 +342,26 @@ void AdvSettingsPage::OnCustomFlagsBoxChanged(wxCommandEvent &WXUNUSED(event)) {
 	ProfileProxy::GetProxy()->SetCustomFlags(customFlagsText->GetValue(), false);
 }
 
+/** Filters the flag list as the user types, so this is called for every key. */
+void AdvSettingsPage::OnFlagSearchChanged(wxCommandEvent &event) {
+	wxCHECK_RET(this->flagListBox != NULL,
+		_T("OnFlagSearchChanged() called when flagListBox was null."));
+	if (!this->flagListBox->IsReady()) {
+		return; // the search box is hidden until the flags are shown
+	}
+	
+	this->flagListBox->SetFilter(event.GetString());
+}
+
+void AdvSettingsPage::OnFlagSearchCancelled(wxCommandEvent &WXUNUSED(event)) {
+	wxSearchCtrl* flagSearch = dynamic_cast<wxSearchCtrl*>(
+		wxWindow::FindWindowById(ID_FLAG_SEARCH_TEXT, this));
+	wxCHECK_RET(flagSearch != NULL,
+		_T("Unable to find the flag search ctrl"));
+	
+	flagSearch->Clear(); // which filters the list through OnFlagSearchChanged()
+}
+
 void AdvSettingsPage::UpdateFlagSetsBox() {
 	wxASSERT(this->flagListBox != NULL);
 	wxASSERT(this->flagListBox->IsReady());
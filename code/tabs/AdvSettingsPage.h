@@ -38,13 +38,17 @@ private:
 	FlagListBox* flagListBox;
 	LightingPresets* lightingPresets;
 	wxStaticText* errorText;
+	wxButton* cancelButton; //!< shown while waiting for the flag file
 	
 public:
 	void OnExeChanged(wxCommandEvent& event);
 	void OnSelectFlagSet(wxCommandEvent& event);
 	void OnFlagFileProcessingStatusChanged(wxCommandEvent& event);
+	void OnCancelFlagFileProcessing(wxCommandEvent& event);
 	void OnNeedUpdateCustomFlags(wxCommandEvent& event);
 	void OnCustomFlagsBoxChanged(wxCommandEvent& event);
+	void OnFlagSearchChanged(wxCommandEvent& event);
+	void OnFlagSearchCancelled(wxCommandEvent& event);
 	void OnFlagListBoxReady(wxCommandEvent& event);
 	void OnProxyFlagDataReady(wxCommandEvent& event);
 
@@ -1789,20 +1789,20 @@ void BasicSettingsPage::InitializeSoundDeviceDropDownBox(
 	
 	WindowIDS deviceDropDownBoxID;
 	wxString deviceTypeNameAdjustment;
-	wxString deviceProfileEntryName;
+	const ProfileKey<wxString>* deviceProfileEntry = NULL;
 	wxArrayString availableDevices;
 	wxString defaultDevice;
 	
 	if (deviceType == PLAYBACK) {
 		deviceDropDownBoxID = ID_SELECT_SOUND_DEVICE;
 		// (deviceTypeNameAdjustment remains empty in this case)
-		deviceProfileEntryName = PRO_CFG_OPENAL_DEVICE;
+		deviceProfileEntry = &PRO_CFG_OPENAL_DEVICE;
 		availableDevices = OpenALMan::GetAvailablePlaybackDevices();
 		defaultDevice = OpenALMan::GetSystemDefaultPlaybackDevice();
 	} else {
 		deviceDropDownBoxID = ID_SELECT_CAPTURE_DEVICE;
 		deviceTypeNameAdjustment = _T(" capture");
-		deviceProfileEntryName = PRO_CFG_OPENAL_CAPTURE_DEVICE;
+		deviceProfileEntry = &PRO_CFG_OPENAL_CAPTURE_DEVICE;
 		availableDevices = OpenALMan::GetAvailableCaptureDevices();
 		defaultDevice = OpenALMan::GetSystemDefaultCaptureDevice();
 	}
@@ -1823,7 +1823,7 @@ void BasicSettingsPage::InitializeSoundDeviceDropDownBox(
 			deviceDropDownBox->GetCount(),
 			deviceDropDownBox->GetString(0).c_str()));
 	
-	wxASSERT(!deviceProfileEntryName.IsEmpty());
+	wxASSERT(deviceProfileEntry != NULL);
 	
 	if (availableDevices.IsEmpty()) {
 		if (deviceType == PLAYBACK) {
@@ -1843,7 +1843,7 @@ void BasicSettingsPage::InitializeSoundDeviceDropDownBox(
 	
 	wxString device;
 	
-	if (ProMan::GetProfileManager()->ProfileRead(deviceProfileEntryName, &device)) {
+	if (ProMan::GetProfileManager()->ProfileRead(*deviceProfileEntry, &device)) {
 		deviceDropDownBox->SetStringSelection(device);
 	} else {
 		wxLogDebug(_T("Reported default sound%s device: %s"),
@@ -1863,13 +1863,13 @@ void BasicSettingsPage::InitializeSoundDeviceDropDownBox(
 	}
 	
 	// update current profile if necessary
-	if (!ProMan::GetProfileManager()->ProfileRead(deviceProfileEntryName, &device) ||
+	if (!ProMan::GetProfileManager()->ProfileRead(*deviceProfileEntry, &device) ||
 		(device != deviceDropDownBox->GetStringSelection())) {
 		wxLogDebug(_T("updating OpenAL sound%s device profile entry to \"%s\""),
 			deviceTypeNameAdjustment.c_str(),
 			deviceDropDownBox->GetStringSelection().c_str());
 		ProMan::GetProfileManager()->ProfileWrite(
-			deviceProfileEntryName,
+			*deviceProfileEntry,
 			deviceDropDownBox->GetStringSelection());
 	}
 }
@@ -43,6 +43,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "apis/ProfileManager.h"
 #include "apis/HelpManager.h"
 #include "apis/FlagListManager.h"
+#include "apis/FlagFilePrewarmer.h"
 #include "apis/ProfileProxy.h"
 
 #include "global/MemoryDebugging.h" // Last include for memory debugging
@@ -64,10 +65,20 @@ void wxLauncher::OnInitCmdLine(wxCmdLineParser& parser)
 	static const char selectprofiledesc[] =
 		"Make PROFILE the that wxLauncher will use "
 		"on next run. *Operator*";
+	static const char importprofilesdesc[] =
+		"Import every profile listed in the manifest FILE, or every .ini "
+		"file in FOLDER. Each line of a manifest is a profile's name and "
+		"its file, separated by a tab. Profiles that already exist will "
+		"not be overwritten. *Operator*";
+	static const char exportprofilesdesc[] =
+		"Export every profile listed in the manifest FILE to the file next "
+		"to it, or every profile to FOLDER. *Operator*";
 	static const char profiledesc[] =
 		"The name of a profile to operate on. Operand PROFILE.";
 	static const char filedesc[] =
 		"The path to a file to operate on. Operand FILE.";
+	static const char folderdesc[] =
+		"The path to a folder to operate on. Operand FOLDER.";
 	static const char sessiononlydesc[] =
 		"Do not remember the profile that is selected at exit";
 
@@ -76,6 +87,10 @@ void wxLauncher::OnInitCmdLine(wxCmdLineParser& parser)
 		wxGetTranslation(wxString::FromUTF8(addprofiledesc)));
 	parser.AddSwitch(wxEmptyString, wxT_2("select-profile"),
 		wxGetTranslation(wxString::FromUTF8(selectprofiledesc)));
+	parser.AddSwitch(wxEmptyString, wxT_2("import-profiles"),
+		wxGetTranslation(wxString::FromUTF8(importprofilesdesc)));
+	parser.AddSwitch(wxEmptyString, wxT_2("export-profiles"),
+		wxGetTranslation(wxString::FromUTF8(exportprofilesdesc)));
 
 	/* Operands */
 	parser.AddOption(wxEmptyString, wxT_2("profile"),
@@ -84,6 +99,9 @@ void wxLauncher::OnInitCmdLine(wxCmdLineParser& parser)
 	parser.AddOption(wxEmptyString, wxT_2("file"),
 		wxGetTranslation(wxString::FromUTF8(filedesc)),
 		wxCMD_LINE_VAL_STRING);
+	parser.AddOption(wxEmptyString, wxT_2("folder"),
+		wxGetTranslation(wxString::FromUTF8(folderdesc)),
+		wxCMD_LINE_VAL_STRING);
 
 	/* Other */
 	parser.AddSwitch(wxEmptyString, wxT_2("session-only"),
@@ -127,6 +145,18 @@ bool wxLauncher::OnCmdLineParsed(wxCmdLineParser& parser)
 			return false;
 		}
 	}
+	else if (parser.Found(wxT_2("import-profiles"))
+		|| parser.Found(wxT_2("export-profiles")))
+	{
+		mProfileOperator = parser.Found(wxT_2("import-profiles"))
+			? ProManOperator::importBatch : ProManOperator::exportBatch;
+		if (!parser.Found(wxT_2("file"), &mFileOperand)
+			&& !parser.Found(wxT_2("folder"), &mFolderOperand))
+		{
+			wxLogError(_("No manifest file or folder specified"));
+			return false;
+		}
+	}
 
 	return true;
 }
@@ -247,6 +277,9 @@ bool wxLauncher::OnInit() {
 	wxLogInfo(wxT_2("Initializing FlagListManager..."));
 	FlagListManager::Initialize();
 	
+	wxLogInfo(wxT_2("Initializing FlagFilePrewarmer..."));
+	FlagFilePrewarmer::Initialize();
+	
 	wxLogInfo(wxT_2("Initializing ProfileProxy..."));
 	ProfileProxy::Initialize();
 
@@ -280,6 +313,7 @@ int wxLauncher::OnExit() {
 
 		// deinitialize subsystems in the opposite order of initialization
 		ProfileProxy::DeInitialize();
+		FlagFilePrewarmer::DeInitialize();
 		FlagListManager::DeInitialize();
 		HelpManager::DeInitialize();
 		SkinSystem::DeInitialize();
@@ -32,6 +32,7 @@ public:
 	virtual bool OnCmdLineParsed(wxCmdLineParser& parser);
 
 	wxString mFileOperand;
+	wxString mFolderOperand;
 	wxString mProfileOperand;
 	ProManOperator::profileOperator mProfileOperator;
 	bool mKeepForSessionOnly;